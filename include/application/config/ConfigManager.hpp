@@ -8,6 +8,7 @@
 #include <unordered_map>
 #include <mutex>
 #include <algorithm>
+#include <vector>
 
 namespace core::config {
     struct PrinterCheckConfig {
@@ -25,6 +26,13 @@ namespace core::config {
         int highPriorityThreshold = 3;
         bool enableDiskPaging = true;
         std::string diskPagePath = "temp/queue";
+        std::string jobArchivePath = "temp/jobs"; // Archivio dei job conclusi oltre maxCompletedJobs
+        std::string checkpointPath = "temp/jobs/job.checkpoint"; // Ripresa dopo un'interruzione di corrente
+        int checkpointSyncMs = 1000;                             // Intervallo di msync del checkpoint
+        size_t streamMarginLines = 0; // Righe scaricate prima di avviare un job da URL; 0 = attende il file intero
+        int downloadConnections = 1;  // Connessioni in parallelo per i file grandi (1 = download sequenziale)
+        size_t downloadParallelMinBytes = 8 * 1024 * 1024; // Sotto questa dimensione una sola connessione
+        int downloadRetryMaxMs = 60000; // Tetto dell'attesa esponenziale tra i tentativi di download
     };
 
     struct SerialConfig {
@@ -33,6 +41,28 @@ namespace core::config {
         int maxRetries = 5;
         int retryDelayMs = 100;
         bool enableKeepAlive = true;
+        int initialRtoMs = 3000;
+        int minRtoMs = 50;
+        int maxRtoMs = 300000;
+        int maxRetransmits = 3;
+        int maxOverflowBackoffMs = 2000;
+        bool binaryFraming = true; // Negozia il framing binario se il firmware lo annuncia
+        std::string capturePath;   // Se valorizzato registra il traffico seriale su file
+        std::string replayPath;    // Se valorizzato sostituisce la porta reale con il replay della cattura
+        double replaySpeed = 1.0;  // 0 = nessuna attesa
+        int telemetryIntervalMs = 1000; // Auto-report firmware (0 = stato solo da query)
+        int reconnectTimeoutMs = 5000;  // Attesa del device dopo CONN_LOST (riconnessione senza reset)
+        int bootTimeoutMs = 10000;      // Attesa del banner "Sistema pronto." dopo il reset DTR
+    };
+
+    /**
+     * @brief Una stampante del processo: porta seriale, driverId con cui arrivano le richieste Kafka e core
+     */
+    struct PrinterConfig {
+        std::string driverId;
+        std::string serialPort;
+        int baudrate = 115200;
+        int cpuCore = -1; // Core su cui fissare i thread seriale/esecutore (-1 = nessun vincolo)
     };
 
     struct PerformanceConfig {
@@ -43,6 +73,15 @@ namespace core::config {
         int backgroundPollInterval = 2000; // ms
     };
 
+    struct LoggingConfig {
+        std::string level;           // Tutti i moduli (vuoto = livello minimo compilato)
+        std::string translatorLevel; // Sovrascrive il livello per modulo
+        std::string serialLevel;
+        std::string queueLevel;
+        std::string kafkaLevel;
+        std::string tracePath;       // Se valorizzato registra gli eventi ad alta frequenza nel trace binario
+    };
+
     class ConfigManager {
     public:
         static ConfigManager &getInstance();
@@ -61,6 +100,19 @@ namespace core::config {
 
         PerformanceConfig getPerformanceConfig() const;
 
+        LoggingConfig getLoggingConfig() const;
+
+        /**
+         * @brief Stampanti da PRINTERS ("id=porta[@baud][#core]", separate da virgola).
+         * @return Vuoto se PRINTERS non è impostata: una sola stampante da DRIVER_ID / SERIAL_PORT
+         */
+        std::vector<PrinterConfig> getPrinterConfigs() const;
+
+        /**
+         * @brief Core della stampante singola (PRINTER_CPU_CORE), -1 = nessun vincolo
+         */
+        int getPrinterCpuCore() const;
+
         // Generic getters with defaults
         template<typename T>
         T get(const std::string &key, const T &defaultValue) const;
@@ -8,12 +8,13 @@
 #include <thread>
 #include <chrono>
 #include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
 
 // Core includes
-#include "core/serial/impl/RealSerialPort.hpp"
-#include "core/printer/impl/RealPrinter.hpp"
-#include "core/DriverInterface.hpp"
-#include "core/queue/CommandExecutorQueue.hpp"
+#include "core/printer/registry/PrinterRegistry.hpp"
 
 // Connector includes
 #include "connector/controllers/HeartbeatController.hpp"
@@ -28,7 +29,7 @@
  * @brief Main application controller for the 3D Printer Driver
  *
  * This class orchestrates the entire 3D printer driver application:
- * - Initializes hardware connections (serial port, printer)
+ * - Initializes hardware connections (serial port, printer) for every configured printer
  * - Sets up the GCode translation system with dispatchers
  * - Manages the command execution queue (always active)
  * - Initializes and manages Kafka controllers for remote communication
@@ -53,13 +54,17 @@ public:
      * @brief Initialize all application components
      *
      * Initialization sequence:
-     * 1. Hardware (serial port, printer, driver)
-     * 2. GCode Translator and dispatchers
-     * 3. Command Executor Queue (always running)
-     * 4. Kafka Controllers (optional - system works offline)
+     * 1. Serial link and driver objects (DTR reset, no boot wait)
+     * 2. GCode Translator, dispatchers and Command Executor Queue (always running)
+     * 3. Firmware ready banner of every printer and Kafka Controllers, concurrently
+     *    (optional - system works offline; early commands wait for the link)
+     * 4. Command Queue verification
      * 5. System Monitor
      *
-     * @return true if initialization successful, false otherwise
+     * A printer that fails steps 1-3 is marked offline and the others keep running.
+     * A per-phase timing breakdown is logged at the end.
+     *
+     * @return true if at least one printer is online, false otherwise
      */
     bool initialize();
 
@@ -82,14 +87,9 @@ public:
     void shutdown();
 
 private:
-    // ========== Hardware Components ==========
-    std::shared_ptr<core::RealSerialPort> serialPort_;
-    std::shared_ptr<core::RealPrinter> printer_;
-    std::shared_ptr<core::DriverInterface> driver_;
-
-    // ========== Translation System ==========
-    std::shared_ptr<translator::gcode::GCodeTranslator> translator_;
-    std::shared_ptr<core::CommandExecutorQueue> commandQueue_;
+    // ========== Printers ==========
+    // Porta, driver, traduttore, coda comandi e job di ogni stampante (PRINTERS, o la singola di KafkaConfig)
+    std::shared_ptr<core::PrinterRegistry> printers_;
 
     // ========== Kafka Components ==========
     connector::kafka::KafkaConfig kafkaConfig_;
@@ -98,9 +98,6 @@ private:
     std::unique_ptr<connector::controllers::PrinterCheckController> printerCheckController_;
     std::unique_ptr<connector::controllers::PrinterControlController> printerControlController_;
 
-    // ========== Print Management ==========
-    std::shared_ptr<core::print::PrintJobManager> jobManager_;
-
     // ========== Monitoring ==========
     std::unique_ptr<SystemMonitor> monitor_;
 
@@ -108,21 +105,53 @@ private:
     std::atomic<bool> isRunning_;
     std::atomic<bool> initializationComplete_;
 
+    // ========== Startup Timing ==========
+    struct StartupPhase {
+        std::string name;
+        std::chrono::milliseconds offset;   // From the start of initialize()
+        std::chrono::milliseconds duration;
+        bool ok;
+    };
+
+    std::chrono::steady_clock::time_point startupBegin_;
+    std::vector<StartupPhase> startupPhases_;
+    std::mutex startupMutex_;
+
     // ========== Initialization Methods ==========
     /**
-     * @brief Initialize hardware components (serial, printer, driver)
+     * @brief Apply LOG_LEVEL / LOG_LEVEL_<MODULE> to the logger and open the LOG_TRACE_PATH trace
+     */
+    void configureLogging();
+
+    /**
+     * @brief Build the printer registry from PRINTERS (or the single KafkaConfig printer) and open
+     * the per-printer job checkpoints
+     * @return false if the printer list is invalid
+     */
+    bool registerPrinters();
+
+    /**
+     * @brief Open the serial link and create printer and driver objects.
+     * The driver link stays "not ready" until waitForHardwareReady() completes.
+     * @return true if successful, false otherwise
+     */
+    bool initializeHardware(core::PrinterContext &printer);
+
+    /**
+     * @brief Wait for the firmware ready banner, negotiate framing, probe the urgent lane and enable telemetry,
+     * then mark the link ready for queued commands
      * @return true if successful, false otherwise
      */
-    bool initializeHardware();
+    bool waitForHardwareReady(core::PrinterContext &printer);
 
     /**
      * @brief Initialize the GCode translator and command queue
      * @return true if successful, false otherwise
      */
-    bool initializeTranslator();
+    bool initializeTranslator(core::PrinterContext &printer);
 
     /**
-     * @brief Initialize all Kafka controllers
+     * @brief Initialize all Kafka controllers concurrently
      * @return true if successful (works even if Kafka offline)
      */
     bool initializeKafkaControllers();
@@ -130,18 +159,18 @@ private:
     /**
      * @brief Register all GCode command dispatchers
      */
-    void initializeDispatchers();
+    void initializeDispatchers(core::PrinterContext &printer);
 
     /**
      * @brief Initialize and start the command executor queue
      * @throws std::runtime_error if queue fails to start
      */
-    void initializeCommandExecutorQueue();
+    void initializeCommandExecutorQueue(core::PrinterContext &printer);
 
     // ========== Verification & Monitoring ==========
     /**
-     * @brief Verify that the command queue is running properly
-     * @return true if queue is active, false otherwise
+     * @brief Verify that the command queue of every printer is running properly
+     * @return true if all queues are active, false otherwise
      */
     bool verifyCommandQueueStatus();
 
@@ -160,6 +189,30 @@ private:
      */
     void stopKafkaControllers();
 
+    /**
+     * @brief Run a startup phase and record its start offset and duration (thread-safe)
+     * @return Phase result, false if it threw
+     */
+    bool runStartupPhase(const std::string &name, const std::function<bool()> &phase);
+
+    /**
+     * @brief Phase name, with the driverId appended when the process drives several printers
+     */
+    std::string phaseName(const std::string &name, const core::PrinterContext &printer) const;
+
+    /**
+     * @brief Take a printer out of service after a failed startup step: its queues stop and requests
+     * and health checks skip it, while the other printers keep running
+     */
+    void markOffline(core::PrinterContext &printer, const std::string &reason);
+
+    size_t onlinePrinters() const;
+
+    /**
+     * @brief Log the startup-phase timing breakdown and the slowest phase
+     */
+    void printStartupTiming();
+
     /**
      * @brief Print detailed initialization summary
      *
@@ -3,8 +3,7 @@
 #include "connector/controllers/HeartbeatController.hpp"
 #include "connector/controllers/PrinterCommandController.hpp"
 #include "connector/controllers/PrinterCheckController.hpp"
-#include "core/printer/impl/RealPrinter.hpp"
-#include "core/queue/CommandExecutorQueue.hpp"
+#include "core/printer/registry/PrinterRegistry.hpp"
 #include <memory>
 #include <thread>
 #include <atomic>
@@ -17,8 +16,7 @@ public:
                   std::unique_ptr<connector::controllers::PrinterCommandController> &printerCommandController,
                   std::unique_ptr<connector::controllers::PrinterCheckController> &printerCheckController,
                   std::unique_ptr<connector::controllers::PrinterControlController> &printerControlController,
-                  std::shared_ptr<core::RealPrinter> printer,
-                  std::shared_ptr<core::CommandExecutorQueue> commandQueue);
+                  std::shared_ptr<core::PrinterRegistry> printers);
 
     ~SystemMonitor();
 
@@ -36,8 +34,7 @@ private:
     std::unique_ptr<connector::controllers::PrinterCommandController> &printerCommandController_;
     std::unique_ptr<connector::controllers::PrinterCheckController> &printerCheckController_;
     std::unique_ptr<connector::controllers::PrinterControlController> &printerControlController_;
-    std::shared_ptr<core::RealPrinter> printer_;
-    std::shared_ptr<core::CommandExecutorQueue> commandQueue_;
+    std::shared_ptr<core::PrinterRegistry> printers_;
 
     void monitorLoop();
 
@@ -4,15 +4,20 @@
 #include "../events/heartbeat/HeartbeatSender.hpp"
 #include "../processors/heartbeat/HeartbeatProcessor.hpp"
 #include "../kafka/KafkaConfig.hpp"
-#include "core/DriverInterface.hpp"
+#include "core/printer/registry/PrinterRegistry.hpp"
 #include <memory>
+#include <string>
+#include <unordered_map>
 
 namespace connector::controllers {
 
+    /**
+     * @brief Un solo consumer/producer per tutte le stampanti: ogni heartbeat riceve una risposta per stampante
+     */
     class HeartbeatController {
     public:
         HeartbeatController(const kafka::KafkaConfig &config,
-                            std::shared_ptr<core::DriverInterface> driver);
+                            std::shared_ptr<core::PrinterRegistry> printers);
 
         ~HeartbeatController();
 
@@ -33,11 +38,12 @@ namespace connector::controllers {
 
     private:
         kafka::KafkaConfig config_;
-        std::shared_ptr<core::DriverInterface> driver_;
+        std::shared_ptr<core::PrinterRegistry> printers_;
 
         std::shared_ptr<events::heartbeat::HeartbeatReceiver> receiver_;
         std::shared_ptr<events::heartbeat::HeartbeatSender> sender_;
-        std::shared_ptr<processors::heartbeat::HeartbeatProcessor> processor_;
+        // Uno per stampante, per driverId
+        std::unordered_map<std::string, std::shared_ptr<processors::heartbeat::HeartbeatProcessor>> processors_;
 
         mutable Statistics stats_;
         bool running_;
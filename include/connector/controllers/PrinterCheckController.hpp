@@ -8,16 +8,15 @@
 #include "../events/printer-check/PrinterCheckSender.hpp"
 #include "../processors/printer-check/PrinterCheckProcessor.hpp"
 #include "../kafka/KafkaConfig.hpp"
-#include "core/DriverInterface.hpp"
-#include "core/queue/CommandExecutorQueue.hpp"
+#include "core/printer/registry/PrinterRegistry.hpp"
 #include <memory>
+#include <unordered_map>
 
 namespace connector::controllers {
     class PrinterCheckController {
     public:
         PrinterCheckController(const kafka::KafkaConfig &config,
-                               std::shared_ptr<core::DriverInterface> driver,
-                               std::shared_ptr<core::CommandExecutorQueue> commandQueue);
+                               std::shared_ptr<core::PrinterRegistry> printers);
 
         ~PrinterCheckController();
 
@@ -38,12 +37,12 @@ namespace connector::controllers {
 
     private:
         kafka::KafkaConfig config_;
-        std::shared_ptr<core::DriverInterface> driver_;
-        std::shared_ptr<core::CommandExecutorQueue> commandQueue_;
+        std::shared_ptr<core::PrinterRegistry> printers_;
 
         std::shared_ptr<events::printer_check::PrinterCheckReceiver> receiver_;
         std::shared_ptr<events::printer_check::PrinterCheckSender> sender_;
-        std::shared_ptr<processors::printer_check::PrinterCheckProcessor> processor_;
+        // Un processor per stampante, per driverId
+        std::unordered_map<std::string, std::shared_ptr<processors::printer_check::PrinterCheckProcessor>> processors_;
 
         mutable Statistics stats_;
         bool running_;
@@ -8,17 +8,19 @@
 #include "../events/printer-command/PrinterCommandSender.hpp"
 #include "../processors/printer-command/PrinterCommandProcessor.hpp"
 #include "../kafka/KafkaConfig.hpp"
-#include "core/DriverInterface.hpp"
-#include "core/queue/CommandExecutorQueue.hpp"
+#include "core/printer/registry/PrinterRegistry.hpp"
 #include <memory>
 #include <atomic>
+#include <unordered_map>
 
 namespace connector::controllers {
+    /**
+     * @brief Un solo consumer/producer per tutte le stampanti: le richieste vanno alla coda del loro driverId
+     */
     class PrinterCommandController {
     public:
         PrinterCommandController(kafka::KafkaConfig config,
-                                 std::shared_ptr<core::DriverInterface> driver,
-                                 std::shared_ptr<core::CommandExecutorQueue> commandQueue);
+                                 std::shared_ptr<core::PrinterRegistry> printers);
 
         ~PrinterCommandController();
 
@@ -39,12 +41,13 @@ namespace connector::controllers {
 
     private:
         kafka::KafkaConfig config_;
-        std::shared_ptr<core::DriverInterface> driver_;
-        std::shared_ptr<core::CommandExecutorQueue> commandQueue_;
+        std::shared_ptr<core::PrinterRegistry> printers_;
 
         std::shared_ptr<events::printer_command::PrinterCommandReceiver> receiver_;
         std::shared_ptr<events::printer_command::PrinterCommandSender> sender_;
-        std::shared_ptr<processors::printer_command::PrinterCommandProcessor> processor_;
+        // Un processor per stampante, per driverId
+        std::unordered_map<std::string, std::shared_ptr<processors::printer_command::PrinterCommandProcessor>>
+        processors_;
 
         mutable Statistics stats_;
         bool running_;
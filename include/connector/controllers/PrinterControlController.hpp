@@ -9,18 +9,28 @@
 #include "../events/printer-control/PrinterPauseReceiver.hpp"
 #include "../processors/printer-control/PrinterControlProcessor.hpp"
 #include "../kafka/KafkaConfig.hpp"
-#include "core/DriverInterface.hpp"
-#include "core/queue/CommandExecutorQueue.hpp"
-#include "core/printer/job/PrintJobManager.hpp"
+#include "core/printer/registry/PrinterRegistry.hpp"
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 
 namespace connector::controllers {
+    /**
+     * @brief Richieste di avvio, stop e pausa instradate per driverId.
+     *
+     * Ogni stampante ha una coda e un thread propri: i consumer Kafka condivisi si limitano a decodificare e
+     * accodare, quindi un avvio o un cancelJob lento su una stampante non ritarda le altre. Le richieste
+     * di una stessa stampante restano nell'ordine di arrivo, tranne l'e-stop: parte dal thread del consumer
+     * sulla corsia urgente (al più un RTO) senza attendere il worker; sul worker resta solo l'annullamento del job.
+     */
     class PrinterControlController {
     public:
         PrinterControlController(const kafka::KafkaConfig &config,
-                                 std::shared_ptr<core::DriverInterface> driver,
-                                 std::shared_ptr<core::CommandExecutorQueue> commandQueue,
-                                 std::shared_ptr<core::print::PrintJobManager> jobManager);
+                                 std::shared_ptr<core::PrinterRegistry> printers);
 
         ~PrinterControlController();
 
@@ -41,18 +51,39 @@ namespace connector::controllers {
 
     private:
         kafka::KafkaConfig config_;
-        std::shared_ptr<core::DriverInterface> driver_;
-        std::shared_ptr<core::CommandExecutorQueue> commandQueue_;
-        std::shared_ptr<core::print::PrintJobManager> jobManager_;
+        std::shared_ptr<core::PrinterRegistry> printers_;
 
         std::shared_ptr<events::printer_control::PrinterStartReceiver> startReceiver_;
         std::shared_ptr<events::printer_control::PrinterStopReceiver> stopReceiver_;
         std::shared_ptr<events::printer_control::PrinterPauseReceiver> pauseReceiver_;
-        std::shared_ptr<processors::printer_control::PrinterControlProcessor> processor_;
+        using Task = std::function<void(processors::printer_control::PrinterControlProcessor &)>;
+
+        struct PrinterWorker {
+            std::shared_ptr<core::PrinterContext> printer;
+            std::shared_ptr<processors::printer_control::PrinterControlProcessor> processor;
+            std::mutex mutex;
+            std::condition_variable cv;
+            std::deque<Task> tasks;
+            bool running = false;
+            std::thread thread;
+        };
+
+        // Un worker per stampante, per driverId
+        std::unordered_map<std::string, std::unique_ptr<PrinterWorker>> workers_;
 
         mutable Statistics stats_;
         bool running_;
 
+        /**
+         * @brief Accoda la richiesta sul worker della stampante
+         * @return false se la stampante non è servita da questo processo o è offline
+         */
+        bool post(const std::string &driverId, Task task);
+
+        void workerLoop(PrinterWorker &worker);
+
+        void stopWorkers();
+
         void onStartMessageReceived(const std::string &message, const std::string &key);
 
         void onStopMessageReceived(const std::string &message, const std::string &key);
@@ -49,6 +49,12 @@ namespace connector::models::printer_check {
         std::string exceptions;
         std::string logs;
 
+        // Telemetry freshness: AUTO_REPORT/POLLED, ages in ms ("-1" = never received)
+        std::string telemetrySource;
+        std::string positionAgeMs;
+        std::string temperatureAgeMs;
+        std::string fanAgeMs;
+
         PrinterCheckResponse() = default;
 
         explicit PrinterCheckResponse(const nlohmann::json &json) { fromJson(json); }
@@ -76,7 +82,11 @@ namespace connector::models::printer_check {
                 {"lastCommand", lastCommand},
                 {"averageSpeed", averageSpeed},
                 {"exceptions", exceptions},
-                {"logs", logs}
+                {"logs", logs},
+                {"telemetrySource", telemetrySource},
+                {"positionAgeMs", positionAgeMs},
+                {"temperatureAgeMs", temperatureAgeMs},
+                {"fanAgeMs", fanAgeMs}
             };
         }
 
@@ -113,6 +123,10 @@ namespace connector::models::printer_check {
             averageSpeed = safeGetString("averageSpeed");
             exceptions = safeGetString("exceptions");
             logs = safeGetString("logs");
+            telemetrySource = safeGetString("telemetrySource");
+            positionAgeMs = safeGetString("positionAgeMs");
+            temperatureAgeMs = safeGetString("temperatureAgeMs");
+            fanAgeMs = safeGetString("fanAgeMs");
         }
 
         bool isValid() const override {
@@ -10,9 +10,14 @@ namespace connector::models::printer_control {
     class PrinterStartRequest : public BaseModel {
     public:
         std::string driverId;
+        std::string jobId;   // Facoltativo: se vuoto il driver ne genera uno
         std::string startGCode;
         std::string endGCode;
         std::string gcodeUrl;
+        bool resume = false; // Riprende il job interrotto dal checkpoint invece di avviarne uno nuovo
+        bool axesReferenced = false; // Con resume: X/Y di nuovo referenziati e Z impostata dall'operatore
+        int priority = 5;    // Posizione nella coda dei job (numero più basso = prima)
+        bool releaseQueue = false; // Riavvia la coda dei job fermata da uno stop
 
         PrinterStartRequest() = default;
 
@@ -27,9 +32,14 @@ namespace connector::models::printer_control {
         nlohmann::json toJson() const override {
             return nlohmann::json{
                 {"driverId", driverId},
+                {"jobId", jobId},
                 {"startGCode", startGCode},
                 {"endGCode", endGCode},
-                {"gcodeUrl", gcodeUrl}
+                {"gcodeUrl", gcodeUrl},
+                {"resume", resume},
+                {"axesReferenced", axesReferenced},
+                {"priority", priority},
+                {"releaseQueue", releaseQueue}
             };
         }
 
@@ -37,6 +47,9 @@ namespace connector::models::printer_control {
             driverId = json.at("driverId").get<std::string>();
 
             // Optional fields - handle null safely
+            if (json.contains("jobId") && !json["jobId"].is_null()) {
+                jobId = json["jobId"].get<std::string>();
+            }
             if (json.contains("startGCode") && !json["startGCode"].is_null()) {
                 startGCode = json["startGCode"].get<std::string>();
             }
@@ -46,10 +59,22 @@ namespace connector::models::printer_control {
             if (json.contains("gcodeUrl") && !json["gcodeUrl"].is_null()) {
                 gcodeUrl = json["gcodeUrl"].get<std::string>();
             }
+            if (json.contains("resume") && !json["resume"].is_null()) {
+                resume = json["resume"].get<bool>();
+            }
+            if (json.contains("axesReferenced") && !json["axesReferenced"].is_null()) {
+                axesReferenced = json["axesReferenced"].get<bool>();
+            }
+            if (json.contains("priority") && !json["priority"].is_null()) {
+                priority = json["priority"].get<int>();
+            }
+            if (json.contains("releaseQueue") && !json["releaseQueue"].is_null()) {
+                releaseQueue = json["releaseQueue"].get<bool>();
+            }
         }
 
         bool isValid() const override {
-            return !driverId.empty() && (!gcodeUrl.empty() || !startGCode.empty());
+            return !driverId.empty() && (resume || releaseQueue || !gcodeUrl.empty() || !startGCode.empty());
         }
 
         std::string getTypeName() const override {
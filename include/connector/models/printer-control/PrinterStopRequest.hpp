@@ -11,6 +11,7 @@ namespace connector::models::printer_control {
     class PrinterStopRequest : public BaseModel {
     public:
         std::string driverId;
+        std::string jobId; // Facoltativo: un job ancora in coda viene solo tolto, senza fermare la stampante
 
         PrinterStopRequest() = default;
 
@@ -21,12 +22,16 @@ namespace connector::models::printer_control {
         // BaseModel implementation
         nlohmann::json toJson() const override {
             return nlohmann::json{
-                    {"driverId", driverId}
+                    {"driverId", driverId},
+                    {"jobId", jobId}
             };
         }
 
         void fromJson(const nlohmann::json &json) override {
             driverId = json.at("driverId").get<std::string>();
+            if (json.contains("jobId") && !json["jobId"].is_null()) {
+                jobId = json["jobId"].get<std::string>();
+            }
         }
 
         bool isValid() const override {
@@ -10,7 +10,11 @@
 #include "../../events/printer-check/PrinterCheckSender.hpp"
 #include "core/DriverInterface.hpp"
 #include "core/queue/CommandExecutorQueue.hpp"
+#include "core/printer/state/StateTracker.hpp"
+#include <chrono>
+#include <future>
 #include <memory>
+#include <optional>
 #include <string>
 
 namespace connector::processors::printer_check {
@@ -41,18 +45,37 @@ namespace connector::processors::printer_check {
 
         void sendErrorResponse(const std::string &jobId, const std::string &error);
 
-        void collectPositionDataAsync(models::printer_check::PrinterCheckResponse &response) const;
+        /**
+         * @brief Query al firmware in volo per una richiesta di check (future non valido = non inviata)
+         */
+        struct FirmwareQueries {
+            int autoReportIntervalMs = 0;
+            std::future<std::optional<::position::Position>> position;
+            std::future<core::types::Result> hotendTemp;
+            std::future<core::types::Result> bedTemp;
+            std::future<core::types::Result> endstops;
+        };
 
-        void collectTemperatureDataAsync(models::printer_check::PrinterCheckResponse &response) const;
+        FirmwareQueries submitFirmwareQueries(const core::state::StateSnapshot &state) const;
 
-        static void collectFanDataAsync(models::printer_check::PrinterCheckResponse &response);
+        // I dati in memoria vengono da un unico snapshot dello StateTracker, preso all'inizio della richiesta
+        void collectPositionData(models::printer_check::PrinterCheckResponse &response, FirmwareQueries &queries,
+                                 std::chrono::steady_clock::time_point deadline,
+                                 const core::state::StateSnapshot &state) const;
 
-        static void collectJobStatusDataAsync(models::printer_check::PrinterCheckResponse &response,
-                                              const std::string &jobId);
+        void collectTemperatureData(models::printer_check::PrinterCheckResponse &response, FirmwareQueries &queries,
+                                    std::chrono::steady_clock::time_point deadline,
+                                    const core::state::StateSnapshot &state) const;
 
-        void collectDiagnosticDataAsync(models::printer_check::PrinterCheckResponse &response) const;
+        static void collectFanData(models::printer_check::PrinterCheckResponse &response,
+                                   const core::state::StateSnapshot &state);
 
-        static double parseTemperatureFromResponse(const std::string &response);
+        static void collectJobStatusData(models::printer_check::PrinterCheckResponse &response,
+                                         const std::string &jobId, const core::state::StateSnapshot &state);
+
+        void collectDiagnosticData(models::printer_check::PrinterCheckResponse &response, FirmwareQueries &queries,
+                                   std::chrono::steady_clock::time_point deadline,
+                                   const core::state::StateSnapshot &state) const;
 
         static std::string formatDouble(double value);
 
@@ -60,7 +83,5 @@ namespace connector::processors::printer_check {
         std::string getJobStatusCode(const std::string &jobId) const;
 
         std::string getPrinterStatusCode() const;
-
-        static std::string parseFanFromResponse(const std::string &response);
     };
 } // namespace connector::processors::printer_check
@@ -7,6 +7,8 @@
 #include "core/DriverInterface.hpp"
 #include "core/queue/CommandExecutorQueue.hpp"
 #include "core/printer/job/PrintJobManager.hpp"
+#include "core/printer/job/PrintJobScheduler.hpp"
+#include <chrono>
 #include <memory>
 
 namespace connector::processors::printer_control {
@@ -14,13 +16,35 @@ namespace connector::processors::printer_control {
     public:
         PrinterControlProcessor(std::shared_ptr<core::DriverInterface> driver,
                                 std::shared_ptr<core::CommandExecutorQueue> commandQueue,
-                                std::shared_ptr<core::print::PrintJobManager> jobManager);
+                                std::shared_ptr<core::print::PrintJobManager> jobManager,
+                                std::shared_ptr<core::print::PrintJobScheduler> jobScheduler = nullptr);
 
         void processPrinterStartRequest(const models::printer_control::PrinterStartRequest &request);
 
-        void processPrinterStopRequest(const models::printer_control::PrinterStopRequest &request) const;
+        /**
+         * @brief emergencyStop() seguito da cancelAfterStop()
+         */
+        void processPrinterStopRequest(const models::printer_control::PrinterStopRequest &request,
+                                       std::chrono::steady_clock::time_point receivedAt =
+                                               std::chrono::steady_clock::now()) const;
 
-        void processPrinterPauseRequest(const models::printer_control::PrinterPauseRequest &request) const;
+        /**
+         * @brief Parte urgente dello stop, da eseguire sul thread che riceve il messaggio: ferma la coda dei job
+         * e invia l'e-stop sulla corsia urgente. Un job ancora in coda indicato da request.jobId viene solo tolto.
+         * @param receivedAt Istante di ricezione del messaggio Kafka: la latenza fino ai byte sul link parte da qui
+         * @return true se resta da annullare il job corrente con cancelAfterStop()
+         */
+        bool emergencyStop(const models::printer_control::PrinterStopRequest &request,
+                           std::chrono::steady_clock::time_point receivedAt) const;
+
+        /**
+         * @brief Annulla il job corrente dopo emergencyStop(); può attendere il job manager
+         */
+        void cancelAfterStop(const models::printer_control::PrinterStopRequest &request) const;
+
+        void processPrinterPauseRequest(const models::printer_control::PrinterPauseRequest &request,
+                                        std::chrono::steady_clock::time_point receivedAt =
+                                                std::chrono::steady_clock::now()) const;
 
         std::string getProcessorName() const override {
             return "PrinterControlProcessor";
@@ -34,6 +58,7 @@ namespace connector::processors::printer_control {
         std::shared_ptr<core::DriverInterface> driver_;
         std::shared_ptr<core::CommandExecutorQueue> commandQueue_;
         std::shared_ptr<core::print::PrintJobManager> jobManager_;
+        std::shared_ptr<core::print::PrintJobScheduler> jobScheduler_; // Job da URL in coda con prefetch
 
         void executeGCodeSequence(const std::string &gcode, const std::string &jobId) const;
 
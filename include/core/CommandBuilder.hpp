@@ -4,9 +4,11 @@
 
 #pragma once
 
+#include "core/utils/WireEncoder.hpp"
 #include <string>
 #include <vector>
 #include <cstdint>
+#include <initializer_list>
 
 namespace core {
 
@@ -24,10 +26,17 @@ namespace core {
          * @return Comando formattato con checksum.
          */
         static std::string
-        buildCommand(uint16_t number, char category, int code, const std::vector<std::string> &params);
+        buildCommand(uint32_t number, char category, int code, const std::vector<std::string> &params);
 
-    private:
-        static uint8_t computeChecksum(const std::string &data);
+        /**
+         * @brief Scrive il comando completo nel buffer del chiamante, senza allocazioni.
+         * @param buffer Buffer di destinazione (utils::MAX_WIRE_COMMAND_SIZE è sempre sufficiente).
+         * @param capacity Dimensione del buffer.
+         * @param params Parametri numerici, formattati in virgola fissa.
+         * @return Numero di byte scritti, 0 se il buffer non è sufficiente.
+         */
+        static size_t buildCommand(char *buffer, size_t capacity, uint32_t number, char category, int code,
+                                   std::initializer_list<utils::WireParam> params);
     };
 
 }
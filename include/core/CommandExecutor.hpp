@@ -8,13 +8,26 @@
 #include "CommandContext.hpp"
 #include "types/Result.hpp"
 #include "core/serial/handler/SerialProtocolHandler.hpp"
+#include "core/serial/LinkQualityEstimator.hpp"
 #include <memory>
 #include <string>
 #include <mutex>
 #include <cstdint>
+#include <chrono>
+#include <atomic>
 
 namespace core {
 
+    /**
+     * @brief Latenze della corsia urgente: dalla ricezione della richiesta ai byte scritti sulla porta.
+     */
+    struct UrgentLaneStats {
+        uint64_t sent = 0;
+        uint64_t acknowledged = 0;
+        std::chrono::microseconds lastLatency{0};
+        std::chrono::microseconds maxLatency{0};
+    };
+
 /**
  * @brief Gestisce invio dei comandi, attesa di ACK/ERR, gestione RESEND.
  *
@@ -28,8 +41,10 @@ namespace core {
          * @brief Costruttore.
          * @param serial Porta seriale da usare.
          * @param context Contesto dei comandi (numerazione e storico).
+         * @param stateTracker Stato della stampante collegata, alimentato dalla telemetria.
          */
-        CommandExecutor(std::shared_ptr<SerialPort> serial, std::shared_ptr<CommandContext> context);
+        CommandExecutor(std::shared_ptr<SerialPort> serial, std::shared_ptr<CommandContext> context,
+                        state::StateTracker &stateTracker = state::StateTracker::getInstance());
 
         /**
          * @brief Invia un comando e attende una risposta valida.
@@ -40,25 +55,83 @@ namespace core {
          */
         types::Result sendCommandAndAwaitResponse(const std::string &command, uint32_t commandNumber);
 
+        /**
+         * @brief Corsia urgente: invia un comando non numerato ("!M0") anche mentre un comando normale
+         * attende la risposta, poi attende la conferma "URG" per un solo RTO, senza ritrasmettere.
+         * @param line Linea già formattata con checksum.
+         * @param receivedAt Istante di ricezione della richiesta, per la misura di latenza.
+         * @return Success se confermato, Timeout se la conferma non è arrivata entro l'RTO.
+         */
+        types::Result sendUrgent(const std::string &line, std::chrono::steady_clock::time_point receivedAt);
+
+        UrgentLaneStats urgentStats() const;
+
+        /**
+         * @brief Riconnessioni a caldo effettuate (senza reset del dispositivo).
+         */
+        uint64_t reconnectCount() const { return reconnectCount_; }
+
+        /**
+         * @brief true se il firmware si è resettato durante un comando (numerazione e planner persi).
+         */
+        bool firmwareSyncLost() const { return firmwareSyncLost_; }
+
+        /**
+         * @brief Legge le linee non sollecitate (auto-report, CRT) arrivate mentre nessun comando è in corso.
+         * Non blocca: se un comando sta usando il link ritorna subito.
+         * @return Numero di messaggi consumati.
+         */
+        size_t drainUnsolicited();
+
+        /**
+         * @brief Stima RTT/RTO del link usata per timeout e ritrasmissioni.
+         */
+        std::shared_ptr<const LinkQualityEstimator> linkQuality() const { return linkQuality_; }
+
+        /**
+         * @brief Framing dei comandi in uscita, negoziato con il firmware (default ASCII).
+         */
+        void setFramingMode(FramingMode mode) { protocolHandler_->setFramingMode(mode); }
+
+        FramingMode getFramingMode() const { return protocolHandler_->getFramingMode(); }
+
     private:
         std::shared_ptr<SerialPort> serial_;
         std::shared_ptr<CommandContext> context_;
         std::mutex serialMutex_;
+        std::shared_ptr<LinkQualityEstimator> linkQuality_;
         std::shared_ptr<SerialProtocolHandler> protocolHandler_;
+        int maxRetransmits_;
+        int maxOverflowRetries_;
+        std::chrono::milliseconds reconnectTimeout_;
+        std::atomic<uint64_t> reconnectCount_{0};
+
+        mutable std::mutex urgentMutex_; // Un solo comando urgente alla volta
+        UrgentLaneStats urgentStats_;
 
         std::string lastSentCommand_;
         uint32_t lastSentNumber_ = 0;
-        bool firmwareSyncLost_ = false;
+        std::atomic<bool> firmwareSyncLost_{false};
+
+        /**
+         * @brief Riapre la porta senza reset; il chiamante ritrasmette il comando in sospeso.
+         */
+        bool reconnectLink();
 
         /**
          * @brief Process responses for a specific command number.
          * Handles OK, RESEND, DUPLICATE, ERROR, and BUSY responses.
+         * The wait is bounded by the adaptive RTO of the command: on expiry the command is
+         * retransmitted with exponential backoff, then reported as Timeout.
+         * @param command The command text (retransmitted on RTO expiry).
          * @param expectedNumber The command number we're waiting for.
+         * @param resent True if this number was already transmitted (a DUPLICATE then means executed).
          * @return Result of the command execution.
          */
-        types::Result processResponse(uint32_t expectedNumber);
+        types::Result processResponse(const std::string &command, uint32_t expectedNumber, bool resent);
 
-        types::Result sendCommandAndAwaitResponseLocked(const std::string &command, uint32_t commandNumber);
+        types::Result
+        sendCommandAndAwaitResponseLocked(const std::string &command, uint32_t commandNumber, bool resent = false);
 
     };
 
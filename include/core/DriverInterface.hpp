@@ -13,11 +13,21 @@
 #include "core/command/fan/FanCommands.hpp"
 #include "core/command/system/SystemCommands.hpp"
 #include "core/CommandExecutor.hpp"
+#include "core/utils/WireEncoder.hpp"
 #include "core/command/history/HistoryCommands.hpp"
 #include "core/command/temperature/TemperatureCommands.hpp"
+#include "core/printer/state/StateTracker.hpp"
 #include <memory>
 #include <vector>
 #include <mutex>  // ADDED
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <thread>
+#include <initializer_list>
 
 namespace core {
     /**
@@ -25,7 +35,13 @@ namespace core {
      */
     class DriverInterface {
     public:
-        explicit DriverInterface(std::shared_ptr<Printer> printer, std::shared_ptr<SerialPort> serialPort);
+        /**
+         * @param stateTracker Stato della stampante: ogni stampante del processo ha il proprio
+         */
+        explicit DriverInterface(std::shared_ptr<Printer> printer, std::shared_ptr<SerialPort> serialPort,
+                                 state::StateTracker &stateTracker = state::StateTracker::getInstance());
+
+        ~DriverInterface();
 
         std::shared_ptr<command::motion::MotionCommands> motion() const;
 
@@ -41,6 +57,14 @@ namespace core {
 
         std::shared_ptr<command::temperature::TemperatureCommands> temperature() const;
 
+        state::StateTracker &stateTracker() const;
+
+        /**
+         * @brief Fissa su un core i thread del driver (worker asincrono e telemetria) avviati da qui in poi
+         * @param cpu -1 = nessun vincolo
+         */
+        void setCpuAffinity(int cpu);
+
         PrintState getState() const;
 
         void setState(PrintState newState);
@@ -49,15 +73,124 @@ namespace core {
 
         types::Result sendCommandInternal(char category, int code, const std::vector<std::string> &params) const;
 
+        /**
+         * @brief Variante per parametri numerici: il comando viene codificato senza stringhe intermedie.
+         */
+        types::Result sendCommandInternal(char category, int code, std::initializer_list<utils::WireParam> params) const;
+
+        /**
+         * @brief Accoda il comando e ritorna subito. Un unico worker esegue le richieste in ordine FIFO
+         * sullo stesso percorso di sendCommandInternal: N richieste in volo non occupano N thread chiamanti.
+         */
+        std::future<types::Result> sendCommandAsync(char category, int code, std::vector<std::string> params);
+
+        /**
+         * @brief Variante con callback, invocata sul worker al completamento. La callback non deve
+         * attendere altri comandi asincroni (il worker è unico).
+         */
+        void sendCommandAsync(char category, int code, std::vector<std::string> params,
+                              types::ResultCallback onComplete);
+
+        size_t pendingAsyncCommands() const;
+
+        /**
+         * @brief Negozia il framing binario (CRC16) se il firmware annuncia "BIN1" nelle capability,
+         * altrimenti resta in ASCII.
+         * @return Framing attivo dopo la negoziazione
+         */
+        FramingMode negotiateFraming();
+
+        /**
+         * @brief Verifica una volta, dopo l'handshake, se il firmware annuncia la corsia urgente ("URG1"
+         * nelle capability). Finché non è verificata i comandi urgenti usano il percorso numerato.
+         * @return true se la corsia urgente è disponibile
+         */
+        bool probeUrgentLane();
+
+        /**
+         * @brief Corsia urgente (e-stop, pausa): il comando non attende commandMutex_ e viene scritto
+         * sul link anche mentre un comando normale attende la risposta. Se la conferma non arriva entro
+         * un RTO quel comando ricade sul percorso numerato; la corsia resta attiva per i successivi.
+         * @param receivedAt Istante di ricezione della richiesta (es. messaggio Kafka), per la latenza
+         */
+        types::Result sendUrgentCommand(char category, int code, std::chrono::steady_clock::time_point receivedAt);
+
+        UrgentLaneStats urgentStats() const;
+
+        /**
+         * @brief Attiva l'auto-report del firmware e avvia il thread che legge le linee non sollecitate
+         * quando il link è libero. Temperature, posizione e ventola arrivano nello StateTracker senza query.
+         * @return false se il firmware non supporta S91: lo stato resta alimentato dalle query
+         */
+        bool enableTelemetry(std::chrono::milliseconds interval);
+
+        void disableTelemetry();
+
+        /**
+         * @brief Segnala se il firmware ha completato il boot. Finché il link non è pronto i comandi
+         * normali attendono (fino a serial.boot.timeout.ms) invece di essere scritti su una scheda in avvio;
+         * permette di avviare i consumer Kafka in parallelo all'handshake hardware.
+         */
+        void setLinkReady(bool ready);
+
+        bool isLinkReady() const;
+
+        /**
+         * @brief Esegue l'handshake (negoziazione del framing, probe, telemetria) con il link ancora non pronto:
+         * passano solo i comandi del thread chiamante, gli altri attendono il successivo setLinkReady(true)
+         */
+        void runHandshake(const std::function<void()> &handshake);
+
+        bool waitForLinkReady(std::chrono::milliseconds timeout) const;
+
     private:
         std::shared_ptr<Printer> printer_;
         std::shared_ptr<SerialPort> serialPort_;
+        state::StateTracker &stateTracker_;
         std::shared_ptr<CommandContext> commandContext_;
         std::shared_ptr<CommandExecutor> commandExecutor_;
-        mutable PrintState currentState_;
+        std::atomic<PrintState> currentState_;
+        std::atomic<int> cpuAffinity_{-1};
 
         mutable std::mutex commandMutex_;
 
+        std::atomic<bool> urgentLaneAvailable_{false}; // Impostato da probeUrgentLane()
+
+        std::atomic<bool> linkReady_{true};
+        std::atomic<std::thread::id> handshakeThread_{}; // Thread di runHandshake(), esente dall'attesa del link
+        std::chrono::milliseconds linkReadyTimeout_;
+        mutable std::mutex linkReadyMutex_;
+        mutable std::condition_variable linkReadyCv_;
+
+        std::thread telemetryThread_;
+        std::atomic<bool> telemetryRunning_{false};
+        std::mutex telemetryMutex_;
+        std::condition_variable telemetryCv_;
+
+        void telemetryLoop();
+
+        struct AsyncCommand {
+            char category;
+            int code;
+            std::vector<std::string> params;
+            types::ResultCallback onComplete;
+        };
+
+        std::deque<AsyncCommand> asyncQueue_;
+        mutable std::mutex asyncMutex_;
+        std::condition_variable asyncCv_;
+        std::thread asyncThread_;
+        bool asyncStopping_ = false;
+
+        void asyncLoop();
+
+        void stopAsyncWorker();
+
+        /**
+         * @brief Aggiorna lo stato in base al comando e lo invia tramite l'executor (commandMutex_ già acquisito).
+         */
+        types::Result executeCommand(char category, int code, uint32_t cmdNum, const std::string &command) const;
+
         std::shared_ptr<command::motion::MotionCommands> motion_;
         std::shared_ptr<command::endstop::EndstopCommands> endstop_;
         std::shared_ptr<command::extruder::ExtruderCommands> extruder_;
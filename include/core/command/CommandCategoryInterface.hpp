@@ -5,8 +5,14 @@
 #pragma once
 
 #include "core/types/Result.hpp"
+#include "core/utils/WireEncoder.hpp"
 #include <vector>
 #include <string>
+#include <initializer_list>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
 
 namespace core {
 
@@ -32,6 +38,49 @@ namespace core {
              */
             core::types::Result sendCommand(char category, int code, const std::vector<std::string> &params) const;
 
+            /**
+             * @brief Invia un comando con parametri numerici senza passare da stringhe intermedie.
+             * @param params Parametri del comando (lettera + valore in virgola fissa).
+             */
+            core::types::Result sendCommand(char category, int code,
+                                            std::initializer_list<utils::WireParam> params) const;
+
+            /**
+             * @brief Variante asincrona di sendCommand: il comando viene accodato sul worker del
+             * DriverInterface e il risultato arriva sul future.
+             */
+            std::future<core::types::Result> sendCommandAsync(char category, int code,
+                                                              std::vector<std::string> params = {}) const;
+
+            /**
+             * @brief Variante asincrona con decodifica: decode viene eseguita sul worker al completamento
+             * e il future porta direttamente il valore decodificato (o l'eccezione di decode).
+             */
+            template<typename T>
+            std::future<T> sendCommandAsync(char category, int code, std::vector<std::string> params,
+                                            std::function<T(const core::types::Result &)> decode) const {
+                auto promise = std::make_shared<std::promise<T>>();
+                auto future = promise->get_future();
+                submitAsync(category, code, std::move(params),
+                            [promise, decode = std::move(decode)](const core::types::Result &result) {
+                                try {
+                                    promise->set_value(decode(result));
+                                } catch (...) {
+                                    promise->set_exception(std::current_exception());
+                                }
+                            });
+                return future;
+            }
+
+            void submitAsync(char category, int code, std::vector<std::string> params,
+                             core::types::ResultCallback onComplete) const;
+
+            /**
+             * @brief Invia un comando senza parametri sulla corsia urgente del DriverInterface.
+             */
+            core::types::Result sendUrgent(char category, int code,
+                                           std::chrono::steady_clock::time_point receivedAt) const;
+
             DriverInterface *driver_;
         };
 
@@ -17,6 +17,8 @@ namespace core::command::endstop {
         explicit EndstopCommands(DriverInterface *driver);
 
         types::Result readEndstopStatus();
+
+        std::future<types::Result> readEndstopStatusAsync();
     };
 
 } // namespace core::printer-command::endstop
@@ -17,7 +17,11 @@ namespace core::command::motion {
     public:
         explicit MotionCommands(DriverInterface *driver);
 
-        types::Result emergencyStop();
+        /**
+         * @brief Arresto di emergenza (M0) sulla corsia urgente.
+         * @param receivedAt Istante di ricezione della richiesta, per la misura di latenza
+         */
+        types::Result emergencyStop(std::chrono::steady_clock::time_point receivedAt = std::chrono::steady_clock::now());
 
         types::Result moveTo(float x, float y, float z, float feedrate);
 
@@ -27,6 +31,13 @@ namespace core::command::motion {
 
         std::optional<position::Position> getPosition();
 
+        /**
+         * @brief M114 accodato sul worker asincrono; la posizione viene decodificata al completamento
+         */
+        std::future<std::optional<position::Position>> getPositionAsync();
+
+    private:
+        std::optional<position::Position> decodePosition(const types::Result &result) const;
     };
 
 } // namespace core::printer-command::motion
@@ -20,7 +20,10 @@ namespace core::command::system {
 
         types::Result startPrint();
 
-        types::Result pause();
+        /**
+         * @brief Pausa (S2) sulla corsia urgente: non attende il comando in corso.
+         */
+        types::Result pause(std::chrono::steady_clock::time_point receivedAt = std::chrono::steady_clock::now());
 
         types::Result resume();
 
@@ -29,6 +32,18 @@ namespace core::command::system {
         types::Result brutalReset();
 
         types::Result printStatus();
+
+        /**
+         * @brief Interroga le capability del firmware (S90). Il firmware risponde con una linea
+         * informativa "CAP <token>..." (es. "CAP BIN1"), i firmware legacy con un errore.
+         */
+        types::Result capabilities();
+
+        /**
+         * @brief Attiva il report periodico di stato (S91 I<ms>): il firmware invia linee "STS ..."
+         * con temperature, posizione e ventola. I0 lo disattiva.
+         */
+        types::Result autoReport(int intervalMs);
     };
 
 } // namespace core::printer-command::system
@@ -23,6 +23,20 @@ namespace core::command::temperature {
         types::Result getHotendTemperature();
 
         types::Result getBedTemperature();
+
+        /**
+         * @brief Letture accodate sul worker asincrono, con la stessa decodifica delle varianti sincrone
+         */
+        std::future<types::Result> getHotendTemperatureAsync();
+
+        std::future<types::Result> getBedTemperatureAsync();
+
+    private:
+        types::Result decodeHotendTemperature(const types::Result &result) const;
+
+        types::Result decodeBedTemperature(const types::Result &result) const;
+
+        types::Result decodeTemperature(const types::Result &result, bool hotend) const;
     };
 
 } // namespace core::printer-command::temperature
@@ -8,13 +8,22 @@
 #include "../../serial/SerialPort.hpp"
 #include <memory>
 #include <atomic>
+#include <chrono>
 #include <mutex>
 
 namespace core {
     class RealPrinter : public Printer {
     public:
-        explicit RealPrinter(std::shared_ptr<SerialPort> serial);
-
+        /**
+         * @param readyTimeout Attesa massima del banner "Sistema pronto." dopo il reset
+         */
+        explicit RealPrinter(std::shared_ptr<SerialPort> serial,
+                             std::chrono::milliseconds readyTimeout = std::chrono::seconds(10));
+
+        /**
+         * @brief Attende il banner di fine boot del firmware
+         * @throws std::runtime_error se la porta non è aperta o il banner non arriva entro readyTimeout
+         */
         void initialize() override;
 
         void shutdown() override;
@@ -26,6 +35,7 @@ namespace core {
 
     private:
         std::shared_ptr<SerialPort> serial_;
+        std::chrono::milliseconds readyTimeout_;
         std::atomic<bool> systemReady_{false};
         mutable std::mutex stateMutex_;
 
@@ -8,6 +8,8 @@
 #include <mutex>
 #include <filesystem>
 #include <chrono>
+#include <cstdint>
+#include <vector>
 
 // Forward declare CURL per evitare dipendenza header
 typedef void CURL;
@@ -15,25 +17,48 @@ typedef void CURL;
 namespace core::print {
     struct DownloadProgress {
         std::string url;
-        size_t totalBytes = 0;
-        size_t downloadedBytes = 0;
+        size_t totalBytes = 0;       // 0 = dimensione ancora ignota
+        size_t downloadedBytes = 0;  // Byte nel file, compresi quelli dei tentativi precedenti
         double percentage = 0.0;
+        double bytesPerSecond = 0.0; // Velocità nell'ultimo intervallo di notifica
+        int connections = 1;         // Connessioni in parallelo del tentativo corrente
+        int attempt = 0;
         std::string status = "Initializing...";
     };
 
+    /**
+     * @brief Scarica un G-code in un file temporaneo e ne costruisce l'indice durante il download.
+     *
+     * Dopo un errore il tentativo successivo riprende dall'ultimo byte scritto con una richiesta Range (da capo
+     * se il server la ignora), sugli stessi handle CURL e quindi sulla stessa connessione se ancora aperta;
+     * l'attesa tra i tentativi raddoppia fino a QUEUE_DOWNLOAD_RETRY_MAX_MS e torna al minimo dopo un tentativo
+     * che ha scaricato qualcosa. Non c'è un timeout totale: un tentativo fallisce se resta sotto 1 KB/s per 60 s.
+     * Con QUEUE_DOWNLOAD_CONNECTIONS > 1 i file oltre QUEUE_DOWNLOAD_PARALLEL_MIN_KB, su server che accettano
+     * Range, si scaricano a intervalli su più connessioni; in quel caso l'indice si costruisce rileggendo il file.
+     * Lo streaming delle righe (LinesCallback) richiede l'ordine del file e usa sempre una connessione.
+     */
     class GCodeDownloader {
     public:
         using ProgressCallback = std::function<void(const DownloadProgress &)>;
         using CompletionCallback = std::function<void(bool success, const std::string &filePath,
                                                       const std::string &error)>;
+        /**
+         * @brief Righe eseguibili appena arrivate, in ordine e ciascuna una sola volta anche tra un tentativo e
+         * l'altro; tutte consegnate prima del CompletionCallback. Restituire false interrompe il download.
+         */
+        using LinesCallback = std::function<bool(std::vector<std::string> &&lines)>;
 
         GCodeDownloader();
 
         ~GCodeDownloader();
 
+        /**
+         * @param progressCb Chiamato al più una volta al secondo, dal thread del download
+         */
         void downloadAsync(const std::string &url, const std::string &jobId,
                            ProgressCallback progressCb = nullptr,
-                           CompletionCallback completionCb = nullptr);
+                           CompletionCallback completionCb = nullptr,
+                           LinesCallback linesCb = nullptr);
 
         void cancelDownload();
 
@@ -41,26 +66,83 @@ namespace core::print {
 
         DownloadProgress getCurrentProgress() const;
 
-        void downloadWorkerWithRetry(const std::string &url, const std::string &jobId);
+    private:
+        struct Segment; // Intervallo del file scritto da una connessione (GCodeDownloader.cpp)
 
-        bool performSingleDownload(const std::string &url, const std::string &jobId);
+        // Configurazione (QueueConfig)
+        int maxConnections_ = 1;
+        size_t parallelMinBytes_ = 0;
+        std::chrono::milliseconds retryMaxDelay_{60000};
 
-    private:
         std::atomic<bool> downloading_{false};
         std::atomic<bool> cancelRequested_{false};
         std::thread downloadThread_;
         mutable std::mutex progressMutex_;
         DownloadProgress currentProgress_;
+        std::chrono::steady_clock::time_point rateWindowStart_; // progressMutex_
+        size_t rateWindowBytes_ = 0;
 
         ProgressCallback progressCallback_;
         CompletionCallback completionCallback_;
+        LinesCallback linesCallback_;
 
-        static size_t writeCallback(void *contents, size_t size, size_t nmemb, void *userp);
+        // Download corrente, conservato tra un tentativo e l'altro (solo thread del download)
+        std::string tempFilePath_;
+        std::vector<std::unique_ptr<Segment>> segments_;
+        size_t totalBytes_ = 0;    // 0 = ignota
+        size_t streamedLines_ = 0; // Righe già consegnate a linesCallback_
+        std::chrono::steady_clock::time_point downloadStart_;
+
+        // Handle riusati per tutta la vita del downloader: connessioni e cache DNS restano tra tentativi e download
+        std::vector<CURL *> handles_;
+
+        void downloadWorkerWithRetry(const std::string &url, const std::string &jobId);
+
+        /**
+         * @brief Crea (o ricrea vuoto) il file temporaneo e lo divide in intervalli, uno per connessione
+         * @param allowParallel false dopo un server che ha ignorato il Range di una connessione parallela
+         * @return false se il file non si può creare (segments_ resta vuoto)
+         */
+        bool prepareSegments(const std::string &url, bool allowParallel);
+
+        /**
+         * @brief Dimensione del file e supporto dei Range (richiesta HEAD)
+         */
+        bool probeRanges(const std::string &url, size_t &totalBytes);
 
-        static int progressCallback(void *clientp, long long dltotal, long long dlnow,
-                                    long long ultotal, long long ulnow);
+        /**
+         * @return true se il file è completo e il callback di completamento è stato chiamato
+         */
+        bool performSingleDownload(const std::string &url);
+
+        bool performParallelDownload(const std::string &url);
+
+        /**
+         * @brief Opzioni di un tentativo sull'handle, ripartendo dal prossimo byte dell'intervallo
+         */
+        void configureTransfer(CURL *curl, const std::string &url, Segment &segment);
+
+        /**
+         * @brief Righe finali, indice e callback di completamento
+         */
+        bool finishDownload();
+
+        CURL *handle(size_t index);
+
+        size_t downloadedBytes() const;
+
+        void setStatus(const std::string &status);
+
+        /**
+         * @brief Aggiorna currentProgress_; notifica progressCallback_ e la velocità una volta al secondo
+         */
+        void publishProgress(bool force);
+
+        static size_t writeCallback(void *contents, size_t size, size_t nmemb, void *userp);
 
-        void downloadWorker(const std::string &url, const std::string &jobId);
+        // curl_off_t è un intero con segno a 64 bit
+        static int progressCallback(void *clientp, std::int64_t dltotal, std::int64_t dlnow,
+                                    std::int64_t ultotal, std::int64_t ulnow);
 
         std::string generateTempFilePath(const std::string &jobId) const;
     };
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace core::print {
+    /**
+     * @brief Stato modale del G-code in un punto del file (posizione, E, feedrate, temperature, ventola)
+     */
+    struct GCodeModalState {
+        double x = 0.0;
+        double y = 0.0;
+        double z = 0.0;
+        double e = 0.0;
+        double feedRate = 0.0;   // 0 = mai impostato
+        double hotendTemp = 0.0; // M104/M109
+        double bedTemp = 0.0;    // M140/M190
+        int fanSpeed = 0;        // M106/M107
+        bool absolutePositioning = true; // G90/G91
+        bool absoluteExtrusion = true;   // M82/M83
+
+        /**
+         * @brief Cosa è stato riconosciuto nella riga applicata
+         */
+        struct LineInfo {
+            char letter = 0; // 'G', 'M' o 0 se la riga non è un comando
+            long code = -1;
+            bool hasZ = false;
+            bool hasE = false;
+        };
+
+        /**
+         * @brief Aggiorna lo stato con una riga (i commenti dopo ';' vengono ignorati)
+         */
+        LineInfo apply(const char *line);
+    };
+
+    /**
+     * @brief Inizio di un layer: primo comando con Z oltre il layer precedente (stessa soglia del MotionDispatcher)
+     */
+    struct GCodeLayer {
+        uint64_t commandIndex = 0; // Indice nella tabella dei comandi
+        uint64_t offset = 0;       // Offset in byte della riga nel file
+        double z = 0.0;
+        GCodeModalState state;     // Stato prima del primo comando del layer: ripresa senza rileggere il file
+    };
+
+    /**
+     * @brief Indice di un file G-code: offset di ogni riga eseguibile, layer, hash e statistiche.
+     *
+     * Righe eseguibili = non vuote, non solo spazi, che non iniziano con ';' o '%' (come la coda comandi).
+     * Salvato accanto al file come "<file>.idx"; load() lo scarta se la dimensione del file non coincide.
+     */
+    struct GCodeIndex {
+        uint64_t fileSize = 0;
+        uint64_t totalLines = 0;
+        uint32_t crc32 = 0;
+        std::vector<uint64_t> commandOffsets;
+        std::vector<GCodeLayer> layers;
+
+        // Statistiche
+        uint64_t moveCommands = 0;   // G0/G1/G2/G3
+        uint64_t extrusionMoves = 0; // Movimenti con E
+        uint64_t commentLines = 0;
+        double maxZ = 0.0;
+
+        size_t commandCount() const { return commandOffsets.size(); }
+
+        static std::string pathFor(const std::string &gcodePath) { return gcodePath + ".idx"; }
+
+        bool save(const std::string &path) const;
+
+        static std::optional<GCodeIndex> load(const std::string &gcodePath);
+
+        /**
+         * @brief Indicizza un file già su disco (una lettura); per i download l'indice si costruisce in streaming
+         */
+        static std::optional<GCodeIndex> build(const std::string &gcodePath);
+    };
+
+    /**
+     * @brief Costruisce un GCodeIndex dai byte man mano che arrivano, senza rileggere il file
+     */
+    class GCodeIndexer {
+    public:
+        void feed(const char *data, size_t size);
+
+        /**
+         * @brief Chiude l'eventuale ultima riga senza '\n' e restituisce l'indice
+         */
+        GCodeIndex finish();
+
+    private:
+        static constexpr size_t MAX_PARSED_LINE = 256; // Oltre servono solo per la classificazione
+
+        GCodeIndex index_;
+        GCodeModalState modal_;
+        uint64_t offset_ = 0;
+        uint64_t lineStart_ = 0;
+        std::string line_;
+        bool hasContent_ = false;
+        double lastZ_ = 0.0;
+
+        void appendToLine(const char *data, size_t size);
+
+        void finishLine();
+
+        void parseCommand();
+    };
+} // namespace core::print
@@ -5,25 +5,78 @@
 #include "PrintJobState.hpp"
 #include "PrintJobProgress.hpp"
 #include "GCodeDownloader.hpp"  // Include completo invece di forward declaration
+#include "GCodeIndex.hpp"
+#include "tracking/JobCheckpoint.hpp"
 #include <string>
 #include <chrono>
 #include <atomic>
 #include <mutex>
 #include <memory>
 #include <fstream>
+#include <optional>
+#include <thread>
+#include <vector>
 
 namespace core::print {
     class PrintJobManager {
     public:
+        /**
+         * @param checkpoint Checkpoint dei job di questa stampante (uno per stampante)
+         */
         PrintJobManager(std::shared_ptr<DriverInterface> driver,
-                        std::shared_ptr<core::CommandExecutorQueue> commandQueue);
+                        std::shared_ptr<core::CommandExecutorQueue> commandQueue,
+                        jobs::JobCheckpoint &checkpoint = jobs::JobCheckpoint::getInstance());
 
-        // Job control
-        bool startPrintJob(const std::string &gcodePath, const std::string &jobId);
-
-        bool startPrintJobFromUrl(const std::string &gcodeUrl, const std::string &jobId);
+        ~PrintJobManager();
 
-        bool pauseJob();
+        // Job control
+        /**
+         * @param startCommands,endCommands G-code di inizio e fine accodati prima e dopo il file
+         * (non contano nell'avanzamento del job)
+         */
+        bool startPrintJob(const std::string &gcodePath, const std::string &jobId,
+                           const std::vector<std::string> &startCommands = {},
+                           const std::vector<std::string> &endCommands = {});
+
+        /**
+         * @brief Scarica il G-code e lo stampa. Con QUEUE_STREAM_MARGIN_LINES > 0 la stampa parte dopo quel numero di
+         * righe eseguibili e le successive vengono accodate mentre arrivano; altrimenti parte a download completato.
+         */
+        bool startPrintJobFromUrl(const std::string &gcodeUrl, const std::string &jobId,
+                                  const std::vector<std::string> &startCommands = {},
+                                  const std::vector<std::string> &endCommands = {});
+
+        /**
+         * @brief Righe di margine prima di stampare durante il download (0 = attende il file completo)
+         */
+        size_t streamMargin() const { return streamMargin_; }
+
+        /**
+         * @brief Riprende una stampa interrotta dall'inizio di un layer (1 = primo layer).
+         * Lo stato modale viene dall'indice del file: nessuna rilettura, tempo costante rispetto alla dimensione.
+         * Gli assi devono essere ancora referenziati (nessun G28: l'homing Z urterebbe il pezzo); il file viene
+         * accodato a blocchi dall'offset indicizzato: il primo subito, i successivi da un thread di lettura.
+         */
+        bool resumeFromLayer(const std::string &gcodePath, const std::string &jobId, size_t layer);
+
+        /**
+         * @brief Riprende una stampa interrotta da un comando: indice 0-based delle righe eseguibili, lo stesso
+         * contato dal JobTracker (commandOffset del printer check). Si rilegge al massimo il layer che lo contiene.
+         */
+        bool resumeFromCommand(const std::string &gcodePath, const std::string &jobId, size_t commandIndex);
+
+        /**
+         * @brief Riprende il job interrotto registrato nel checkpoint (JobCheckpoint::recovered) con il suo jobId.
+         * Dopo una perdita di alimentazione il firmware non conosce più la posizione e il driver non può
+         * referenziarla (l'homing Z urterebbe il pezzo): l'operatore porta X/Y in home e imposta Z alla quota
+         * di ripresa, poi lo conferma con axesReferenced. Senza conferma la ripresa viene rifiutata.
+         */
+        bool resumeFromCheckpoint(bool axesReferenced);
+
+        /**
+         * @param receivedAt Istante di ricezione della richiesta: la pausa viaggia sulla corsia urgente
+         */
+        bool pauseJob(std::chrono::steady_clock::time_point receivedAt = std::chrono::steady_clock::now());
 
         bool resumeJob();
 
@@ -32,6 +85,12 @@ namespace core::print {
         // Status
         JobState getCurrentState() const;
 
+        /**
+         * @brief Nessun job in corso. Un job RUNNING con tutti i comandi confermati dal firmware
+         * viene chiuso qui come COMPLETED.
+         */
+        bool isIdle();
+
         PrintJobProgress getProgress() const;
 
         std::string stateToString(JobState state) const;
@@ -39,9 +98,15 @@ namespace core::print {
         // Safety
         bool isReadyToPrint() const;
 
+        /**
+         * @brief Indice salvato accanto al file, o costruito (e salvato) con una lettura se manca
+         */
+        static std::optional<GCodeIndex> loadIndex(const std::string &gcodePath);
+
     private:
         std::shared_ptr<DriverInterface> driver_;
         std::shared_ptr<core::CommandExecutorQueue> commandQueue_;
+        jobs::JobCheckpoint &checkpoint_;
         mutable std::mutex stateMutex_;
         JobState currentState_;
         std::string currentJobId_;
@@ -52,14 +117,66 @@ namespace core::print {
         std::atomic<size_t> executedLines_{0};
         std::chrono::steady_clock::time_point startTime_;
 
+        jobs::JobProgressHandle progress_; // Comandi confermati del job corrente
+
         std::unique_ptr<GCodeDownloader> downloader_;
 
-        bool startPrintJobInternal(const std::string &gcodePath, const std::string &jobId);
+        // Stampa durante il download (stateMutex_)
+        size_t streamMargin_ = 0;
+        bool streaming_ = false;  // Stampa avviata, download ancora in corso
+        bool cancelling_ = false; // cancelJob attende la fine del download: i suoi callback vengono ignorati
+        std::vector<std::string> streamBuffer_; // Righe arrivate prima del margine
+        std::vector<std::string> pendingStartCommands_;
+        std::vector<std::string> pendingEndCommands_;
+
+        // Ripresa: blocchi successivi al primo accodati da un thread di lettura (join senza stateMutex_)
+        std::thread resumeReader_;
+        std::atomic<bool> stopResumeReader_{false};
+
+        bool startPrintJobInternal(const std::string &gcodePath, const std::string &jobId,
+                                   const std::vector<std::string> &startCommands = {},
+                                   const std::vector<std::string> &endCommands = {});
+
+        bool resumeInternal(std::unique_lock<std::mutex> &lock, const std::string &gcodePath,
+                            const std::string &jobId, const GCodeIndex &index, size_t commandIndex,
+                            const GCodeModalState &state);
+
+        /**
+         * @brief Thread di lettura della ripresa: accoda il resto del file finché il job resta attivo
+         */
+        void feedResume(std::ifstream file, std::string jobId);
+
+        /**
+         * @brief Ferma e attende il thread di lettura, rilasciando stateMutex_ durante il join
+         */
+        void stopResumeReader(std::unique_lock<std::mutex> &lock);
+
+        /**
+         * @brief Prima del file: riscaldamento con attesa delle temperature (M190/M109) prima di qualunque
+         * movimento, ventola, poi posizione di ripresa (sollevamento Z, XY, discesa)
+         */
+        static std::vector<std::string> buildRestoreCommands(const GCodeModalState &state);
 
         void onDownloadProgress(const DownloadProgress &progress);
 
         void onDownloadCompleted(bool success, const std::string &filePath, const std::string &error);
 
+        /**
+         * @brief Righe appena scaricate: accumulate fino al margine, poi accodate al job in stampa
+         * @return false per interrompere il download (job fallito o non più attivo)
+         */
+        bool onDownloadLines(std::vector<std::string> &&lines);
+
+        /**
+         * @brief Avvia il job con le righe accumulate fino al margine (stateMutex_ acquisito)
+         */
+        bool beginStreaming();
+
+        /**
+         * @brief Download terminato durante la stampa: totale definitivo, G-code di fine e checkpoint
+         */
+        void finishStreaming(const std::string &filePath);
+
         // Safety checks
         bool checkTemperatures() const;
 
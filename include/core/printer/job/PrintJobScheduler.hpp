@@ -0,0 +1,133 @@
+#pragma once
+
+#include "GCodeDownloader.hpp"
+#include "PrintJobManager.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace core::print {
+    enum class ScheduledJobState {
+        QUEUED,      // In attesa del prefetch
+        PREFETCHING, // Download e indicizzazione in corso
+        READY        // File scaricato, indicizzato e validato: parte appena la stampante è libera
+    };
+
+    struct ScheduledJob {
+        std::string jobId;
+        std::string gcodeUrl;  // Vuoto per un file locale
+        std::string gcodePath; // File locale, o scaricato dal prefetch
+        std::string startGCode;
+        std::string endGCode;
+        int priority = 5;      // Numero più basso = prima (come la coda comandi)
+        uint64_t sequence = 0; // FIFO a parità di priorità
+        ScheduledJobState state = ScheduledJobState::QUEUED;
+        size_t commandCount = 0;
+    };
+
+    /**
+     * @brief Coda dei job di una stampante con priorità e prefetch del prossimo job.
+     *
+     * Durante la stampa corrente il job successivo viene scaricato, indicizzato e validato in background;
+     * quando il PrintJobManager torna libero parte subito, quindi tra due job restano solo i G-code di fine
+     * e di inizio. Se l'ultimo job avviato non si è concluso come COMPLETED (annullato, fallito, o mai registrato
+     * nel JobTracker) la coda resta ferma fino al prossimo submit o a release(); uno stop la ferma con hold()
+     * anche tra due job.
+     * Con la stampa durante il download (PrintJobManager::streamMargin) un job da URL che trova la stampante
+     * libera non viene prefetchato ma avviato subito, e scaricato dal job manager mentre stampa.
+     */
+    class PrintJobScheduler {
+    public:
+        explicit PrintJobScheduler(std::shared_ptr<PrintJobManager> jobManager);
+
+        ~PrintJobScheduler();
+
+        void start();
+
+        void stop();
+
+        /**
+         * @brief Accoda un job (gcodeUrl da scaricare oppure gcodePath locale)
+         * @return false se il jobId è già in coda o mancano sia URL sia file
+         */
+        bool submit(ScheduledJob job);
+
+        /**
+         * @brief Toglie un job non ancora avviato (annulla il suo download se in corso)
+         */
+        bool remove(const std::string &jobId);
+
+        /**
+         * @brief Ferma la coda: nessun job parte fino al prossimo submit o a release()
+         */
+        void hold();
+
+        /**
+         * @brief Riavvia la coda fermata da hold() o dopo un job non completato
+         */
+        void release();
+
+        /**
+         * @return Job in attesa, nell'ordine in cui partiranno
+         */
+        std::vector<ScheduledJob> pendingJobs() const;
+
+    private:
+        static constexpr auto POLL_INTERVAL = std::chrono::milliseconds(100);
+
+        std::shared_ptr<PrintJobManager> jobManager_;
+        std::unique_ptr<GCodeDownloader> downloader_; // Solo per il prefetch: il job manager ha il proprio
+
+        mutable std::mutex mutex_;
+        std::condition_variable wakeCv_;
+        std::thread schedulerThread_;
+        bool running_ = false;
+        bool wake_ = false;
+        bool held_ = false;
+        std::vector<ScheduledJob> jobs_;
+        uint64_t nextSequence_ = 1;
+        std::string prefetchingJobId_;
+        std::string lastStartedJobId_;
+
+        void schedulerLoop();
+
+        /**
+         * @brief Prossimo job da avviare (mutex_ acquisito)
+         */
+        std::vector<ScheduledJob>::iterator nextJob();
+
+        /**
+         * @brief Stampante libera e ultimo job avviato concluso come COMPLETED, altrimenti ferma la coda.
+         * Rilascia mutex_ durante la verifica.
+         */
+        bool printerIdle(std::unique_lock<std::mutex> &lock);
+
+        /**
+         * @brief Avvia il prefetch del primo job in QUEUED, se nessun altro è in corso (mutex_ acquisito)
+         */
+        void startPrefetch(std::unique_lock<std::mutex> &lock);
+
+        /**
+         * @param downloaded File temporaneo del prefetch (da cancellare se il job non parte), non un file locale
+         */
+        void onPrefetchCompleted(const std::string &jobId, bool downloaded, bool success, const std::string &filePath,
+                                 const std::string &error);
+
+        /**
+         * @brief Indice e validazione del file; in caso di errore restituisce 0 e il motivo
+         */
+        static size_t validate(const std::string &gcodePath, std::string &error);
+
+        /**
+         * @brief Avvia un job READY dal file, o un job QUEUED con URL stampandolo durante il download
+         * @return false se il job manager rifiuta l'avvio
+         */
+        bool startJob(const ScheduledJob &job);
+
+        static std::vector<std::string> splitGCode(const std::string &gcode);
+    };
+} // namespace core::print
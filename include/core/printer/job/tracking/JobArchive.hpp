@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "core/printer/job/tracking/JobTracker.hpp"
+
+namespace core::jobs {
+    /**
+     * @brief Archivio append-only dei job conclusi, con indice per jobId.
+     *
+     * <dir>/jobs.archive: un riepilogo per riga, campi separati da tab
+     *   jobId, stato, avvio e fine (ms epoch), comandi totali, eseguiti, ultimo comando, errore
+     * <dir>/jobs.index: voci fisse da 16 byte [hash FNV-1a del jobId][offset della riga]
+     *
+     * All'apertura l'indice viene caricato in una mappa hash -> offset: una ricerca legge al più una riga
+     * dell'archivio e vince il riepilogo più recente dello stesso jobId. In memoria restano 16 byte circa per
+     * job archiviato, non i riepiloghi. I jobId cercati e non trovati restano in una cache limitata.
+     * All'apertura una riga troncata da un crash viene scartata e l'indice completato dalle righe mancanti.
+     */
+    class JobArchive {
+    public:
+        JobArchive() = default;
+
+        ~JobArchive();
+
+        bool open(const std::string &directory);
+
+        bool isOpen() const;
+
+        bool append(const JobInfo &info);
+
+        /**
+         * @brief Ricostruisce un JobInfo dal riepilogo (startTime/lastUpdate riportati sull'orologio monotono)
+         */
+        std::optional<JobInfo> find(const std::string &jobId) const;
+
+        size_t size() const;
+
+    private:
+        struct IndexEntry {
+            uint64_t hash;
+            uint64_t offset;
+        };
+
+        mutable std::mutex mutex_;
+        std::string archivePath_;
+        std::string indexPath_;
+        std::ofstream archive_;
+        std::ofstream index_;
+        mutable std::ifstream reader_; // Lettura dei riepiloghi trovati nell'indice
+        std::unordered_map<uint64_t, std::vector<uint64_t>> offsets_; // Hash del jobId -> offset, in ordine
+        mutable std::unordered_set<std::string> misses_;              // Ricerche senza esito
+        uint64_t archiveSize_ = 0;
+        size_t entries_ = 0;
+
+        static uint64_t hashJobId(const std::string &jobId);
+
+        static std::string formatRecord(const JobInfo &info);
+
+        static std::optional<JobInfo> parseRecord(const std::string &line);
+
+        /**
+         * @brief Scarta l'eventuale riga incompleta, indicizza le righe non ancora presenti nell'indice
+         * e carica l'indice in offsets_
+         */
+        bool recover();
+
+        bool loadIndex();
+
+        std::optional<JobInfo> readRecord(uint64_t offset) const;
+    };
+} // namespace core::jobs
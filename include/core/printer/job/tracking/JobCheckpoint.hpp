@@ -0,0 +1,134 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include "core/printer/job/GCodeIndex.hpp"
+#include "core/printer/job/tracking/JobTracker.hpp"
+
+namespace core::jobs {
+    /**
+     * @brief Punto di ripresa di un job: prossimo comando da eseguire e stato modale prima di esso
+     */
+    struct CheckpointRecord {
+        std::string jobId;
+        std::string gcodePath;
+        uint64_t commandIndex = 0; // Comandi del file già confermati dal firmware (indice 0-based del prossimo)
+        uint64_t totalCommands = 0;
+        core::print::GCodeModalState state;
+        std::chrono::system_clock::time_point updatedAt;
+    };
+
+    /**
+     * @brief Checkpoint del job in stampa per la ripresa dopo un'interruzione di corrente.
+     *
+     * Il file (una pagina, mappata in memoria) contiene due slot scritti alternativamente, ciascuno con
+     * numero di sequenza e CRC32: uno slot troncato da un crash viene scartato e resta valido l'altro.
+     * Sul thread della coda resta solo il contatore lock-free JobProgress::recordAcknowledged: ogni
+     * syncInterval un thread dedicato applica allo stato modale le righe confermate nel frattempo,
+     * rileggendole dal file, scrive lo slot e chiama msync. Avvio e fine del job vengono sincronizzati subito.
+     */
+    class JobCheckpoint {
+    public:
+        /**
+         * @brief Checkpoint della prima stampante; le altre stampanti del processo hanno un'istanza e un file propri
+         */
+        static JobCheckpoint &getInstance();
+
+        JobCheckpoint() = default;
+
+        JobCheckpoint(const JobCheckpoint &) = delete;
+
+        JobCheckpoint &operator=(const JobCheckpoint &) = delete;
+
+        /**
+         * @brief Apre (o crea) il file e legge il job interrotto dall'esecuzione precedente, se presente
+         */
+        bool open(const std::string &path, std::chrono::milliseconds syncInterval);
+
+        /**
+         * @brief Scrive lo stato corrente, sincronizza e chiude il file
+         */
+        void close();
+
+        bool isOpen() const;
+
+        /**
+         * @brief Job ancora attivo nel checkpoint trovato all'apertura
+         */
+        std::optional<CheckpointRecord> recovered() const;
+
+        void discardRecovered();
+
+        /**
+         * @brief Inizia a tracciare un job già registrato nel JobTracker (comandi già in coda).
+         * Per una ripresa commandIndex, fileOffset (offset della riga del comando) e state indicano il punto di partenza.
+         */
+        void begin(const std::string &jobId, const std::string &gcodePath, uint64_t totalCommands,
+                   uint64_t commandIndex = 0, uint64_t fileOffset = 0, const core::print::GCodeModalState &state = {});
+
+        /**
+         * @brief Il job non va più ripreso (completato o annullato)
+         */
+        void finish(const std::string &jobId);
+
+        ~JobCheckpoint();
+
+    private:
+        struct Slot;
+
+        static constexpr size_t FILE_SIZE = 4096;
+
+        mutable std::mutex mutex_;
+        std::condition_variable syncCv_;
+        std::thread syncThread_;
+        bool stopping_ = false;
+        bool syncNow_ = false;
+        std::chrono::milliseconds syncInterval_{1000};
+
+#ifdef _WIN32
+        void *fileHandle_ = nullptr;    // HANDLE del file
+        void *mappingHandle_ = nullptr; // HANDLE di CreateFileMapping
+#else
+        int fd_ = -1;
+#endif
+        char *mapping_ = nullptr;
+        uint64_t sequence_ = 0;
+
+        // Job corrente (mutex_)
+        bool active_ = false;
+        bool dirty_ = false;
+        CheckpointRecord current_;
+        JobProgressHandle progress_;
+        std::ifstream file_; // Posizionato sulla riga del comando current_.commandIndex
+        std::optional<CheckpointRecord> recovered_;
+
+        /**
+         * @brief Porta current_ ai comandi confermati e scrive lo slot successivo (mutex_ acquisito)
+         * @return true se lo slot è cambiato
+         */
+        bool update();
+
+        /**
+         * @brief Applica le righe eseguibili del file fino a raggiungere target comandi
+         */
+        void advanceTo(uint64_t target);
+
+        void writeSlot();
+
+        std::optional<CheckpointRecord> readSlots(bool &active);
+
+        void syncLoop();
+
+        /**
+         * @brief Porta su disco le pagine mappate (msync, su Windows FlushViewOfFile + FlushFileBuffers)
+         */
+        bool syncMapping();
+    };
+} // namespace core::jobs
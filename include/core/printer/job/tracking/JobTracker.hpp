@@ -5,10 +5,16 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <unordered_set>
+#include <deque>
 #include <mutex>
 #include <atomic>
+#include <array>
 #include <chrono>
+#include <cstdint>
+#include <memory>
 #include <optional>
 #include <vector>
 
@@ -36,18 +42,122 @@ namespace core::jobs {
         }
     };
 
+    /**
+     * @brief Avanzamento di un job aggiornato dal thread esecutore senza lock.
+     *
+     * Un solo scrittore (il thread della coda); i lettori non lo bloccano mai. L'ultimo comando
+     * è pubblicato con un seqlock su parole atomiche: chi legge ritenta se la copia si è
+     * sovrapposta a una scrittura. Comandi più lunghi di MAX_COMMAND_LENGTH vengono troncati.
+     */
+    class JobProgress {
+    public:
+        static constexpr size_t MAX_COMMAND_LENGTH = 96;
+
+        /**
+         * @param streaming G-code ancora in download: il totale cresce con addCommands fino a finishStreaming
+         */
+        JobProgress(std::string jobId, size_t totalCommands, size_t executedCommands = 0, bool streaming = false);
+
+        /**
+         * @return Comandi eseguiti dopo questo
+         */
+        size_t recordCommand(std::string_view command);
+
+        const std::string &jobId() const { return jobId_; }
+
+        size_t totalCommands() const { return totalCommands_.load(); }
+
+        /**
+         * @brief Righe arrivate dal download e accodate (solo job in streaming)
+         */
+        void addCommands(size_t count) { totalCommands_.fetch_add(count); }
+
+        /**
+         * @brief Totale non ancora definitivo: nessun completamento automatico
+         */
+        bool isStreaming() const { return streaming_.load(); }
+
+        size_t executedCommands() const { return executed_.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Comando completato dal firmware (executed conta i comandi inviati, questo le risposte)
+         */
+        void recordAcknowledged() { acknowledged_.fetch_add(1, std::memory_order_relaxed); }
+
+        size_t acknowledgedCommands() const { return acknowledged_.load(std::memory_order_relaxed); }
+
+        std::chrono::steady_clock::time_point lastUpdate() const;
+
+        std::string currentCommand() const;
+
+    private:
+        static constexpr size_t WORDS = MAX_COMMAND_LENGTH / sizeof(uint64_t);
+
+        friend class JobTracker;
+
+        const std::string jobId_;
+        std::atomic<size_t> totalCommands_;
+        std::atomic<bool> streaming_;
+        std::atomic<size_t> executed_{0};
+        std::atomic<size_t> acknowledged_{0};
+        std::atomic<std::chrono::steady_clock::rep> lastUpdate_{0};
+
+        std::atomic<uint32_t> sequence_{0}; // Dispari durante la scrittura
+        std::atomic<uint32_t> commandLength_{0};
+        std::array<std::atomic<uint64_t>, WORDS> command_{};
+    };
+
+    using JobProgressHandle = std::shared_ptr<JobProgress>;
+
+    class JobArchive;
+
     class JobTracker {
     public:
         static JobTracker &getInstance();
 
-        JobTracker() = default;
+        JobTracker();
 
-        ~JobTracker() = default;
+        ~JobTracker();
 
-        // Job lifecycle
-        void startJob(const std::string &jobId, size_t totalCommands);
+        /**
+         * @brief Limite dei job conclusi tenuti in memoria; i riepiloghi vanno nell'archivio su disco
+         * @param archiveDirectory Vuota = nessun archivio (i job oltre il limite vengono dimenticati)
+         */
+        void configure(size_t maxFinishedJobs, const std::string &archiveDirectory);
 
-        void updateJobProgress(const std::string &jobId, const std::string &currentCommand);
+        // Job lifecycle
+        /**
+         * @param executedCommands Comandi già eseguiti (ripresa di una stampa interrotta)
+         */
+        void startJob(const std::string &jobId, size_t totalCommands, size_t executedCommands = 0);
+
+        /**
+         * @brief Job che parte mentre il G-code è ancora in download (totale iniziale 0, cresce con
+         * JobProgress::addCommands)
+         */
+        void startStreamingJob(const std::string &jobId);
+
+        /**
+         * @brief Download concluso: il totale diventa definitivo e il job si completa se i comandi
+         * sono già stati tutti eseguiti
+         */
+        void finishStreaming(const JobProgressHandle &progress);
+
+        /**
+         * @brief Risolve una volta il job per gli aggiornamenti di avanzamento
+         * @return nullptr se il job non esiste
+         */
+        JobProgressHandle acquireProgress(const std::string &jobId) const;
+
+        /**
+         * @brief Cambia a ogni startJob: un handle ottenuto prima può riferirsi a un job sostituito
+         */
+        uint64_t generation() const { return generation_.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Conta un comando eseguito; il lock viene preso solo al completamento automatico
+         */
+        void updateJobProgress(const JobProgressHandle &progress, std::string_view currentCommand);
 
         void completeJob(const std::string &jobId);
 
@@ -59,7 +169,7 @@ namespace core::jobs {
 
         void cancelJob(const std::string &jobId);
 
-        // Query methods
+        // Query methods (i job non più in memoria vengono cercati nell'archivio)
         std::optional<JobInfo> getJobInfo(const std::string &jobId) const;
 
         std::string getJobStateCode(const std::string &jobId) const;
@@ -81,11 +191,33 @@ namespace core::jobs {
         Statistics getStatistics() const;
 
     private:
+        struct JobEntry {
+            JobInfo info; // Stato e metadati; i contatori vivono in progress
+            JobProgressHandle progress;
+        };
+
         mutable std::mutex jobsMutex_;
-        std::unordered_map<std::string, JobInfo> jobs_;
+        std::unordered_map<std::string, JobEntry> jobs_; // Attivi + ultimi maxFinishedJobs_ conclusi
+        std::unordered_set<std::string> activeJobIds_;
+        std::deque<std::string> finishedJobIds_;         // In ordine di conclusione
+        size_t maxFinishedJobs_ = 100;
+        std::unique_ptr<JobArchive> archive_;
         std::string currentJobId_;
+        std::atomic<uint64_t> generation_{0};
         mutable Statistics stats_;
 
+        static JobInfo snapshot(const JobEntry &entry);
+
+        void registerJob(const std::string &jobId, size_t totalCommands, size_t executedCommands, bool streaming);
+
+        static bool isActiveState(core::print::JobState state);
+
+        static bool isFinalState(core::print::JobState state);
+
+        /**
+         * @brief Aggiorna lo stato; alla conclusione il job viene compattato, archiviato ed eventualmente
+         * espulso il più vecchio dei conclusi (chiamata con jobsMutex_ acquisito)
+         */
         void updateJobState(const std::string &jobId, core::print::JobState newState);
 
         void cleanupCompletedJobs();
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "application/config/ConfigManager.hpp"
+#include "core/DriverInterface.hpp"
+#include "core/printer/impl/RealPrinter.hpp"
+#include "core/printer/job/PrintJobManager.hpp"
+#include "core/printer/job/PrintJobScheduler.hpp"
+#include "core/printer/job/tracking/JobCheckpoint.hpp"
+#include "core/printer/state/StateTracker.hpp"
+#include "core/queue/CommandExecutorQueue.hpp"
+#include "core/serial/SerialPort.hpp"
+#include "translator/GCodeTranslator.hpp"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace core {
+    /**
+     * @brief Pipeline completa di una stampante: porta, driver, traduttore, coda comandi e gestione dei job.
+     *
+     * La prima stampante registrata usa StateTracker e JobCheckpoint di processo (getInstance), così
+     * l'installazione con una sola stampante resta identica; le altre hanno istanze proprie.
+     */
+    struct PrinterContext {
+        config::PrinterConfig config;
+
+        // Dichiarati per primi: distrutti dopo i componenti che li referenziano
+        std::unique_ptr<state::StateTracker> ownStateTracker;
+        std::unique_ptr<jobs::JobCheckpoint> ownCheckpoint;
+
+        std::shared_ptr<SerialPort> serialPort;
+        std::shared_ptr<RealPrinter> printer;
+        std::shared_ptr<DriverInterface> driver;
+        std::shared_ptr<translator::gcode::GCodeTranslator> translator;
+        std::shared_ptr<CommandExecutorQueue> commandQueue;
+        std::shared_ptr<print::PrintJobManager> jobManager;
+        std::shared_ptr<print::PrintJobScheduler> jobScheduler;
+
+        // false se apertura della porta o handshake sono falliti: esclusa da instradamento e controlli
+        std::atomic<bool> online{true};
+
+        const std::string &driverId() const { return config.driverId; }
+
+        state::StateTracker &stateTracker() const {
+            return ownStateTracker ? *ownStateTracker : state::StateTracker::getInstance();
+        }
+
+        jobs::JobCheckpoint &checkpoint() const {
+            return ownCheckpoint ? *ownCheckpoint : jobs::JobCheckpoint::getInstance();
+        }
+    };
+
+    /**
+     * @brief Stampanti servite dal processo, indicizzate per driverId.
+     *
+     * Popolato durante l'inizializzazione e poi solo letto: i consumer Kafka condivisi instradano ogni
+     * richiesta con find(driverId) senza lock. Una stampante offline resta registrata (PrinterContext::online).
+     */
+    class PrinterRegistry {
+    public:
+        /**
+         * @throws std::invalid_argument se il driverId è vuoto o già registrato
+         */
+        std::shared_ptr<PrinterContext> add(config::PrinterConfig config);
+
+        /**
+         * @return nullptr se nessuna stampante ha quel driverId
+         */
+        std::shared_ptr<PrinterContext> find(const std::string &driverId) const;
+
+        /**
+         * @return Stampanti nell'ordine di registrazione (la prima usa le istanze di processo)
+         */
+        const std::vector<std::shared_ptr<PrinterContext>> &all() const { return printers_; }
+
+        size_t size() const { return printers_.size(); }
+
+        bool empty() const { return printers_.empty(); }
+
+    private:
+        std::vector<std::shared_ptr<PrinterContext>> printers_;
+        std::unordered_map<std::string, std::shared_ptr<PrinterContext>> byDriverId_;
+    };
+} // namespace core
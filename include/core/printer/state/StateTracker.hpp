@@ -3,123 +3,266 @@
 //
 
 #pragma once
+#include "core/types/DecodedResponse.hpp"
+#include <array>
 #include <atomic>
-#include <mutex>
+#include <cstdint>
 #include <chrono>
 #include <string>
+#include <string_view>
+#include <optional>
+#include <thread>
 
 namespace core::state {
+       struct PositionSample {
+              double x = 0.0;
+              double y = 0.0;
+              double z = 0.0;
+       };
+
+       /**
+        * @brief Ultimo comando in forma compatta (nome + parametri numerici), formattato solo in lettura
+        */
+       struct CommandRef {
+              static constexpr size_t MAX_NAME = 7;
+              static constexpr size_t MAX_PARAMS = 6;
+
+              std::array<char, MAX_NAME + 1> name{};
+              uint8_t paramCount = 0;
+              std::array<char, MAX_PARAMS> keys{};
+              std::array<double, MAX_PARAMS> values{};
+
+              static CommandRef of(std::string_view command);
+
+              /**
+               * @brief Aggiunge un parametro; oltre MAX_PARAMS viene ignorato
+               */
+              CommandRef &with(char key, double value);
+
+              bool empty() const { return name[0] == '\0'; }
+
+              /**
+               * @return Es. "G1 E1.2 F1500 X10 Y20"
+               */
+              std::string toString() const;
+       };
+
+       /**
+        * @brief Copia coerente dello stato: tutti i campi appartengono alla stessa versione
+        */
+       struct StateSnapshot {
+              uint64_t version = 0;
+
+              // Position and motion state
+              double ePosition = 0.0;
+              double feedRate = 1000.0;
+              int currentLayer = 0;
+              double layerHeight = 0.2;
+              int fanSpeed = 0;
+              uint64_t commandCount = 0;
+              int autoReportIntervalMs = 0;
+
+              // Target temperatures (from M104/M140)
+              double hotendTargetTemp = 0.0;
+              double bedTargetTemp = 0.0;
+
+              // Actual temperatures/position (from queries or auto-report)
+              double hotendActualTemp = 0.0;
+              double bedActualTemp = 0.0;
+              PositionSample position;
+              types::EndstopStatus endstops;
+              std::chrono::steady_clock::time_point hotendTempTime;
+              std::chrono::steady_clock::time_point bedTempTime;
+              std::chrono::steady_clock::time_point positionTime;
+              std::chrono::steady_clock::time_point fanTime;
+              std::chrono::steady_clock::time_point endstopTime;
+
+              CommandRef lastCommand;
+
+              std::optional<PositionSample> cachedPosition() const {
+                     if (positionTime == std::chrono::steady_clock::time_point{}) return std::nullopt;
+                     return position;
+              }
+
+              // Età dei dati in ms, -1 se mai ricevuti
+              int64_t positionAgeMs() const { return ageMs(positionTime); }
+              int64_t hotendTempAgeMs() const { return ageMs(hotendTempTime); }
+              int64_t bedTempAgeMs() const { return ageMs(bedTempTime); }
+              int64_t fanAgeMs() const { return ageMs(fanTime); }
+              int64_t endstopAgeMs() const { return ageMs(endstopTime); }
+
+              bool isHotendTempFresh(int maxAgeMs = 3000) const { return isFresh(hotendTempTime, maxAgeMs); }
+              bool isBedTempFresh(int maxAgeMs = 3000) const { return isFresh(bedTempTime, maxAgeMs); }
+
+              static int64_t ageMs(std::chrono::steady_clock::time_point time) {
+                     if (time == std::chrono::steady_clock::time_point{}) return -1;
+                     return std::chrono::duration_cast<std::chrono::milliseconds>(
+                                   std::chrono::steady_clock::now() - time).count();
+              }
+
+              static bool isFresh(std::chrono::steady_clock::time_point time, int maxAgeMs) {
+                     return std::chrono::steady_clock::now() - time < std::chrono::milliseconds(maxAgeMs);
+              }
+       };
+
+       /**
+        * @brief Stato della stampante in un unico blocco versionato.
+        *
+        * Gli aggiornamenti modificano una copia privata e la pubblicano con un seqlock su parole atomiche;
+        * snapshot() copia il blocco senza lock e ritenta solo se si sovrappone a una pubblicazione.
+        * Gli scrittori (thread esecutore, auto-report, query) sono serializzati da uno spinlock tenuto
+        * per la sola copia del blocco, mai durante I/O.
+        */
        class StateTracker {
        public:
+              /**
+               * @brief Stato della prima stampante; le altre stampanti del processo hanno un'istanza propria
+               */
               static StateTracker &getInstance();
 
+              StateTracker();
+
+              StateTracker(const StateTracker &) = delete;
+
+              StateTracker &operator=(const StateTracker &) = delete;
+
+              /**
+               * @brief Lettura coerente di tutti i campi, non blocca gli scrittori
+               */
+              StateSnapshot snapshot() const;
+
+              /**
+               * @brief Applica più modifiche in una sola versione
+               */
+              template<typename Apply>
+              void modify(Apply &&apply) {
+                     while (writerLock_.test_and_set(std::memory_order_acquire)) {
+                            std::this_thread::yield();
+                     }
+                     apply(state_);
+                     publish();
+                     writerLock_.clear(std::memory_order_release);
+              }
+
               // Position tracking
-              void updateEPosition(double e) { ePosition_ = e; }
-              double getCurrentEPosition() const { return ePosition_; }
+              void updateEPosition(double e) { modify([e](StateSnapshot &s) { s.ePosition = e; }); }
+              double getCurrentEPosition() const { return snapshot().ePosition; }
               // Feed rate tracking
-              void updateFeedRate(double feed) { feedRate_ = feed; }
-              double getCurrentFeedRate() const { return feedRate_; }
+              void updateFeedRate(double feed) { modify([feed](StateSnapshot &s) { s.feedRate = feed; }); }
+              double getCurrentFeedRate() const { return snapshot().feedRate; }
               // Layer tracking
-              void incrementLayer() { currentLayer_++; }
-              void setCurrentLayer(int layer) { currentLayer_ = layer; }
-              void setLayerHeight(double height) { layerHeight_ = height; }
-              int getCurrentLayer() const { return currentLayer_; }
-              double getCurrentLayerHeight() const { return layerHeight_; }
+              void incrementLayer() { modify([](StateSnapshot &s) { s.currentLayer++; }); }
+              void setCurrentLayer(int layer) { modify([layer](StateSnapshot &s) { s.currentLayer = layer; }); }
+              void setLayerHeight(double height) { modify([height](StateSnapshot &s) { s.layerHeight = height; }); }
+              int getCurrentLayer() const { return snapshot().currentLayer; }
+              double getCurrentLayerHeight() const { return snapshot().layerHeight; }
               // Fan tracking
-              void updateFanSpeed(int speed) { fanSpeed_ = speed; }
-              int getCurrentFanSpeed() const { return fanSpeed_; }
-              // Target temperature tracking
-              void setHotendTargetTemp(double temp) { hotendTargetTemp_ = temp; }
-              void setBedTargetTemp(double temp) { bedTargetTemp_ = temp; }
-              double getHotendTargetTemp() const { return hotendTargetTemp_; }
-              double getBedTargetTemp() const { return bedTargetTemp_; }
-              // Actual temperature caching (hotend)
-              void updateHotendActualTemp(double temp) {
-                     std::lock_guard<std::mutex> lock(tempMutex_);
-                     hotendActualTemp_ = temp;
-                     hotendTempTime_ = std::chrono::steady_clock::now();
+              void updateFanSpeed(int speed) { modify([speed](StateSnapshot &s) { s.fanSpeed = speed; }); }
+              int getCurrentFanSpeed() const { return snapshot().fanSpeed; }
+
+              // Fan speed riportata dal firmware (auto-report), con timestamp
+              void updateReportedFanSpeed(int speed) {
+                     auto now = std::chrono::steady_clock::now();
+                     modify([speed, now](StateSnapshot &s) {
+                            s.fanSpeed = speed;
+                            s.fanTime = now;
+                     });
               }
 
-              bool isHotendTempFresh(int maxAgeMs = 3000) const {
-                     std::lock_guard<std::mutex> lock(tempMutex_);
-                     auto age = std::chrono::steady_clock::now() - hotendTempTime_;
-                     return age < std::chrono::milliseconds(maxAgeMs);
+              // Actual position (M114 o auto-report)
+              void updatePosition(double x, double y, double z) {
+                     auto now = std::chrono::steady_clock::now();
+                     modify([x, y, z, now](StateSnapshot &s) {
+                            s.position = {x, y, z};
+                            s.positionTime = now;
+                     });
               }
 
-              double getCachedHotendTemp() const {
-                     std::lock_guard<std::mutex> lock(tempMutex_);
-                     return hotendActualTemp_;
+              // Endstop riportati dal firmware (auto-report), con timestamp
+              void updateEndstops(const types::EndstopStatus &endstops) {
+                     auto now = std::chrono::steady_clock::now();
+                     modify([endstops, now](StateSnapshot &s) {
+                            s.endstops = endstops;
+                            s.endstopTime = now;
+                     });
               }
 
-              // Actual temperature caching (bed)
-              void updateBedActualTemp(double temp) {
-                     std::lock_guard<std::mutex> lock(tempMutex_);
-                     bedActualTemp_ = temp;
-                     bedTempTime_ = std::chrono::steady_clock::now();
+              std::optional<PositionSample> getCachedPosition() const { return snapshot().cachedPosition(); }
+
+              // Età dei dati in ms, -1 se mai ricevuti
+              int64_t getPositionAgeMs() const { return snapshot().positionAgeMs(); }
+              int64_t getHotendTempAgeMs() const { return snapshot().hotendTempAgeMs(); }
+              int64_t getBedTempAgeMs() const { return snapshot().bedTempAgeMs(); }
+              int64_t getFanAgeMs() const { return snapshot().fanAgeMs(); }
+
+              // Intervallo dell'auto-report firmware (0 = disattivo, i dati arrivano solo da query)
+              void setAutoReportInterval(int intervalMs) {
+                     modify([intervalMs](StateSnapshot &s) { s.autoReportIntervalMs = intervalMs; });
               }
 
-              bool isBedTempFresh(int maxAgeMs = 3000) const {
-                     std::lock_guard<std::mutex> lock(tempMutex_);
-                     auto age = std::chrono::steady_clock::now() - bedTempTime_;
-                     return age < std::chrono::milliseconds(maxAgeMs);
+              int getAutoReportIntervalMs() const { return snapshot().autoReportIntervalMs; }
+              // Target temperature tracking
+              void setHotendTargetTemp(double temp) { modify([temp](StateSnapshot &s) { s.hotendTargetTemp = temp; }); }
+              void setBedTargetTemp(double temp) { modify([temp](StateSnapshot &s) { s.bedTargetTemp = temp; }); }
+              double getHotendTargetTemp() const { return snapshot().hotendTargetTemp; }
+              double getBedTargetTemp() const { return snapshot().bedTargetTemp; }
+              // Actual temperature caching (hotend)
+              void updateHotendActualTemp(double temp) {
+                     auto now = std::chrono::steady_clock::now();
+                     modify([temp, now](StateSnapshot &s) {
+                            s.hotendActualTemp = temp;
+                            s.hotendTempTime = now;
+                     });
               }
 
-              double getCachedBedTemp() const {
-                     std::lock_guard<std::mutex> lock(tempMutex_);
-                     return bedActualTemp_;
+              bool isHotendTempFresh(int maxAgeMs = 3000) const { return snapshot().isHotendTempFresh(maxAgeMs); }
+              double getCachedHotendTemp() const { return snapshot().hotendActualTemp; }
+
+              // Actual temperature caching (bed)
+              void updateBedActualTemp(double temp) {
+                     auto now = std::chrono::steady_clock::now();
+                     modify([temp, now](StateSnapshot &s) {
+                            s.bedActualTemp = temp;
+                            s.bedTempTime = now;
+                     });
               }
 
+              bool isBedTempFresh(int maxAgeMs = 3000) const { return snapshot().isBedTempFresh(maxAgeMs); }
+              double getCachedBedTemp() const { return snapshot().bedActualTemp; }
+
               // Command tracking
-              void updateLastCommand(const std::string &cmd) {
-                     std::lock_guard<std::mutex> lock(cmdMutex_);
-                     lastCommand_ = cmd;
+              void updateLastCommand(const CommandRef &cmd) {
+                     modify([&cmd](StateSnapshot &s) { s.lastCommand = cmd; });
               }
 
-              std::string getLastCommand() const {
-                     std::lock_guard<std::mutex> lock(cmdMutex_);
-                     return lastCommand_;
-              }
+              std::string getLastCommand() const { return snapshot().lastCommand.toString(); }
 
               // Statistics
-              void incrementCommandCount() { commandCount_++; }
-              size_t getCommandCount() const { return commandCount_; }
+              void incrementCommandCount() { modify([](StateSnapshot &s) { s.commandCount++; }); }
+              size_t getCommandCount() const { return snapshot().commandCount; }
               // Reset for new job
               void resetForNewJob() {
-                     ePosition_ = 0.0;
-                     currentLayer_ = 0;
-                     commandCount_ = 0;
-                     layerHeight_ = 0.2; // Default
-                     std::lock_guard<std::mutex> lock(cmdMutex_);
-                     lastCommand_.clear();
+                     modify([](StateSnapshot &s) {
+                            s.ePosition = 0.0;
+                            s.currentLayer = 0;
+                            s.commandCount = 0;
+                            s.layerHeight = 0.2; // Default
+                            s.lastCommand = CommandRef{};
+                     });
               }
 
        private:
-              StateTracker() : ePosition_(0.0), feedRate_(1000.0), currentLayer_(0), layerHeight_(0.2), fanSpeed_(0),
-                               commandCount_(0),
-                               hotendTargetTemp_(0.0), bedTargetTemp_(0.0),
-                               hotendActualTemp_(0.0), bedActualTemp_(0.0) {
-              }
+              static constexpr size_t WORDS = (sizeof(StateSnapshot) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
 
-              // Position and motion state
-              std::atomic<double> ePosition_;
-              std::atomic<double> feedRate_;
-              std::atomic<int> currentLayer_;
-              std::atomic<double> layerHeight_;
-              std::atomic<int> fanSpeed_;
-              std::atomic<size_t> commandCount_;
-              // Target temperatures (from M104/M140)
-              std::atomic<double> hotendTargetTemp_;
-              std::atomic<double> bedTargetTemp_;
+              /**
+               * @brief Copia state_ nelle parole pubblicate (chiamata con writerLock_ acquisito)
+               */
+              void publish();
 
-              // Actual temperatures (from queries) with cache
-              mutable std::mutex tempMutex_;
-              double hotendActualTemp_;
-              double bedActualTemp_;
-              std::chrono::steady_clock::time_point hotendTempTime_;
-              std::chrono::steady_clock::time_point bedTempTime_;
+              std::atomic_flag writerLock_ = ATOMIC_FLAG_INIT;
+              StateSnapshot state_; // Copia di lavoro degli scrittori
 
-              // Command tracking
-              mutable std::mutex cmdMutex_;
-              std::string lastCommand_;
+              std::atomic<uint64_t> sequence_{0}; // Dispari durante la pubblicazione
+              std::array<std::atomic<uint64_t>, WORDS> published_{};
        };
 } // namespace core::state
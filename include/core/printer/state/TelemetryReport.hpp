@@ -0,0 +1,42 @@
+#pragma once
+
+#include "core/types/DecodedResponse.hpp"
+#include <optional>
+#include <string>
+
+namespace core::state {
+    class StateTracker;
+
+    /**
+     * @brief Report periodico di stato inviato dal firmware dopo S91 I<ms>.
+     *
+     * Formato (linea informativa con checksum):
+     *   STS HE=205.1/210 BED=60.2/60 X=10.5 Y=20 Z=0.2 FAN=255 ES=010 *cs
+     * ES: endstop X, Y, Z (1 = premuto). Ogni campo è opzionale: vengono aggiornati solo quelli presenti.
+     */
+    struct TelemetryReport {
+        static constexpr const char *PREFIX = "STS";
+
+        std::optional<double> hotendTemp;
+        std::optional<double> hotendTarget;
+        std::optional<double> bedTemp;
+        std::optional<double> bedTarget;
+        std::optional<double> x;
+        std::optional<double> y;
+        std::optional<double> z;
+        std::optional<int> fanSpeed;
+        std::optional<types::EndstopStatus> endstops;
+
+        /**
+         * @brief true se il payload è un report di stato ("STS ...")
+         */
+        static bool matches(const std::string &payload);
+
+        /**
+         * @return Report parsato, std::nullopt se il payload non è un report valido
+         */
+        static std::optional<TelemetryReport> parse(const std::string &payload);
+
+        void applyTo(StateTracker &stateTracker) const;
+    };
+} // namespace core::state
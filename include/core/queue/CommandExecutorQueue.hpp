@@ -5,6 +5,7 @@
 #pragma once
 
 #include "translator/GCodeTranslator.hpp"
+#include "core/printer/job/tracking/JobTracker.hpp"
 #include <queue>
 #include <thread>
 #include <mutex>
@@ -33,7 +34,11 @@ namespace core {
 
     class CommandExecutorQueue {
     public:
-        explicit CommandExecutorQueue(std::shared_ptr<translator::gcode::GCodeTranslator> translator);
+        /**
+         * @param diskPath File di paging: con più stampanti nello stesso processo ognuna ha il proprio
+         */
+        explicit CommandExecutorQueue(std::shared_ptr<translator::gcode::GCodeTranslator> translator,
+                                      std::string diskPath = "temp/command_queue.dat");
 
         ~CommandExecutorQueue();
 
@@ -45,12 +50,25 @@ namespace core {
 
         void stop();
 
+        /**
+         * @brief Fissa il thread di esecuzione (e quindi l'I/O seriale dei comandi) su un core.
+         * Vale dal prossimo avvio o riavvio del thread; -1 = nessun vincolo
+         */
+        void setCpuAffinity(int cpu) { cpuAffinity_ = cpu; }
+
         void enqueue(const std::string &command, int priority = 5, const std::string &jobId = "");
 
         void enqueueFile(const std::string &filePath, int priority = 5, const std::string &jobId = "");
 
         void enqueueCommands(const std::vector<std::string> &commands, int priority = 5, const std::string &jobId = "");
 
+        /**
+         * @brief Accoda in coda a quanto già presente, con una sola notifica e senza le attese di enqueueCommands:
+         * per le righe di un G-code che arrivano durante il download. Se il thread di esecuzione raggiunge
+         * l'ultima riga arrivata attende la successiva.
+         */
+        void appendCommands(const std::vector<std::string> &commands, int priority, const std::string &jobId);
+
         size_t getQueueSize() const;
 
         void clearQueue();
@@ -85,6 +103,7 @@ namespace core {
         std::priority_queue<PriorityCommand> commandQueue_;      // 10k commands in RAM
         std::priority_queue<PriorityCommand> pagingBuffer_;      // 5k intermediate buffer
         std::deque<PriorityCommand> diskQueue_;                  // On-disk storage
+        std::string diskPath_;
         std::fstream diskFile_;
         mutable std::mutex queueMutex_;
         mutable std::mutex diskMutex_;
@@ -94,6 +113,7 @@ namespace core {
         std::atomic<bool> running_{false};
         std::atomic<bool> stopping_{false};
         std::atomic<uint64_t> nextSequenceId_{1};
+        std::atomic<int> cpuAffinity_{-1};
 
         // Health monitoring
         std::atomic<std::chrono::steady_clock::time_point> lastExecutionTime_;
@@ -105,6 +125,11 @@ namespace core {
         mutable Statistics stats_;
         mutable std::mutex statsMutex_;
 
+        // Avanzamento del job corrente, usato solo dal thread di esecuzione
+        std::string progressJobId_;
+        uint64_t progressGeneration_ = 0;
+        jobs::JobProgressHandle progress_;
+
         void processingLoop();
 
         void healthMonitorLoop();                                // Health check loop
@@ -126,6 +151,12 @@ namespace core {
 
         void pageCommandsToDisk();
 
+        /**
+         * @brief Inserisce i comandi non vuoti in RAM, buffer di paging o disco (queueMutex_ acquisito)
+         * @return Comandi inseriti
+         */
+        size_t pushCommands(const std::vector<std::string> &commands, int priority, const std::string &jobId);
+
         void executeCommand(const PriorityCommand &cmd);
 
         void restartProcessingThread();
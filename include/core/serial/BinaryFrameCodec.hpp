@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace core {
+
+    /**
+     * @brief Modalità di framing dei comandi host -> firmware
+     */
+    enum class FramingMode {
+        ASCII,  // N123 M10 X10.5 Y20 Z0.3 F1500 *87\n
+        BINARY  // Frame compatto con CRC16, vedi BinaryFrameCodec
+    };
+
+    /**
+     * @brief Codifica/decodifica dei comandi nel formato binario compatto.
+     *
+     * Layout del frame:
+     *   [0xA5] [LEN] [N varint] [categoria] [codice varint] [parametri...] [CRC16 hi] [CRC16 lo]
+     *
+     * - LEN è la lunghezza del corpo (da N all'ultimo parametro), massimo 255 byte.
+     * - Ogni parametro è un byte lettera (es. 'X') seguito da un varint in virgola fissa
+     *   decimale: (zigzag(mantissa) << 2) | decimali, con al più 3 decimali ("10.5" -> 105, 1).
+     *   Una lettera con bit 7 alto è un flag senza valore (es. asse di M99).
+     * - Il CRC16 (CCITT-FALSE, poly 0x1021, init 0xFFFF) copre LEN e corpo.
+     *
+     * La conversione è lossless rispetto al testo ASCII: il firmware ricostruisce esattamente
+     * gli stessi parametri. I comandi non rappresentabili restano in ASCII.
+     */
+    class BinaryFrameCodec {
+    public:
+        static constexpr uint8_t SYNC_BYTE = 0xA5;
+        static constexpr uint8_t FLAG_PARAM = 0x80;
+        static constexpr size_t HEADER_SIZE = 2;
+        static constexpr size_t CRC_SIZE = 2;
+        static constexpr size_t MAX_BODY_SIZE = 255;
+        static constexpr int MAX_DECIMALS = 3;
+
+        /**
+         * @brief Converte un comando ASCII formattato (con o senza " *checksum") in frame binario.
+         * @return Frame codificato, std::nullopt se il comando non è rappresentabile
+         */
+        static std::optional<std::string> encode(const std::string &command);
+
+        /**
+         * @brief Decodifica un frame binario completo nel comando ASCII equivalente, senza checksum.
+         * @return Comando "N123 M10 X10.5 ...", std::nullopt se frame troncato o CRC errato
+         */
+        static std::optional<std::string> decode(const std::string &frame);
+
+        /**
+         * @brief Dimensione totale del frame che inizia in data, se l'header è disponibile.
+         */
+        static std::optional<size_t> frameSize(const std::string &data);
+
+        static uint16_t crc16(const uint8_t *data, size_t size);
+    };
+
+} // namespace core
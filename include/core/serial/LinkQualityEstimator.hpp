@@ -0,0 +1,106 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace core {
+
+    /**
+     * @brief Stima della qualità del link seriale (RTT smussato e varianza, stile TCP / RFC 6298).
+     *
+     * Mantiene una stima per chiave comando (categoria + codice, es. "M10", "S0") e una
+     * aggregata per l'intero link. Le stime guidano i timeout di attesa ACK, i ritardi
+     * prima dei resend e il backoff sul buffer overflow (E02) del firmware.
+     */
+    class LinkQualityEstimator {
+    public:
+        struct Config {
+            std::chrono::milliseconds initialRto{3000};   // RTO prima del primo campione
+            std::chrono::milliseconds minRto{50};
+            std::chrono::milliseconds maxRto{300000};
+            std::chrono::milliseconds maxRetryDelay{100}; // Ritardo massimo prima di un resend
+            std::chrono::milliseconds maxOverflowBackoff{2000};
+        };
+
+        struct Snapshot {
+            std::chrono::microseconds srtt{0};
+            std::chrono::microseconds rttvar{0};
+            std::chrono::milliseconds rto{0};
+            uint64_t samples = 0;
+        };
+
+        LinkQualityEstimator();
+
+        explicit LinkQualityEstimator(Config config);
+
+        /**
+         * @brief Registra un campione RTT (invio comando -> risposta STANDARD).
+         * I comandi ritrasmessi non devono essere campionati (algoritmo di Karn).
+         */
+        void addSample(const std::string &key, std::chrono::microseconds rtt);
+
+        /**
+         * @brief Timeout di ritrasmissione per la chiave, ricade sulla stima del link se non ci sono campioni.
+         */
+        std::chrono::milliseconds retransmissionTimeout(const std::string &key) const;
+
+        /**
+         * @brief Timeout di ritrasmissione aggregato del link.
+         */
+        std::chrono::milliseconds retransmissionTimeout() const;
+
+        /**
+         * @brief Raddoppia un RTO dopo una ritrasmissione scaduta (backoff esponenziale, limitato a maxRto).
+         */
+        std::chrono::milliseconds backoff(std::chrono::milliseconds rto) const;
+
+        /**
+         * @brief Pausa prima di un resend/retry checksum: un RTT di link, limitato a maxRetryDelay.
+         */
+        std::chrono::milliseconds retryDelay() const;
+
+        /**
+         * @brief Registra un E02 e restituisce il backoff da applicare (esponenziale, limitato).
+         */
+        std::chrono::milliseconds onBufferOverflow();
+
+        /**
+         * @brief Un ACK valido azzera la serie di overflow consecutivi.
+         */
+        void onAcknowledged();
+
+        uint32_t consecutiveOverflows() const;
+
+        Snapshot snapshot(const std::string &key) const;
+
+        Snapshot linkSnapshot() const;
+
+        /**
+         * @brief Estrae la chiave (categoria + codice) da un comando formattato "N123 M10 X1 *87".
+         */
+        static std::string commandKey(const std::string &command);
+
+    private:
+        struct Estimate {
+            double srttUs = 0.0;
+            double rttvarUs = 0.0;
+            uint64_t samples = 0;
+        };
+
+        Config config_;
+        mutable std::mutex mutex_;
+        std::unordered_map<std::string, Estimate> estimates_;
+        Estimate link_;
+        uint32_t consecutiveOverflows_ = 0;
+
+        static void update(Estimate &estimate, double rttUs);
+
+        std::chrono::milliseconds computeRto(const Estimate &estimate) const;
+
+        Snapshot toSnapshot(const Estimate &estimate) const;
+    };
+
+} // namespace core
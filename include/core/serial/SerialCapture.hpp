@@ -0,0 +1,84 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace core {
+
+    /**
+     * @brief Direzione di un record di cattura
+     */
+    enum class CaptureDirection : uint8_t {
+        TX = 0,       // Linea inviata dall'host (senza '\n')
+        RX = 1,       // Linea ricevuta dal firmware (senza '\n')
+        TX_FRAME = 2  // Frame binario inviato dall'host
+    };
+
+    struct CaptureRecord {
+        CaptureDirection direction;
+        std::chrono::nanoseconds timestamp; // Monotono, relativo all'apertura della cattura
+        std::string data;
+    };
+
+    /**
+     * @brief Registra il traffico seriale su file binario compatto.
+     *
+     * Formato: header "3DPCAP" + versione (1 byte), poi per ogni record
+     *   [direzione u8] [delta ns dal record precedente, varint] [lunghezza varint] [byte]
+     * Il timestamp è steady_clock, quindi non risente di aggiustamenti dell'orologio di sistema.
+     * I record restano in un buffer di FLUSH_BYTES e vanno su disco al riempimento, al primo record dopo
+     * FLUSH_INTERVAL e alla chiusura: se il processo termina senza distruttori si perde al più quella coda.
+     */
+    class SerialCaptureWriter {
+    public:
+        explicit SerialCaptureWriter(const std::string &path);
+
+        ~SerialCaptureWriter();
+
+        bool isOpen() const;
+
+        void record(CaptureDirection direction, const std::string &data);
+
+        void flush();
+
+        uint64_t recordCount() const;
+
+    private:
+        static constexpr size_t FLUSH_BYTES = 64 * 1024;
+        static constexpr std::chrono::seconds FLUSH_INTERVAL{1};
+
+        mutable std::mutex mutex_;
+        std::vector<char> buffer_; // Buffer dello stream, dichiarato prima di file_ che lo usa
+        std::ofstream file_;
+        std::chrono::steady_clock::time_point start_;
+        std::chrono::steady_clock::time_point lastFlush_;
+        std::chrono::nanoseconds lastTimestamp_{0};
+        uint64_t records_ = 0;
+    };
+
+    /**
+     * @brief Legge sequenzialmente un file prodotto da SerialCaptureWriter
+     */
+    class SerialCaptureReader {
+    public:
+        explicit SerialCaptureReader(const std::string &path);
+
+        bool isOpen() const;
+
+        /**
+         * @return Prossimo record, std::nullopt a fine file o su record troncato
+         */
+        std::optional<CaptureRecord> next();
+
+    private:
+        std::ifstream file_;
+        std::chrono::nanoseconds timestamp_{0};
+        bool valid_ = false;
+    };
+
+} // namespace core
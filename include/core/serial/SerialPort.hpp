@@ -5,6 +5,7 @@
 #pragma once
 
 #include <string>
+#include <chrono>
 
 namespace core {
 
@@ -21,13 +22,37 @@ namespace core {
          */
         virtual void send(const std::string &data) = 0;
 
+        /**
+         * @brief Invia byte grezzi senza terminatore di linea (frame binari).
+         * @param bytes Frame già codificato.
+         */
+        virtual void sendBytes(const std::string &bytes) = 0;
+
+        static constexpr std::chrono::milliseconds DEFAULT_RECEIVE_TIMEOUT{500};
+
         /**
          * @brief Riceve una linea dalla porta seriale.
-         * @return Stringa ricevuta.
+         * @param timeout Attesa massima di una linea completa; i byte parziali restano per la lettura successiva.
+         * @return Stringa ricevuta, vuota se il timeout scade.
          */
-        virtual std::string receiveLine() = 0;
+        virtual std::string receiveLine(std::chrono::milliseconds timeout) = 0;
+
+        std::string receiveLine() { return receiveLine(DEFAULT_RECEIVE_TIMEOUT); }
+
+        /**
+         * @brief Indica se ci sono dati già ricevuti, senza bloccare.
+         * @return true se receiveLine() ha dati da restituire.
+         */
+        virtual bool hasPendingInput() = 0;
 
         virtual bool isOpen() const = 0;
+
+        /**
+         * @brief Riapre il collegamento dopo una perdita (CONN_LOST) senza resettare il dispositivo.
+         * @param timeout Tempo massimo per ritrovare il dispositivo (es. ri-enumerazione USB).
+         * @return true se la porta è di nuovo aperta.
+         */
+        virtual bool reconnect(std::chrono::milliseconds timeout) = 0;
     };
 
 } // namespace core
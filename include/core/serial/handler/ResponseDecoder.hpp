@@ -0,0 +1,35 @@
+#pragma once
+
+#include "core/types/DecodedResponse.hpp"
+#include <string>
+
+namespace core {
+
+    /**
+     * @brief Decodifica le linee informative note del firmware nei campi di types::DecodedResponse.
+     *
+     * Formati riconosciuti (payload senza checksum):
+     *   POS X=10.5 Y=20 Z=0.2
+     *   TEMP=205.1 | TEMP=205.1/210
+     *   ENDSTOP X=0 Y=1 Z=0
+     *   FAN=255 | FAN S=255
+     * Scansione a mano senza regex né allocazioni: viene eseguita per ogni linea ricevuta.
+     */
+    class ResponseDecoder {
+    public:
+        /**
+         * @return true se la linea è stata riconosciuta e decodificata
+         */
+        static bool decode(const std::string &payload, types::DecodedResponse &decoded);
+
+    private:
+        static bool decodePosition(const char *cursor, const char *end, types::DecodedResponse &decoded);
+
+        static bool decodeTemperature(const char *cursor, const char *end, types::DecodedResponse &decoded);
+
+        static bool decodeEndstops(const char *cursor, const char *end, types::DecodedResponse &decoded);
+
+        static bool decodeFan(const char *cursor, const char *end, types::DecodedResponse &decoded);
+    };
+
+} // namespace core
@@ -5,11 +5,15 @@
 #pragma once
 
 #include "core/serial/SerialPort.hpp"
+#include "core/serial/LinkQualityEstimator.hpp"
+#include "core/serial/BinaryFrameCodec.hpp"
+#include "core/printer/state/StateTracker.hpp"
 #include "core/types/Result.hpp"
 #include "logger/Logger.hpp"
 #include <memory>
 #include <string>
 #include <mutex>
+#include <atomic>
 #include <condition_variable>
 #include <chrono>
 #include <sstream>
@@ -19,7 +23,9 @@ namespace core {
     enum class MessageType {
         STANDARD,      // OK0 N123 *67
         INFORMATIONAL, // POS 10.5 20.0 5.2 *156
-        CRITICAL       // CRT TMP 205.4 200.0 *89
+        CRITICAL,      // CRT TMP 205.4 200.0 *89
+        TELEMETRY,     // STS HE=205.1/210 BED=60/60 X=10 Y=20 Z=0.2 FAN=255 *42 (auto-report, non legato a comandi)
+        URGENT         // URG M0 *23 (conferma di un comando della corsia urgente)
     };
 
     enum class MessageCodeType {
@@ -38,6 +44,7 @@ namespace core {
         UNAVAIABLE_SERIAL_PORT,
         EMPTY_MESSAGE,
         CRITICAL_MESSAGE_PROCESSING_ERROR,
+        CONNECTION_LOST,
     };
 
     struct SerialMessage {
@@ -54,15 +61,23 @@ namespace core {
      */
     class SerialProtocolHandler {
     public:
-        explicit SerialProtocolHandler(std::shared_ptr<SerialPort> serialPort);
+        /**
+         * @param linkQuality Stima RTT del link, usata per il timeout di attesa dei CRT ritrasmessi (opzionale)
+         * @param stateTracker Stato della stampante su questo link, aggiornato dai report TELEMETRY
+         */
+        explicit SerialProtocolHandler(std::shared_ptr<SerialPort> serialPort,
+                                       std::shared_ptr<LinkQualityEstimator> linkQuality = nullptr,
+                                       state::StateTracker &stateTracker = state::StateTracker::getInstance());
 
         ~SerialProtocolHandler() = default;
 
         /**
-         * @brief Riceve un messaggio dal firmware con gestione checksum e ACK
+         * @brief Riceve un messaggio dal firmware con gestione checksum e ACK.
+         * I report TELEMETRY validi vengono applicati allo StateTracker prima di essere restituiti.
+         * @param timeout Attesa massima di una linea: scaduta restituisce EMPTY_MESSAGE
          * @return SerialMessage parsed, con validazione checksum
          */
-        SerialMessage receiveMessage();
+        SerialMessage receiveMessage(std::chrono::milliseconds timeout = SerialPort::DEFAULT_RECEIVE_TIMEOUT);
 
         /**
          * @brief Invia un comando al firmware (wrapper per compatibilità)
@@ -70,6 +85,37 @@ namespace core {
          */
         void sendCommand(const std::string &command);
 
+        /**
+         * @brief Invia un comando urgente non numerato ("!M0 *cs") senza attendere il comando in corso.
+         * La scrittura è serializzata con quelle normali, la lettura no: il frame può interporsi
+         * mentre un altro thread attende la risposta di un comando normale.
+         */
+        void sendUrgent(const std::string &line);
+
+        /**
+         * @brief Numero di conferme URG ricevute (da qualunque thread stia leggendo il link)
+         */
+        uint64_t urgentAckCount() const;
+
+        /**
+         * @brief Attende che urgentAckCount() superi @p seen
+         * @return true se è arrivata una nuova conferma entro il timeout
+         */
+        bool waitForUrgentAck(uint64_t seen, std::chrono::milliseconds timeout);
+
+        /**
+         * @brief Imposta il framing dei comandi in uscita (le risposte restano linee ASCII)
+         */
+        void setFramingMode(FramingMode mode);
+
+        FramingMode getFramingMode() const;
+
+        /**
+         * @brief Riapre la porta dopo CONNECTION_LOST senza reset del dispositivo.
+         * Le scritture (anche urgenti) restano bloccate fino alla fine del tentativo.
+         */
+        bool reconnect(std::chrono::milliseconds timeout);
+
         /**
          * @brief Controlla se la porta seriale è aperta
          */
@@ -166,7 +212,14 @@ namespace core {
 
     private:
         std::shared_ptr<SerialPort> serialPort_;
+        std::shared_ptr<LinkQualityEstimator> linkQuality_;
+        state::StateTracker &stateTracker_;
+        std::atomic<FramingMode> framingMode_{FramingMode::ASCII};
         mutable std::mutex protocolMutex_;
+        std::mutex writeMutex_; // Una sola scrittura alla volta: i frame urgenti non si mescolano ai normali
+        mutable std::mutex urgentMutex_;
+        std::condition_variable urgentCondition_;
+        uint64_t urgentAcks_ = 0;
         std::condition_variable criticalMessageCondition_;
         bool waitingForCriticalMessage_;
 
@@ -220,9 +273,10 @@ namespace core {
 
         /**
          * @brief Attende un nuovo messaggio dal firmware (per messaggi CRT con errore)
+         * @param timeout Tempo massimo di attesa, derivato dall'RTO del link
          * @return Nuovo messaggio ricevuto
          */
-        SerialMessage waitForRetryMessage(long timeoutMs = 300000);
+        SerialMessage waitForRetryMessage(std::chrono::milliseconds timeout);
     };
 
 } // namespace core
\ No newline at end of file
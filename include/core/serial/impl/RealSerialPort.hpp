@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../SerialPort.hpp"
+#include "../SerialCapture.hpp"
 #include <boost/asio.hpp>
 #include <string>
 #include <memory>
@@ -27,17 +28,43 @@ namespace core {
 
         void send(const std::string &data) override;
 
-        std::string receiveLine() override;
+        void sendBytes(const std::string &bytes) override;
+
+        using SerialPort::receiveLine;
+
+        std::string receiveLine(std::chrono::milliseconds timeout) override;
+
+        bool hasPendingInput() override;
 
         bool isOpen() const override;
 
+        /**
+         * @brief Riapre il tty senza toggle del DTR né attesa del bootloader: il firmware continua
+         * a girare e la sessione riprende dal comando in sospeso.
+         */
+        bool reconnect(std::chrono::milliseconds timeout) override;
+
+        /**
+         * @brief Registra tutto il traffico (TX/RX) su file, riproducibile con ReplaySerialPort.
+         * Da chiamare prima di avviare i thread che usano la porta.
+         */
+        bool startCapture(const std::string &path);
+
     private:
+        std::string portName_;
+        uint32_t baudrate_;
         boost::asio::io_context io_context_;
         std::unique_ptr<boost::asio::serial_port> serial_port_;
         std::string buffer_;
+        std::unique_ptr<SerialCaptureWriter> capture_;
 
         void configurePort(uint32_t baudrate);
 
+        /**
+         * @brief Disattiva HUPCL: alla chiusura (o perdita) del tty il DTR resta alto e la scheda non si resetta
+         */
+        void keepDtrOnClose();
+
         /**
          * @brief Triggers device reset via DTR signal manipulation (generic serial device)
          */
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "../SerialPort.hpp"
+#include "../SerialCapture.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace core {
+
+/**
+ * @brief SerialPort che riproduce il lato firmware di una cattura di SerialCaptureWriter.
+ *
+ * Le linee RX vengono rilasciate rispettando i tempi registrati, relativi all'ultimo
+ * comando TX corrispondente inviato dall'host: così la temporizzazione resta coerente
+ * anche se il driver è più lento o più veloce della sessione originale.
+ * speed = 1.0 tempi originali, 10.0 dieci volte più veloce, 0 senza attese.
+ */
+    class ReplaySerialPort : public SerialPort {
+    public:
+        explicit ReplaySerialPort(const std::string &capturePath, double speed = 1.0);
+
+        ~ReplaySerialPort() override;
+
+        void send(const std::string &data) override;
+
+        void sendBytes(const std::string &bytes) override;
+
+        using SerialPort::receiveLine;
+
+        std::string receiveLine(std::chrono::milliseconds timeout) override;
+
+        bool hasPendingInput() override;
+
+        bool isOpen() const override;
+
+        bool reconnect(std::chrono::milliseconds timeout) override;
+
+        /**
+         * @return true quando tutti i record della cattura sono stati consumati
+         */
+        bool finished() const;
+
+        uint64_t mismatchCount() const;
+
+    private:
+        std::vector<CaptureRecord> records_;
+        double speed_;
+        bool loaded_ = false;
+
+        mutable std::mutex mutex_;
+        std::condition_variable cv_;
+        size_t cursor_ = 0;
+        std::deque<std::string> ready_;
+
+        // Ancoraggio temporale: istante reale e registrato dell'ultimo TX
+        std::chrono::steady_clock::time_point anchorWall_;
+        std::chrono::nanoseconds anchorRecorded_{0};
+
+        uint64_t mismatches_ = 0;
+        uint64_t unexpectedSends_ = 0;
+
+        void handleSend(CaptureDirection direction, const std::string &data);
+
+        std::chrono::steady_clock::time_point dueTime(const CaptureRecord &record) const;
+    };
+
+} // namespace core
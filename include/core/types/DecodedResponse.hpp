@@ -0,0 +1,42 @@
+#pragma once
+
+#include "core/types/Position.hpp"
+#include <optional>
+
+namespace core::types {
+
+    /**
+     * @brief Temperatura letta dal firmware ("TEMP=205.1" oppure "TEMP=205.1/210")
+     */
+    struct TemperatureReading {
+        double actual = 0.0;
+        std::optional<double> target;
+    };
+
+    /**
+     * @brief Stato degli endstop ("ENDSTOP X=0 Y=1 Z=0", 1 o TRIGGERED = premuto)
+     */
+    struct EndstopStatus {
+        bool x = false;
+        bool y = false;
+        bool z = false;
+
+        bool anyTriggered() const {
+            return x || y || z;
+        }
+    };
+
+    /**
+     * @brief Dati tipizzati estratti dalle linee informative di una risposta.
+     *
+     * Popolati una sola volta dal CommandExecutor mentre le linee arrivano: i chiamanti leggono i campi
+     * invece di ri-parsare Result::body. Un campo vuoto indica che la risposta non conteneva quel dato.
+     */
+    struct DecodedResponse {
+        std::optional<::position::Position> position;
+        std::optional<TemperatureReading> temperature;
+        std::optional<EndstopStatus> endstops;
+        std::optional<int> fanSpeed;
+    };
+
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "core/types/DecodedResponse.hpp"
+#include <functional>
 #include <string>
 #include <optional>
 #include <vector>
@@ -25,6 +27,7 @@ namespace core::types {
         std::string message;
         std::optional<uint32_t> commandNumber;
         std::vector<std::string> body;
+        DecodedResponse decoded; // Linee del body già decodificate (POS, TEMP, ENDSTOP, FAN)
 
         inline bool isSuccess() const {
             return code == ResultCode::Success;
@@ -63,20 +66,29 @@ namespace core::types {
         }
 
         static inline Result success(const std::string &msg = "Success") {
-            return {ResultCode::Success, msg, std::nullopt, {}};
+            return {ResultCode::Success, msg, std::nullopt, {}, {}};
         }
 
         static inline Result error(const std::string &msg = "Error") {
-            return {ResultCode::Error, msg, std::nullopt, {}};
+            return {ResultCode::Error, msg, std::nullopt, {}, {}};
+        }
+
+        static inline Result timeout(const std::string &msg = "Timeout") {
+            return {ResultCode::Timeout, msg, std::nullopt, {}, {}};
         }
 
         static inline Result duplicate(const uint32_t cmdNum) {
-            return {ResultCode::Duplicate, "DUPLICATE ERROR", cmdNum, {}};
+            return {ResultCode::Duplicate, "DUPLICATE ERROR", cmdNum, {}, {}};
         }
 
         static inline Result resendError(const uint32_t cmdNum) {
-            return {ResultCode::ResendError, "RESEND ERROR - command not in history", cmdNum, {}};
+            return {ResultCode::ResendError, "RESEND ERROR - command not in history", cmdNum, {}, {}};
         }
     };
 
+    /**
+     * @brief Callback di completamento dei comandi asincroni
+     */
+    using ResultCallback = std::function<void(const Result &)>;
+
 }
\ No newline at end of file
@@ -4,32 +4,80 @@
 
 #pragma once
 
-#include <string>
-#include <sstream>
-#include <iomanip>
+#include <array>
+#include <charconv>
 #include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
 
 namespace core::utils {
     constexpr int DEFAULT_PRECISION = 2;
 
+    namespace detail {
+        constexpr std::array<float, 7> POW10 = {1.0f, 10.0f, 100.0f, 1000.0f, 10000.0f, 100000.0f, 1000000.0f};
+
+        // Oltre questa soglia la mantissa non entra in un int64
+        constexpr float MAX_FIXED_MANTISSA = 9.0e18f;
+    }
+
     /**
-        * @brief Formatta un float rimuovendo zeri finali inutili, max default 2 decimali
-        */
-    inline std::string formatFloat(float value, int precision = DEFAULT_PRECISION) {
-        float factor = std::pow(10.0f, precision);
-        float rounded = std::round(value * factor) / factor;
-        if (rounded == std::floor(rounded)) {
-            return std::to_string(static_cast<int>(rounded));
+     * @brief Scrive value in virgola fissa senza zeri finali nel buffer [first, last), senza allocazioni.
+     * @return Puntatore al carattere successivo all'ultimo scritto, nullptr se il buffer non basta
+     */
+    inline char *formatFixed(char *first, char *last, float value, int precision) {
+        if (precision < 0) precision = 0;
+        if (precision >= static_cast<int>(detail::POW10.size())) precision = static_cast<int>(detail::POW10.size()) - 1;
+
+        float scaled = std::round(value * detail::POW10[precision]);
+        if (!std::isfinite(scaled) || std::fabs(scaled) >= detail::MAX_FIXED_MANTISSA) {
+            // Valori fuori scala: percorso lento ma corretto
+            int written = std::snprintf(first, static_cast<size_t>(last - first), "%.*f", precision, value);
+            return (written < 0 || written >= last - first) ? nullptr : first + written;
         }
 
-        std::ostringstream oss;
-        oss << std::fixed << std::setprecision(precision) << rounded;
-        std::string result = oss.str();
+        auto mantissa = static_cast<int64_t>(scaled);
+        auto factor = static_cast<int64_t>(detail::POW10[precision]);
+        int64_t integral = mantissa / factor;
+        int64_t fraction = mantissa % factor;
+
+        char *out = first;
+        if (mantissa < 0) {
+            if (out == last) return nullptr;
+            *out++ = '-';
+            integral = -integral;
+            fraction = -fraction;
+        }
 
-        // Rimuovi zeri finali
-        size_t end = result.find_last_not_of('0');
-        if (end != std::string::npos && result[end] == '.') end--;
-        return result.substr(0, end + 1);
+        auto res = std::to_chars(out, last, integral);
+        if (res.ec != std::errc()) return nullptr;
+        out = res.ptr;
+
+        if (fraction == 0) return out;
+
+        // Rimuove gli zeri finali della parte frazionaria
+        int digits = precision;
+        while (fraction % 10 == 0) {
+            fraction /= 10;
+            digits--;
+        }
+
+        if (last - out < digits + 1) return nullptr;
+        *out++ = '.';
+        for (int i = digits - 1; i >= 0; --i) {
+            out[i] = static_cast<char>('0' + fraction % 10);
+            fraction /= 10;
+        }
+        return out + digits;
+    }
+
+    /**
+        * @brief Formatta un float rimuovendo zeri finali inutili, max default 2 decimali
+        */
+    inline std::string formatFloat(float value, int precision = DEFAULT_PRECISION) {
+        char buffer[64];
+        char *end = formatFixed(buffer, buffer + sizeof(buffer), value, precision);
+        return end ? std::string(buffer, end) : std::string();
     }
 
     /**
@@ -0,0 +1,26 @@
+#pragma once
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace core::utils {
+    /**
+     * @brief Fissa il thread chiamante su un core (Linux). Con più stampanti nello stesso processo ogni
+     * pipeline seriale/esecutore resta sul proprio core e non si contende cache e scheduler con le altre.
+     * @return false se cpu < 0, se il core non esiste o su piattaforme senza supporto
+     */
+    inline bool pinCurrentThread(int cpu) {
+#ifdef __linux__
+        if (cpu < 0 || cpu >= CPU_SETSIZE) return false;
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+        (void) cpu;
+        return false;
+#endif
+    }
+} // namespace core::utils
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "core/utils/FloatFormatter.hpp"
+#include <charconv>
+#include <cstdint>
+#include <string_view>
+
+namespace core::utils {
+
+    /**
+     * @brief Parametro numerico di un comando (es. {'X', 10.5f} -> "X10.5")
+     */
+    struct WireParam {
+        char letter;
+        float value;
+        int precision = DEFAULT_PRECISION;
+    };
+
+    /**
+     * @brief Dimensione del buffer sufficiente per qualunque comando con parametri numerici
+     */
+    constexpr size_t MAX_WIRE_COMMAND_SIZE = 256;
+
+    /**
+     * @brief Scrive un comando "N<num> <cat><code> params *cs" in un buffer fornito dal chiamante.
+     *
+     * Il checksum XOR viene aggiornato mentre si scrive, quindi il frame è pronto in un solo passaggio
+     * senza stringhe intermedie. Se il buffer non basta, overflowed() diventa true e finish() restituisce
+     * una view vuota.
+     */
+    class WireEncoder {
+    public:
+        WireEncoder(char *buffer, size_t capacity) : buffer_(buffer), capacity_(capacity) {}
+
+        WireEncoder &begin(uint32_t number, char category, int code) {
+            size_ = 0;
+            checksum_ = 0;
+            overflow_ = false;
+            put('N');
+            putInteger(number);
+            put(' ');
+            put(category);
+            putInteger(code);
+            return *this;
+        }
+
+        WireEncoder &param(const WireParam &param) {
+            put(' ');
+            put(param.letter);
+            if (overflow_) return *this;
+
+            char *end = formatFixed(buffer_ + size_, buffer_ + capacity_, param.value, param.precision);
+            commit(end);
+            return *this;
+        }
+
+        /**
+         * @brief Parametro già formattato (es. "X" per un asse o "S200")
+         */
+        WireEncoder &param(std::string_view token) {
+            put(' ');
+            for (char c: token) put(c);
+            return *this;
+        }
+
+        /**
+         * @brief Chiude il comando aggiungendo " *<checksum>".
+         * @return View sul buffer con il comando completo, vuota in caso di overflow
+         */
+        std::string_view finish() {
+            uint8_t checksum = checksum_;
+            putTrailer(' ');
+            putTrailer('*');
+            if (!overflow_) {
+                auto res = std::to_chars(buffer_ + size_, buffer_ + capacity_, static_cast<int>(checksum));
+                if (res.ec != std::errc()) {
+                    overflow_ = true;
+                } else {
+                    size_ = static_cast<size_t>(res.ptr - buffer_);
+                }
+            }
+            return overflow_ ? std::string_view() : std::string_view(buffer_, size_);
+        }
+
+        uint8_t checksum() const { return checksum_; }
+
+        size_t size() const { return size_; }
+
+        bool overflowed() const { return overflow_; }
+
+    private:
+        char *buffer_;
+        size_t capacity_;
+        size_t size_ = 0;
+        uint8_t checksum_ = 0;
+        bool overflow_ = false;
+
+        void put(char c) {
+            if (size_ >= capacity_) {
+                overflow_ = true;
+                return;
+            }
+            buffer_[size_++] = c;
+            checksum_ ^= static_cast<uint8_t>(c);
+        }
+
+        /**
+         * @brief Scrive un carattere escluso dal checksum (" *<cs>")
+         */
+        void putTrailer(char c) {
+            if (size_ >= capacity_) {
+                overflow_ = true;
+                return;
+            }
+            buffer_[size_++] = c;
+        }
+
+        template<typename T>
+        void putInteger(T value) {
+            if (overflow_) return;
+            auto res = std::to_chars(buffer_ + size_, buffer_ + capacity_, value);
+            commit(res.ec == std::errc() ? res.ptr : nullptr);
+        }
+
+        /**
+         * @brief Aggiorna dimensione e checksum dopo una scrittura diretta nel buffer
+         */
+        void commit(char *end) {
+            if (!end) {
+                overflow_ = true;
+                return;
+            }
+            for (char *p = buffer_ + size_; p < end; ++p) {
+                checksum_ ^= static_cast<uint8_t>(*p);
+            }
+            size_ = static_cast<size_t>(end - buffer_);
+        }
+    };
+
+} // namespace core::utils
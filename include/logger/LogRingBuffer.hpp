@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+enum class LogLevel : uint8_t {
+    Debug,
+    Info,
+    Warning,
+    Error
+};
+
+struct LogRecord {
+    LogLevel level = LogLevel::Info;
+    std::chrono::system_clock::time_point time;
+    std::string message;
+};
+
+/**
+ * @brief Coda circolare limitata multi-produttore / singolo consumatore, senza lock.
+ *
+ * Ogni slot ha un numero di sequenza (schema di Vyukov): i produttori si contendono solo l'indice di
+ * scrittura con una CAS, il consumatore (thread writer del Logger) non usa operazioni atomiche RMW.
+ * A coda piena tryPush fallisce subito: il chiamante conta lo scarto invece di bloccarsi.
+ */
+class LogRingBuffer {
+public:
+    /**
+     * @param capacity Numero di record, arrotondato alla potenza di due successiva
+     */
+    explicit LogRingBuffer(size_t capacity);
+
+    LogRingBuffer(const LogRingBuffer &) = delete;
+
+    LogRingBuffer &operator=(const LogRingBuffer &) = delete;
+
+    bool tryPush(LogRecord &&record);
+
+    /**
+     * @brief Solo dal thread consumatore
+     */
+    bool tryPop(LogRecord &record);
+
+    /**
+     * @brief Solo dal thread consumatore
+     */
+    bool empty() const;
+
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence{0};
+        LogRecord record;
+    };
+
+    std::unique_ptr<Slot[]> slots_;
+    size_t mask_;
+
+    alignas(64) std::atomic<size_t> enqueuePos_{0};
+    alignas(64) size_t dequeuePos_ = 0;
+};
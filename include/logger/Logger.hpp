@@ -4,23 +4,118 @@
 
 #pragma once
 
+#include "logger/LogRingBuffer.hpp"
 #include <string>
 #include <fstream>
 #include <mutex>
 #include <thread>
 #include <atomic>
+#include <charconv>
+#include <condition_variable>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include <type_traits>
 
+/**
+ * Livello minimo compilato (0=DEBUG, 1=INFO, 2=WARNING, 3=ERROR): le chiamate DRIVER_LOG_* sotto
+ * questa soglia non generano codice. Impostato da CMake (1 nelle build Release).
+ */
+#ifndef DRIVER_LOG_MIN_LEVEL
+#define DRIVER_LOG_MIN_LEVEL 0
+#endif
+
+/**
+ * @brief Moduli con livello di log indipendente, modificabile a runtime
+ */
+enum class LogModule : uint8_t {
+    General,
+    Translator,
+    Serial,
+    Queue,
+    Kafka,
+    Count
+};
+
+/**
+ * @brief Logger asincrono.
+ *
+ * Dopo init() i chiamanti inseriscono il record in una coda lock-free limitata e ritornano subito;
+ * un unico thread writer formatta i record a blocchi e scrive console e file con una write per blocco.
+ * A coda piena il record viene scartato e contato (mai bloccare il percorso di stampa).
+ * Prima di init() e dopo shutdown() la scrittura è sincrona.
+ */
 class Logger {
 public:
+    struct Stats {
+        uint64_t enqueued = 0; // Record accodati al writer
+        uint64_t dropped = 0;  // Scartati a coda piena
+        uint64_t written = 0;  // Scritti dal writer
+        uint64_t batches = 0;  // Blocchi di scrittura
+    };
+
     static void init();
 
+    /**
+     * @brief Svuota la coda, ferma il writer e chiude il file
+     */
     static void shutdown();
 
-    static void logInfo(const std::string &message);
+    static void logInfo(std::string message);
+
+    static void logWarning(std::string message);
+
+    static void logError(std::string message);
+
+    static constexpr bool isCompiledIn(LogLevel level) {
+        return level >= static_cast<LogLevel>(DRIVER_LOG_MIN_LEVEL);
+    }
+
+    static bool isEnabled(LogModule module, LogLevel level) {
+        return isCompiledIn(level) &&
+               level >= moduleLevels_[static_cast<size_t>(module)].load(std::memory_order_relaxed);
+    }
 
-    static void logWarning(const std::string &message);
+    static void setLevel(LogModule module, LogLevel level);
 
-    static void logError(const std::string &message);
+    /**
+     * @brief Imposta lo stesso livello per tutti i moduli
+     */
+    static void setLevel(LogLevel level);
+
+    static LogLevel level(LogModule module);
+
+    /**
+     * @brief "debug" | "info" | "warning" | "error" (case insensitive)
+     */
+    static bool parseLevel(const std::string &name, LogLevel &level);
+
+    /**
+     * @brief Concatena gli argomenti in un unico messaggio; usare tramite DRIVER_LOG_*,
+     * che verificano il livello prima di valutarli
+     */
+    template<typename... Args>
+    static void write(LogLevel level, Args &&... args) {
+        std::string message;
+        (appendArg(message, std::forward<Args>(args)), ...);
+        log(level, std::move(message));
+    }
+
+    static void write(LogLevel level, std::string message) {
+        log(level, std::move(message));
+    }
+
+    /**
+     * @brief Attende che i record accodati prima della chiamata siano stati scritti
+     */
+    static void flush();
+
+    static Stats stats();
+
+    /**
+     * @brief Abilita o disabilita la copia su stdout/stderr (il file resta attivo)
+     */
+    static void setConsoleEnabled(bool enabled);
 
 private:
     static std::ofstream logFile_;
@@ -30,16 +125,94 @@ private:
     static std::atomic<bool> rotationEnabled_;
     static std::thread cleanupThread_;
     static std::atomic<bool> shutdownRequested_;
+    static std::mutex cleanupMutex_;
+    static std::condition_variable cleanupCv_;
+    static std::vector<std::string> pendingCompression_; // Log ruotati da comprimere (cleanupMutex_)
+
+    // Writer asincrono
+    static std::thread writerThread_;
+    static std::atomic<bool> writerRunning_;
+    static std::atomic<bool> writerIdle_;
+    static std::mutex writerMutex_;
+    static std::condition_variable writerCv_;
+    static std::atomic<bool> consoleEnabled_;
+    static std::atomic<uint64_t> enqueued_;
+    static std::atomic<uint64_t> dropped_;
+    static std::atomic<uint64_t> written_;
+    static std::atomic<uint64_t> batches_;
+    static std::atomic<LogLevel> moduleLevels_[static_cast<size_t>(LogModule::Count)];
 
-    static void log(const std::string &level, const std::string &message);
+    static LogRingBuffer &ring();
+
+    static void log(LogLevel level, std::string &&message);
+
+    static void appendArg(std::string &out, const std::string &value) { out += value; }
+
+    static void appendArg(std::string &out, std::string_view value) { out += value; }
+
+    static void appendArg(std::string &out, const char *value) { out += value; }
+
+    static void appendArg(std::string &out, char value) { out += value; }
+
+    static void appendArg(std::string &out, bool value) { out += value ? "true" : "false"; }
+
+    template<typename T>
+    static std::enable_if_t<std::is_arithmetic_v<T>> appendArg(std::string &out, T value) {
+        if constexpr (std::is_integral_v<T>) {
+            char buffer[24];
+            auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+            out.append(buffer, result.ptr);
+        } else {
+            out += std::to_string(value);
+        }
+    }
+
+    static void writerLoop();
+
+    /**
+     * @brief Percorso sincrono (writer non attivo)
+     */
+    static void writeSynchronously(const LogRecord &record);
+
+    static void appendFormatted(const LogRecord &record, std::string &out);
+
+    /**
+     * @brief Scrive un blocco già formattato su file (con rotazione) — logMutex_ acquisito dal chiamante
+     */
+    static void writeToFile(const std::string &data);
 
     static void rotateLogFile();
 
     static void startCleanupThread();
 
-    static void cleanupOldLogs();
+    /**
+     * @brief Comprime un log ruotato in <path>.gz e rimuove l'originale (thread di pulizia)
+     */
+    static bool compressLogFile(const std::string &path);
 
-    static std::string currentTimestamp();
+    /**
+     * @brief Retention per età e per dimensione compressa sugli archivi 3dp_driver_*.log.gz
+     */
+    static void cleanupOldLogs();
 
     static std::string generateLogFilename();
 };
+
+/**
+ * Log per modulo con valutazione pigra: gli argomenti vengono formattati solo se il livello è attivo,
+ * e sotto DRIVER_LOG_MIN_LEVEL la chiamata viene eliminata in compilazione.
+ *   DRIVER_LOG_DEBUG(LogModule::Serial, "[CommandExecutor] Sent N", number, ": ", command);
+ */
+#define DRIVER_LOG(module, level, ...)                         \
+    do {                                                       \
+        if constexpr (Logger::isCompiledIn(level)) {           \
+            if (Logger::isEnabled(module, level)) {            \
+                Logger::write(level, __VA_ARGS__);             \
+            }                                                  \
+        }                                                      \
+    } while (0)
+
+#define DRIVER_LOG_DEBUG(module, ...) DRIVER_LOG(module, LogLevel::Debug, __VA_ARGS__)
+#define DRIVER_LOG_INFO(module, ...) DRIVER_LOG(module, LogLevel::Info, __VA_ARGS__)
+#define DRIVER_LOG_WARNING(module, ...) DRIVER_LOG(module, LogLevel::Warning, __VA_ARGS__)
+#define DRIVER_LOG_ERROR(module, ...) DRIVER_LOG(module, LogLevel::Error, __VA_ARGS__)
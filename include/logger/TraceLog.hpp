@@ -0,0 +1,215 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Eventi ad alta frequenza registrati nel trace binario (id stabili, non riordinare)
+ */
+enum class TraceEvent : uint8_t {
+    SerialTx = 1,
+    SerialTxFrame = 2,
+    SerialRx = 3,
+    AckSent = 4,
+    CommandSent = 5,
+    CommandCompleted = 6,
+    CommandStored = 7,
+    CommandRemoved = 8,
+    CommandRetrieved = 9,
+    QueueExecute = 10,
+    TranslatorDispatch = 11,
+    KafkaReceived = 12,
+    KafkaSent = 13
+};
+
+/**
+ * @brief Schema di un evento: nome e argomenti "nome:tipo" separati da spazio.
+ * Tipi: u = intero senza segno (varint), s = intero con segno (zigzag varint),
+ *       b = byte inline (lunghezza + dati), i = stringa internata (id della tabella)
+ */
+struct TraceEventInfo {
+    TraceEvent event;
+    const char *name;
+    const char *args;
+};
+
+/**
+ * @brief Stringa da internare: scritta una sola volta nel file, poi referenziata per id
+ */
+struct TraceInterned {
+    std::string_view value;
+};
+
+/**
+ * @brief Trace binario per gli eventi seriali, di coda e Kafka a frequenza di comando.
+ *
+ * Formato: header "3DPTRC" + versione, tabella degli schemi, poi record
+ *   [evento u8] [delta ns dal record precedente, varint] [argomenti secondo lo schema]
+ * Le definizioni di stringhe internate sono record con evento 0xFF: [id varint] [lunghezza varint] [byte].
+ * I produttori accodano in un buffer in memoria; un thread dedicato lo scrive su file a blocchi.
+ * Se il disco non tiene il passo gli eventi oltre il limite del buffer vengono scartati e contati.
+ * Il file si legge con TraceReader o con lo strumento trace_decoder.
+ */
+class TraceLog {
+public:
+    static TraceLog &getInstance();
+
+    static const std::vector<TraceEventInfo> &schema();
+
+    static bool isEnabled() { return enabled_.load(std::memory_order_relaxed); }
+
+    bool open(const std::string &path);
+
+    /**
+     * @brief Scrive gli eventi in sospeso e chiude il file
+     */
+    void close();
+
+    template<typename... Args>
+    void record(TraceEvent event, const Args &... args) {
+        auto now = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!enabled_) return;
+        if (active_.size() > MAX_PENDING_BYTES) {
+            dropped_++;
+            return;
+        }
+
+        size_t start = active_.size();
+        recordStart_ = start;
+        active_.push_back(static_cast<char>(event));
+        appendTimestamp(now);
+        (appendArg(args), ...);
+        events_++;
+
+        if (active_.size() >= FLUSH_THRESHOLD && start < FLUSH_THRESHOLD) {
+            flushCv_.notify_one();
+        }
+    }
+
+    uint64_t eventCount() const;
+
+    uint64_t droppedCount() const;
+
+    ~TraceLog();
+
+private:
+    static constexpr size_t FLUSH_THRESHOLD = 64 * 1024;
+    static constexpr size_t MAX_PENDING_BYTES = 16 * 1024 * 1024;
+
+    static std::atomic<bool> enabled_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable flushCv_;
+    std::string active_;
+    std::string spare_;
+    std::unordered_map<std::string, uint32_t> interned_;
+    size_t recordStart_ = 0; // Le nuove stringhe internate vengono definite prima del record corrente
+    std::chrono::steady_clock::time_point start_;
+    std::chrono::nanoseconds lastTimestamp_{0};
+    uint64_t events_ = 0;
+    uint64_t dropped_ = 0;
+
+    std::ofstream file_;
+    std::mutex fileMutex_;
+    std::thread flushThread_;
+    bool stopping_ = false;
+
+    TraceLog() = default;
+
+    /**
+     * @return true se il file era aperto
+     */
+    bool stop();
+
+    void flushLoop();
+
+    void writePending();
+
+    void appendVarint(uint64_t value);
+
+    void appendTimestamp(std::chrono::steady_clock::time_point now);
+
+    void appendBytes(std::string_view value);
+
+    void appendArg(std::string_view value) { appendBytes(value); }
+
+    void appendArg(const std::string &value) { appendBytes(value); }
+
+    void appendArg(const char *value) { appendBytes(value); }
+
+    void appendArg(const TraceInterned &value);
+
+    template<typename T>
+    std::enable_if_t<std::is_integral_v<T>> appendArg(T value) {
+        if constexpr (std::is_signed_v<T>) {
+            auto wide = static_cast<int64_t>(value);
+            appendVarint((static_cast<uint64_t>(wide) << 1) ^ static_cast<uint64_t>(wide >> 63));
+        } else {
+            appendVarint(static_cast<uint64_t>(value));
+        }
+    }
+};
+
+/**
+ * @brief Registra un evento solo se il trace è aperto (nessuna valutazione degli argomenti altrimenti)
+ */
+#define DRIVER_TRACE(event, ...)                                           \
+    do {                                                                   \
+        if (TraceLog::isEnabled()) {                                       \
+            TraceLog::getInstance().record(event, __VA_ARGS__);            \
+        }                                                                  \
+    } while (0)
+
+struct TraceArgument {
+    std::string name;
+    char type;
+    uint64_t number = 0;      // u, i (id)
+    int64_t signedNumber = 0; // s
+    std::string text;         // b, i (testo risolto)
+};
+
+struct TraceRecord {
+    uint8_t event;
+    std::string name;
+    std::chrono::nanoseconds timestamp; // Monotono, relativo all'apertura del trace
+    std::vector<TraceArgument> args;
+};
+
+/**
+ * @brief Legge sequenzialmente un file prodotto da TraceLog usando lo schema salvato nell'header
+ */
+class TraceReader {
+public:
+    explicit TraceReader(const std::string &path);
+
+    bool isOpen() const;
+
+    /**
+     * @return Prossimo evento, std::nullopt a fine file o su record corrotto
+     */
+    std::optional<TraceRecord> next();
+
+private:
+    struct EventSchema {
+        std::string name;
+        std::vector<std::pair<std::string, char>> args;
+    };
+
+    std::ifstream file_;
+    std::unordered_map<uint8_t, EventSchema> schema_;
+    std::unordered_map<uint64_t, std::string> strings_;
+    std::chrono::nanoseconds timestamp_{0};
+    bool valid_ = false;
+};
@@ -23,6 +23,7 @@ namespace translator::gcode {
 
     private:
         std::shared_ptr<core::DriverInterface> driver_;
+        double lastZ_ = 0.0; // Ultima Z vista da questa stampante, per il rilevamento del layer
     };
 
 }
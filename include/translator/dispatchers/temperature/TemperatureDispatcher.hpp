@@ -22,6 +22,12 @@ namespace translator::gcode {
 
     private:
         std::shared_ptr<core::DriverInterface> driver_;
+
+        /**
+         * @brief M109/M190: attende che la temperatura raggiunga il target. Si interrompe se durante l'attesa
+         * il driver passa a Idle o Error (job fermato, emergenza).
+         */
+        void waitForTemperature(bool hotend, double target);
     };
 
 } // namespace translator::gcode
\ No newline at end of file
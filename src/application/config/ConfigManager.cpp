@@ -4,8 +4,10 @@
 
 #include "application/config/ConfigManager.hpp"
 #include "logger/Logger.hpp"
+#include <algorithm>
 #include <fstream>
 #include <cstdlib>
+#include <sstream>
 
 namespace core::config {
     ConfigManager &ConfigManager::getInstance() {
@@ -29,18 +31,43 @@ namespace core::config {
         config_["queue.high.priority.threshold"] = "3";
         config_["queue.enable.disk.paging"] = "true";
         config_["queue.disk.page.path"] = "temp/queue";
+        config_["queue.job.archive.path"] = "temp/jobs";
+        config_["queue.checkpoint.path"] = "temp/jobs/job.checkpoint";
+        config_["queue.checkpoint.sync.ms"] = "1000";
+        config_["queue.stream.margin.lines"] = "0";
+        config_["queue.download.connections"] = "1";
+        config_["queue.download.parallel.min.kb"] = "8192";
+        config_["queue.download.retry.max.ms"] = "60000";
         // Serial defaults
         config_["serial.read.timeout.ms"] = "1000";
         config_["serial.write.timeout.ms"] = "5000";
         config_["serial.max.retries"] = "5";
         config_["serial.retry.delay.ms"] = "100";
         config_["serial.enable.keep.alive"] = "true";
+        config_["serial.initial.rto.ms"] = "3000";
+        config_["serial.min.rto.ms"] = "50";
+        config_["serial.max.rto.ms"] = "300000";
+        config_["serial.max.retransmits"] = "3";
+        config_["serial.max.overflow.backoff.ms"] = "2000";
+        config_["serial.binary.framing"] = "true";
+        config_["serial.capture.path"] = "";
+        config_["serial.replay.path"] = "";
+        config_["serial.replay.speed"] = "1.0";
+        config_["serial.telemetry.interval.ms"] = "1000";
+        config_["serial.reconnect.timeout.ms"] = "5000";
+        config_["serial.boot.timeout.ms"] = "10000";
+        // Printer farm defaults (vuoto = una stampante da DRIVER_ID / SERIAL_PORT)
+        config_["printers"] = "";
+        config_["printer.cpu.core"] = "-1";
         // Performance defaults
         config_["performance.enable.response.cache"] = "true";
         config_["performance.cache.default.ttl"] = "5000";
         config_["performance.max.cache.entries"] = "1000";
         config_["performance.enable.async.data.collection"] = "true";
         config_["performance.background.poll.interval"] = "2000";
+        // Logging defaults (vuoto = livello minimo compilato)
+        config_["log.level"] = "";
+        config_["log.trace.path"] = "";
         Logger::logInfo("[ConfigManager] Loaded default configuration");
     }
 
@@ -50,8 +77,18 @@ namespace core::config {
             "PRINTER_CHECK_CACHE_TTL", "PRINTER_CHECK_MAX_RETRIES", "PRINTER_CHECK_DEFAULT_FEED",
             "PRINTER_CHECK_DEFAULT_LAYER_HEIGHT", "PRINTER_CHECK_TIMEOUT_MS",
             "QUEUE_MAX_COMMANDS_IN_RAM", "QUEUE_MAX_COMPLETED_JOBS", "QUEUE_ENABLE_DISK_PAGING",
+            "QUEUE_JOB_ARCHIVE_PATH", "QUEUE_CHECKPOINT_PATH", "QUEUE_CHECKPOINT_SYNC_MS", "QUEUE_STREAM_MARGIN_LINES",
+            "QUEUE_DOWNLOAD_CONNECTIONS", "QUEUE_DOWNLOAD_PARALLEL_MIN_KB", "QUEUE_DOWNLOAD_RETRY_MAX_MS",
             "SERIAL_READ_TIMEOUT_MS", "SERIAL_WRITE_TIMEOUT_MS", "SERIAL_MAX_RETRIES",
-            "PERFORMANCE_ENABLE_CACHE", "PERFORMANCE_CACHE_TTL", "PERFORMANCE_MAX_CACHE_ENTRIES"
+            "SERIAL_RETRY_DELAY_MS", "SERIAL_INITIAL_RTO_MS", "SERIAL_MIN_RTO_MS", "SERIAL_MAX_RTO_MS",
+            "SERIAL_MAX_RETRANSMITS", "SERIAL_MAX_OVERFLOW_BACKOFF_MS", "SERIAL_BINARY_FRAMING",
+            "SERIAL_CAPTURE_PATH", "SERIAL_REPLAY_PATH", "SERIAL_REPLAY_SPEED",
+            "SERIAL_TELEMETRY_INTERVAL_MS", "SERIAL_RECONNECT_TIMEOUT_MS",
+            "SERIAL_BOOT_TIMEOUT_MS",
+            "PRINTERS", "PRINTER_CPU_CORE",
+            "PERFORMANCE_ENABLE_CACHE", "PERFORMANCE_CACHE_TTL", "PERFORMANCE_MAX_CACHE_ENTRIES",
+            "LOG_LEVEL", "LOG_LEVEL_TRANSLATOR", "LOG_LEVEL_SERIAL", "LOG_LEVEL_QUEUE", "LOG_LEVEL_KAFKA",
+            "LOG_TRACE_PATH"
         };
         int loaded = 0;
         for (const char *envVar: envVars) {
@@ -87,6 +124,14 @@ namespace core::config {
         config.highPriorityThreshold = get<int>("queue.high.priority.threshold", 3);
         config.enableDiskPaging = get<bool>("queue.enable.disk.paging", true);
         config.diskPagePath = get<std::string>("queue.disk.page.path", "temp/queue");
+        config.jobArchivePath = get<std::string>("queue.job.archive.path", "temp/jobs");
+        config.checkpointPath = get<std::string>("queue.checkpoint.path", "temp/jobs/job.checkpoint");
+        config.checkpointSyncMs = get<int>("queue.checkpoint.sync.ms", 1000);
+        config.streamMarginLines = std::max(get<int>("queue.stream.margin.lines", 0), 0);
+        config.downloadConnections = std::max(get<int>("queue.download.connections", 1), 1);
+        config.downloadParallelMinBytes =
+                static_cast<size_t>(std::max(get<int>("queue.download.parallel.min.kb", 8192), 0)) * 1024;
+        config.downloadRetryMaxMs = get<int>("queue.download.retry.max.ms", 60000);
         return config;
     }
 
@@ -98,6 +143,18 @@ namespace core::config {
         config.maxRetries = get<int>("serial.max.retries", 5);
         config.retryDelayMs = get<int>("serial.retry.delay.ms", 100);
         config.enableKeepAlive = get<bool>("serial.enable.keep.alive", true);
+        config.initialRtoMs = get<int>("serial.initial.rto.ms", 3000);
+        config.minRtoMs = get<int>("serial.min.rto.ms", 50);
+        config.maxRtoMs = get<int>("serial.max.rto.ms", 300000);
+        config.maxRetransmits = get<int>("serial.max.retransmits", 3);
+        config.maxOverflowBackoffMs = get<int>("serial.max.overflow.backoff.ms", 2000);
+        config.binaryFraming = get<bool>("serial.binary.framing", true);
+        config.capturePath = get<std::string>("serial.capture.path", "");
+        config.replayPath = get<std::string>("serial.replay.path", "");
+        config.replaySpeed = get<double>("serial.replay.speed", 1.0);
+        config.telemetryIntervalMs = get<int>("serial.telemetry.interval.ms", 1000);
+        config.reconnectTimeoutMs = get<int>("serial.reconnect.timeout.ms", 5000);
+        config.bootTimeoutMs = get<int>("serial.boot.timeout.ms", 10000);
         return config;
     }
 
@@ -113,4 +170,60 @@ namespace core::config {
 
         return config;
     }
+
+    LoggingConfig ConfigManager::getLoggingConfig() const {
+        std::lock_guard<std::mutex> lock(configMutex_);
+        LoggingConfig config;
+        config.level = get<std::string>("log.level", "");
+        config.translatorLevel = get<std::string>("log.level.translator", "");
+        config.serialLevel = get<std::string>("log.level.serial", "");
+        config.queueLevel = get<std::string>("log.level.queue", "");
+        config.kafkaLevel = get<std::string>("log.level.kafka", "");
+        config.tracePath = get<std::string>("log.trace.path", "");
+        return config;
+    }
+
+    std::vector<PrinterConfig> ConfigManager::getPrinterConfigs() const {
+        std::string value;
+        {
+            std::lock_guard<std::mutex> lock(configMutex_);
+            value = get<std::string>("printers", "");
+        }
+
+        std::vector<PrinterConfig> printers;
+        std::istringstream stream(value);
+        std::string entry;
+        while (std::getline(stream, entry, ',')) {
+            entry.erase(0, entry.find_first_not_of(" \t"));
+            entry.erase(entry.find_last_not_of(" \t") + 1);
+            if (entry.empty()) continue;
+
+            // id=porta[@baud][#core]
+            size_t equals = entry.find('=');
+            size_t at = entry.find('@', equals);
+            size_t hash = entry.find('#', equals);
+            if (equals == std::string::npos || equals == 0 || equals + 1 == std::min(at, hash)) {
+                Logger::logWarning("[ConfigManager] Ignoring malformed printer entry: " + entry);
+                continue;
+            }
+
+            PrinterConfig printer;
+            printer.driverId = entry.substr(0, equals);
+            printer.serialPort = entry.substr(equals + 1, std::min(at, hash) - equals - 1);
+            try {
+                if (at != std::string::npos) printer.baudrate = std::stoi(entry.substr(at + 1, hash - at - 1));
+                if (hash != std::string::npos) printer.cpuCore = std::stoi(entry.substr(hash + 1));
+            } catch (...) {
+                Logger::logWarning("[ConfigManager] Ignoring malformed printer entry: " + entry);
+                continue;
+            }
+            printers.push_back(std::move(printer));
+        }
+        return printers;
+    }
+
+    int ConfigManager::getPrinterCpuCore() const {
+        std::lock_guard<std::mutex> lock(configMutex_);
+        return get<int>("printer.cpu.core", -1);
+    }
 } // namespace core::config
@@ -4,6 +4,7 @@
 
 #include "application/controllers/ApplicationController.hpp"
 #include "logger/Logger.hpp"
+#include "logger/TraceLog.hpp"
 
 // Dispatcher includes
 #include "translator/dispatchers/motion/MotionDispatcher.hpp"
@@ -15,6 +16,27 @@
 #include "translator/dispatchers/history/HistoryDispatcher.hpp"
 #include "application/monitor/SystemMonitor.hpp"
 #include "core/serial/impl/RealSerialPort.hpp"
+#include "core/serial/impl/ReplaySerialPort.hpp"
+#include "application/config/ConfigManager.hpp"
+#include "core/printer/job/tracking/JobCheckpoint.hpp"
+#include "core/printer/job/tracking/JobTracker.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <future>
+#include <iomanip>
+#include <sstream>
+#include <tuple>
+
+namespace {
+    /**
+     * @brief File di una stampante aggiuntiva accanto a quello della prima: dir/nome.ext -> dir/nome.<id>.ext
+     */
+    std::string perPrinterPath(const std::string &path, const std::string &driverId) {
+        std::filesystem::path file(path);
+        return (file.parent_path() /
+                (file.stem().string() + "." + driverId + file.extension().string())).string();
+    }
+} // namespace
 
 ApplicationController::ApplicationController()
         : isRunning_(false),
@@ -36,38 +58,91 @@ bool ApplicationController::initialize() {
     Logger::logInfo("[ApplicationController] Version: 2.0.0 - Always Active Controllers");
     Logger::logInfo("[ApplicationController] Build Date: " + std::string(__DATE__) + " " + std::string(__TIME__));
 
+    startupBegin_ = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(startupMutex_);
+        startupPhases_.clear();
+    }
+
     // Load configuration
     Logger::logInfo("[ApplicationController] Loading Kafka configuration...");
-    kafkaConfig_.resolveFromEnvironment();
-    kafkaConfig_.printConfig();
+    bool configured = runStartupPhase("config", [this] {
+        core::config::ConfigManager::getInstance().loadFromEnv();
+        configureLogging();
+        auto queueConfig = core::config::ConfigManager::getInstance().getQueueConfig();
+        core::jobs::JobTracker::getInstance().configure(queueConfig.maxCompletedJobs, queueConfig.jobArchivePath);
+        kafkaConfig_.resolveFromEnvironment();
+        kafkaConfig_.printConfig();
+        return registerPrinters();
+    });
+    if (!configured) {
+        Logger::logError("[ApplicationController] ✗ Printer configuration FAILED");
+        return false;
+    }
 
-    // Initialize components in order with detailed logging
+    // Initialize components with detailed logging
     Logger::logInfo("[ApplicationController] Starting initialization sequence...");
 
-    // Step 1: Hardware
-    Logger::logInfo("[ApplicationController] [1/5] Initializing Hardware...");
-    if (!initializeHardware()) {
+    // Step 1: Serial link and driver objects (no firmware wait yet).
+    // Una stampante che fallisce va offline: le altre continuano a essere servite.
+    Logger::logInfo("[ApplicationController] [1/5] Opening serial link...");
+    for (const auto &printer: printers_->all()) {
+        if (!runStartupPhase(phaseName("serial.open", *printer), [&] { return initializeHardware(*printer); })) {
+            markOffline(*printer, "hardware initialization failed");
+        }
+    }
+    if (onlinePrinters() == 0) {
         Logger::logError("[ApplicationController] ✗ Hardware initialization FAILED");
         return false;
     }
-    Logger::logInfo("[ApplicationController] ✓ Hardware initialized successfully");
+    Logger::logInfo("[ApplicationController] ✓ Serial link open - firmware booting");
 
-    // Step 2: Translator
+    // Step 2: Translator (needs only the driver object)
     Logger::logInfo("[ApplicationController] [2/5] Initializing GCode Translator...");
-    if (!initializeTranslator()) {
+    for (const auto &printer: printers_->all()) {
+        if (!printer->online) continue;
+        if (!runStartupPhase(phaseName("translator", *printer), [&] { return initializeTranslator(*printer); })) {
+            markOffline(*printer, "translator initialization failed");
+        }
+    }
+    if (onlinePrinters() == 0) {
         Logger::logError("[ApplicationController] ✗ Translator initialization FAILED");
         return false;
     }
     Logger::logInfo("[ApplicationController] ✓ GCode Translator ready");
 
-    // Step 3: Kafka Controllers
-    Logger::logInfo("[ApplicationController] [3/5] Initializing Kafka Controllers...");
+    // Step 3: Firmware handshake of every printer and Kafka Controllers in parallel.
+    // I comandi che arrivano da Kafka prima del banner di boot attendono il link nel DriverInterface.
+    Logger::logInfo("[ApplicationController] [3/5] Waiting for firmware and starting Kafka Controllers in parallel...");
+    std::vector<std::pair<std::shared_ptr<core::PrinterContext>, std::future<bool>>> hardwareReady;
+    for (const auto &printer: printers_->all()) {
+        if (!printer->online) continue;
+        hardwareReady.emplace_back(printer, std::async(std::launch::async, [this, printer] {
+            return runStartupPhase(phaseName("hardware.ready", *printer),
+                                   [this, printer] { return waitForHardwareReady(*printer); });
+        }));
+    }
+
     if (!initializeKafkaControllers()) {
         Logger::logWarning("[ApplicationController] ⚠ Kafka initialization partial - continuing in offline mode");
     } else {
         Logger::logInfo("[ApplicationController] ✓ Kafka Controllers initialized");
     }
 
+    for (auto &[printer, ready]: hardwareReady) {
+        if (!ready.get()) {
+            markOffline(*printer, "firmware handshake failed");
+        }
+    }
+    if (onlinePrinters() == 0) {
+        Logger::logError("[ApplicationController] ✗ Hardware initialization FAILED");
+        stopKafkaControllers();
+        printStartupTiming();
+        return false;
+    }
+    Logger::logInfo("[ApplicationController] ✓ Hardware initialized successfully (" +
+                    std::to_string(onlinePrinters()) + "/" + std::to_string(printers_->size()) + " printers online)");
+
     // Step 4: Verify Command Queue is running
     Logger::logInfo("[ApplicationController] [4/5] Verifying Command Queue...");
     if (!verifyCommandQueueStatus()) {
@@ -78,19 +153,22 @@ bool ApplicationController::initialize() {
 
     // Step 5: Start System Monitor
     Logger::logInfo("[ApplicationController] [5/5] Starting System Monitor...");
-    monitor_ = std::make_unique<SystemMonitor>(
-            heartbeatController_,
-            printerCommandController_,
-            printerCheckController_,
-            printerControlController_,
-            printer_,
-            commandQueue_  // Pass command queue to monitor
-    );
-    monitor_->start();
+    runStartupPhase("monitor", [this] {
+        monitor_ = std::make_unique<SystemMonitor>(
+                heartbeatController_,
+                printerCommandController_,
+                printerCheckController_,
+                printerControlController_,
+                printers_  // Code comandi di tutte le stampanti
+        );
+        monitor_->start();
+        return true;
+    });
     Logger::logInfo("[ApplicationController] ✓ System Monitor ACTIVE");
 
     // Print initialization summary
     printInitializationSummary();
+    printStartupTiming();
 
     initializationComplete_ = true;
     isRunning_ = true;
@@ -119,10 +197,13 @@ void ApplicationController::run() {
             lastHealthCheck = now;
         }
 
-        // Ensure command queue is always running
-        if (commandQueue_ && !commandQueue_->isRunning()) {
-            Logger::logWarning("[ApplicationController] Command Queue stopped unexpectedly - restarting...");
-            commandQueue_->start();
+        // Ensure command queues are always running
+        for (const auto &printer: printers_->all()) {
+            if (printer->online && printer->commandQueue && !printer->commandQueue->isRunning()) {
+                Logger::logWarning("[ApplicationController] Command Queue " + printer->driverId() +
+                                   " stopped unexpectedly - restarting...");
+                printer->commandQueue->start();
+            }
         }
     }
 
@@ -148,12 +229,29 @@ void ApplicationController::shutdown() {
         Logger::logInfo("[ApplicationController] ✓ System Monitor stopped");
     }
 
+    std::vector<std::shared_ptr<core::PrinterContext>> printers;
+    if (printers_) printers = printers_->all();
+
+    for (const auto &printer: printers) {
+        if (printer->jobScheduler) {
+            printer->jobScheduler->stop();
+        }
+    }
+
     Logger::logInfo("[ApplicationController] Stopping Command Queue...");
-    if (commandQueue_) {
-        commandQueue_->stop();
-        // Wait for queue to finish processing
+    bool queueStopped = false;
+    for (const auto &printer: printers) {
+        if (printer->commandQueue) {
+            printer->commandQueue->stop();
+            queueStopped = true;
+        }
+    }
+    if (queueStopped) {
+        // Wait for queues to finish processing
         std::this_thread::sleep_for(std::chrono::milliseconds(500));
-        commandQueue_.reset();
+        for (const auto &printer: printers) {
+            printer->commandQueue.reset();
+        }
         Logger::logInfo("[ApplicationController] ✓ Command Queue stopped");
     }
 
@@ -161,38 +259,162 @@ void ApplicationController::shutdown() {
     stopKafkaControllers();
 
     Logger::logInfo("[ApplicationController] Shutting down hardware...");
-    if (printer_) {
-        printer_->shutdown();
-        Logger::logInfo("[ApplicationController] ✓ Hardware shutdown complete");
+    for (const auto &printer: printers) {
+        if (printer->driver) {
+            printer->driver->disableTelemetry();
+        }
+        if (printer->printer) {
+            printer->printer->shutdown();
+            Logger::logInfo("[ApplicationController] ✓ Hardware shutdown complete (" + printer->driverId() + ")");
+        }
     }
 
+    TraceLog::getInstance().close();
+
     Logger::logInfo("===============================================");
     Logger::logInfo("[ApplicationController] APPLICATION SHUTDOWN COMPLETE");
     Logger::logInfo("===============================================");
 }
 
-bool ApplicationController::initializeHardware() {
+void ApplicationController::configureLogging() {
+    auto config = core::config::ConfigManager::getInstance().getLoggingConfig();
+
+    auto parse = [](const std::string &name, const std::string &value, LogLevel &level) {
+        if (value.empty()) return false;
+        if (!Logger::parseLevel(value, level)) {
+            Logger::logWarning("[ApplicationController] Unknown log level '" + value + "' for " + name);
+            return false;
+        }
+        Logger::logInfo("[ApplicationController] Log level " + name + " = " + value);
+        return true;
+    };
+
+    LogLevel level;
+    if (parse("all", config.level, level)) {
+        Logger::setLevel(level);
+    }
+
+    // Le impostazioni per modulo prevalgono su LOG_LEVEL
+    const std::tuple<std::string, LogModule, std::string> modules[] = {
+            {"translator", LogModule::Translator, config.translatorLevel},
+            {"serial", LogModule::Serial, config.serialLevel},
+            {"queue", LogModule::Queue, config.queueLevel},
+            {"kafka", LogModule::Kafka, config.kafkaLevel}
+    };
+    for (const auto &[name, module, value]: modules) {
+        if (parse(name, value, level)) {
+            Logger::setLevel(module, level);
+        }
+    }
+
+    if (!config.tracePath.empty()) {
+        TraceLog::getInstance().open(config.tracePath);
+    }
+}
+
+bool ApplicationController::registerPrinters() {
+    auto &config = core::config::ConfigManager::getInstance();
+    auto queueConfig = config.getQueueConfig();
+
+    auto printerConfigs = config.getPrinterConfigs();
+    if (printerConfigs.empty()) {
+        // Installazione a stampante singola: porta e driverId di KafkaConfig
+        printerConfigs.push_back({kafkaConfig_.driverId, kafkaConfig_.serialPort, kafkaConfig_.serialBaudrate,
+                                  config.getPrinterCpuCore()});
+    }
+
+    printers_ = std::make_shared<core::PrinterRegistry>();
+    for (auto &printerConfig: printerConfigs) {
+        printers_->add(std::move(printerConfig));
+    }
+
+    for (const auto &printer: printers_->all()) {
+        std::string path = &printer->checkpoint() == &core::jobs::JobCheckpoint::getInstance()
+                               ? queueConfig.checkpointPath
+                               : perPrinterPath(queueConfig.checkpointPath, printer->driverId());
+        printer->checkpoint().open(path, std::chrono::milliseconds(queueConfig.checkpointSyncMs));
+    }
+
+    if (printers_->size() > 1) {
+        Logger::logInfo("[ApplicationController] Driving " + std::to_string(printers_->size()) +
+                        " printers (Kafka clients shared, routed by driverId)");
+    }
+    return true;
+}
+
+bool ApplicationController::initializeHardware(core::PrinterContext &printer) {
+    const auto &printerConfig = printer.config;
     try {
-        Logger::logInfo("[ApplicationController] Creating serial port on: " +
-                        kafkaConfig_.serialPort + " @ " +
-                        std::to_string(kafkaConfig_.serialBaudrate) + " baud");
+        auto serialConfig = core::config::ConfigManager::getInstance().getSerialConfig();
+        // Capture e replay descrivono un solo link: valgono per la prima stampante
+        bool first = printers_->all().front().get() == &printer;
+
+        if (first && !serialConfig.replayPath.empty()) {
+            Logger::logInfo("[ApplicationController] Replaying serial capture: " + serialConfig.replayPath);
+            printer.serialPort = std::make_shared<core::ReplaySerialPort>(serialConfig.replayPath,
+                                                                          serialConfig.replaySpeed);
+        } else {
+            Logger::logInfo("[ApplicationController] Creating serial port for " + printer.driverId() + " on: " +
+                            printerConfig.serialPort + " @ " +
+                            std::to_string(printerConfig.baudrate) + " baud");
+
+            auto realPort = std::make_shared<core::RealSerialPort>(
+                    printerConfig.serialPort, printerConfig.baudrate
+            );
+            if (first && !serialConfig.capturePath.empty()) {
+                realPort->startCapture(serialConfig.capturePath);
+            }
+            printer.serialPort = realPort;
+        }
 
-        serialPort_ = std::make_shared<core::RealSerialPort>(
-                kafkaConfig_.serialPort, kafkaConfig_.serialBaudrate
-        );
+        if (!printer.serialPort->isOpen()) {
+            Logger::logError("[ApplicationController] Serial port not open: " + printerConfig.serialPort);
+            return false;
+        }
 
         Logger::logInfo("[ApplicationController] Creating printer interface...");
-        printer_ = std::make_shared<core::RealPrinter>(serialPort_);
+        printer.printer = std::make_shared<core::RealPrinter>(printer.serialPort,
+                                                              std::chrono::milliseconds(serialConfig.bootTimeoutMs));
 
         Logger::logInfo("[ApplicationController] Creating driver interface...");
-        driver_ = std::make_shared<core::DriverInterface>(printer_, serialPort_);
+        printer.driver = std::make_shared<core::DriverInterface>(printer.printer, printer.serialPort,
+                                                                 printer.stateTracker());
+        printer.driver->setCpuAffinity(printerConfig.cpuCore);
+        printer.driver->setLinkReady(false);
+
+        return true;
+    } catch (const std::exception &e) {
+        Logger::logError("[ApplicationController] Hardware initialization failed: " + std::string(e.what()));
+        return false;
+    }
+}
+
+bool ApplicationController::waitForHardwareReady(core::PrinterContext &printer) {
+    try {
+        auto serialConfig = core::config::ConfigManager::getInstance().getSerialConfig();
+
+        Logger::logInfo("[ApplicationController] Initializing printer hardware (" + printer.driverId() + ")...");
+        printer.printer->initialize();
+
+        // I comandi Kafka in attesa partono solo a framing e corsia urgente decisi
+        printer.driver->runHandshake([&] {
+            if (serialConfig.binaryFraming) {
+                Logger::logInfo("[ApplicationController] Negotiating serial framing...");
+                printer.driver->negotiateFraming();
+            }
+
+            printer.driver->probeUrgentLane();
 
-        Logger::logInfo("[ApplicationController] Initializing printer hardware...");
-        printer_->initialize();
+            if (serialConfig.telemetryIntervalMs > 0) {
+                Logger::logInfo("[ApplicationController] Enabling firmware telemetry...");
+                printer.driver->enableTelemetry(std::chrono::milliseconds(serialConfig.telemetryIntervalMs));
+            }
+        });
+        printer.driver->setLinkReady(true);
 
-        Logger::logInfo("[ApplicationController] Hardware initialization complete");
-        Logger::logInfo("[ApplicationController]   Port: " + kafkaConfig_.serialPort);
-        Logger::logInfo("[ApplicationController]   Baudrate: " + std::to_string(kafkaConfig_.serialBaudrate));
+        Logger::logInfo("[ApplicationController] Hardware initialization complete (" + printer.driverId() + ")");
+        Logger::logInfo("[ApplicationController]   Port: " + printer.config.serialPort);
+        Logger::logInfo("[ApplicationController]   Baudrate: " + std::to_string(printer.config.baudrate));
 
         return true;
     } catch (const std::exception &e) {
@@ -201,19 +423,19 @@ bool ApplicationController::initializeHardware() {
     }
 }
 
-bool ApplicationController::initializeTranslator() {
+bool ApplicationController::initializeTranslator(core::PrinterContext &printer) {
     try {
         Logger::logInfo("[ApplicationController] Creating GCode translator...");
-        translator_ = std::make_shared<translator::gcode::GCodeTranslator>(driver_);
+        printer.translator = std::make_shared<translator::gcode::GCodeTranslator>(printer.driver);
 
         Logger::logInfo("[ApplicationController] Registering GCode dispatchers...");
-        initializeDispatchers();
+        initializeDispatchers(printer);
 
         Logger::logInfo("[ApplicationController] Creating Command Executor Queue...");
-        initializeCommandExecutorQueue();
+        initializeCommandExecutorQueue(printer);
 
         // Verify queue is running
-        if (!commandQueue_ || !commandQueue_->isRunning()) {
+        if (!printer.commandQueue || !printer.commandQueue->isRunning()) {
             Logger::logError("[ApplicationController] Command Queue failed to start!");
             return false;
         }
@@ -233,37 +455,72 @@ bool ApplicationController::initializeKafkaControllers() {
     try {
         Logger::logInfo("[ApplicationController] Initializing Kafka Controllers...");
 
-        // Initialize HeartbeatController
-        Logger::logInfo("[ApplicationController]   Creating HeartbeatController...");
-        heartbeatController_ = std::make_unique<connector::controllers::HeartbeatController>(
-                kafkaConfig_, driver_
-        );
-        heartbeatController_->start();
-
-        // Initialize PrinterCommandController
-        Logger::logInfo("[ApplicationController]   Creating PrinterCommandController...");
-        printerCommandController_ = std::make_unique<connector::controllers::PrinterCommandController>(
-                kafkaConfig_, driver_, commandQueue_
-        );
-        printerCommandController_->start();
-
-        // Initialize PrinterCheckController
-        Logger::logInfo("[ApplicationController]   Creating PrinterCheckController...");
-        printerCheckController_ = std::make_unique<connector::controllers::PrinterCheckController>(
-                kafkaConfig_, driver_, commandQueue_
-        );
-        printerCheckController_->start();
-
-        // Initialize PrintJobManager
-        Logger::logInfo("[ApplicationController]   Creating PrintJobManager...");
-        jobManager_ = std::make_shared<core::print::PrintJobManager>(driver_, commandQueue_);
+        // Il PrintJobManager non apre connessioni: serve già pronto al PrinterControlController
+        for (const auto &printer: printers_->all()) {
+            if (!printer->online) continue;
+            printer->jobManager = std::make_shared<core::print::PrintJobManager>(
+                    printer->driver, printer->commandQueue, printer->checkpoint());
+            printer->jobScheduler = std::make_shared<core::print::PrintJobScheduler>(printer->jobManager);
+            printer->jobScheduler->start();
+            if (auto interrupted = printer->checkpoint().recovered()) {
+                Logger::logWarning("[ApplicationController] Job " + interrupted->jobId + " on " +
+                                   printer->driverId() + " was interrupted at command " +
+                                   std::to_string(interrupted->commandIndex) + "/" +
+                                   std::to_string(interrupted->totalCommands) +
+                                   " - send a start request with \"resume\": true to continue it");
+            }
+        }
 
-        // Initialize PrinterControlController
-        Logger::logInfo("[ApplicationController]   Creating PrinterControlController...");
-        printerControlController_ = std::make_unique<connector::controllers::PrinterControlController>(
-                kafkaConfig_, driver_, commandQueue_, jobManager_
-        );
-        printerControlController_->start();
+        // Ogni controller crea consumer e producer propri: costruzione e avvio in parallelo
+        std::vector<std::future<bool>> controllers;
+
+        controllers.push_back(std::async(std::launch::async, [this] {
+            return runStartupPhase("kafka.heartbeat", [this] {
+                Logger::logInfo("[ApplicationController]   Creating HeartbeatController...");
+                heartbeatController_ = std::make_unique<connector::controllers::HeartbeatController>(
+                        kafkaConfig_, printers_
+                );
+                heartbeatController_->start();
+                return heartbeatController_->isRunning();
+            });
+        }));
+
+        controllers.push_back(std::async(std::launch::async, [this] {
+            return runStartupPhase("kafka.command", [this] {
+                Logger::logInfo("[ApplicationController]   Creating PrinterCommandController...");
+                printerCommandController_ = std::make_unique<connector::controllers::PrinterCommandController>(
+                        kafkaConfig_, printers_
+                );
+                printerCommandController_->start();
+                return printerCommandController_->isRunning();
+            });
+        }));
+
+        controllers.push_back(std::async(std::launch::async, [this] {
+            return runStartupPhase("kafka.check", [this] {
+                Logger::logInfo("[ApplicationController]   Creating PrinterCheckController...");
+                printerCheckController_ = std::make_unique<connector::controllers::PrinterCheckController>(
+                        kafkaConfig_, printers_
+                );
+                printerCheckController_->start();
+                return printerCheckController_->isRunning();
+            });
+        }));
+
+        controllers.push_back(std::async(std::launch::async, [this] {
+            return runStartupPhase("kafka.control", [this] {
+                Logger::logInfo("[ApplicationController]   Creating PrinterControlController...");
+                printerControlController_ = std::make_unique<connector::controllers::PrinterControlController>(
+                        kafkaConfig_, printers_
+                );
+                printerControlController_->start();
+                return printerControlController_->isRunning();
+            });
+        }));
+
+        for (auto &controller: controllers) {
+            controller.get();
+        }
 
         // Report status with detailed info
         Logger::logInfo("[ApplicationController] Kafka Controllers Status:");
@@ -312,46 +569,48 @@ bool ApplicationController::initializeKafkaControllers() {
     }
 }
 
-void ApplicationController::initializeDispatchers() {
+void ApplicationController::initializeDispatchers(core::PrinterContext &printer) {
     Logger::logInfo("[ApplicationController] Registering GCode dispatchers:");
 
-    translator_->registerDispatcher(std::make_unique<translator::gcode::MotionDispatcher>(driver_));
+    printer.translator->registerDispatcher(std::make_unique<translator::gcode::MotionDispatcher>(printer.driver));
     Logger::logInfo("[ApplicationController]   ✓ MotionDispatcher (G0, G1, G28, etc.)");
 
-    translator_->registerDispatcher(std::make_unique<translator::gcode::SystemDispatcher>(driver_));
+    printer.translator->registerDispatcher(std::make_unique<translator::gcode::SystemDispatcher>(printer.driver));
     Logger::logInfo("[ApplicationController]   ✓ SystemDispatcher (M24, M25, M112, etc.)");
 
-    translator_->registerDispatcher(std::make_unique<translator::gcode::ExtruderDispatcher>(driver_));
+    printer.translator->registerDispatcher(std::make_unique<translator::gcode::ExtruderDispatcher>(printer.driver));
     Logger::logInfo("[ApplicationController]   ✓ ExtruderDispatcher (M82, M83, etc.)");
 
-    translator_->registerDispatcher(std::make_unique<translator::gcode::FanDispatcher>(driver_));
+    printer.translator->registerDispatcher(std::make_unique<translator::gcode::FanDispatcher>(printer.driver));
     Logger::logInfo("[ApplicationController]   ✓ FanDispatcher (M106, M107)");
 
-    translator_->registerDispatcher(std::make_unique<translator::gcode::EndstopDispatcher>(driver_));
+    printer.translator->registerDispatcher(std::make_unique<translator::gcode::EndstopDispatcher>(printer.driver));
     Logger::logInfo("[ApplicationController]   ✓ EndstopDispatcher (M119)");
 
-    translator_->registerDispatcher(std::make_unique<translator::gcode::TemperatureDispatcher>(driver_));
+    printer.translator->registerDispatcher(std::make_unique<translator::gcode::TemperatureDispatcher>(printer.driver));
     Logger::logInfo("[ApplicationController]   ✓ TemperatureDispatcher (M104, M109, etc.)");
 
-    translator_->registerDispatcher(std::make_unique<translator::gcode::HistoryDispatcher>(driver_));
+    printer.translator->registerDispatcher(std::make_unique<translator::gcode::HistoryDispatcher>(printer.driver));
     Logger::logInfo("[ApplicationController]   ✓ HistoryDispatcher");
 
     Logger::logInfo("[ApplicationController] All GCode dispatchers registered successfully");
 }
 
-void ApplicationController::initializeCommandExecutorQueue() {
+void ApplicationController::initializeCommandExecutorQueue(core::PrinterContext &printer) {
     Logger::logInfo("[ApplicationController] Initializing Command Executor Queue...");
 
-    commandQueue_ = std::make_shared<core::CommandExecutorQueue>(translator_);
+    // La prima stampante mantiene il file della coda di sempre, le altre uno proprio accanto
+    const std::string queuePath = "temp/command_queue.dat";
+    bool first = printers_->all().front().get() == &printer;
+    printer.commandQueue = std::make_shared<core::CommandExecutorQueue>(
+            printer.translator, first ? queuePath : perPrinterPath(queuePath, printer.driverId()));
+    printer.commandQueue->setCpuAffinity(printer.config.cpuCore);
 
-    // Start the queue immediately
-    commandQueue_->start();
-
-    // Wait a moment for initialization
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    // Start the queue immediately (start() marca la coda attiva prima di ritornare)
+    printer.commandQueue->start();
 
     // Verify it's running
-    if (!commandQueue_->isRunning()) {
+    if (!printer.commandQueue->isRunning()) {
         Logger::logError("[ApplicationController] CRITICAL: Command Queue failed to start!");
         throw std::runtime_error("Command Queue initialization failed");
     }
@@ -364,42 +623,46 @@ void ApplicationController::initializeCommandExecutorQueue() {
 }
 
 bool ApplicationController::verifyCommandQueueStatus() {
-    if (!commandQueue_) {
-        Logger::logError("[ApplicationController] Command Queue is null!");
-        return false;
-    }
-
-    if (!commandQueue_->isRunning()) {
-        Logger::logWarning("[ApplicationController] Command Queue not running - attempting to start...");
-        commandQueue_->start();
+    for (const auto &printer: printers_->all()) {
+        if (!printer->online) continue;
+        auto &commandQueue = printer->commandQueue;
+        if (!commandQueue) {
+            Logger::logError("[ApplicationController] Command Queue is null for " + printer->driverId() + "!");
+            return false;
+        }
 
-        // Wait a moment and check again
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        if (!commandQueue->isRunning()) {
+            Logger::logWarning("[ApplicationController] Command Queue not running - attempting to start...");
+            commandQueue->start();
 
-        if (!commandQueue_->isRunning()) {
-            Logger::logError("[ApplicationController] Failed to start Command Queue!");
-            return false;
+            if (!commandQueue->isRunning()) {
+                Logger::logError("[ApplicationController] Failed to start Command Queue for " +
+                                 printer->driverId() + "!");
+                return false;
+            }
         }
+
+        // Test the queue with a simple command
+        Logger::logInfo("[ApplicationController] Testing queue " + printer->driverId() +
+                        " with M115 (firmware info)...");
+        commandQueue->enqueue("M115", 5); // Low priority test command
     }
 
     Logger::logInfo("[ApplicationController] Command Queue verification passed");
     Logger::logInfo("[ApplicationController]   Queue Status: ACTIVE");
 
-    // Test the queue with a simple command
-    Logger::logInfo("[ApplicationController] Testing queue with M115 (firmware info)...");
-    commandQueue_->enqueue("M115", 5); // Low priority test command
-
     return true;
 }
 
 void ApplicationController::performHealthCheck() {
     Logger::logInfo("[ApplicationController] Performing health check...");
 
-    // Check Command Queue
-    if (commandQueue_) {
-        if (!commandQueue_->isRunning()) {
-            Logger::logWarning("[ApplicationController] Health Check: Command Queue stopped - restarting!");
-            commandQueue_->start();
+    // Check Command Queues
+    for (const auto &printer: printers_->all()) {
+        if (printer->online && printer->commandQueue && !printer->commandQueue->isRunning()) {
+            Logger::logWarning("[ApplicationController] Health Check: Command Queue " + printer->driverId() +
+                               " stopped - restarting!");
+            printer->commandQueue->start();
         }
     }
 
@@ -413,11 +676,20 @@ void ApplicationController::performHealthCheck() {
     Logger::logInfo("[ApplicationController] Health Check: " +
                     std::to_string(activeControllers) + "/4 Kafka controllers active");
 
-    // Check hardware connection
-    if (printer_ && printer_->isSystemReady()) {
-        Logger::logInfo("[ApplicationController] Health Check: Hardware ready");
-    } else {
-        Logger::logWarning("[ApplicationController] Health Check: Hardware not ready or disconnected!");
+    // Check hardware connections (le stampanti offline sono escluse dall'avvio)
+    size_t offline = printers_->size() - onlinePrinters();
+    if (offline > 0) {
+        Logger::logWarning("[ApplicationController] Health Check: " + std::to_string(offline) +
+                           " printer(s) offline - skipped");
+    }
+    for (const auto &printer: printers_->all()) {
+        if (!printer->online) continue;
+        if (printer->printer && printer->printer->isSystemReady()) {
+            Logger::logInfo("[ApplicationController] Health Check: Hardware " + printer->driverId() + " ready");
+        } else {
+            Logger::logWarning("[ApplicationController] Health Check: Hardware " + printer->driverId() +
+                               " not ready or disconnected!");
+        }
     }
 }
 
@@ -449,20 +721,95 @@ void ApplicationController::stopKafkaControllers() {
     Logger::logInfo("[ApplicationController] ✓ All Kafka controllers stopped");
 }
 
+bool ApplicationController::runStartupPhase(const std::string &name, const std::function<bool()> &phase) {
+    auto begin = std::chrono::steady_clock::now();
+    bool ok = false;
+    try {
+        ok = phase();
+    } catch (const std::exception &e) {
+        Logger::logError("[ApplicationController] Startup phase " + name + " failed: " + std::string(e.what()));
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> lock(startupMutex_);
+    startupPhases_.push_back({
+            name,
+            std::chrono::duration_cast<std::chrono::milliseconds>(begin - startupBegin_),
+            std::chrono::duration_cast<std::chrono::milliseconds>(end - begin),
+            ok
+    });
+    return ok;
+}
+
+std::string ApplicationController::phaseName(const std::string &name, const core::PrinterContext &printer) const {
+    return printers_->size() > 1 ? name + ":" + printer.driverId() : name;
+}
+
+void ApplicationController::markOffline(core::PrinterContext &printer, const std::string &reason) {
+    Logger::logError("[ApplicationController] ✗ Printer " + printer.driverId() + " OFFLINE: " + reason);
+    printer.online = false;
+    // Niente comandi o job su un link che non ha completato l'avvio
+    if (printer.jobScheduler) printer.jobScheduler->stop();
+    if (printer.commandQueue) printer.commandQueue->stop();
+    if (printer.driver) printer.driver->setLinkReady(false);
+}
+
+size_t ApplicationController::onlinePrinters() const {
+    return std::count_if(printers_->all().begin(), printers_->all().end(),
+                         [](const std::shared_ptr<core::PrinterContext> &printer) { return printer->online.load(); });
+}
+
+void ApplicationController::printStartupTiming() {
+    std::vector<StartupPhase> phases;
+    {
+        std::lock_guard<std::mutex> lock(startupMutex_);
+        phases = startupPhases_;
+    }
+    std::sort(phases.begin(), phases.end(), [](const StartupPhase &a, const StartupPhase &b) {
+        return a.offset < b.offset;
+    });
+
+    auto total = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - startupBegin_);
+    const StartupPhase *slowest = nullptr;
+    for (const auto &phase: phases) {
+        if (!slowest || phase.duration > slowest->duration) slowest = &phase;
+    }
+
+    Logger::logInfo("[ApplicationController] Startup timing (total " + std::to_string(total.count()) + "ms):");
+    for (const auto &phase: phases) {
+        std::ostringstream line;
+        line << "[ApplicationController]   " << std::left << std::setw(16) << phase.name
+             << " +" << std::right << std::setw(5) << phase.offset.count() << "ms "
+             << std::setw(6) << phase.duration.count() << "ms"
+             << (phase.ok ? "" : "  FAILED");
+        Logger::logInfo(line.str());
+    }
+    if (slowest) {
+        Logger::logInfo("[ApplicationController]   Critical path: " + slowest->name);
+    }
+}
+
 void ApplicationController::printInitializationSummary() {
     Logger::logInfo("===============================================");
     Logger::logInfo("[ApplicationController] INITIALIZATION SUMMARY");
     Logger::logInfo("===============================================");
-    Logger::logInfo("  Hardware:");
-    Logger::logInfo("    Serial Port: " + kafkaConfig_.serialPort);
-    Logger::logInfo("    Baudrate: " + std::to_string(kafkaConfig_.serialBaudrate));
-    Logger::logInfo("    Status: " + std::string(printer_ ? "✓ CONNECTED" : "✗ DISCONNECTED"));
+    for (const auto &printer: printers_->all()) {
+        Logger::logInfo("  Printer " + printer->driverId() + ":");
+        Logger::logInfo("    Serial Port: " + printer->config.serialPort);
+        Logger::logInfo("    Baudrate: " + std::to_string(printer->config.baudrate));
+        if (printer->config.cpuCore >= 0) {
+            Logger::logInfo("    CPU Core: " + std::to_string(printer->config.cpuCore));
+        }
+        Logger::logInfo("    Status: " + std::string(!printer->online ? "✗ OFFLINE"
+                                                     : printer->printer ? "✓ CONNECTED" : "✗ DISCONNECTED"));
+        Logger::logInfo("    Command Queue: " + std::string(
+                printer->commandQueue && printer->commandQueue->isRunning() ? "✓ RUNNING" : "✗ STOPPED"));
+    }
 
     Logger::logInfo("  GCode System:");
     Logger::logInfo("    Translator: ✓ READY");
     Logger::logInfo("    Dispatchers: ✓ 7 REGISTERED");
-    Logger::logInfo("    Command Queue: " +
-                    std::string(commandQueue_ && commandQueue_->isRunning() ? "✓ RUNNING" : "✗ STOPPED"));
 
     Logger::logInfo("  Kafka Controllers:");
     Logger::logInfo("    Heartbeat: " +
@@ -9,14 +9,12 @@ SystemMonitor::SystemMonitor(std::unique_ptr<connector::controllers::HeartbeatCo
                              std::unique_ptr<connector::controllers::PrinterCheckController> &printerCheckController,
                              std::unique_ptr<connector::controllers::PrinterControlController> &
                              printerControlController,
-                             std::shared_ptr<core::RealPrinter> printer,
-                             std::shared_ptr<core::CommandExecutorQueue> commandQueue_)
+                             std::shared_ptr<core::PrinterRegistry> printers)
         : heartbeatController_(heartbeatController),
           printerCommandController_(printerCommandController),
           printerCheckController_(printerCheckController),
           printerControlController_(printerControlController),
-          printer_(std::move(printer)),
-          commandQueue_(std::move(commandQueue_)) {
+          printers_(std::move(printers)) {
 }
 
 SystemMonitor::~SystemMonitor() {
@@ -78,23 +76,35 @@ void SystemMonitor::monitorLoop() {
 void SystemMonitor::reportKafkaStats() const {
     Logger::logInfo("[SystemMonitor] ===== System Status Report =====");
 
-    // Command Queue Status - CRITICAL
-    Logger::logInfo("[SystemMonitor] Command Executor Queue:");
-    if (commandQueue_) {
-        bool isRunning = commandQueue_->isRunning();
-        auto stats = commandQueue_->getStatistics();
-        Logger::logInfo("  Running: " + std::string(isRunning ? "TRUE" : "FALSE"));
-        Logger::logInfo("  Total Enqueued: " + std::to_string(stats.totalEnqueued));
-        Logger::logInfo("  Total Executed: " + std::to_string(stats.totalExecuted));
-        Logger::logInfo("  Current Queue Size: " + std::to_string(stats.currentQueueSize));
-        Logger::logInfo("  Errors: " + std::to_string(stats.totalErrors));
-        Logger::logInfo("  Disk Operations: " + std::to_string(stats.diskOperations));
-
-        if (!isRunning && stats.currentQueueSize > 0) {
-            Logger::logError("[SystemMonitor] WARNING: Queue has commands but is not running!");
-        }
-    } else {
+    // Command Queue Status - CRITICAL (una coda per stampante)
+    if (!printers_ || printers_->empty()) {
         Logger::logError("[SystemMonitor] Command Queue: NOT AVAILABLE");
+    } else {
+        for (const auto &printer: printers_->all()) {
+            if (!printer->online) {
+                Logger::logWarning("[SystemMonitor] Printer " + printer->driverId() + ": OFFLINE");
+                continue;
+            }
+            const auto &commandQueue = printer->commandQueue;
+            Logger::logInfo("[SystemMonitor] Command Executor Queue [" + printer->driverId() + "]:");
+            if (!commandQueue) {
+                Logger::logError("[SystemMonitor] Command Queue: NOT AVAILABLE");
+                continue;
+            }
+            bool isRunning = commandQueue->isRunning();
+            auto stats = commandQueue->getStatistics();
+            Logger::logInfo("  Running: " + std::string(isRunning ? "TRUE" : "FALSE"));
+            Logger::logInfo("  Total Enqueued: " + std::to_string(stats.totalEnqueued));
+            Logger::logInfo("  Total Executed: " + std::to_string(stats.totalExecuted));
+            Logger::logInfo("  Current Queue Size: " + std::to_string(stats.currentQueueSize));
+            Logger::logInfo("  Errors: " + std::to_string(stats.totalErrors));
+            Logger::logInfo("  Disk Operations: " + std::to_string(stats.diskOperations));
+
+            if (!isRunning && stats.currentQueueSize > 0) {
+                Logger::logError("[SystemMonitor] WARNING: Queue " + printer->driverId() +
+                                 " has commands but is not running!");
+            }
+        }
     }
 
     // Heartbeat Controller
@@ -4,13 +4,13 @@
 
 namespace connector::controllers {
     HeartbeatController::HeartbeatController(const kafka::KafkaConfig &config,
-                                             std::shared_ptr<core::DriverInterface> driver)
-        : config_(config), driver_(driver), running_(false) {
-        if (!driver_) {
-            throw std::invalid_argument("DriverInterface cannot be null");
+                                             std::shared_ptr<core::PrinterRegistry> printers)
+        : config_(config), printers_(std::move(printers)), running_(false) {
+        if (!printers_ || printers_->empty()) {
+            throw std::invalid_argument("PrinterRegistry cannot be empty");
         }
 
-        Logger::logInfo("[HeartbeatController] Initializing for driver: " + config_.driverId);
+        Logger::logInfo("[HeartbeatController] Initializing for " + std::to_string(printers_->size()) + " printer(s)");
 
         try {
             // Crea i componenti con gestione errori
@@ -18,21 +18,24 @@ namespace connector::controllers {
 
             receiver_ = std::make_shared<events::heartbeat::HeartbeatReceiver>(config_);
             sender_ = std::make_shared<events::heartbeat::HeartbeatSender>(config_);
-            processor_ = std::make_shared<processors::heartbeat::HeartbeatProcessor>(sender_,
-                driver_, config_.driverId);
+            for (const auto &printer: printers_->all()) {
+                if (!printer->online) continue;
+                processors_.emplace(printer->driverId(), std::make_shared<processors::heartbeat::HeartbeatProcessor>(
+                    sender_, printer->driver, printer->driverId()));
+            }
 
             // Registra il callback per i messaggi
             receiver_->setMessageCallback([this](const std::string &message, const std::string &key) {
                 onMessageReceived(message, key);
             });
 
-            Logger::logInfo("[HeartbeatController] Created successfully for driver: " + config_.driverId);
+            Logger::logInfo("[HeartbeatController] Created successfully");
         } catch (const std::exception &e) {
             Logger::logError("[HeartbeatController] Failed to initialize: " + std::string(e.what()));
             // Non rethrow - permetti all'applicazione di continuare senza Kafka
             receiver_.reset();
             sender_.reset();
-            processor_.reset();
+            processors_.clear();
         }
     }
 
@@ -46,7 +49,7 @@ namespace connector::controllers {
             return;
         }
 
-        if (!receiver_ || !sender_ || !processor_) {
+        if (!receiver_ || !sender_ || processors_.empty()) {
             Logger::logError("[HeartbeatController] Cannot start - components not initialized properly");
             return;
         }
@@ -91,13 +94,18 @@ namespace connector::controllers {
         stats_.messagesReceived++;
 
         try {
-            if (processor_) {
-                processor_->processHeartbeatRequest(message, key);
-                stats_.messagesProcessed++;
-                stats_.messagesSent++;
-            } else {
+            if (processors_.empty()) {
                 Logger::logWarning("[HeartbeatController] Processor not available, dropping message");
+                return;
+            }
+            // Le stampanti offline non rispondono: per il backend restano senza heartbeat
+            for (const auto &printer: printers_->all()) {
+                auto processor = processors_.find(printer->driverId());
+                if (!printer->online || processor == processors_.end()) continue;
+                processor->second->processHeartbeatRequest(message, key);
+                stats_.messagesSent++;
             }
+            stats_.messagesProcessed++;
         } catch (const std::exception &e) {
             stats_.processingErrors++;
             Logger::logError("[HeartbeatController] Processing failed: " + std::string(e.what()));
@@ -10,17 +10,14 @@
 
 namespace connector::controllers {
     PrinterCheckController::PrinterCheckController(const kafka::KafkaConfig &config,
-                                                   std::shared_ptr<core::DriverInterface> driver,
-                                                   std::shared_ptr<core::CommandExecutorQueue> commandQueue)
-        : config_(config), driver_(driver), commandQueue_(commandQueue), running_(false) {
-        if (!driver_) {
-            throw std::invalid_argument("DriverInterface cannot be null");
-        }
-        if (!commandQueue_) {
-            throw std::invalid_argument("CommandExecutorQueue cannot be null");
+                                                   std::shared_ptr<core::PrinterRegistry> printers)
+        : config_(config), printers_(std::move(printers)), running_(false) {
+        if (!printers_ || printers_->empty()) {
+            throw std::invalid_argument("PrinterRegistry cannot be empty");
         }
 
-        Logger::logInfo("[PrinterCheckController] Initializing for driver: " + config_.driverId);
+        Logger::logInfo("[PrinterCheckController] Initializing for " + std::to_string(printers_->size()) +
+                        " printer(s)");
 
         try {
             // Create Kafka components
@@ -28,20 +25,25 @@ namespace connector::controllers {
 
             receiver_ = std::make_shared<events::printer_check::PrinterCheckReceiver>(config_);
             sender_ = std::make_shared<events::printer_check::PrinterCheckSender>(config_);
-            processor_ = std::make_shared<processors::printer_check::PrinterCheckProcessor>(
-                sender_, driver_, commandQueue_, config_.driverId);
+            for (const auto &printer: printers_->all()) {
+                if (!printer->online) continue;
+                processors_.emplace(printer->driverId(),
+                                    std::make_shared<processors::printer_check::PrinterCheckProcessor>(
+                                        sender_, printer->driver, printer->commandQueue, printer->driverId()));
+            }
 
             // Register message callback
             receiver_->setMessageCallback([this](const std::string &message, const std::string &key) {
                 onMessageReceived(message, key);
             });
 
-            Logger::logInfo("[PrinterCheckController] Created successfully for driver: " + config_.driverId);
+            Logger::logInfo("[PrinterCheckController] Created successfully for " +
+                            std::to_string(processors_.size()) + " printer(s)");
         } catch (const std::exception &e) {
             Logger::logError("[PrinterCheckController] Failed to initialize: " + std::string(e.what()));
             receiver_.reset();
             sender_.reset();
-            processor_.reset();
+            processors_.clear();
         }
     }
 
@@ -55,7 +57,7 @@ namespace connector::controllers {
             return;
         }
 
-        if (!receiver_ || !sender_ || !processor_) {
+        if (!receiver_ || !sender_ || processors_.empty()) {
             Logger::logError("[PrinterCheckController] Cannot start - components not initialized properly");
             return;
         }
@@ -119,18 +121,23 @@ namespace connector::controllers {
                 return;
             }
 
-            // Check if this request is for our driver
-            if (request.driverId != config_.driverId) {
-                Logger::logInfo("[PrinterCheckController] Request not for this driver (" + request.driverId +
-                                " vs " + config_.driverId + "), ignoring");
+            // Check if this request is for one of our printers
+            auto processor = processors_.find(request.driverId);
+            if (processor == processors_.end()) {
+                Logger::logInfo("[PrinterCheckController] Request not for our printers (" + request.driverId +
+                                "), ignoring");
+                return;
+            }
+            if (!printers_->find(request.driverId)->online) {
+                Logger::logWarning("[PrinterCheckController] Printer " + request.driverId + " offline, ignoring");
                 return;
             }
 
             Logger::logInfo("[PrinterCheckController] Processing check request for job: " + request.jobId +
                             " (criteria: '" + request.criteria + "')");
 
-            if (processor_) {
-                processor_->processPrinterCheckRequest(request);
+            if (processor->second) {
+                processor->second->processPrinterCheckRequest(request);
                 stats_.messagesProcessed++;
                 stats_.messagesSent++;
                 Logger::logInfo("[PrinterCheckController] Check request processed successfully");
@@ -12,24 +12,24 @@
 
 namespace connector::controllers {
     PrinterCommandController::PrinterCommandController(kafka::KafkaConfig config,
-                                                       std::shared_ptr<core::DriverInterface> driver,
-                                                       std::shared_ptr<core::CommandExecutorQueue> commandQueue)
-            : config_(std::move(config)), driver_(std::move(driver)), commandQueue_(std::move(commandQueue)),
-              running_(false) {
-        if (!driver_) {
-            throw std::invalid_argument("DriverInterface cannot be null");
-        }
-        if (!commandQueue_) {
-            throw std::invalid_argument("CommandExecutorQueue cannot be null");
+                                                       std::shared_ptr<core::PrinterRegistry> printers)
+            : config_(std::move(config)), printers_(std::move(printers)), running_(false) {
+        if (!printers_ || printers_->empty()) {
+            throw std::invalid_argument("PrinterRegistry cannot be empty");
         }
 
-        Logger::logInfo("[PrinterCommandController] Initializing for driver: " + config_.driverId);
+        Logger::logInfo("[PrinterCommandController] Initializing for " + std::to_string(printers_->size()) +
+                        " printer(s)");
 
         try {
             receiver_ = std::make_shared<events::printer_command::PrinterCommandReceiver>(config_);
             sender_ = std::make_shared<events::printer_command::PrinterCommandSender>(config_);
-            processor_ = std::make_shared<processors::printer_command::PrinterCommandProcessor>(
-                    sender_, commandQueue_, config_.driverId);
+            for (const auto &printer: printers_->all()) {
+                if (!printer->online) continue;
+                processors_.emplace(printer->driverId(),
+                                    std::make_shared<processors::printer_command::PrinterCommandProcessor>(
+                                            sender_, printer->commandQueue, printer->driverId()));
+            }
 
             // FIXED: Simplified message processing - NO SEPARATE THREAD
             receiver_->setMessageCallback([this](const std::string &message, const std::string &key) {
@@ -41,7 +41,7 @@ namespace connector::controllers {
             Logger::logError("[PrinterCommandController] Failed to initialize: " + std::string(e.what()));
             receiver_.reset();
             sender_.reset();
-            processor_.reset();
+            processors_.clear();
         }
     }
 
@@ -56,7 +56,7 @@ namespace connector::controllers {
             return;
         }
 
-        if (!receiver_ || !sender_ || !processor_) {
+        if (!receiver_ || !sender_ || processors_.empty()) {
             Logger::logError("[PrinterCommandController] Cannot start - components not initialized properly");
             return;
         }
@@ -110,7 +110,7 @@ namespace connector::controllers {
 
     // REMOVED: messageProcessingLoop() - No longer needed
 
-    void PrinterCommandController::processMessage(const std::string &message, const std::string &key) {
+    void PrinterCommandController::processMessage(const std::string &message, const std::string &) {
         try {
             nlohmann::json json = nlohmann::json::parse(message);
             Logger::logInfo("[PrinterCommandController] Parsed JSON: " + json.dump());
@@ -129,17 +129,22 @@ namespace connector::controllers {
             Logger::logInfo("  Command: " + request.command);
             Logger::logInfo("  Priority: " + std::to_string(request.priority));
 
-            // Check if request is for this driver
-            if (request.driverId != config_.driverId) {
-                Logger::logInfo("[PrinterCommandController] Request not for this driver (" +
-                                request.driverId + " vs " + config_.driverId + "), ignoring");
+            // Stampante del driverId richiesto, se servita da questo processo
+            auto processor = processors_.find(request.driverId);
+            if (processor == processors_.end()) {
+                Logger::logInfo("[PrinterCommandController] Request not for our printers (" + request.driverId +
+                                "), ignoring");
+                return;
+            }
+            if (!printers_->find(request.driverId)->online) {
+                Logger::logWarning("[PrinterCommandController] Printer " + request.driverId + " offline, ignoring");
                 return;
             }
 
-            Logger::logInfo("[PrinterCommandController] Processing command for our driver");
+            Logger::logInfo("[PrinterCommandController] Processing command for " + request.driverId);
 
-            if (processor_) {
-                processor_->dispatch(request);
+            if (processor->second) {
+                processor->second->dispatch(request);
                 stats_.messagesProcessed++;
                 stats_.messagesSent++;
                 Logger::logInfo("[PrinterCommandController] Command dispatched successfully");
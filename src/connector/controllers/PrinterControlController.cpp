@@ -8,24 +8,35 @@
 #include "connector/models/printer-control/PrinterPauseRequest.hpp"
 #include "logger/Logger.hpp"
 #include <nlohmann/json.hpp>
+#include <chrono>
+#include <stdexcept>
 
 namespace connector::controllers {
     PrinterControlController::PrinterControlController(
         const kafka::KafkaConfig &config,
-        std::shared_ptr<core::DriverInterface> driver,
-        std::shared_ptr<core::CommandExecutorQueue> commandQueue,
-        std::shared_ptr<core::print::PrintJobManager> jobManager)
-        : config_(config), driver_(driver), commandQueue_(commandQueue), jobManager_(jobManager), running_(false) {
-        Logger::logInfo("[PrinterControlController] Initializing for driver: " + config_.driverId);
+        std::shared_ptr<core::PrinterRegistry> printers)
+        : config_(config), printers_(std::move(printers)), running_(false) {
+        if (!printers_ || printers_->empty()) {
+            throw std::invalid_argument("PrinterRegistry cannot be empty");
+        }
+
+        Logger::logInfo("[PrinterControlController] Initializing for " + std::to_string(printers_->size()) +
+                        " printer(s)");
 
         try {
             // Create receivers
             startReceiver_ = std::make_shared<events::printer_control::PrinterStartReceiver>(config_);
             stopReceiver_ = std::make_shared<events::printer_control::PrinterStopReceiver>(config_);
             pauseReceiver_ = std::make_shared<events::printer_control::PrinterPauseReceiver>(config_);
-            // Create processor
-            processor_ = std::make_shared<processors::printer_control::PrinterControlProcessor>(
-                driver_, commandQueue_, jobManager_);
+            // Create processors, each with its own worker
+            for (const auto &printer: printers_->all()) {
+                if (!printer->online) continue;
+                auto worker = std::make_unique<PrinterWorker>();
+                worker->printer = printer;
+                worker->processor = std::make_shared<processors::printer_control::PrinterControlProcessor>(
+                    printer->driver, printer->commandQueue, printer->jobManager, printer->jobScheduler);
+                workers_.emplace(printer->driverId(), std::move(worker));
+            }
 
             // Set callbacks
             startReceiver_->setMessageCallback([this](const std::string &message, const std::string &key) {
@@ -46,6 +57,7 @@ namespace connector::controllers {
 
     PrinterControlController::~PrinterControlController() {
         stop();
+        stopWorkers();
     }
 
     void PrinterControlController::start() {
@@ -54,11 +66,18 @@ namespace connector::controllers {
             return;
         }
 
-        if (!startReceiver_ || !stopReceiver_ || !pauseReceiver_ || !processor_) {
+        if (!startReceiver_ || !stopReceiver_ || !pauseReceiver_ || workers_.empty()) {
             Logger::logError("[PrinterControlController] Cannot start - components not initialized");
             return;
         }
 
+        for (auto &[driverId, worker]: workers_) {
+            std::lock_guard<std::mutex> lock(worker->mutex);
+            if (worker->running) continue;
+            worker->running = true;
+            worker->thread = std::thread(&PrinterControlController::workerLoop, this, std::ref(*worker));
+        }
+
         try {
             Logger::logInfo("[PrinterControlController] Starting receivers...");
             startReceiver_->startReceiving();
@@ -70,6 +89,7 @@ namespace connector::controllers {
         } catch (const std::exception &e) {
             running_ = false;
             Logger::logError("[PrinterControlController] Failed to start: " + std::string(e.what()));
+            stopWorkers();
         }
     }
 
@@ -84,6 +104,8 @@ namespace connector::controllers {
         } catch (const std::exception &e) {
             Logger::logError("[PrinterControlController] Error stopping: " + std::string(e.what()));
         }
+        // Dopo i receiver: le richieste già accodate vengono eseguite
+        stopWorkers();
 
         Logger::logInfo("[PrinterControlController] Stopped");
     }
@@ -99,6 +121,50 @@ namespace connector::controllers {
         return stats_;
     }
 
+    bool PrinterControlController::post(const std::string &driverId, Task task) {
+        auto it = workers_.find(driverId);
+        if (it == workers_.end() || !it->second->printer->online) return false;
+
+        auto &worker = *it->second;
+        {
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            if (!worker.running) return false;
+            worker.tasks.push_back(std::move(task));
+        }
+        worker.cv.notify_one();
+        return true;
+    }
+
+    void PrinterControlController::workerLoop(PrinterWorker &worker) {
+        std::unique_lock<std::mutex> lock(worker.mutex);
+        while (true) {
+            worker.cv.wait(lock, [&worker] { return !worker.running || !worker.tasks.empty(); });
+            if (worker.tasks.empty()) break; // Fermato e coda vuota
+
+            Task task = std::move(worker.tasks.front());
+            worker.tasks.pop_front();
+            lock.unlock();
+            try {
+                task(*worker.processor);
+            } catch (const std::exception &e) {
+                Logger::logError("[PrinterControlController] Request for " + worker.printer->driverId() +
+                                 " failed: " + std::string(e.what()));
+            }
+            lock.lock();
+        }
+    }
+
+    void PrinterControlController::stopWorkers() {
+        for (auto &[driverId, worker]: workers_) {
+            {
+                std::lock_guard<std::mutex> lock(worker->mutex);
+                worker->running = false;
+            }
+            worker->cv.notify_all();
+            if (worker->thread.joinable()) worker->thread.join();
+        }
+    }
+
     void PrinterControlController::onStartMessageReceived(const std::string &message, const std::string &key) {
         stats_.startRequests++;
         Logger::logInfo("[PrinterControlController] Start message received, key: " + key);
@@ -113,12 +179,12 @@ namespace connector::controllers {
                 return;
             }
 
-            if (request.driverId != config_.driverId) {
-                Logger::logInfo("[PrinterControlController] Start request not for this driver");
-                return;
+            bool posted = post(request.driverId, [request](auto &processor) {
+                processor.processPrinterStartRequest(request);
+            });
+            if (!posted) {
+                Logger::logInfo("[PrinterControlController] Start request not for our online printers");
             }
-
-            processor_->processPrinterStartRequest(request);
         } catch (const std::exception &e) {
             stats_.processingErrors++;
             Logger::logError("[PrinterControlController] Start processing failed: " + std::string(e.what()));
@@ -126,6 +192,7 @@ namespace connector::controllers {
     }
 
     void PrinterControlController::onStopMessageReceived(const std::string &message, const std::string &key) {
+        auto receivedAt = std::chrono::steady_clock::now();
         stats_.stopRequests++;
         Logger::logInfo("[PrinterControlController] Stop message received, key: " + key);
 
@@ -133,12 +200,16 @@ namespace connector::controllers {
             nlohmann::json json = nlohmann::json::parse(message);
             models::printer_control::PrinterStopRequest request(json);
 
-            if (!request.isValid() || request.driverId != config_.driverId) {
-                Logger::logInfo("[PrinterControlController] Stop request not for this driver");
+            auto worker = request.isValid() ? workers_.find(request.driverId) : workers_.end();
+            if (worker == workers_.end() || !worker->second->printer->online) {
+                Logger::logInfo("[PrinterControlController] Stop request not for our online printers");
                 return;
             }
 
-            processor_->processPrinterStopRequest(request);
+            // E-stop subito, da questo thread: non attende avvii o ripristini in corso sul worker della stampante
+            if (worker->second->processor->emergencyStop(request, receivedAt)) {
+                post(request.driverId, [request](auto &processor) { processor.cancelAfterStop(request); });
+            }
         } catch (const std::exception &e) {
             stats_.processingErrors++;
             Logger::logError("[PrinterControlController] Stop processing failed: " + std::string(e.what()));
@@ -146,6 +217,7 @@ namespace connector::controllers {
     }
 
     void PrinterControlController::onPauseMessageReceived(const std::string &message, const std::string &key) {
+        auto receivedAt = std::chrono::steady_clock::now();
         stats_.pauseRequests++;
         Logger::logInfo("[PrinterControlController] Pause message received, key: " + key);
 
@@ -153,12 +225,12 @@ namespace connector::controllers {
             nlohmann::json json = nlohmann::json::parse(message);
             models::printer_control::PrinterPauseRequest request(json);
 
-            if (!request.isValid() || request.driverId != config_.driverId) {
-                Logger::logInfo("[PrinterControlController] Pause request not for this driver");
-                return;
+            bool posted = request.isValid() && post(request.driverId, [request, receivedAt](auto &processor) {
+                processor.processPrinterPauseRequest(request, receivedAt);
+            });
+            if (!posted) {
+                Logger::logInfo("[PrinterControlController] Pause request not for our online printers");
             }
-
-            processor_->processPrinterPauseRequest(request);
         } catch (const std::exception &e) {
             stats_.processingErrors++;
             Logger::logError("[PrinterControlController] Pause processing failed: " + std::string(e.what()));
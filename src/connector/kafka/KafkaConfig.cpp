@@ -25,9 +25,9 @@ namespace connector::kafka {
 
             // Log per debug
             if (envValue) {
-                Logger::logInfo("[KafkaConfig] Resolved " + varName + " = " + replacement);
+                DRIVER_LOG_INFO(LogModule::Kafka, "[KafkaConfig] Resolved " + varName + " = " + replacement);
             } else {
-                Logger::logInfo("[KafkaConfig] Using default for " + varName + " = " + replacement);
+                DRIVER_LOG_INFO(LogModule::Kafka, "[KafkaConfig] Using default for " + varName + " = " + replacement);
             }
 
             // Sostituisce il placeholder con il valore risolto
@@ -43,11 +43,12 @@ namespace connector::kafka {
     void KafkaConfig::loadEnvFile(const std::string &envFilePath) {
         std::ifstream envFile(envFilePath);
         if (!envFile.is_open()) {
-            Logger::logInfo("[KafkaConfig] No .env file found at: " + envFilePath + " (using system environment only)");
+            DRIVER_LOG_INFO(LogModule::Kafka,
+                            "[KafkaConfig] No .env file found at: " + envFilePath + " (using system environment only)");
             return;
         }
 
-        Logger::logInfo("[KafkaConfig] Loading .env file: " + envFilePath);
+        DRIVER_LOG_INFO(LogModule::Kafka, "[KafkaConfig] Loading .env file: " + envFilePath);
 
         std::string line;
         int loadedVars = 0;
@@ -87,15 +88,16 @@ namespace connector::kafka {
 #else
                 setenv(key.c_str(), value.c_str(), 0);
 #endif
-                Logger::logInfo("[KafkaConfig] Loaded from .env: " + key + " = " + value);
+                DRIVER_LOG_INFO(LogModule::Kafka, "[KafkaConfig] Loaded from .env: " + key + " = " + value);
                 loadedVars++;
             } else {
-                Logger::logInfo("[KafkaConfig] Skipped (already set): " + key);
+                DRIVER_LOG_INFO(LogModule::Kafka, "[KafkaConfig] Skipped (already set): " + key);
             }
         }
 
         envFile.close();
-        Logger::logInfo("[KafkaConfig] Loaded " + std::to_string(loadedVars) + " variables from .env file");
+        DRIVER_LOG_INFO(LogModule::Kafka,
+                        "[KafkaConfig] Loaded " + std::to_string(loadedVars) + " variables from .env file");
     }
 
     void KafkaConfig::resolveFromEnvironment() {
@@ -118,21 +120,22 @@ namespace connector::kafka {
         location = resolvePlaceholder(location);
         serialPort = resolvePlaceholder(serialPort);
 
-        Logger::logInfo("[KafkaConfig] All placeholders resolved");
+        DRIVER_LOG_INFO(LogModule::Kafka, "[KafkaConfig] All placeholders resolved");
     }
 
     void KafkaConfig::printConfig() const {
-        Logger::logInfo("[KafkaConfig] Final configuration:");
-        Logger::logInfo("  Brokers: " + brokers);
-        Logger::logInfo("  Client ID: " + clientId);
-        Logger::logInfo("  Consumer Group: " + consumerGroupId);
-        Logger::logInfo("  Driver ID: " + driverId);
-        Logger::logInfo("  Location: " + location);
-        Logger::logInfo("  Serial Port: " + serialPort + " @ " + std::to_string(serialBaudrate) + " baud");
-        Logger::logInfo("  SSL Enabled: " + std::string(enableSsl ? "true" : "false"));
+        DRIVER_LOG_INFO(LogModule::Kafka, "[KafkaConfig] Final configuration:");
+        DRIVER_LOG_INFO(LogModule::Kafka, "  Brokers: " + brokers);
+        DRIVER_LOG_INFO(LogModule::Kafka, "  Client ID: " + clientId);
+        DRIVER_LOG_INFO(LogModule::Kafka, "  Consumer Group: " + consumerGroupId);
+        DRIVER_LOG_INFO(LogModule::Kafka, "  Driver ID: " + driverId);
+        DRIVER_LOG_INFO(LogModule::Kafka, "  Location: " + location);
+        DRIVER_LOG_INFO(LogModule::Kafka,
+                        "  Serial Port: " + serialPort + " @ " + std::to_string(serialBaudrate) + " baud");
+        DRIVER_LOG_INFO(LogModule::Kafka, "  SSL Enabled: " + std::string(enableSsl ? "true" : "false"));
 
         if (!saslMechanism.empty()) {
-            Logger::logInfo("  SASL Mechanism: " + saslMechanism);
+            DRIVER_LOG_INFO(LogModule::Kafka, "  SASL Mechanism: " + saslMechanism);
         }
     }
 
@@ -1,12 +1,13 @@
 #include "connector/kafka/KafkaConsumerBase.hpp"
 #include "logger/Logger.hpp"
+#include "logger/TraceLog.hpp"
 #include <stdexcept>
 #include <sstream>
 
 namespace connector::kafka {
     KafkaConsumerBase::KafkaConsumerBase(const KafkaConfig &config, const std::string &topicName)
         : config_(config), topicName_(topicName), consumer_(nullptr), running_(false), receiving_(false) {
-        Logger::logInfo("[KafkaConsumerBase] Initializing consumer for topic: " + topicName);
+        DRIVER_LOG_INFO(LogModule::Kafka, "[KafkaConsumerBase] Initializing consumer for topic: " + topicName);
 
         // Non creare il consumer qui nel costruttore - rimandalo a startReceiving()
         // Questo evita crash durante la costruzione
@@ -23,34 +24,37 @@ namespace connector::kafka {
 
     void KafkaConsumerBase::startReceiving() {
         if (receiving_) {
-            Logger::logWarning("[" + getReceiverName() + "] Already receiving");
+            DRIVER_LOG_WARNING(LogModule::Kafka, "[" + getReceiverName() + "] Already receiving");
             return;
         }
 
         try {
-            Logger::logInfo("[" + getReceiverName() + "] Creating Kafka consumer...");
+            DRIVER_LOG_INFO(LogModule::Kafka, "[" + getReceiverName() + "] Creating Kafka consumer...");
             createConsumer();
-            Logger::logInfo("[" + getReceiverName() + "] Kafka consumer created successfully");
+            DRIVER_LOG_INFO(LogModule::Kafka, "[" + getReceiverName() + "] Kafka consumer created successfully");
 
             running_ = true;
             receiving_ = true;
 
-            Logger::logInfo("[" + getReceiverName() + "] Starting consumer thread...");
+            DRIVER_LOG_INFO(LogModule::Kafka, "[" + getReceiverName() + "] Starting consumer thread...");
             consumerThread_ = std::thread([this]() {
                 try {
                     consumerLoop();
                 } catch (const std::exception &e) {
-                    Logger::logError("[" + getReceiverName() + "] Consumer thread crashed: " + std::string(e.what()));
+                    DRIVER_LOG_ERROR(LogModule::Kafka,
+                                     "[" + getReceiverName() + "] Consumer thread crashed: " + std::string(e.what()));
                 } catch (...) {
-                    Logger::logError("[" + getReceiverName() + "] Consumer thread crashed with unknown exception");
+                    DRIVER_LOG_ERROR(LogModule::Kafka,
+                                     "[" + getReceiverName() + "] Consumer thread crashed with unknown exception");
                 }
             });
 
-            Logger::logInfo("[" + getReceiverName() + "] Started receiving from topic: " + topicName_);
+            DRIVER_LOG_INFO(LogModule::Kafka,
+                            "[" + getReceiverName() + "] Started receiving from topic: " + topicName_);
         } catch (const std::exception &e) {
             receiving_ = false;
             running_ = false;
-            Logger::logError("[" + getReceiverName() + "] Failed to start: " + std::string(e.what()));
+            DRIVER_LOG_ERROR(LogModule::Kafka, "[" + getReceiverName() + "] Failed to start: " + std::string(e.what()));
             destroyConsumer();
             throw;
         }
@@ -61,19 +65,20 @@ namespace connector::kafka {
             return;
         }
 
-        Logger::logInfo("[" + getReceiverName() + "] Stopping consumer...");
+        DRIVER_LOG_INFO(LogModule::Kafka, "[" + getReceiverName() + "] Stopping consumer...");
         running_ = false;
 
         if (consumerThread_.joinable()) {
             try {
                 consumerThread_.join();
             } catch (const std::exception &e) {
-                Logger::logError("[" + getReceiverName() + "] Error joining consumer thread: " + std::string(e.what()));
+                DRIVER_LOG_ERROR(LogModule::Kafka,
+                                 "[" + getReceiverName() + "] Error joining consumer thread: " + std::string(e.what()));
             }
         }
 
         receiving_ = false;
-        Logger::logInfo("[" + getReceiverName() + "] Stopped receiving");
+        DRIVER_LOG_INFO(LogModule::Kafka, "[" + getReceiverName() + "] Stopped receiving");
     }
 
     bool KafkaConsumerBase::isReceiving() const {
@@ -88,7 +93,7 @@ namespace connector::kafka {
         char errstr[512];
         errstr[0] = '\0';
 
-        Logger::logInfo("[" + getReceiverName() + "] Creating librdkafka configuration...");
+        DRIVER_LOG_INFO(LogModule::Kafka, "[" + getReceiverName() + "] Creating librdkafka configuration...");
         rd_kafka_conf_t *conf = rd_kafka_conf_new();
         if (!conf) {
             throw std::runtime_error("Failed to create Kafka configuration object");
@@ -96,26 +101,27 @@ namespace connector::kafka {
 
         try {
             // Basic configuration con controllo errori
-            Logger::logInfo("[" + getReceiverName() + "] Setting brokers: " + config_.brokers);
+            DRIVER_LOG_INFO(LogModule::Kafka, "[" + getReceiverName() + "] Setting brokers: " + config_.brokers);
             if (rd_kafka_conf_set(conf, "bootstrap.servers", config_.brokers.c_str(), errstr, sizeof(errstr)) !=
                 RD_KAFKA_CONF_OK) {
                 throw std::runtime_error("Failed to set bootstrap.servers: " + std::string(errstr));
             }
 
-            Logger::logInfo("[" + getReceiverName() + "] Setting group.id: " + config_.consumerGroupId);
+            DRIVER_LOG_INFO(LogModule::Kafka,
+                            "[" + getReceiverName() + "] Setting group.id: " + config_.consumerGroupId);
             if (rd_kafka_conf_set(conf, "group.id", config_.consumerGroupId.c_str(), errstr, sizeof(errstr)) !=
                 RD_KAFKA_CONF_OK) {
                 throw std::runtime_error("Failed to set group.id: " + std::string(errstr));
             }
 
-            Logger::logInfo("[" + getReceiverName() + "] Setting client.id: " + config_.clientId);
+            DRIVER_LOG_INFO(LogModule::Kafka, "[" + getReceiverName() + "] Setting client.id: " + config_.clientId);
             if (rd_kafka_conf_set(conf, "client.id", config_.clientId.c_str(), errstr, sizeof(errstr)) !=
                 RD_KAFKA_CONF_OK) {
                 throw std::runtime_error("Failed to set client.id: " + std::string(errstr));
             }
 
             // Consumer specific settings
-            Logger::logInfo("[" + getReceiverName() + "] Setting consumer-specific configuration...");
+            DRIVER_LOG_INFO(LogModule::Kafka, "[" + getReceiverName() + "] Setting consumer-specific configuration...");
             rd_kafka_conf_set(conf, "session.timeout.ms", std::to_string(config_.sessionTimeoutMs).c_str(), errstr,
                               sizeof(errstr));
             rd_kafka_conf_set(conf, "enable.auto.commit", config_.autoCommit ? "true" : "false", errstr,
@@ -131,14 +137,14 @@ namespace connector::kafka {
             // Set error callback
             rd_kafka_conf_set_error_cb(conf, errorCallback);
 
-            Logger::logInfo("[" + getReceiverName() + "] Creating Kafka consumer instance...");
+            DRIVER_LOG_INFO(LogModule::Kafka, "[" + getReceiverName() + "] Creating Kafka consumer instance...");
             consumer_ = rd_kafka_new(RD_KAFKA_CONSUMER, conf, errstr, sizeof(errstr));
             if (!consumer_) {
                 rd_kafka_conf_destroy(conf);
                 throw std::runtime_error("Failed to create Kafka consumer: " + std::string(errstr));
             }
 
-            Logger::logInfo("[" + getReceiverName() + "] Subscribing to topic: " + topicName_);
+            DRIVER_LOG_INFO(LogModule::Kafka, "[" + getReceiverName() + "] Subscribing to topic: " + topicName_);
             rd_kafka_topic_partition_list_t *subscription = rd_kafka_topic_partition_list_new(1);
             rd_kafka_topic_partition_list_add(subscription, topicName_.c_str(), RD_KAFKA_PARTITION_UA);
 
@@ -151,7 +157,8 @@ namespace connector::kafka {
                 throw std::runtime_error("Failed to subscribe to topic: " + std::string(rd_kafka_err2str(err)));
             }
 
-            Logger::logInfo("[" + getReceiverName() + "] Consumer created and subscribed successfully");
+            DRIVER_LOG_INFO(LogModule::Kafka,
+                            "[" + getReceiverName() + "] Consumer created and subscribed successfully");
         } catch (const std::exception &e) {
             if (conf) rd_kafka_conf_destroy(conf);
             throw;
@@ -161,20 +168,20 @@ namespace connector::kafka {
     void KafkaConsumerBase::destroyConsumer() {
         if (consumer_) {
             try {
-                Logger::logInfo("[" + getReceiverName() + "] Closing consumer...");
+                DRIVER_LOG_INFO(LogModule::Kafka, "[" + getReceiverName() + "] Closing consumer...");
                 rd_kafka_consumer_close(consumer_);
                 rd_kafka_destroy(consumer_);
                 consumer_ = nullptr;
-                Logger::logInfo("[" + getReceiverName() + "] Consumer destroyed");
+                DRIVER_LOG_INFO(LogModule::Kafka, "[" + getReceiverName() + "] Consumer destroyed");
             } catch (...) {
-                Logger::logError("[" + getReceiverName() + "] Error destroying consumer");
+                DRIVER_LOG_ERROR(LogModule::Kafka, "[" + getReceiverName() + "] Error destroying consumer");
                 consumer_ = nullptr;
             }
         }
     }
 
     void KafkaConsumerBase::consumerLoop() {
-        Logger::logInfo("[" + getReceiverName() + "] Consumer loop started");
+        DRIVER_LOG_INFO(LogModule::Kafka, "[" + getReceiverName() + "] Consumer loop started");
 
         auto lastMessageTime = std::chrono::steady_clock::now();
         const auto maxSilenceTime = std::chrono::minutes(5); // Alert after 5min silence
@@ -187,7 +194,8 @@ namespace connector::kafka {
                     // Check for extended silence
                     auto now = std::chrono::steady_clock::now();
                     if (now - lastMessageTime > maxSilenceTime) {
-                        Logger::logWarning("[" + getReceiverName() + "] No messages for " +
+                        DRIVER_LOG_WARNING(LogModule::Kafka,
+                                           "[" + getReceiverName() + "] No messages for " +
                                            std::to_string(
                                                std::chrono::duration_cast<std::chrono::minutes>(now - lastMessageTime).
                                                count()) + " minutes");
@@ -200,10 +208,10 @@ namespace connector::kafka {
 
                 if (msg->err != RD_KAFKA_RESP_ERR_NO_ERROR) {
                     if (msg->err == RD_KAFKA_RESP_ERR__PARTITION_EOF) {
-                        Logger::logInfo("[" + getReceiverName() + "] Reached end of partition");
+                        DRIVER_LOG_INFO(LogModule::Kafka, "[" + getReceiverName() + "] Reached end of partition");
                     } else {
-                        Logger::logError("[" + getReceiverName() + "] Consumer error: " +
-                                         std::string(rd_kafka_message_errstr(msg)));
+                        DRIVER_LOG_ERROR(LogModule::Kafka, "[" + getReceiverName() + "] Consumer error: " +
+                                                           std::string(rd_kafka_message_errstr(msg)));
                     }
                     rd_kafka_message_destroy(msg);
                     continue;
@@ -213,22 +221,23 @@ namespace connector::kafka {
                 std::string message(static_cast<const char *>(msg->payload), msg->len);
                 std::string key = msg->key ? std::string(static_cast<const char *>(msg->key), msg->key_len) : "";
 
-                Logger::logInfo(
-                    "[" + getReceiverName() + "] Received message, key: " + key + ", size: " + std::to_string(
-                        message.size()));
+                DRIVER_TRACE(TraceEvent::KafkaReceived, TraceInterned{getReceiverName()}, key, message.size());
+                DRIVER_LOG_DEBUG(LogModule::Kafka, "[", getReceiverName(), "] Received message, key: ", key,
+                                 ", size: ", message.size());
 
                 if (messageCallback_) {
                     try {
                         messageCallback_(message, key);
                     } catch (const std::exception &e) {
-                        Logger::logError(
+                        DRIVER_LOG_ERROR(LogModule::Kafka,
                             "[" + getReceiverName() + "] Message processing error: " + std::string(e.what()));
                     }
                 }
 
                 rd_kafka_message_destroy(msg);
             } catch (const std::exception &e) {
-                Logger::logError("[" + getReceiverName() + "] Error in consumer loop: " + std::string(e.what()));
+                DRIVER_LOG_ERROR(LogModule::Kafka,
+                                 "[" + getReceiverName() + "] Error in consumer loop: " + std::string(e.what()));
 
                 // Exponential backoff on errors
                 std::this_thread::sleep_for(std::chrono::milliseconds(1000));
@@ -238,17 +247,17 @@ namespace connector::kafka {
             static int healthCheckCounter = 0;
             if (++healthCheckCounter % 100 == 0) {
                 // Every 100 polls
-                Logger::logInfo("[" + getReceiverName() + "] Health check - still polling");
+                DRIVER_LOG_INFO(LogModule::Kafka, "[" + getReceiverName() + "] Health check - still polling");
             }
         }
 
-        Logger::logInfo("[" + getReceiverName() + "] Consumer loop stopped");
+        DRIVER_LOG_INFO(LogModule::Kafka, "[" + getReceiverName() + "] Consumer loop stopped");
     }
 
     void KafkaConsumerBase::errorCallback(rd_kafka_t *rk, int err, const char *reason, void *opaque) {
         (void) rk;
         (void) opaque;
-        Logger::logError(
+        DRIVER_LOG_ERROR(LogModule::Kafka,
             "[KafkaConsumer] Error: " + std::string(rd_kafka_err2str(static_cast<rd_kafka_resp_err_t>(err))) +
             " - " + reason);
     }
@@ -1,5 +1,6 @@
 #include "connector/kafka/KafkaProducerBase.hpp"
 #include "logger/Logger.hpp"
+#include "logger/TraceLog.hpp"
 #include <stdexcept>
 
 namespace connector::kafka {
@@ -7,12 +8,13 @@ namespace connector::kafka {
     KafkaProducerBase::KafkaProducerBase(const KafkaConfig &config, const std::string &topicName)
             : config_(config), topicName_(topicName), producer_(nullptr), ready_(false) {
 
-        Logger::logInfo("[KafkaProducerBase] Initializing producer for topic: " + topicName);
+        DRIVER_LOG_INFO(LogModule::Kafka, "[KafkaProducerBase] Initializing producer for topic: " + topicName);
 
         try {
             createProducer();
         } catch (const std::exception &e) {
-            Logger::logError("[KafkaProducerBase] Failed to initialize producer: " + std::string(e.what()));
+            DRIVER_LOG_ERROR(LogModule::Kafka,
+                             "[KafkaProducerBase] Failed to initialize producer: " + std::string(e.what()));
             // Non rethrow - lascia il producer in stato non-ready ma non crasha
             ready_ = false;
         }
@@ -28,7 +30,7 @@ namespace connector::kafka {
 
     bool KafkaProducerBase::sendMessage(const std::string &message, const std::string &key) {
         if (!ready_ || !producer_) {
-            Logger::logError("[" + getSenderName() + "] Producer not ready");
+            DRIVER_LOG_ERROR(LogModule::Kafka, "[" + getSenderName() + "] Producer not ready");
             return false;
         }
 
@@ -47,17 +49,21 @@ namespace connector::kafka {
             );
 
             if (result != RD_KAFKA_RESP_ERR_NO_ERROR) {
-                Logger::logError("[" + getSenderName() + "] Failed to produce message: " +
+                DRIVER_LOG_ERROR(LogModule::Kafka,
+                                 "[" + getSenderName() + "] Failed to produce message: " +
                                  std::string(rd_kafka_err2str(static_cast<rd_kafka_resp_err_t>(result))));
                 return false;
             }
 
             rd_kafka_poll(producer_, 0);
-            Logger::logInfo("[" + getSenderName() + "] Message sent to topic: " + topicName_ + ", key: " + key);
+            DRIVER_TRACE(TraceEvent::KafkaSent, TraceInterned{getSenderName()}, TraceInterned{topicName_}, key);
+            DRIVER_LOG_DEBUG(LogModule::Kafka, "[", getSenderName(), "] Message sent to topic: ", topicName_,
+                             ", key: ", key);
             return true;
 
         } catch (const std::exception &e) {
-            Logger::logError("[" + getSenderName() + "] Exception sending message: " + std::string(e.what()));
+            DRIVER_LOG_ERROR(LogModule::Kafka,
+                             "[" + getSenderName() + "] Exception sending message: " + std::string(e.what()));
             return false;
         }
     }
@@ -74,7 +80,7 @@ namespace connector::kafka {
         char errstr[512];
         errstr[0] = '\0';
 
-        Logger::logInfo("[KafkaProducerBase] Creating librdkafka producer configuration...");
+        DRIVER_LOG_INFO(LogModule::Kafka, "[KafkaProducerBase] Creating librdkafka producer configuration...");
         rd_kafka_conf_t *conf = rd_kafka_conf_new();
         if (!conf) {
             throw std::runtime_error("Failed to create Kafka producer configuration object");
@@ -82,20 +88,20 @@ namespace connector::kafka {
 
         try {
             // Basic configuration con controllo errori
-            Logger::logInfo("[KafkaProducerBase] Setting brokers: " + config_.brokers);
+            DRIVER_LOG_INFO(LogModule::Kafka, "[KafkaProducerBase] Setting brokers: " + config_.brokers);
             if (rd_kafka_conf_set(conf, "bootstrap.servers", config_.brokers.c_str(), errstr, sizeof(errstr)) !=
                 RD_KAFKA_CONF_OK) {
                 throw std::runtime_error("Failed to set bootstrap.servers: " + std::string(errstr));
             }
 
-            Logger::logInfo("[KafkaProducerBase] Setting client.id: " + config_.clientId);
+            DRIVER_LOG_INFO(LogModule::Kafka, "[KafkaProducerBase] Setting client.id: " + config_.clientId);
             if (rd_kafka_conf_set(conf, "client.id", config_.clientId.c_str(), errstr, sizeof(errstr)) !=
                 RD_KAFKA_CONF_OK) {
                 throw std::runtime_error("Failed to set client.id: " + std::string(errstr));
             }
 
             // Producer specific settings
-            Logger::logInfo("[KafkaProducerBase] Setting producer-specific configuration...");
+            DRIVER_LOG_INFO(LogModule::Kafka, "[KafkaProducerBase] Setting producer-specific configuration...");
             rd_kafka_conf_set(conf, "delivery.timeout.ms", std::to_string(config_.deliveryTimeoutMs).c_str(), errstr,
                               sizeof(errstr));
             rd_kafka_conf_set(conf, "request.timeout.ms", std::to_string(config_.requestTimeoutMs).c_str(), errstr,
@@ -112,7 +118,7 @@ namespace connector::kafka {
             rd_kafka_conf_set_dr_msg_cb(conf, deliveryReportCallback);
             rd_kafka_conf_set_error_cb(conf, errorCallback);
 
-            Logger::logInfo("[KafkaProducerBase] Creating Kafka producer instance...");
+            DRIVER_LOG_INFO(LogModule::Kafka, "[KafkaProducerBase] Creating Kafka producer instance...");
             producer_ = rd_kafka_new(RD_KAFKA_PRODUCER, conf, errstr, sizeof(errstr));
             if (!producer_) {
                 rd_kafka_conf_destroy(conf);
@@ -120,7 +126,7 @@ namespace connector::kafka {
             }
 
             ready_ = true;
-            Logger::logInfo("[KafkaProducerBase] Producer created and ready");
+            DRIVER_LOG_INFO(LogModule::Kafka, "[KafkaProducerBase] Producer created and ready");
 
         } catch (const std::exception &e) {
             if (conf) rd_kafka_conf_destroy(conf);
@@ -133,14 +139,14 @@ namespace connector::kafka {
         if (producer_) {
             try {
                 ready_ = false;
-                Logger::logInfo("[KafkaProducerBase] Flushing producer...");
+                DRIVER_LOG_INFO(LogModule::Kafka, "[KafkaProducerBase] Flushing producer...");
                 rd_kafka_flush(producer_, 5000); // 5 second timeout
-                Logger::logInfo("[KafkaProducerBase] Destroying producer...");
+                DRIVER_LOG_INFO(LogModule::Kafka, "[KafkaProducerBase] Destroying producer...");
                 rd_kafka_destroy(producer_);
                 producer_ = nullptr;
-                Logger::logInfo("[KafkaProducerBase] Producer destroyed");
+                DRIVER_LOG_INFO(LogModule::Kafka, "[KafkaProducerBase] Producer destroyed");
             } catch (...) {
-                Logger::logError("[KafkaProducerBase] Error destroying producer");
+                DRIVER_LOG_ERROR(LogModule::Kafka, "[KafkaProducerBase] Error destroying producer");
                 producer_ = nullptr;
                 ready_ = false;
             }
@@ -152,16 +158,17 @@ namespace connector::kafka {
         (void) opaque;
 
         if (rkmessage->err != RD_KAFKA_RESP_ERR_NO_ERROR) {
-            Logger::logError("[KafkaProducer] Delivery failed: " + std::string(rd_kafka_err2str(rkmessage->err)));
+            DRIVER_LOG_ERROR(LogModule::Kafka,
+                             "[KafkaProducer] Delivery failed: " + std::string(rd_kafka_err2str(rkmessage->err)));
         } else {
-            Logger::logInfo("[KafkaProducer] Message delivered successfully");
+            DRIVER_LOG_DEBUG(LogModule::Kafka, "[KafkaProducer] Message delivered successfully");
         }
     }
 
     void KafkaProducerBase::errorCallback(rd_kafka_t *rk, int err, const char *reason, void *opaque) {
         (void) rk;
         (void) opaque;
-        Logger::logError(
+        DRIVER_LOG_ERROR(LogModule::Kafka,
                 "[KafkaProducer] Error: " + std::string(rd_kafka_err2str(static_cast<rd_kafka_resp_err_t>(err))) +
                 " - " + reason);
     }
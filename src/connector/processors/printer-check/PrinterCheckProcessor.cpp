@@ -2,7 +2,6 @@
 #include "logger/Logger.hpp"
 #include <nlohmann/json.hpp>
 #include <future>
-#include <regex>
 #include <sstream>
 
 #include "application/config/ConfigManager.hpp"
@@ -29,94 +28,139 @@ namespace connector::processors::printer_check {
             response.driverId = driverId_;
             response.jobStatusCode = getJobStatusCode(request.jobId);
             response.printerStatusCode = getPrinterStatusCode();
+            // Un solo snapshot: E, feed, layer, ventola e temperature in cache sono dello stesso istante
+            auto state = driver_->stateTracker().snapshot();
+            response.telemetrySource = state.autoReportIntervalMs > 0
+                                           ? "AUTO_REPORT"
+                                           : "POLLED";
 
-            // Parallel data collection with timeout
             auto config = core::config::ConfigManager::getInstance().getPrinterCheckConfig();
-
-            std::vector<std::future<void> > futures;
-            futures.emplace_back(std::async(std::launch::async, [this, &response]() {
-                collectPositionDataAsync(response);
-            }));
-            futures.emplace_back(std::async(std::launch::async, [this, &response]() {
-                collectTemperatureDataAsync(response);
-            }));
-            futures.emplace_back(std::async(std::launch::async, [this, &response]() {
-                collectFanDataAsync(response);
-            }));
-            futures.emplace_back(std::async(std::launch::async, [this, &response, &request]() {
-                collectJobStatusDataAsync(response, request.jobId);
-            }));
-            futures.emplace_back(std::async(std::launch::async, [this, &response]() {
-                collectDiagnosticDataAsync(response);
-            }));
-
-            // Wait for all with timeout
-            bool allComplete = true;
-            for (auto &future: futures) {
-                try {
-                    if (future.wait_for(std::chrono::milliseconds(config.timeoutMs)) == std::future_status::ready) {
-                        future.get(); // Cattura eccezioni dal thread
-                    }
-                } catch (const std::exception &e) {
-                    Logger::logError("[PrinterCheckProcessor] Async task failed: " + std::string(e.what()));
-                    allComplete = false;
-                }
-            }
-
-            if (allComplete) {
-                sendResponse(response);
-                auto duration = std::chrono::steady_clock::now() - start;
-                auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
-                Logger::logInfo(
-                    "[PrinterCheckProcessor] Check completed in " + std::to_string(ms) + "ms for job: " + request.
-                    jobId);
-            } else {
-                sendErrorResponse(request.jobId, "TIMEOUT_COLLECTING_DATA");
-            }
+            auto deadline = start + std::chrono::milliseconds(config.timeoutMs);
+
+            // Le query al firmware partono subito sul worker asincrono del DriverInterface; mentre il link
+            // le serve si raccolgono i dati in memoria, senza un thread parcheggiato per ogni richiesta
+            FirmwareQueries queries = submitFirmwareQueries(state);
+
+            collectFanData(response, state);
+            collectJobStatusData(response, request.jobId, state);
+            collectPositionData(response, queries, deadline, state);
+            collectTemperatureData(response, queries, deadline, state);
+            collectDiagnosticData(response, queries, deadline, state);
+
+            sendResponse(response);
+            auto duration = std::chrono::steady_clock::now() - start;
+            auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+            Logger::logInfo(
+                "[PrinterCheckProcessor] Check completed in " + std::to_string(ms) + "ms for job: " + request.
+                jobId);
         } catch (const std::exception &e) {
             Logger::logError("[PrinterCheckProcessor] Processing error: " + std::string(e.what()));
             sendErrorResponse(request.jobId, "PROCESSING_EXCEPTION: " + std::string(e.what()));
         }
     }
 
-    void PrinterCheckProcessor::collectPositionDataAsync(
-        connector::models::printer_check::PrinterCheckResponse &response) const {
+    PrinterCheckProcessor::FirmwareQueries PrinterCheckProcessor::submitFirmwareQueries(
+        const core::state::StateSnapshot &state) const {
+        FirmwareQueries queries;
+
+        // Con l'auto-report attivo posizione, temperature ed endstop arrivano dal firmware: nessuna query sul link
+        queries.autoReportIntervalMs = state.autoReportIntervalMs;
+        if (queries.autoReportIntervalMs <= 0) {
+            queries.position = driver_->motion()->getPositionAsync();
+            if (!state.isHotendTempFresh(3000)) {
+                queries.hotendTemp = driver_->temperature()->getHotendTemperatureAsync();
+            }
+            if (!state.isBedTempFresh(3000)) {
+                queries.bedTemp = driver_->temperature()->getBedTemperatureAsync();
+            }
+        }
+        // Firmware con auto-report senza il campo ES: endstop ancora interrogati
+        if (queries.autoReportIntervalMs <= 0 || state.endstopAgeMs() < 0) {
+            queries.endstops = driver_->endstop()->readEndstopStatusAsync();
+        }
+        return queries;
+    }
+
+    void PrinterCheckProcessor::collectPositionData(
+        connector::models::printer_check::PrinterCheckResponse &response, FirmwareQueries &queries,
+        std::chrono::steady_clock::time_point deadline, const core::state::StateSnapshot &state) const {
         try {
-            auto &stateTracker = core::state::StateTracker::getInstance();
-            auto position = driver_->motion()->getPosition();
+            if (queries.autoReportIntervalMs > 0) {
+                auto cached = state.cachedPosition();
+                if (cached.has_value()) {
+                    response.xPosition = formatDouble(cached->x);
+                    response.yPosition = formatDouble(cached->y);
+                    response.zPosition = formatDouble(cached->z);
+                } else {
+                    response.xPosition = response.yPosition = response.zPosition = "NO_DATA";
+                }
+                response.ePosition = formatDouble(state.ePosition);
+                response.positionAgeMs = std::to_string(state.positionAgeMs());
+                return;
+            }
+
+            if (queries.position.wait_until(deadline) != std::future_status::ready) {
+                Logger::logWarning("[PrinterCheckProcessor] Position query timed out");
+                response.xPosition = response.yPosition = response.zPosition = "TIMEOUT";
+                response.ePosition = formatDouble(state.ePosition);
+                response.positionAgeMs = std::to_string(state.positionAgeMs());
+                return;
+            }
 
+            auto position = queries.position.get();
             if (position.has_value()) {
                 response.xPosition = formatDouble(position->x);
                 response.yPosition = formatDouble(position->y);
                 response.zPosition = formatDouble(position->z);
-                response.ePosition = formatDouble(stateTracker.getCurrentEPosition());
+                response.ePosition = formatDouble(state.ePosition);
             } else {
                 Logger::logWarning("[PrinterCheckProcessor] Position query failed");
                 response.xPosition = response.yPosition = response.zPosition = "QUERY_FAILED";
-                response.ePosition = formatDouble(stateTracker.getCurrentEPosition()); // Use cached E
+                response.ePosition = formatDouble(state.ePosition); // Use cached E
             }
+            // La query appena conclusa ha aggiornato la posizione: età letta dallo stato corrente
+            response.positionAgeMs = std::to_string(driver_->stateTracker().getPositionAgeMs());
         } catch (const std::exception &e) {
             Logger::logError("[PrinterCheckProcessor] Position collection failed: " + std::string(e.what()));
             response.xPosition = response.yPosition = response.zPosition = response.ePosition = "ERROR";
         }
     }
 
-    void PrinterCheckProcessor::collectTemperatureDataAsync(
-        connector::models::printer_check::PrinterCheckResponse &response) const {
+    void PrinterCheckProcessor::collectTemperatureData(
+        connector::models::printer_check::PrinterCheckResponse &response, FirmwareQueries &queries,
+        std::chrono::steady_clock::time_point deadline, const core::state::StateSnapshot &state) const {
         try {
-            auto &stateTracker = core::state::StateTracker::getInstance();
+            int reportInterval = queries.autoReportIntervalMs;
+            if (reportInterval > 0) {
+                // Servito solo dallo stato: un report perso è tollerato, oltre è STALE
+                int64_t hotendAge = state.hotendTempAgeMs();
+                int64_t bedAge = state.bedTempAgeMs();
+
+                if (hotendAge < 0) {
+                    response.extruderTemp = "NO_DATA";
+                    response.extruderStatus = "NO_DATA";
+                } else {
+                    response.extruderTemp = formatDouble(state.hotendActualTemp);
+                    response.extruderStatus = hotendAge <= 2 * reportInterval ? "LIVE" : "STALE";
+                }
+                response.bedTemp = bedAge < 0 ? "NO_DATA" : formatDouble(state.bedActualTemp);
+                response.temperatureAgeMs = std::to_string(std::max(hotendAge, bedAge));
+                return;
+            }
 
             // Hotend temperature
-            if (stateTracker.isHotendTempFresh(3000)) {
-                response.extruderTemp = formatDouble(stateTracker.getCachedHotendTemp());
+            if (!queries.hotendTemp.valid()) {
+                response.extruderTemp = formatDouble(state.hotendActualTemp);
                 response.extruderStatus = "CACHED";
+            } else if (queries.hotendTemp.wait_until(deadline) != std::future_status::ready) {
+                response.extruderTemp = "TIMEOUT";
+                response.extruderStatus = "TIMEOUT";
             } else {
-                auto result = driver_->temperature()->getHotendTemperature();
-                if (result.isSuccess() && !result.body.empty()) {
-                    double temp = parseTemperatureFromResponse(result.body[0]);
-                    if (temp > 0) {
-                        stateTracker.updateHotendActualTemp(temp);
-                        response.extruderTemp = formatDouble(temp);
+                // Lo StateTracker è già aggiornato dalla decodifica in TemperatureCommands
+                auto result = queries.hotendTemp.get();
+                if (result.isSuccess()) {
+                    if (result.decoded.temperature) {
+                        response.extruderTemp = formatDouble(result.decoded.temperature->actual);
                         response.extruderStatus = "LIVE";
                     } else {
                         response.extruderTemp = "PARSE_FAILED";
@@ -129,15 +173,15 @@ namespace connector::processors::printer_check {
             }
 
             // Bed temperature
-            if (stateTracker.isBedTempFresh(3000)) {
-                response.bedTemp = formatDouble(stateTracker.getCachedBedTemp());
+            if (!queries.bedTemp.valid()) {
+                response.bedTemp = formatDouble(state.bedActualTemp);
+            } else if (queries.bedTemp.wait_until(deadline) != std::future_status::ready) {
+                response.bedTemp = "TIMEOUT";
             } else {
-                auto result = driver_->temperature()->getBedTemperature();
-                if (result.isSuccess() && !result.body.empty()) {
-                    double temp = parseTemperatureFromResponse(result.body[0]);
-                    if (temp > 0) {
-                        stateTracker.updateBedActualTemp(temp);
-                        response.bedTemp = formatDouble(temp);
+                auto result = queries.bedTemp.get();
+                if (result.isSuccess()) {
+                    if (result.decoded.temperature) {
+                        response.bedTemp = formatDouble(result.decoded.temperature->actual);
                     } else {
                         response.bedTemp = "PARSE_FAILED";
                     }
@@ -145,6 +189,9 @@ namespace connector::processors::printer_check {
                     response.bedTemp = "COMM_ERROR";
                 }
             }
+            // Le query appena concluse hanno aggiornato le temperature: età lette dallo stato corrente
+            auto current = driver_->stateTracker().snapshot();
+            response.temperatureAgeMs = std::to_string(std::max(current.hotendTempAgeMs(), current.bedTempAgeMs()));
         } catch (const std::exception &e) {
             Logger::logError("[PrinterCheckProcessor] Temperature collection failed: " + std::string(e.what()));
             response.extruderTemp = response.bedTemp = "ERROR";
@@ -152,26 +199,26 @@ namespace connector::processors::printer_check {
         }
     }
 
-    void PrinterCheckProcessor::collectFanDataAsync(
-        connector::models::printer_check::PrinterCheckResponse &response) {
+    void PrinterCheckProcessor::collectFanData(
+        connector::models::printer_check::PrinterCheckResponse &response, const core::state::StateSnapshot &state) {
         try {
-            auto &stateTracker = core::state::StateTracker::getInstance();
-            int fanSpeed = stateTracker.getCurrentFanSpeed();
+            int fanSpeed = state.fanSpeed;
 
             response.fanSpeed = std::to_string(fanSpeed);
             response.fanStatus = (fanSpeed > 0) ? "RUNNING" : "STOPPED";
+            response.fanAgeMs = std::to_string(state.fanAgeMs());
         } catch (const std::exception &e) {
             Logger::logError("[PrinterCheckProcessor] Fan collection failed: " + std::string(e.what()));
             response.fanStatus = response.fanSpeed = "ERROR";
         }
     }
 
-    void PrinterCheckProcessor::collectJobStatusDataAsync(
-        connector::models::printer_check::PrinterCheckResponse &response, const std::string &jobId) {
+    void PrinterCheckProcessor::collectJobStatusData(
+        connector::models::printer_check::PrinterCheckResponse &response, const std::string &jobId,
+        const core::state::StateSnapshot &state) {
         try {
             auto &config = core::config::ConfigManager::getInstance();
             auto &jobTracker = core::jobs::JobTracker::getInstance();
-            auto &stateTracker = core::state::StateTracker::getInstance();
 
             auto jobInfo = jobTracker.getJobInfo(jobId);
             if (jobInfo.has_value()) {
@@ -192,9 +239,9 @@ namespace connector::processors::printer_check {
             }
 
             // Real-time state data
-            response.feed = formatDouble(stateTracker.getCurrentFeedRate());
-            response.layer = std::to_string(stateTracker.getCurrentLayer());
-            response.layerHeight = formatDouble(stateTracker.getCurrentLayerHeight());
+            response.feed = formatDouble(state.feedRate);
+            response.layer = std::to_string(state.currentLayer);
+            response.layerHeight = formatDouble(state.layerHeight);
 
             // Apply config defaults only for zero/invalid values
             if (response.feed == "0" || response.feed == "0.000") {
@@ -210,26 +257,37 @@ namespace connector::processors::printer_check {
         }
     }
 
-    void PrinterCheckProcessor::collectDiagnosticDataAsync(
-        connector::models::printer_check::PrinterCheckResponse &response) const {
+    void PrinterCheckProcessor::collectDiagnosticData(
+        connector::models::printer_check::PrinterCheckResponse &response, FirmwareQueries &queries,
+        std::chrono::steady_clock::time_point deadline, const core::state::StateSnapshot &state) const {
         try {
             std::ostringstream exceptions;
             std::ostringstream logs;
 
             // Check driver state
-            auto state = driver_->getState();
-            if (state == core::PrintState::Error) {
+            if (driver_->getState() == core::PrintState::Error) {
                 exceptions << "DRIVER_ERROR;";
             }
 
             // Quick endstop check with timeout
             try {
-                auto endstopResult = driver_->endstop()->readEndstopStatus();
-                if (endstopResult.isSuccess()) {
+                if (!queries.endstops.valid()) {
+                    // Dall'auto-report: un report perso è tollerato, oltre è STALE
+                    if (state.endstops.anyTriggered()) {
+                        exceptions << "ENDSTOP_TRIGGERED;";
+                    }
+                    if (state.endstopAgeMs() > 2 * queries.autoReportIntervalMs) {
+                        exceptions << "ENDSTOP_STALE;";
+                    }
+                    logs << "ENDSTOP:X=" << state.endstops.x << " Y=" << state.endstops.y
+                            << " Z=" << state.endstops.z << ";";
+                } else if (queries.endstops.wait_until(deadline) != std::future_status::ready) {
+                    exceptions << "ENDSTOP_TIMEOUT;";
+                } else if (auto endstopResult = queries.endstops.get(); endstopResult.isSuccess()) {
+                    if (endstopResult.decoded.endstops && endstopResult.decoded.endstops->anyTriggered()) {
+                        exceptions << "ENDSTOP_TRIGGERED;";
+                    }
                     for (const auto &line: endstopResult.body) {
-                        if (line.find("TRIGGERED") != std::string::npos) {
-                            exceptions << "ENDSTOP_TRIGGERED;";
-                        }
                         logs << "ENDSTOP:" << line << ";";
                     }
                 } else {
@@ -265,56 +323,6 @@ namespace connector::processors::printer_check {
         }
     }
 
-    double PrinterCheckProcessor::parseTemperatureFromResponse(const std::string &response) {
-        // More robust temperature parsing
-        std::vector<std::regex> patterns = {
-            std::regex(R"(T:(\d+(?:\.\d+)?))"), // T:25.5
-            std::regex(R"(TEMP:(\d+(?:\.\d+)?))"), // TEMP:25.5
-            std::regex(R"((\d+(?:\.\d+)?)°?C?)"), // 25.5°C or 25.5
-        };
-
-        for (const auto &pattern: patterns) {
-            std::smatch match;
-            if (std::regex_search(response, match, pattern)) {
-                try {
-                    return std::stod(match[1].str());
-                } catch (...) {
-                    continue;
-                }
-            }
-        }
-
-        Logger::logWarning("[PrinterCheckProcessor] Failed to parse temperature from: " + response);
-        return 0.0;
-    }
-
-    std::string PrinterCheckProcessor::parseFanFromResponse(const std::string &response) {
-        // Parse fan speed from response using multiple patterns
-        std::vector<std::regex> patterns = {
-            std::regex(R"(S:(\d+))"), // S:255
-            std::regex(R"(FAN:(\d+))"), // FAN:128
-            std::regex(R"(SPEED:(\d+))"), // SPEED:50
-            std::regex(R"((\d+)%)"), // 50%
-        };
-
-        for (const auto &pattern: patterns) {
-            std::smatch match;
-            if (std::regex_search(response, match, pattern)) {
-                try {
-                    int value = std::stoi(match[1].str());
-                    // Normalize to 0-100 range if needed
-                    if (value > 255) value = 255;
-                    return std::to_string(value);
-                } catch (...) {
-                    continue;
-                }
-            }
-        }
-
-        Logger::logWarning("[PrinterCheckProcessor] Failed to parse fan speed from: " + response);
-        return "UNKNOWN";
-    }
-
     std::string PrinterCheckProcessor::formatDouble(double value) {
         // Remove trailing zeros and format consistently
         if (std::abs(value - std::round(value)) < 1e-6) {
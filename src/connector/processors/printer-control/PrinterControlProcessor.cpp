@@ -5,6 +5,7 @@
 #include "connector/processors/printer-control/PrinterControlProcessor.hpp"
 #include "logger/Logger.hpp"
 #include "core/printer/job/tracking/JobTracker.hpp"
+#include <atomic>
 #include <chrono>
 #include <sstream>
 #include <iomanip>
@@ -13,15 +14,44 @@ namespace connector::processors::printer_control {
     PrinterControlProcessor::PrinterControlProcessor(
         std::shared_ptr<core::DriverInterface> driver,
         std::shared_ptr<core::CommandExecutorQueue> commandQueue,
-        std::shared_ptr<core::print::PrintJobManager> jobManager)
-        : driver_(driver), commandQueue_(commandQueue), jobManager_(jobManager) {
+        std::shared_ptr<core::print::PrintJobManager> jobManager,
+        std::shared_ptr<core::print::PrintJobScheduler> jobScheduler)
+        : driver_(driver), commandQueue_(commandQueue), jobManager_(jobManager), jobScheduler_(jobScheduler) {
     }
 
     void PrinterControlProcessor::processPrinterStartRequest(
         const models::printer_control::PrinterStartRequest &request) {
         Logger::logInfo("[PrinterControlProcessor] Processing start request for driver: " + request.driverId);
         try {
-            std::string jobId = generateJobId(request.driverId);
+            if (request.resume) {
+                // Il job interrotto mantiene il proprio jobId
+                if (jobManager_->resumeFromCheckpoint(request.axesReferenced)) {
+                    Logger::logInfo("[PrinterControlProcessor] Interrupted print job resumed");
+                } else {
+                    Logger::logError("[PrinterControlProcessor] Failed to resume interrupted print job");
+                }
+                return;
+            }
+            if (request.releaseQueue && jobScheduler_) {
+                jobScheduler_->release();
+                if (request.gcodeUrl.empty() && request.startGCode.empty()) return;
+            }
+            std::string jobId = request.jobId.empty() ? generateJobId(request.driverId) : request.jobId;
+            // Job da URL: in coda, G-code di inizio e fine eseguiti attorno al file quando il job parte
+            if (!request.gcodeUrl.empty() && jobScheduler_) {
+                core::print::ScheduledJob job;
+                job.jobId = jobId;
+                job.gcodeUrl = request.gcodeUrl;
+                job.startGCode = request.startGCode;
+                job.endGCode = request.endGCode;
+                job.priority = request.priority;
+                if (jobScheduler_->submit(job)) {
+                    Logger::logInfo("[PrinterControlProcessor] Print job queued: " + jobId);
+                } else {
+                    Logger::logError("[PrinterControlProcessor] Failed to queue print job: " + jobId);
+                }
+                return;
+            }
             // Execute pre-print G-code if provided
             if (!request.startGCode.empty()) {
                 Logger::logInfo("[PrinterControlProcessor] Executing start G-code");
@@ -50,30 +80,61 @@ namespace connector::processors::printer_control {
     }
 
     void PrinterControlProcessor::processPrinterStopRequest(
-        const models::printer_control::PrinterStopRequest &request) const {
+        const models::printer_control::PrinterStopRequest &request,
+        std::chrono::steady_clock::time_point receivedAt) const {
+        if (emergencyStop(request, receivedAt)) {
+            cancelAfterStop(request);
+        }
+    }
+
+    bool PrinterControlProcessor::emergencyStop(const models::printer_control::PrinterStopRequest &request,
+                                                std::chrono::steady_clock::time_point receivedAt) const {
         Logger::logInfo("[PrinterControlProcessor] Processing stop request for driver: " + request.driverId);
         try {
-            // Cancel current job
-            if (!jobManager_->cancelJob()) {
-                Logger::logWarning("[PrinterControlProcessor] No active job to cancel");
+            // Job ancora in coda: basta toglierlo, la stampa corrente continua
+            if (!request.jobId.empty() && jobScheduler_ && jobScheduler_->remove(request.jobId)) {
+                Logger::logInfo("[PrinterControlProcessor] Queued print job removed: " + request.jobId);
+                return false;
             }
-            // Emergency stop
-            auto result = driver_->motion()->emergencyStop();
+            // Nessun job della coda parte dopo lo stop, nemmeno se la stampante era già libera
+            if (jobScheduler_) jobScheduler_->hold();
+            // Emergency stop first: the urgent lane does not wait for the command in flight
+            auto result = driver_->motion()->emergencyStop(receivedAt);
             if (result.isSuccess()) {
                 Logger::logInfo("[PrinterControlProcessor] Emergency stop executed successfully");
             } else {
                 Logger::logError("[PrinterControlProcessor] Emergency stop failed: " + result.message);
             }
+        } catch (const std::exception &e) {
+            Logger::logError("[PrinterControlProcessor] Emergency stop failed: " + std::string(e.what()));
+        }
+        return true;
+    }
+
+    void PrinterControlProcessor::cancelAfterStop(const models::printer_control::PrinterStopRequest &request) const {
+        try {
+            // Di nuovo: una richiesta di avvio accodata prima dello stop può aver appena rilasciato la coda
+            if (jobScheduler_) jobScheduler_->hold();
+            Logger::logInfo("[PrinterControlProcessor] Cancelling current job for driver: " + request.driverId);
+            // Cancel current job
+            if (!jobManager_->cancelJob()) {
+                Logger::logWarning("[PrinterControlProcessor] No active job to cancel");
+            }
+            if (jobScheduler_) {
+                Logger::logInfo("[PrinterControlProcessor] Job queue held with " +
+                                std::to_string(jobScheduler_->pendingJobs().size()) + " pending jobs");
+            }
         } catch (const std::exception &e) {
             Logger::logError("[PrinterControlProcessor] Stop request failed: " + std::string(e.what()));
         }
     }
 
     void PrinterControlProcessor::processPrinterPauseRequest(
-        const models::printer_control::PrinterPauseRequest &request) const {
+        const models::printer_control::PrinterPauseRequest &request,
+        std::chrono::steady_clock::time_point receivedAt) const {
         Logger::logInfo("[PrinterControlProcessor] Processing pause request for driver: " + request.driverId);
         try {
-            if (!jobManager_->pauseJob()) {
+            if (!jobManager_->pauseJob(receivedAt)) {
                 Logger::logWarning("[PrinterControlProcessor] No active job to pause or job already paused");
             } else {
                 Logger::logInfo("[PrinterControlProcessor] Job paused successfully");
@@ -103,11 +164,15 @@ namespace connector::processors::printer_control {
     }
 
     std::string PrinterControlProcessor::generateJobId(const std::string &driverId) {
+        // Contatore di processo: due richieste nello stesso millisecondo hanno comunque id diversi
+        static std::atomic<uint64_t> sequence{0};
         auto now = std::chrono::system_clock::now();
         auto time_t = std::chrono::system_clock::to_time_t(now);
+        auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count() % 1000;
 
         std::ostringstream oss;
-        oss << driverId << "_job_" << std::put_time(std::gmtime(&time_t), "%Y%m%d_%H%M%S");
+        oss << driverId << "_job_" << std::put_time(std::gmtime(&time_t), "%Y%m%d_%H%M%S") << '_'
+            << std::setw(3) << std::setfill('0') << millis << '_' << ++sequence;
         return oss.str();
     }
 }
@@ -3,8 +3,6 @@
 //
 
 #include "core/CommandBuilder.hpp"
-#include <sstream>
-#include <iomanip>
 
 namespace core {
 
@@ -12,31 +10,45 @@ namespace core {
  * @brief Costruisce una stringa comando completa da numero, categoria, codice e parametri.
  */
     std::string
-    CommandBuilder::buildCommand(uint16_t number, char category, int code, const std::vector<std::string> &params) {
-        std::ostringstream oss;
-
-        oss << "N" << number << " " << category << code;
+    CommandBuilder::buildCommand(uint32_t number, char category, int code, const std::vector<std::string> &params) {
+        // "N<numero> <cat><codice>" e " *<cs>" stanno sempre in 32 byte
+        size_t required = 32;
         for (const auto &param: params) {
-            oss << " " << param;
+            required += param.size() + 1;
         }
 
-        std::string rawCommand = oss.str();
-        uint8_t checksum = computeChecksum(rawCommand);
+        char stackBuffer[utils::MAX_WIRE_COMMAND_SIZE];
+        std::vector<char> heapBuffer;
+        char *buffer = stackBuffer;
+        size_t capacity = sizeof(stackBuffer);
+        if (required > capacity) {
+            heapBuffer.resize(required);
+            buffer = heapBuffer.data();
+            capacity = required;
+        }
 
-        oss << " *" << static_cast<int>(checksum);
+        utils::WireEncoder encoder(buffer, capacity);
+        encoder.begin(number, category, code);
+        for (const auto &param: params) {
+            encoder.param(std::string_view(param));
+        }
 
-        return oss.str();
+        return std::string(encoder.finish());
     }
 
 /**
- * @brief Calcola il checksum XOR dei caratteri di una stringa.
+ * @brief Scrive un comando con parametri numerici direttamente nel buffer, checksum calcolato in scrittura.
  */
-    uint8_t CommandBuilder::computeChecksum(const std::string &data) {
-        uint8_t checksum = 0;
-        for (char c: data) {
-            checksum ^= static_cast<uint8_t>(c);
+    size_t CommandBuilder::buildCommand(char *buffer, size_t capacity, uint32_t number, char category, int code,
+                                        std::initializer_list<utils::WireParam> params) {
+        utils::WireEncoder encoder(buffer, capacity);
+
+        encoder.begin(number, category, code);
+        for (const auto &param: params) {
+            encoder.param(param);
         }
-        return checksum;
+
+        return encoder.finish().size();
     }
 
 } // namespace core
@@ -4,6 +4,7 @@
 
 #include "core/CommandContext.hpp"
 #include "logger/Logger.hpp"
+#include "logger/TraceLog.hpp"
 #include <algorithm>
 
 namespace core {
@@ -28,29 +29,34 @@ namespace core {
         }
 
         history_[number] = commandText;
-        Logger::logInfo("[CommandContext] Stored command N" + std::to_string(number) +
-                        " (history size: " + std::to_string(history_.size()) + ")");
+        DRIVER_TRACE(TraceEvent::CommandStored, number, history_.size());
+        DRIVER_LOG_DEBUG(LogModule::Serial, "[CommandContext] Stored command N", number,
+                         " (history size: ", history_.size(), ")");
     }
 
     bool CommandContext::removeCommand(uint32_t number) {
         size_t removed = history_.erase(number);
         if (removed > 0) {
-            Logger::logInfo("[CommandContext] Removed command N" + std::to_string(number) +
-                            " from history (history size: " + std::to_string(history_.size()) + ")");
+            DRIVER_TRACE(TraceEvent::CommandRemoved, number, history_.size());
+            DRIVER_LOG_DEBUG(LogModule::Serial, "[CommandContext] Removed command N", number,
+                             " from history (history size: ", history_.size(), ")");
             return true;
         }
 
-        Logger::logWarning("[CommandContext] No command found with N" + std::to_string(number) + "signature");
+        DRIVER_LOG_WARNING(LogModule::Serial,
+                           "[CommandContext] No command found with N" + std::to_string(number) + "signature");
         return false;
     }
 
     std::string CommandContext::getCommandText(uint32_t number) const {
         auto it = history_.find(number);
         if (it != history_.end()) {
-            Logger::logInfo("[CommandContext] Retrieved command N" + std::to_string(number));
+            DRIVER_TRACE(TraceEvent::CommandRetrieved, number);
+            DRIVER_LOG_DEBUG(LogModule::Serial, "[CommandContext] Retrieved command N", number);
             return it->second;
         }
-        Logger::logWarning("[CommandContext] Command N" + std::to_string(number) + " not found in history");
+        DRIVER_LOG_WARNING(LogModule::Serial,
+                           "[CommandContext] Command N" + std::to_string(number) + " not found in history");
         return "";
     }
 
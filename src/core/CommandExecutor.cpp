@@ -1,15 +1,37 @@
 #include "core/CommandExecutor.hpp"
+#include "core/serial/handler/ResponseDecoder.hpp"
 #include "core/types/Error.hpp"
+#include "application/config/ConfigManager.hpp"
 #include "logger/Logger.hpp"
+#include "logger/TraceLog.hpp"
 #include <sstream>
 #include <chrono>
 #include <regex>
+#include <thread>
 
 namespace core {
 
-    CommandExecutor::CommandExecutor(std::shared_ptr<SerialPort> serial, std::shared_ptr<CommandContext> context)
+    namespace {
+        constexpr const char *FIRMWARE_BOOT_BANNER = "Avvio firmware 3DP";
+    }
+
+    CommandExecutor::CommandExecutor(std::shared_ptr<SerialPort> serial, std::shared_ptr<CommandContext> context,
+                                     state::StateTracker &stateTracker)
             : serial_(std::move(serial)), context_(std::move(context)), firmwareSyncLost_(false) {
-        protocolHandler_ = std::make_shared<SerialProtocolHandler>(serial_);
+        auto serialConfig = config::ConfigManager::getInstance().getSerialConfig();
+
+        LinkQualityEstimator::Config linkConfig;
+        linkConfig.initialRto = std::chrono::milliseconds(serialConfig.initialRtoMs);
+        linkConfig.minRto = std::chrono::milliseconds(serialConfig.minRtoMs);
+        linkConfig.maxRto = std::chrono::milliseconds(serialConfig.maxRtoMs);
+        linkConfig.maxRetryDelay = std::chrono::milliseconds(serialConfig.retryDelayMs);
+        linkConfig.maxOverflowBackoff = std::chrono::milliseconds(serialConfig.maxOverflowBackoffMs);
+
+        linkQuality_ = std::make_shared<LinkQualityEstimator>(linkConfig);
+        maxRetransmits_ = serialConfig.maxRetransmits;
+        maxOverflowRetries_ = serialConfig.maxRetries;
+        reconnectTimeout_ = std::chrono::milliseconds(serialConfig.reconnectTimeoutMs);
+        protocolHandler_ = std::make_shared<SerialProtocolHandler>(serial_, linkQuality_, stateTracker);
     }
 
     types::Result CommandExecutor::sendCommandAndAwaitResponse(const std::string &command, uint32_t commandNumber) {
@@ -18,15 +40,17 @@ namespace core {
     }
 
     types::Result
-    CommandExecutor::sendCommandAndAwaitResponseLocked(const std::string &command, uint32_t commandNumber) {
+    CommandExecutor::sendCommandAndAwaitResponseLocked(const std::string &command, uint32_t commandNumber,
+                                                       bool resent) {
         context_->storeCommand(commandNumber, command);
         lastSentCommand_ = command;
         lastSentNumber_ = commandNumber;
 
         protocolHandler_->sendCommand(command);
-        Logger::logInfo("[CommandExecutor] Sent N" + std::to_string(commandNumber) + ": " + command);
+        DRIVER_TRACE(TraceEvent::CommandSent, commandNumber, command);
+        DRIVER_LOG_DEBUG(LogModule::Serial, "[CommandExecutor] Sent N", commandNumber, ": ", command);
 
-        types::Result result = processResponse(commandNumber);
+        types::Result result = processResponse(command, commandNumber, resent);
 
         if (result.isDuplicate()) {
             // Se è duplicato, si passa al comando successivo e si rimuove il duplicato dallo storico
@@ -39,25 +63,44 @@ namespace core {
             std::string resendCommand = context_->getCommandText(result.commandNumber.value());
 
             if (resendCommand.empty()) {
-                Logger::logError("[CommandExecutor] RESEND FAILED - command N" +
+                DRIVER_LOG_ERROR(LogModule::Serial,
+                                 "[CommandExecutor] RESEND FAILED - command N" +
                                  std::to_string(result.commandNumber.value()) + " not found in history");
                 context_->setCommandNumber(result.commandNumber.value() - 1);
                 return types::Result::resendError(result.commandNumber.value());
             }
 
-            std::this_thread::sleep_for(std::chrono::milliseconds(500));
-            sendCommandAndAwaitResponseLocked(resendCommand, result.commandNumber.value());
-            std::this_thread::sleep_for(std::chrono::milliseconds(500));
-            return sendCommandAndAwaitResponseLocked(command,
-                                                     commandNumber); // Esegue nuovamente a prescindere dal result
+            // Pausa di un RTT di link per lasciare svuotare il buffer RX del firmware
+            std::this_thread::sleep_for(linkQuality_->retryDelay());
+            // Entrambi già trasmessi: nessun campione RTT (Karn)
+            sendCommandAndAwaitResponseLocked(resendCommand, result.commandNumber.value(), true);
+            return sendCommandAndAwaitResponseLocked(command, commandNumber,
+                                                     true); // Esegue nuovamente a prescindere dal result
         } else if (result.isChecksumMismatch()) {
             // Se il checksum non corrisponde, riesegue il comando: se era già stato eseguito arriverà DUPLICATE, se è stato saltato un comando arriverà RESEND, altrimenti OK
-            std::this_thread::sleep_for(std::chrono::milliseconds(500));
-            return sendCommandAndAwaitResponseLocked(command, commandNumber);
+            std::this_thread::sleep_for(linkQuality_->retryDelay());
+            return sendCommandAndAwaitResponseLocked(command, commandNumber, true);
+        } else if (result.isBufferOverflow()) {
+            // Il firmware ha scartato il comando: backoff esponenziale e reinvio dello stesso numero
+            if (linkQuality_->consecutiveOverflows() > static_cast<uint32_t>(maxOverflowRetries_)) {
+                DRIVER_LOG_ERROR(LogModule::Serial,
+                                 "[CommandExecutor] Buffer overflow persists for N" + std::to_string(commandNumber) +
+                                 " - giving up");
+                linkQuality_->onAcknowledged();
+                return result;
+            }
+
+            auto backoff = linkQuality_->onBufferOverflow();
+            DRIVER_LOG_WARNING(LogModule::Serial,
+                               "[CommandExecutor] Buffer overflow - retrying N" + std::to_string(commandNumber) +
+                               " in " + std::to_string(backoff.count()) + "ms");
+            std::this_thread::sleep_for(backoff);
+            return sendCommandAndAwaitResponseLocked(command, commandNumber, true);
         } else if (result.isSuccess() && result.commandNumber.has_value()) {
             context_->removeCommand(commandNumber);
-            Logger::logInfo("[CommandExecutor] SET Command N" + std::to_string(result.commandNumber.value()) +
-                            " completed successfully");
+            DRIVER_TRACE(TraceEvent::CommandCompleted, result.commandNumber.value());
+            DRIVER_LOG_DEBUG(LogModule::Serial, "[CommandExecutor] SET Command N", result.commandNumber.value(),
+                             " completed successfully");
             context_->setCommandNumber(result.commandNumber.value() + 1);
             return result;
         }
@@ -67,95 +110,182 @@ namespace core {
         return result;
     }
 
-    types::Result CommandExecutor::processResponse(uint32_t expectedNumber) {
-        const int maxRetries = 2;
-        const auto commandTimeout = std::chrono::milliseconds(300000);
+    types::Result
+    CommandExecutor::processResponse(const std::string &command, uint32_t expectedNumber, bool resent) {
+        const std::string commandKey = LinkQualityEstimator::commandKey(command);
+        auto rto = linkQuality_->retransmissionTimeout(commandKey);
+        int retransmits = 0;
 
-        int retries = 0;
         types::Result result;
         result.code = types::ResultCode::Skip;
         result.commandNumber = expectedNumber;
 
-        auto commandStartTime = std::chrono::steady_clock::now();
+        auto sentAt = std::chrono::steady_clock::now();
+        auto deadline = sentAt + rto;
+        int reconnects = 0;
 
-        while (retries <= maxRetries) {
-            if (std::chrono::steady_clock::now() - commandStartTime > commandTimeout) {
-                Logger::logError("[CommandExecutor] Command timeout for N" + std::to_string(expectedNumber));
-                result.code = types::ResultCode::Success;
-                result.message = "Command timeout - continuing";
-                return result;
+        while (true) {
+            auto now = std::chrono::steady_clock::now();
+            if (now >= deadline) {
+                if (retransmits >= maxRetransmits_) {
+                    DRIVER_LOG_ERROR(LogModule::Serial,
+                                     "[CommandExecutor] Command timeout for N" + std::to_string(expectedNumber) +
+                                     " after " + std::to_string(retransmits) + " retransmissions");
+                    result.code = types::ResultCode::Timeout;
+                    result.message = "Command timeout";
+                    return result;
+                }
+
+                retransmits++;
+                rto = linkQuality_->backoff(rto);
+                DRIVER_LOG_WARNING(LogModule::Serial,
+                                   "[CommandExecutor] No response for N" + std::to_string(expectedNumber) +
+                                   " - retransmission #" + std::to_string(retransmits) +
+                                   " (RTO " + std::to_string(rto.count()) + "ms)");
+                protocolHandler_->sendCommand(command);
+                deadline = now + rto;
+                continue;
             }
 
-            SerialMessage message = protocolHandler_->receiveMessage();
+            // Si attende al più fino alla scadenza dell'RTO, così la ritrasmissione parte in tempo
+            SerialMessage message = protocolHandler_->receiveMessage(
+                    std::chrono::ceil<std::chrono::milliseconds>(deadline - now));
+
+            // Perdita del link (USB scollegata/ri-enumerata): si riapre senza reset e si riprende da questo comando
+            if (message.code == MessageCodeType::CONNECTION_LOST ||
+                message.code == MessageCodeType::UNAVAIABLE_SERIAL_PORT) {
+                if (reconnects >= maxRetransmits_ || !reconnectLink()) {
+                    result.code = types::ResultCode::Error;
+                    result.message = "Serial connection lost";
+                    return result;
+                }
+                reconnects++;
+
+                // Il firmware potrebbe averlo già eseguito: in quel caso risponderà DUPLICATE (= confermato),
+                // se ha perso comandi precedenti RESEND, altrimenti OK
+                resent = true;
+                protocolHandler_->sendCommand(command);
+                deadline = std::chrono::steady_clock::now() + rto;
+                continue;
+            }
 
             if (message.rawMessage.empty()) {
-                std::this_thread::sleep_for(std::chrono::milliseconds(10));
                 continue;
             }
 
-            if (message.rawMessage.find("BUSY") == 0 || SerialProtocolHandler::isUnknown(message)) continue;
+            // Banner di boot durante un comando: il dispositivo si è resettato, numerazione e planner sono persi
+            if (message.rawMessage.find(FIRMWARE_BOOT_BANNER) == 0) {
+                DRIVER_LOG_ERROR(LogModule::Serial, "[CommandExecutor] Firmware reset detected while waiting for N" +
+                                                    std::to_string(expectedNumber) + " - print state lost");
+                firmwareSyncLost_ = true;
+                result.code = types::ResultCode::Error;
+                result.message = "Firmware reset";
+                return result;
+            }
+
+            // Il firmware sta ancora lavorando sul comando: il link è vivo, si estende la scadenza
+            if (message.rawMessage.find("BUSY") == 0) {
+                deadline = std::max(deadline, std::chrono::steady_clock::now() + rto);
+                continue;
+            }
+
+            // Scartato dal protocollo (checksum errato): la risposta buona arriverà con la ritrasmissione
+            if (message.code == MessageCodeType::CHECKSUM_ERROR_SKIP) continue;
+
+            // Auto-report e conferme urgenti: già gestiti dal protocollo, non fanno parte della risposta
+            if (message.type == MessageType::TELEMETRY || message.type == MessageType::URGENT) continue;
+
+            // Le linee informative/critiche hanno codici "sconosciuti" (POS, TEMP, CAP...) ma vanno nel body
+            if (message.type == MessageType::STANDARD && SerialProtocolHandler::isUnknown(message)) continue;
 
             // Scarta messaggi non critici con checksum invalido
             if (!SerialProtocolHandler::isValidMessage(message) && message.type != MessageType::CRITICAL) {
-                Logger::logWarning("[CommandExecutor] Invalid message discarded: " + message.rawMessage);
+                DRIVER_LOG_WARNING(LogModule::Serial,
+                                   "[CommandExecutor] Invalid message discarded: " + message.rawMessage);
                 continue;
             }
 
             if (message.type == MessageType::INFORMATIONAL) {
+                ResponseDecoder::decode(message.payload, result.decoded);
                 result.body.push_back(message.payload);
+                deadline = std::max(deadline, std::chrono::steady_clock::now() + rto);
                 continue;
             }
 
             if (message.type == MessageType::CRITICAL) {
-                Logger::logInfo("[CommandExecutor] Critical: " + message.payload);
+                DRIVER_LOG_INFO(LogModule::Serial, "[CommandExecutor] Critical: " + message.payload);
                 result.body.push_back(message.payload);
                 continue;
             }
 
             if (message.type == MessageType::STANDARD) {
+                uint32_t replyNumber = SerialProtocolHandler::fetchMessageCommandNumber(message);
+
+                // Eco di una ritrasmissione precedente (OK/DUPLICATE per un numero già chiuso): non riguarda questo comando
+                if ((SerialProtocolHandler::isOk(message) || SerialProtocolHandler::isDuplicate(message)) &&
+                    replyNumber < expectedNumber) {
+                    DRIVER_LOG_DEBUG(LogModule::Serial, "[CommandExecutor] Discarding stale reply for N", replyNumber);
+                    continue;
+                }
+
+                // Algoritmo di Karn: si campiona l'RTT solo per comandi non ritrasmessi
+                if (retransmits == 0 && !resent) {
+                    linkQuality_->addSample(commandKey, std::chrono::duration_cast<std::chrono::microseconds>(
+                            std::chrono::steady_clock::now() - sentAt));
+                }
+
                 if (SerialProtocolHandler::isOk(message)) {
+                    linkQuality_->onAcknowledged();
                     result.code = types::ResultCode::Success;
                     result.message = "Command acknowledged";
+                } else if (SerialProtocolHandler::isDuplicate(message) && (retransmits > 0 || resent) &&
+                           replyNumber == expectedNumber) {
+                    // La copia originale era arrivata: la ritrasmissione conferma l'esecuzione
+                    linkQuality_->onAcknowledged();
+                    result.code = types::ResultCode::Success;
+                    result.message = "Command acknowledged after retransmission";
                 } else {
-                    result.commandNumber = SerialProtocolHandler::fetchMessageCommandNumber(message);
+                    result.commandNumber = replyNumber;
                     if (SerialProtocolHandler::isDuplicate(message)) {
-                        Logger::logInfo("[CommandExecutor] DUPLICATE response");
+                        DRIVER_LOG_DEBUG(LogModule::Serial, "[CommandExecutor] DUPLICATE response");
                         result.code = types::ResultCode::Duplicate;
                         result.message = "Command already processed";
                     } else if (SerialProtocolHandler::isResend(message)) {
-                        Logger::logWarning("[CommandExecutor] RESEND request for N" +
-                                           std::to_string(result.commandNumber.value()));
+                        DRIVER_LOG_WARNING(LogModule::Serial, "[CommandExecutor] RESEND request for N" +
+                                                              std::to_string(result.commandNumber.value()));
                         result.code = types::ResultCode::Resend;
                         result.message = "Resend command";
                     } else if (SerialProtocolHandler::isChecksumMismatch(message)) {
-                        Logger::logWarning("[CommandExecutor] Firmware checksum error");
+                        DRIVER_LOG_WARNING(LogModule::Serial, "[CommandExecutor] Firmware checksum error");
                         result.code = types::ResultCode::ChecksumMismatch;
                         result.message = "Firmware reported checksum error";
                     } else if (SerialProtocolHandler::isBufferOverflow(message)) {
-                        Logger::logError("[CommandExecutor] Firmware buffer overflow");
-                        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+                        DRIVER_LOG_ERROR(LogModule::Serial, "[CommandExecutor] Firmware buffer overflow");
+                        result.commandNumber = expectedNumber;
+                        result.code = types::ResultCode::BufferOverflow;
+                        result.message = "Firmware buffer overflow";
                     } else if (SerialProtocolHandler::isInvalidCategory(message)) {
-                        Logger::logError("[CommandExecutor] Invalid command category");
+                        DRIVER_LOG_ERROR(LogModule::Serial, "[CommandExecutor] Invalid command category");
                         result.code = types::ResultCode::Error;
                         result.message = "Invalid command category";
                     } else if (SerialProtocolHandler::isMotionBlocked(message)) {
-                        Logger::logWarning("[CommandExecutor] Motion blocked by firmware");
+                        DRIVER_LOG_WARNING(LogModule::Serial, "[CommandExecutor] Motion blocked by firmware");
                         result.code = types::ResultCode::Busy;
                         result.message = "Motion blocked";
                     } else if (SerialProtocolHandler::isTemperatureBlocked(message)) {
-                        Logger::logWarning("[CommandExecutor] Temperature operation blocked");
+                        DRIVER_LOG_WARNING(LogModule::Serial, "[CommandExecutor] Temperature operation blocked");
                         result.code = types::ResultCode::Busy;
                         result.message = "Temperature blocked";
                     } else if (SerialProtocolHandler::isOperationCancelled(message)) {
-                        Logger::logInfo("[CommandExecutor] Operation cancelled by firmware");
+                        DRIVER_LOG_INFO(LogModule::Serial, "[CommandExecutor] Operation cancelled by firmware");
                         result.code = types::ResultCode::Skip;
                         result.message = "Operation cancelled";
                     } else if (SerialProtocolHandler::isNoError(message)) { // No error
-                        Logger::logInfo("[CommandExecutor] No error response");
+                        DRIVER_LOG_INFO(LogModule::Serial, "[CommandExecutor] No error response");
                         result.code = types::ResultCode::Success;
                         result.message = "No error";
                     } else {
-                        Logger::logWarning("[CommandExecutor] Unknown response");
+                        DRIVER_LOG_WARNING(LogModule::Serial, "[CommandExecutor] Unknown response");
                         result.code = types::ResultCode::Error;
                         result.message = "Unknown response - continuing";
                     }
@@ -163,8 +293,96 @@ namespace core {
                 return result;
             }
         }
+    }
 
-        return result;
+    bool CommandExecutor::reconnectLink() {
+        DRIVER_LOG_WARNING(LogModule::Serial, "[CommandExecutor] Serial link lost - reconnecting without device reset");
+        auto start = std::chrono::steady_clock::now();
+
+        if (!protocolHandler_->reconnect(reconnectTimeout_)) {
+            DRIVER_LOG_ERROR(LogModule::Serial, "[CommandExecutor] Serial link could not be restored");
+            return false;
+        }
+
+        reconnectCount_++;
+        DRIVER_LOG_INFO(LogModule::Serial,
+                        "[CommandExecutor] Serial link restored in " + std::to_string(
+                std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count()) +
+                        "ms - resuming from N" + std::to_string(lastSentNumber_));
+        return true;
+    }
+
+    types::Result CommandExecutor::sendUrgent(const std::string &line,
+                                              std::chrono::steady_clock::time_point receivedAt) {
+        // Volutamente senza serialMutex_: il comando normale in corso resta in attesa della sua risposta
+        std::lock_guard<std::mutex> lock(urgentMutex_);
+
+        uint64_t seenAcks = protocolHandler_->urgentAckCount();
+        auto rto = linkQuality_->retransmissionTimeout();
+
+        protocolHandler_->sendUrgent(line);
+
+        auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - receivedAt);
+        urgentStats_.sent++;
+        urgentStats_.lastLatency = latency;
+        urgentStats_.maxLatency = std::max(urgentStats_.maxLatency, latency);
+        DRIVER_LOG_INFO(LogModule::Serial, "[CommandExecutor] Urgent " + line + " on the wire " +
+                                           std::to_string(latency.count()) + "us after request");
+
+        // Nessuna ritrasmissione: scaduto un RTO il chiamante ricade sul comando numerato
+        auto deadline = std::chrono::steady_clock::now() + rto;
+        while (true) {
+            if (protocolHandler_->urgentAckCount() > seenAcks) {
+                urgentStats_.acknowledged++;
+                return types::Result::success("Urgent command acknowledged");
+            }
+
+            auto now = std::chrono::steady_clock::now();
+            if (now >= deadline) break;
+
+            // Link libero: nessun altro legge le risposte, si legge qui
+            std::unique_lock<std::mutex> serialLock(serialMutex_, std::try_to_lock);
+            if (serialLock.owns_lock() && serial_->hasPendingInput()) {
+                protocolHandler_->receiveMessage(std::chrono::ceil<std::chrono::milliseconds>(deadline - now));
+                continue;
+            }
+            if (serialLock.owns_lock()) serialLock.unlock();
+
+            // Altrimenti la conferma arriva al thread che attende il comando normale
+            protocolHandler_->waitForUrgentAck(seenAcks, std::chrono::milliseconds(5));
+        }
+
+        DRIVER_LOG_WARNING(LogModule::Serial, "[CommandExecutor] Urgent " + line + " not confirmed within " +
+                                              std::to_string(rto.count()) + "ms");
+        return types::Result::timeout("Urgent command not confirmed");
+    }
+
+    UrgentLaneStats CommandExecutor::urgentStats() const {
+        std::lock_guard<std::mutex> lock(urgentMutex_);
+        return urgentStats_;
+    }
+
+    size_t CommandExecutor::drainUnsolicited() {
+        // Mai in competizione con un comando: se il link è occupato le linee arriveranno a processResponse
+        std::unique_lock<std::mutex> lock(serialMutex_, std::try_to_lock);
+        if (!lock.owns_lock()) return 0;
+
+        size_t drained = 0;
+        while (serial_->hasPendingInput()) {
+            SerialMessage message = protocolHandler_->receiveMessage();
+            if (message.rawMessage.empty()) break;
+            drained++;
+
+            if (message.type == MessageType::CRITICAL) {
+                DRIVER_LOG_WARNING(LogModule::Serial,
+                                   "[CommandExecutor] Unsolicited critical message: " + message.payload);
+            } else if (message.type == MessageType::STANDARD && message.code != MessageCodeType::CHECKSUM_ERROR_SKIP) {
+                DRIVER_LOG_INFO(LogModule::Serial,
+                                "[CommandExecutor] Discarding unsolicited reply: " + message.rawMessage);
+            }
+        }
+        return drained;
     }
 
 } // namespace core
\ No newline at end of file
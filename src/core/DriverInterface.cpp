@@ -5,17 +5,40 @@
 #include "core/DriverInterface.hpp"
 #include "core/CommandBuilder.hpp"
 #include "core/printer/ErrorRecovery.hpp"
+#include "core/utils/ThreadAffinity.hpp"
+#include "application/config/ConfigManager.hpp"
 #include "logger/Logger.hpp"
 #include <chrono>
 #include <mutex>
+#include <sstream>
 
 namespace core {
 
-    DriverInterface::DriverInterface(std::shared_ptr<Printer> printer, std::shared_ptr<SerialPort> serialPort)
+    namespace {
+        /**
+         * @brief true se una linea "CAP ..." del body contiene il token richiesto
+         */
+        bool advertisesCapability(const types::Result &capabilities, const std::string &capability) {
+            for (const auto &line: capabilities.body) {
+                std::istringstream iss(line);
+                std::string token;
+                if (!(iss >> token) || token != "CAP") continue;
+
+                while (iss >> token) {
+                    if (token == capability) return true;
+                }
+            }
+            return false;
+        }
+    }
+
+    DriverInterface::DriverInterface(std::shared_ptr<Printer> printer, std::shared_ptr<SerialPort> serialPort,
+                                     state::StateTracker &stateTracker)
             : printer_(std::move(printer)),
               serialPort_(std::move(serialPort)),
+              stateTracker_(stateTracker),
               commandContext_(std::make_shared<CommandContext>()),
-              commandExecutor_(std::make_shared<CommandExecutor>(serialPort_, commandContext_)),
+              commandExecutor_(std::make_shared<CommandExecutor>(serialPort_, commandContext_, stateTracker_)),
               currentState_(PrintState::Idle),
               motion_(std::make_shared<command::motion::MotionCommands>(this)),
               endstop_(std::make_shared<command::endstop::EndstopCommands>(this)),
@@ -25,6 +48,13 @@ namespace core {
               history_(std::make_shared<command::history::HistoryCommands>(this)),
               temperature_(std::make_shared<command::temperature::TemperatureCommands>(this)) {
         // REMOVED: Global mutex initialization
+        linkReadyTimeout_ = std::chrono::milliseconds(
+                config::ConfigManager::getInstance().getSerialConfig().bootTimeoutMs);
+    }
+
+    DriverInterface::~DriverInterface() {
+        stopAsyncWorker();
+        disableTelemetry();
     }
 
     // REMOVED: Global variables that caused deadlock
@@ -61,16 +91,24 @@ namespace core {
         return temperature_;
     }
 
+    state::StateTracker &DriverInterface::stateTracker() const {
+        return stateTracker_;
+    }
+
+    void DriverInterface::setCpuAffinity(int cpu) {
+        cpuAffinity_ = cpu;
+    }
+
     PrintState DriverInterface::getState() const {
         return currentState_;
     }
 
     void DriverInterface::setState(PrintState newState) {
-        if (currentState_ != newState) {
+        PrintState previous = currentState_.exchange(newState);
+        if (previous != newState) {
             Logger::logInfo("[DriverInterface] State change: " +
-                            printStateToString(currentState_) + " -> " +
+                            printStateToString(previous) + " -> " +
                             printStateToString(newState));
-            currentState_ = newState;
         }
     }
 
@@ -91,8 +129,218 @@ namespace core {
         }
     }
 
+    FramingMode DriverInterface::negotiateFraming() {
+        // La query viaggia sempre in ASCII: i firmware legacy non riconoscono il frame binario
+        commandExecutor_->setFramingMode(FramingMode::ASCII);
+
+        types::Result result = system_->capabilities();
+        if (!result.isSuccess()) {
+            Logger::logInfo("[DriverInterface] Firmware capabilities not available - using ASCII framing");
+            return FramingMode::ASCII;
+        }
+
+        if (advertisesCapability(result, "BIN1")) {
+            commandExecutor_->setFramingMode(FramingMode::BINARY);
+            return FramingMode::BINARY;
+        }
+
+        Logger::logInfo("[DriverInterface] Firmware does not advertise binary framing - using ASCII");
+        return FramingMode::ASCII;
+    }
+
+    bool DriverInterface::probeUrgentLane() {
+        types::Result result = system_->capabilities();
+        bool available = result.isSuccess() && advertisesCapability(result, "URG1");
+        urgentLaneAvailable_ = available;
+
+        Logger::logInfo(available ? "[DriverInterface] Urgent lane available"
+                                  : "[DriverInterface] Firmware does not advertise the urgent lane - "
+                                    "urgent commands use numbered commands");
+        return available;
+    }
+
+    types::Result DriverInterface::sendUrgentCommand(char category, int code,
+                                                     std::chrono::steady_clock::time_point receivedAt) {
+        if (category == 'M' && code == 0) {
+            setState(PrintState::Error);
+        } else if (category == 'S' && code == 2) {
+            setState(PrintState::Paused);
+        }
+
+        if (urgentLaneAvailable_) {
+            std::string payload = "!" + std::string(1, category) + std::to_string(code);
+            uint8_t checksum = 0;
+            for (char c: payload) {
+                checksum ^= static_cast<uint8_t>(c);
+            }
+
+            types::Result result = commandExecutor_->sendUrgent(payload + " *" + std::to_string(checksum),
+                                                               receivedAt);
+            if (result.isSuccess()) {
+                return result;
+            }
+
+            // Solo questo comando ricade sul percorso numerato: ripetere M0/S2 è innocuo
+            Logger::logWarning("[DriverInterface] Urgent " + payload + " not confirmed - sending numbered command");
+        }
+
+        return sendCommandInternal(category, code, std::vector<std::string>{});
+    }
+
+    UrgentLaneStats DriverInterface::urgentStats() const {
+        return commandExecutor_->urgentStats();
+    }
+
+    bool DriverInterface::enableTelemetry(std::chrono::milliseconds interval) {
+        types::Result result = system_->autoReport(static_cast<int>(interval.count()));
+        if (!result.isSuccess()) {
+            Logger::logInfo("[DriverInterface] Firmware auto-report not available - state served by queries");
+            stateTracker_.setAutoReportInterval(0);
+            return false;
+        }
+
+        stateTracker_.setAutoReportInterval(static_cast<int>(interval.count()));
+
+        if (!telemetryRunning_.exchange(true)) {
+            telemetryThread_ = std::thread(&DriverInterface::telemetryLoop, this);
+        }
+
+        Logger::logInfo("[DriverInterface] Firmware auto-report enabled every " +
+                        std::to_string(interval.count()) + "ms");
+        return true;
+    }
+
+    void DriverInterface::disableTelemetry() {
+        if (!telemetryRunning_.exchange(false)) return;
+
+        telemetryCv_.notify_all();
+        if (telemetryThread_.joinable()) {
+            telemetryThread_.join();
+        }
+        stateTracker_.setAutoReportInterval(0);
+    }
+
+    void DriverInterface::telemetryLoop() {
+        // Durante i comandi i report sono consumati da processResponse: qui si copre solo il link inattivo
+        constexpr auto POLL_INTERVAL = std::chrono::milliseconds(50);
+        if (cpuAffinity_ >= 0) utils::pinCurrentThread(cpuAffinity_);
+
+        std::unique_lock<std::mutex> lock(telemetryMutex_);
+        while (telemetryRunning_) {
+            telemetryCv_.wait_for(lock, POLL_INTERVAL, [this] { return !telemetryRunning_; });
+            if (!telemetryRunning_) break;
+
+            lock.unlock();
+            commandExecutor_->drainUnsolicited();
+            lock.lock();
+        }
+    }
+
+    std::future<types::Result> DriverInterface::sendCommandAsync(char category, int code,
+                                                                 std::vector<std::string> params) {
+        auto promise = std::make_shared<std::promise<types::Result>>();
+        auto future = promise->get_future();
+        sendCommandAsync(category, code, std::move(params), [promise](const types::Result &result) {
+            promise->set_value(result);
+        });
+        return future;
+    }
+
+    void DriverInterface::sendCommandAsync(char category, int code, std::vector<std::string> params,
+                                           types::ResultCallback onComplete) {
+        {
+            std::lock_guard<std::mutex> lock(asyncMutex_);
+            if (!asyncStopping_) {
+                // Worker avviato al primo uso: chi usa solo l'API sincrona non paga un thread in più
+                if (!asyncThread_.joinable()) {
+                    asyncThread_ = std::thread(&DriverInterface::asyncLoop, this);
+                }
+                asyncQueue_.push_back({category, code, std::move(params), std::move(onComplete)});
+                asyncCv_.notify_one();
+                return;
+            }
+        }
+        onComplete(types::Result::error("Driver shutting down"));
+    }
+
+    size_t DriverInterface::pendingAsyncCommands() const {
+        std::lock_guard<std::mutex> lock(asyncMutex_);
+        return asyncQueue_.size();
+    }
+
+    void DriverInterface::asyncLoop() {
+        if (cpuAffinity_ >= 0) utils::pinCurrentThread(cpuAffinity_);
+
+        std::unique_lock<std::mutex> lock(asyncMutex_);
+        while (true) {
+            asyncCv_.wait(lock, [this] { return asyncStopping_ || !asyncQueue_.empty(); });
+            if (asyncQueue_.empty()) break;
+
+            AsyncCommand command = std::move(asyncQueue_.front());
+            asyncQueue_.pop_front();
+            bool cancelled = asyncStopping_;
+            lock.unlock();
+
+            types::Result result = cancelled
+                                   ? types::Result::error("Driver shutting down")
+                                   : sendCommandInternal(command.category, command.code, command.params);
+            try {
+                command.onComplete(result);
+            } catch (const std::exception &e) {
+                Logger::logError("[DriverInterface] Async completion callback failed: " + std::string(e.what()));
+            }
+
+            lock.lock();
+        }
+    }
+
+    void DriverInterface::stopAsyncWorker() {
+        {
+            std::lock_guard<std::mutex> lock(asyncMutex_);
+            asyncStopping_ = true;
+        }
+        asyncCv_.notify_all();
+        if (asyncThread_.joinable()) {
+            asyncThread_.join();
+        }
+    }
+
+    void DriverInterface::setLinkReady(bool ready) {
+        {
+            std::lock_guard<std::mutex> lock(linkReadyMutex_);
+            linkReady_ = ready;
+        }
+        if (ready) {
+            linkReadyCv_.notify_all();
+        }
+    }
+
+    bool DriverInterface::isLinkReady() const {
+        return linkReady_;
+    }
+
+    void DriverInterface::runHandshake(const std::function<void()> &handshake) {
+        struct Scope {
+            std::atomic<std::thread::id> &owner;
+
+            ~Scope() { owner = std::thread::id(); }
+        } scope{handshakeThread_};
+        handshakeThread_ = std::this_thread::get_id();
+        handshake();
+    }
+
+    bool DriverInterface::waitForLinkReady(std::chrono::milliseconds timeout) const {
+        if (linkReady_ || handshakeThread_ == std::this_thread::get_id()) return true;
+
+        std::unique_lock<std::mutex> lock(linkReadyMutex_);
+        return linkReadyCv_.wait_for(lock, timeout, [this] { return linkReady_.load(); });
+    }
+
     types::Result
     DriverInterface::sendCommandInternal(char category, int code, const std::vector<std::string> &params) const {
+        if (!waitForLinkReady(linkReadyTimeout_)) {
+            return types::Result::error("Printer link not ready");
+        }
         std::lock_guard<std::mutex> lock(commandMutex_);
 
         try {
@@ -100,31 +348,61 @@ namespace core {
             uint32_t cmdNum = commandContext_->nextCommandNumber();
             std::string command = CommandBuilder::buildCommand(cmdNum, category, code, params);
 
-            // Update state based on command
-            //TODO: Controllare se ha senso qui. In teoria setta lo stato prima di sapere se il comando va a buon fine...
-            if (category == 'S') {
-                if (code == 1) { // Start print
-                    const_cast<DriverInterface *>(this)->setState(PrintState::Printing);
-                } else if (code == 2) { // Pause
-                    const_cast<DriverInterface *>(this)->setState(PrintState::Paused);
-                } else if (code == 3) { // Resume
-                    const_cast<DriverInterface *>(this)->setState(PrintState::Printing);
-                } else if (code == 0) { // Homing
-                    const_cast<DriverInterface *>(this)->setState(PrintState::Homing);
-                }
-            } else if (category == 'M' && code == 0) { // Emergency stop
-                const_cast<DriverInterface *>(this)->setState(PrintState::Error);
-            }
+            return executeCommand(category, code, cmdNum, command);
+
+        } catch (const std::exception &e) {
+            Logger::logError("[DriverInterface] Exception in sendCommandInternal: " + std::string(e.what()));
+            return types::Result::error(std::string("Exception: ") + e.what());
+        }
+    }
+
+    types::Result DriverInterface::sendCommandInternal(char category, int code,
+                                                       std::initializer_list<utils::WireParam> params) const {
+        if (!waitForLinkReady(linkReadyTimeout_)) {
+            return types::Result::error("Printer link not ready");
+        }
+        std::lock_guard<std::mutex> lock(commandMutex_);
 
-            // Send command with timeout handling
-            types::Result result = commandExecutor_->sendCommandAndAwaitResponse(command, cmdNum);
+        try {
+            uint32_t cmdNum = commandContext_->nextCommandNumber();
 
-            return result;
+            // Comando scritto direttamente su buffer in stack, unica allocazione per lo storico
+            char buffer[utils::MAX_WIRE_COMMAND_SIZE];
+            size_t size = CommandBuilder::buildCommand(buffer, sizeof(buffer), cmdNum, category, code, params);
+            if (size == 0) {
+                return types::Result::error("Command exceeds wire buffer");
+            }
+
+            return executeCommand(category, code, cmdNum, std::string(buffer, size));
 
         } catch (const std::exception &e) {
             Logger::logError("[DriverInterface] Exception in sendCommandInternal: " + std::string(e.what()));
-            return {types::ResultCode::Error, std::string("Exception: ") + e.what()};
+            return types::Result::error(std::string("Exception: ") + e.what());
         }
     }
 
+    types::Result
+    DriverInterface::executeCommand(char category, int code, uint32_t cmdNum, const std::string &command) const {
+        // Update state based on command
+        //TODO: Controllare se ha senso qui. In teoria setta lo stato prima di sapere se il comando va a buon fine...
+        if (category == 'S') {
+            if (code == 1) { // Start print
+                const_cast<DriverInterface *>(this)->setState(PrintState::Printing);
+            } else if (code == 2) { // Pause
+                const_cast<DriverInterface *>(this)->setState(PrintState::Paused);
+            } else if (code == 3) { // Resume
+                const_cast<DriverInterface *>(this)->setState(PrintState::Printing);
+            } else if (code == 0) { // Homing
+                const_cast<DriverInterface *>(this)->setState(PrintState::Homing);
+            }
+        } else if (category == 'M' && code == 0) { // Emergency stop
+            const_cast<DriverInterface *>(this)->setState(PrintState::Error);
+        }
+
+        // Send command with timeout handling
+        types::Result result = commandExecutor_->sendCommandAndAwaitResponse(command, cmdNum);
+
+        return result;
+    }
+
 } // namespace core
\ No newline at end of file
@@ -15,4 +15,26 @@ namespace core::command {
         return driver_->sendCommandInternal(category, code, params);
     }
 
+    core::types::Result
+    CommandCategoryInterface::sendCommand(char category, int code,
+                                          std::initializer_list<utils::WireParam> params) const {
+        return driver_->sendCommandInternal(category, code, params);
+    }
+
+    std::future<core::types::Result>
+    CommandCategoryInterface::sendCommandAsync(char category, int code, std::vector<std::string> params) const {
+        return driver_->sendCommandAsync(category, code, std::move(params));
+    }
+
+    void CommandCategoryInterface::submitAsync(char category, int code, std::vector<std::string> params,
+                                               core::types::ResultCallback onComplete) const {
+        driver_->sendCommandAsync(category, code, std::move(params), std::move(onComplete));
+    }
+
+    core::types::Result
+    CommandCategoryInterface::sendUrgent(char category, int code,
+                                         std::chrono::steady_clock::time_point receivedAt) const {
+        return driver_->sendUrgentCommand(category, code, receivedAt);
+    }
+
 } // namespace core::command
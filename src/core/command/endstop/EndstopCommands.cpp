@@ -14,4 +14,8 @@ namespace core::command::endstop {
         return sendCommand('E', 10, {});
     }
 
+    std::future<types::Result> EndstopCommands::readEndstopStatusAsync() {
+        return sendCommandAsync('E', 10);
+    }
+
 } // namespace core::printer-command::endstop
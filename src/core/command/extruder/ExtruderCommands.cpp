@@ -4,7 +4,6 @@
 
 #include "core/command/extruder/ExtruderCommands.hpp"
 #include "core/DriverInterface.hpp"
-#include "core/utils/FloatFormatter.hpp"
 
 namespace core::command::extruder {
     ExtruderCommands::ExtruderCommands(DriverInterface *driver)
@@ -12,18 +11,10 @@ namespace core::command::extruder {
     }
 
     types::Result ExtruderCommands::extrude(float millimeters, float feedrate) {
-        std::vector<std::string> params = {
-            "E" + utils::formatFloat(millimeters),
-            "F" + utils::formatFloat(feedrate)
-        };
-        return sendCommand('A', 10, params);
+        return sendCommand('A', 10, {{'E', millimeters}, {'F', feedrate}});
     }
 
     types::Result ExtruderCommands::retract(float millimeters, float feedrate) {
-        std::vector<std::string> params = {
-            "E" + utils::formatFloat(millimeters),
-            "F" + utils::formatFloat(feedrate)
-        };
-        return sendCommand('A', 20, params);
+        return sendCommand('A', 20, {{'E', millimeters}, {'F', feedrate}});
     }
 } // namespace core::command::extruder
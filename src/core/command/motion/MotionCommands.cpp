@@ -1,25 +1,19 @@
-#include <regex>
 #include "core/command/motion/MotionCommands.hpp"
 #include "core/DriverInterface.hpp"
 #include "core/utils/FloatFormatter.hpp"
+#include "core/printer/state/StateTracker.hpp"
 
 namespace core::command::motion {
     MotionCommands::MotionCommands(DriverInterface *driver)
         : CommandCategoryInterface(driver) {
     }
 
-    types::Result MotionCommands::emergencyStop() {
-        return sendCommand('M', 0, {});
+    types::Result MotionCommands::emergencyStop(std::chrono::steady_clock::time_point receivedAt) {
+        return sendUrgent('M', 0, receivedAt);
     }
 
     types::Result MotionCommands::moveTo(float x, float y, float z, float feedrate) {
-        std::vector<std::string> params = {
-            "X" + utils::formatFloat(x),
-            "Y" + utils::formatFloat(y),
-            "Z" + utils::formatFloat(z),
-            "F" + utils::formatFloat(feedrate)
-        };
-        return sendCommand('M', 10, params);
+        return sendCommand('M', 10, {{'X', x}, {'Y', y}, {'Z', z}, {'F', feedrate}});
     }
 
     types::Result MotionCommands::diagnoseAxis(const std::string &axis, float feedrate) {
@@ -31,37 +25,25 @@ namespace core::command::motion {
     }
 
     types::Result MotionCommands::goTo(float x, float y, float z, float feedrate) {
-        std::vector<std::string> params = {
-            "X" + utils::formatFloat(x),
-            "Y" + utils::formatFloat(y),
-            "Z" + utils::formatFloat(z),
-            "F" + utils::formatFloat(feedrate)
-        };
-        return sendCommand('M', 11, params);
+        return sendCommand('M', 11, {{'X', x}, {'Y', y}, {'Z', z}, {'F', feedrate}});
     }
 
     std::optional<position::Position> MotionCommands::getPosition() {
-        auto result = sendCommand('M', 114, {});
-        if (!result.isSuccess()) return std::nullopt;
+        return decodePosition(sendCommand('M', 114, {}));
+    }
 
-        position::Position pos;
-        std::regex rxX(R"(X=([-]?[0-9]*\.?[0-9]+))");
-        std::regex rxY(R"(Y=([-]?[0-9]*\.?[0-9]+))");
-        std::regex rxZ(R"(Z=([-]?[0-9]*\.?[0-9]+))");
-        std::smatch match;
+    std::future<std::optional<position::Position>> MotionCommands::getPositionAsync() {
+        return sendCommandAsync<std::optional<position::Position>>('M', 114, {}, [this](const types::Result &result) {
+            return decodePosition(result);
+        });
+    }
 
-        for (const auto &line: result.body) {
-            if (std::regex_search(line, match, rxX)) {
-                pos.x = std::stod(match[1]);
-            }
-            if (std::regex_search(line, match, rxY)) {
-                pos.y = std::stod(match[1]);
-            }
-            if (std::regex_search(line, match, rxZ)) {
-                pos.z = std::stod(match[1]);
-            }
-        }
+    std::optional<position::Position> MotionCommands::decodePosition(const types::Result &result) const {
+        // La linea POS è già decodificata dal CommandExecutor
+        if (!result.isSuccess() || !result.decoded.position) return std::nullopt;
 
+        const auto &pos = *result.decoded.position;
+        driver_->stateTracker().updatePosition(pos.x, pos.y, pos.z);
         return pos;
     }
 } // namespace core::command::motion
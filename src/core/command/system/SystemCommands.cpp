@@ -18,8 +18,8 @@ namespace core::command::system {
         return sendCommand('S', 1, {});
     }
 
-    types::Result SystemCommands::pause() {
-        return sendCommand('S', 2, {});
+    types::Result SystemCommands::pause(std::chrono::steady_clock::time_point receivedAt) {
+        return sendUrgent('S', 2, receivedAt);
     }
 
     types::Result SystemCommands::resume() {
@@ -38,4 +38,12 @@ namespace core::command::system {
         return sendCommand('S', 10, {});
     }
 
+    types::Result SystemCommands::capabilities() {
+        return sendCommand('S', 90, {});
+    }
+
+    types::Result SystemCommands::autoReport(int intervalMs) {
+        return sendCommand('S', 91, {"I" + std::to_string(intervalMs)});
+    }
+
 } // namespace core::printer-command::system
@@ -17,8 +17,7 @@ namespace core::command::temperature {
         auto result = sendCommand('T', 10, params);
 
         if (result.isSuccess()) {
-            auto &stateTracker = state::StateTracker::getInstance();
-            stateTracker.setHotendTargetTemp(temperature);
+            driver_->stateTracker().setHotendTargetTemp(temperature);
         }
 
         return result;
@@ -31,8 +30,7 @@ namespace core::command::temperature {
         auto result = sendCommand('T', 20, params);
 
         if (result.isSuccess()) {
-            auto &stateTracker = state::StateTracker::getInstance();
-            stateTracker.setBedTargetTemp(temperature);
+            driver_->stateTracker().setBedTargetTemp(temperature);
         }
 
         return result;
@@ -40,75 +38,50 @@ namespace core::command::temperature {
 
     types::Result TemperatureCommands::getHotendTemperature() {
         // T11 command gets hotend temperature
-        auto result = sendCommand('T', 11, {});
-
-        if (result.isSuccess() && !result.body.empty()) {
-            try {
-                // Parse temperature from response body
-                for (const auto &line: result.body) {
-                    // Look for TEMP= pattern
-                    size_t pos = line.find("TEMP=");
-                    if (pos != std::string::npos) {
-                        std::string tempStr = line.substr(pos + 5);
-                        size_t endPos = tempStr.find(' ');
-                        if (endPos != std::string::npos) {
-                            tempStr = tempStr.substr(0, endPos);
-                        }
-
-                        double temp = std::stod(tempStr);
-                        auto &stateTracker = state::StateTracker::getInstance();
-                        stateTracker.updateHotendActualTemp(temp);
-
-                        Logger::logInfo("[TemperatureCommands] Hotend temp: " + std::to_string(temp) + "°C");
-
-                        // Add the parsed temperature to the result
-                        result.body.clear();
-                        result.body.push_back("T:" + std::to_string(temp));
-                        break;
-                    }
-                }
-            } catch (const std::exception &e) {
-                Logger::logError("[TemperatureCommands] Failed to parse hotend temperature: " + std::string(e.what()));
-            }
-        }
-
-        return result;
+        return decodeHotendTemperature(sendCommand('T', 11, {}));
     }
 
     types::Result TemperatureCommands::getBedTemperature() {
         // T21 command gets bed temperature
-        auto result = sendCommand('T', 21, {});
-
-        if (result.isSuccess() && !result.body.empty()) {
-            try {
-                // Parse temperature from response body
-                for (const auto &line: result.body) {
-                    // Look for TEMP= pattern
-                    size_t pos = line.find("TEMP=");
-                    if (pos != std::string::npos) {
-                        std::string tempStr = line.substr(pos + 5);
-                        size_t endPos = tempStr.find(' ');
-                        if (endPos != std::string::npos) {
-                            tempStr = tempStr.substr(0, endPos);
-                        }
-
-                        double temp = std::stod(tempStr);
-                        auto &stateTracker = state::StateTracker::getInstance();
-                        stateTracker.updateBedActualTemp(temp);
-
-                        Logger::logInfo("[TemperatureCommands] Bed temp: " + std::to_string(temp) + "°C");
-
-                        // Add the parsed temperature to the result
-                        result.body.clear();
-                        result.body.push_back("T:" + std::to_string(temp));
-                        break;
-                    }
-                }
-            } catch (const std::exception &e) {
-                Logger::logError("[TemperatureCommands] Failed to parse bed temperature: " + std::string(e.what()));
-            }
+        return decodeBedTemperature(sendCommand('T', 21, {}));
+    }
+
+    std::future<types::Result> TemperatureCommands::getHotendTemperatureAsync() {
+        return sendCommandAsync<types::Result>('T', 11, {}, [this](const types::Result &result) {
+            return decodeHotendTemperature(result);
+        });
+    }
+
+    std::future<types::Result> TemperatureCommands::getBedTemperatureAsync() {
+        return sendCommandAsync<types::Result>('T', 21, {}, [this](const types::Result &result) {
+            return decodeBedTemperature(result);
+        });
+    }
+
+    types::Result TemperatureCommands::decodeHotendTemperature(const types::Result &result) const {
+        return decodeTemperature(result, true);
+    }
+
+    types::Result TemperatureCommands::decodeBedTemperature(const types::Result &result) const {
+        return decodeTemperature(result, false);
+    }
+
+    types::Result TemperatureCommands::decodeTemperature(const types::Result &result, bool hotend) const {
+        // La linea TEMP= è già decodificata dal CommandExecutor
+        if (!result.isSuccess() || !result.decoded.temperature) return result;
+
+        const auto &reading = *result.decoded.temperature;
+        auto &stateTracker = driver_->stateTracker();
+        if (hotend) {
+            stateTracker.updateHotendActualTemp(reading.actual);
+            if (reading.target) stateTracker.setHotendTargetTemp(*reading.target);
+        } else {
+            stateTracker.updateBedActualTemp(reading.actual);
+            if (reading.target) stateTracker.setBedTargetTemp(*reading.target);
         }
 
+        Logger::logInfo("[TemperatureCommands] " + std::string(hotend ? "Hotend" : "Bed") + " temp: " +
+                        std::to_string(reading.actual) + "°C");
         return result;
     }
 } // namespace core::command::temperature
\ No newline at end of file
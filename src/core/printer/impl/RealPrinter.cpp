@@ -6,8 +6,8 @@
 #include "logger/Logger.hpp"
 
 namespace core {
-    RealPrinter::RealPrinter(std::shared_ptr<SerialPort> serial)
-            : serial_(std::move(serial)) {
+    RealPrinter::RealPrinter(std::shared_ptr<SerialPort> serial, std::chrono::milliseconds readyTimeout)
+            : serial_(std::move(serial)), readyTimeout_(readyTimeout) {
     }
 
     void RealPrinter::initialize() {
@@ -17,18 +17,31 @@ namespace core {
             throw std::runtime_error("Serial port not open during printer initialization");
         }
 
+        auto start = std::chrono::steady_clock::now();
+        auto deadline = start + readyTimeout_;
         while (true) {
-            std::string line = serial_->receiveLine();
+            // Ogni lettura è limitata al tempo residuo: senza banner si esce allo scadere di readyTimeout_
+            auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+            if (remaining.count() <= 0) break;
+
+            std::string line = serial_->receiveLine(remaining);
             if (line.empty()) continue;
+            if (line == "CONN_LOST" || line == "SERIAL_ERROR") {
+                throw std::runtime_error("Serial link lost during printer initialization");
+            }
 
             Logger::logInfo("[Printer] RX during init: " + line);
             handleSystemMessage(line);
 
             if (systemReady_) {
-                Logger::logInfo("[Printer] System is ready!");
-                break;
+                auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::steady_clock::now() - start);
+                Logger::logInfo("[Printer] System is ready! (" + std::to_string(elapsed.count()) + "ms)");
+                return;
             }
         }
+
+        throw std::runtime_error("Firmware not ready after " + std::to_string(readyTimeout_.count()) + "ms");
     }
 
     void RealPrinter::shutdown() {
@@ -1,16 +1,164 @@
 #include "core/printer/job/GCodeDownloader.hpp"
+#include "application/config/ConfigManager.hpp"
+#include "core/printer/job/GCodeIndex.hpp"
 #include "logger/Logger.hpp"
 #include <curl/curl.h>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
 #include <fstream>
 #include <filesystem>
 #include <sstream>
 #include <iomanip>
+#include <optional>
 #include <chrono>
 #include <thread>
 
 namespace core::print {
+    namespace {
+        constexpr auto RETRY_DELAY_MIN = std::chrono::milliseconds(1000);
+        constexpr auto PROGRESS_INTERVAL = std::chrono::seconds(1); // Notifiche e finestra della velocità
+        constexpr auto CANCEL_POLL = std::chrono::milliseconds(100);
+        constexpr int MULTI_WAIT_MS = 200;
+
+        void applyCommonOptions(CURL *curl, const std::string &url) {
+            curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+            curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_1_1);
+            curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
+            curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0L);
+            curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 30L);
+            curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+            curl_easy_setopt(curl, CURLOPT_MAXREDIRS, 5L);
+            curl_easy_setopt(curl, CURLOPT_USERAGENT, "3DP-Driver/1.0");
+            // Il corpo di una risposta di errore non deve finire nel file
+            curl_easy_setopt(curl, CURLOPT_FAILONERROR, 1L);
+        }
+
+        // Accept-Ranges della risposta finale (un redirect apre un nuovo blocco di header)
+        size_t headerCallback(char *buffer, size_t size, size_t nitems, void *userdata) {
+            auto *acceptRanges = static_cast<bool *>(userdata);
+            std::string header(buffer, size * nitems);
+            std::transform(header.begin(), header.end(), header.begin(),
+                           [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            if (header.rfind("http/", 0) == 0) {
+                *acceptRanges = false;
+            } else if (header.rfind("accept-ranges:", 0) == 0 && header.find("bytes") != std::string::npos) {
+                *acceptRanges = true;
+            }
+            return size * nitems;
+        }
+
+        std::string formatRate(double bytesPerSecond) {
+            std::ostringstream oss;
+            oss << std::fixed << std::setprecision(1) << bytesPerSecond / 1024.0 << " KB/s";
+            return oss.str();
+        }
+    } // namespace
+
+    /**
+     * @brief Intervallo [begin, end) del file temporaneo scritto da una connessione. offset avanza con i byte
+     * scritti e sopravvive ai tentativi: il successivo riparte da lì. Il download sequenziale ha un solo
+     * intervallo aperto (end = 0) che alimenta anche indicizzatore e righe in streaming.
+     */
+    struct GCodeDownloader::Segment {
+        GCodeDownloader *downloader = nullptr;
+        size_t begin = 0;
+        size_t end = 0;
+        size_t offset = 0;
+        std::fstream file;
+        CURL *curl = nullptr;
+        std::unique_ptr<GCodeIndexer> indexer; // Solo download sequenziale
+
+        // Righe in streaming (solo download sequenziale)
+        std::string partialLine;
+        size_t seenLines = 0; // Righe eseguibili viste dall'inizio del file
+
+        // Esito del tentativo corrente
+        bool responseChecked = false;
+        bool rejected = false;     // Il destinatario delle righe ha interrotto il job
+        bool rangeIgnored = false; // Risposta completa a una richiesta Range su una connessione parallela
+
+        bool complete() const { return end > 0 && offset >= end; }
+
+        /**
+         * @brief Prima scrittura del tentativo. Una connessione parallela deve ricevere solo il proprio Range
+         * (per la ripresa sequenziale è CURL a rifiutare una risposta completa, con CURLE_RANGE_ERROR).
+         * @return false se i dati non si possono scrivere in questo intervallo
+         */
+        bool checkResponse() {
+            responseChecked = true;
+            long responseCode = 0;
+            curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &responseCode);
+            if (end > 0 && responseCode == 200) {
+                rangeIgnored = true;
+                return false;
+            }
+            if (end == 0) {
+                curl_off_t length = -1;
+                curl_easy_getinfo(curl, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &length);
+                if (length >= 0) downloader->totalBytes_ = offset + static_cast<size_t>(length);
+            }
+            return true;
+        }
+
+        /**
+         * @brief Ricomincia il file da capo; le righe già consegnate verranno saltate
+         */
+        void restart() {
+            offset = begin;
+            file.close();
+            file.open(downloader->tempFilePath_, std::ios::in | std::ios::out | std::ios::trunc | std::ios::binary);
+            if (indexer) indexer = std::make_unique<GCodeIndexer>();
+            partialLine.clear();
+            seenLines = 0;
+        }
+
+        /**
+         * @brief Consegna le righe eseguibili complete non ancora consegnate (stessa regola della coda).
+         * A fine file consegna anche l'ultima riga senza '\n'.
+         * @return false se il destinatario le rifiuta
+         */
+        bool deliverLines(const char *data, size_t size, bool endOfFile) {
+            std::vector<std::string> lines;
+            size_t &streamedLines = downloader->streamedLines_;
+            auto take = [this, &lines, &streamedLines](std::string &line) {
+                if (line.empty() || line[0] == ';' || line[0] == '%' ||
+                    line.find_first_not_of(" \t\r\n") == std::string::npos) {
+                    return;
+                }
+                // Dopo un restart il file riparte da capo: le righe già consegnate si saltano
+                if (++seenLines <= streamedLines) return;
+                lines.push_back(std::move(line));
+                ++streamedLines;
+            };
+
+            const char *end = data + size;
+            while (data < end) {
+                auto *newline = static_cast<const char *>(std::memchr(data, '\n', end - data));
+                if (!newline) {
+                    partialLine.append(data, end);
+                    break;
+                }
+                partialLine.append(data, newline);
+                take(partialLine);
+                partialLine.clear();
+                data = newline + 1;
+            }
+            if (endOfFile && !partialLine.empty()) {
+                take(partialLine);
+                partialLine.clear();
+            }
+            return lines.empty() || downloader->linesCallback_(std::move(lines));
+        }
+    };
+
     GCodeDownloader::GCodeDownloader() {
         curl_global_init(CURL_GLOBAL_DEFAULT);
+
+        auto config = config::ConfigManager::getInstance().getQueueConfig();
+        maxConnections_ = std::max(config.downloadConnections, 1);
+        parallelMinBytes_ = config.downloadParallelMinBytes;
+        retryMaxDelay_ = std::max(std::chrono::milliseconds(config.downloadRetryMaxMs), RETRY_DELAY_MIN);
     }
 
     GCodeDownloader::~GCodeDownloader() {
@@ -18,13 +166,17 @@ namespace core::print {
         if (downloadThread_.joinable()) {
             downloadThread_.join();
         }
+        for (CURL *curl: handles_) {
+            curl_easy_cleanup(curl);
+        }
         curl_global_cleanup();
     }
 
     void GCodeDownloader::downloadAsync(const std::string &url,
                                         const std::string &jobId,
                                         ProgressCallback progressCb,
-                                        CompletionCallback completionCb) {
+                                        CompletionCallback completionCb,
+                                        LinesCallback linesCb) {
         if (downloading_) {
             if (completionCb) {
                 completionCb(false, "", "Download already in progress");
@@ -32,13 +184,22 @@ namespace core::print {
             return;
         }
 
+        // Thread del download precedente, già concluso
+        if (downloadThread_.joinable()) {
+            downloadThread_.join();
+        }
+
         progressCallback_ = progressCb;
         completionCallback_ = completionCb;
+        linesCallback_ = linesCb;
+        streamedLines_ = 0;
         cancelRequested_ = false;
         {
             std::lock_guard<std::mutex> lock(progressMutex_);
             currentProgress_ = {};
             currentProgress_.url = url;
+            rateWindowStart_ = std::chrono::steady_clock::now();
+            rateWindowBytes_ = 0;
         }
 
         downloading_ = true;
@@ -50,172 +211,403 @@ namespace core::print {
     }
 
     void GCodeDownloader::downloadWorkerWithRetry(const std::string &url, const std::string &jobId) {
+        tempFilePath_ = generateTempFilePath(jobId);
+        downloadStart_ = std::chrono::steady_clock::now();
+        prepareSegments(url, true);
+
         int attemptNumber = 0;
-        const std::chrono::seconds RETRY_DELAY(10);
+        std::chrono::milliseconds retryDelay = RETRY_DELAY_MIN;
 
-        while (!cancelRequested_) {
+        while (!segments_.empty() && !cancelRequested_) {
             attemptNumber++;
+            bool parallel = segments_.size() > 1;
+            size_t before = downloadedBytes();
             Logger::logInfo("[GCodeDownloader] Download attempt #" + std::to_string(attemptNumber) +
-                            " for URL: " + url);
+                            " for URL: " + url + (parallel ? " (" + std::to_string(segments_.size()) +
+                                                             " connections)" : "") +
+                            (before > 0 ? " from byte " + std::to_string(before) : ""));
+            {
+                std::lock_guard<std::mutex> lock(progressMutex_);
+                currentProgress_.attempt = attemptNumber;
+                currentProgress_.connections = static_cast<int>(segments_.size());
+            }
 
-            bool success = performSingleDownload(url, jobId);
+            bool success = parallel ? performParallelDownload(url) : performSingleDownload(url);
 
             if (success) {
                 // Download completato con successo
+                segments_.clear();
                 downloading_ = false;
                 return;
             }
 
-            if (cancelRequested_) {
-                // Download cancellato dall'utente
-                downloading_ = false;
-                if (completionCallback_) {
-                    completionCallback_(false, "", "Download cancelled by user");
-                }
-                return;
+            if (cancelRequested_) break;
+
+            // Un tentativo che ha scaricato qualcosa riporta l'attesa al minimo
+            if (downloadedBytes() > before) {
+                retryDelay = RETRY_DELAY_MIN;
             }
 
-            // Download fallito, aspetta prima di riprovare
             Logger::logWarning("[GCodeDownloader] Download failed on attempt #" +
-                               std::to_string(attemptNumber) +
-                               ". Retrying in " + std::to_string(RETRY_DELAY.count()) + " seconds...");
-
-            // Notifica il callback del progress che stiamo aspettando per il retry
-            {
-                std::lock_guard<std::mutex> lock(progressMutex_);
-                currentProgress_.status = "Waiting for retry (attempt #" +
-                                          std::to_string(attemptNumber + 1) + " in " +
-                                          std::to_string(RETRY_DELAY.count()) + " seconds)";
-            }
+                               std::to_string(attemptNumber) + ". Retrying in " +
+                               std::to_string(retryDelay.count()) + " ms from byte " +
+                               std::to_string(downloadedBytes()) + "...");
+            setStatus("Waiting for retry (attempt #" + std::to_string(attemptNumber + 1) + " in " +
+                      std::to_string(retryDelay.count()) + " ms)");
 
             // Attendi con possibilità di interruzione
-            for (int i = 0; i < RETRY_DELAY.count() && !cancelRequested_; ++i) {
-                std::this_thread::sleep_for(std::chrono::seconds(1));
+            auto retryAt = std::chrono::steady_clock::now() + retryDelay;
+            while (!cancelRequested_ && std::chrono::steady_clock::now() < retryAt) {
+                std::this_thread::sleep_for(CANCEL_POLL);
             }
+            retryDelay = std::min(retryDelay * 2, retryMaxDelay_);
         }
 
-        // Se arriviamo qui, il download è stato cancellato
+        // Annullato (o file temporaneo non creato)
+        bool cancelled = cancelRequested_;
+        segments_.clear();
+        std::error_code ec;
+        std::filesystem::remove(tempFilePath_, ec);
         downloading_ = false;
         if (completionCallback_) {
-            completionCallback_(false, "", "Download cancelled");
+            completionCallback_(false, "", cancelled ? "Download cancelled by user"
+                                                     : "Cannot create temp file: " + tempFilePath_);
         }
     }
 
-    bool GCodeDownloader::performSingleDownload(const std::string &url, const std::string &jobId) {
-        std::string tempFilePath = generateTempFilePath(jobId);
-        std::ofstream outFile(tempFilePath, std::ios::binary);
+    bool GCodeDownloader::prepareSegments(const std::string &url, bool allowParallel) {
+        segments_.clear();
+        totalBytes_ = 0;
 
-        if (!outFile.is_open()) {
-            Logger::logError("[GCodeDownloader] Cannot create temp file: " + tempFilePath);
-            return false;
+        size_t total = 0;
+        size_t connections = 1;
+        if (allowParallel && maxConnections_ > 1 && !linesCallback_ && probeRanges(url, total) &&
+            total >= parallelMinBytes_) {
+            connections = std::min(static_cast<size_t>(maxConnections_), total);
         }
 
-        CURL *curl = curl_easy_init();
-        if (!curl) {
-            Logger::logError("[GCodeDownloader] Failed to initialize CURL");
-            outFile.close();
-            std::filesystem::remove(tempFilePath);
-            return false;
+        {
+            std::ofstream create(tempFilePath_, std::ios::binary | std::ios::trunc);
+            if (!create) {
+                Logger::logError("[GCodeDownloader] Cannot create temp file: " + tempFilePath_);
+                return false;
+            }
+        }
+        std::error_code ec;
+        if (connections > 1) {
+            // Ogni connessione scrive al proprio offset
+            std::filesystem::resize_file(tempFilePath_, total, ec);
+            totalBytes_ = total;
+        }
+
+        size_t step = total / connections;
+        for (size_t i = 0; i < connections; ++i) {
+            auto segment = std::make_unique<Segment>();
+            segment->downloader = this;
+            if (connections > 1) {
+                segment->begin = i * step;
+                segment->end = i + 1 == connections ? total : segment->begin + step;
+            } else {
+                segment->indexer = std::make_unique<GCodeIndexer>();
+            }
+            segment->offset = segment->begin;
+            segment->file.open(tempFilePath_, std::ios::in | std::ios::out | std::ios::binary);
+            if (!segment->file.is_open()) {
+                Logger::logError("[GCodeDownloader] Cannot open temp file: " + tempFilePath_);
+                segments_.clear();
+                return false;
+            }
+            segments_.push_back(std::move(segment));
+        }
+
+        if (connections > 1) {
+            Logger::logInfo("[GCodeDownloader] Downloading " + std::to_string(total) + " bytes over " +
+                            std::to_string(connections) + " connections");
         }
+        return true;
+    }
+
+    bool GCodeDownloader::probeRanges(const std::string &url, size_t &totalBytes) {
+        CURL *curl = handle(0);
+        if (!curl) return false;
+
+        bool acceptRanges = false;
+        curl_easy_reset(curl);
+        applyCommonOptions(curl, url);
+        curl_easy_setopt(curl, CURLOPT_NOBODY, 1L);
+        curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, headerCallback);
+        curl_easy_setopt(curl, CURLOPT_HEADERDATA, &acceptRanges);
 
-        // Configurazione CURL
+        if (curl_easy_perform(curl) != CURLE_OK) return false;
+        curl_off_t length = -1;
+        curl_easy_getinfo(curl, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &length);
+        if (!acceptRanges || length <= 0) return false;
+
+        totalBytes = static_cast<size_t>(length);
+        return true;
+    }
+
+    void GCodeDownloader::configureTransfer(CURL *curl, const std::string &url, Segment &segment) {
+        // Opzioni da capo: la connessione aperta e la cache DNS dell'handle restano
+        curl_easy_reset(curl);
+        applyCommonOptions(curl, url);
         curl_easy_setopt(curl, CURLOPT_VERBOSE, 1L);
-        curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_1_1);
         curl_easy_setopt(curl, CURLOPT_HTTP_TRANSFER_DECODING, 1L);
-
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0L);
-        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
         curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeCallback);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &outFile);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &segment);
         curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, progressCallback);
-        curl_easy_setopt(curl, CURLOPT_XFERINFODATA, this);
+        curl_easy_setopt(curl, CURLOPT_XFERINFODATA, &segment);
         curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
 
-        // Timeouts
-        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 30L);
-        curl_easy_setopt(curl, CURLOPT_TIMEOUT, 300L);
+        // Nessun timeout totale: un file grande su una linea lenta deve poter finire
         curl_easy_setopt(curl, CURLOPT_LOW_SPEED_TIME, 60L);
         curl_easy_setopt(curl, CURLOPT_LOW_SPEED_LIMIT, 1024L);
-        curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
-        curl_easy_setopt(curl, CURLOPT_MAXREDIRS, 5L);
-        curl_easy_setopt(curl, CURLOPT_USERAGENT, "3DP-Driver/1.0");
 
-        // Reset progress status
-        {
-            std::lock_guard<std::mutex> lock(progressMutex_);
-            currentProgress_.status = "Downloading...";
+        if (segment.end > 0) {
+            std::string range = std::to_string(segment.offset) + "-" + std::to_string(segment.end - 1);
+            curl_easy_setopt(curl, CURLOPT_RANGE, range.c_str());
+        } else if (segment.offset > 0) {
+            curl_easy_setopt(curl, CURLOPT_RESUME_FROM_LARGE, static_cast<curl_off_t>(segment.offset));
+        }
+
+        segment.curl = curl;
+        segment.responseChecked = false;
+        segment.rejected = false;
+        segment.rangeIgnored = false;
+        segment.file.clear();
+        segment.file.seekp(static_cast<std::streamoff>(segment.offset));
+    }
+
+    bool GCodeDownloader::performSingleDownload(const std::string &url) {
+        Segment &segment = *segments_.front();
+        CURL *curl = handle(0);
+        if (!curl) {
+            Logger::logError("[GCodeDownloader] Failed to initialize CURL");
+            return false;
         }
 
+        configureTransfer(curl, url, segment);
+        setStatus("Downloading...");
+
         CURLcode res = curl_easy_perform(curl);
         long responseCode = 0;
         curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &responseCode);
+        segment.file.flush();
 
-        curl_easy_cleanup(curl);
-        outFile.close();
-
-        bool success = false;
-        std::string error;
-
+        if (segment.rejected && !cancelRequested_) {
+            // Il destinatario delle righe ha interrotto il job: nessun nuovo tentativo
+            Logger::logWarning("[GCodeDownloader] Streamed lines rejected, stopping download");
+            cancelRequested_ = true;
+        }
         if (cancelRequested_) {
-            std::filesystem::remove(tempFilePath);
             return false; // Verrà gestito dal chiamante
-        } else if (res != CURLE_OK) {
-            error = "Download failed: " + std::string(curl_easy_strerror(res));
-            Logger::logError("[GCodeDownloader] " + error);
-            std::filesystem::remove(tempFilePath);
-        } else if (responseCode != 200) {
-            error = "HTTP error: " + std::to_string(responseCode);
-            Logger::logError("[GCodeDownloader] " + error);
-            std::filesystem::remove(tempFilePath);
-        } else {
-            if (std::filesystem::exists(tempFilePath) && std::filesystem::file_size(tempFilePath) > 0) {
-                success = true;
-                Logger::logInfo("[GCodeDownloader] Download completed successfully: " + tempFilePath +
-                                " (" + std::to_string(std::filesystem::file_size(tempFilePath)) + " bytes)");
+        }
 
-                if (completionCallback_) {
-                    completionCallback_(true, tempFilePath, "");
+        if (res == CURLE_RANGE_ERROR && segment.offset > 0) {
+            // Il server ignora i Range: si riparte subito da zero, le righe già consegnate vengono saltate
+            Logger::logWarning("[GCodeDownloader] Server cannot resume, restarting from byte 0");
+            segment.restart();
+            return performSingleDownload(url);
+        }
+        if (res == CURLE_HTTP_RETURNED_ERROR && responseCode == 416 && segment.offset > 0) {
+            // Nessun byte oltre l'offset: file già completo, oppure cambiato sul server
+            if (segment.offset == totalBytes_) return finishDownload();
+            Logger::logWarning("[GCodeDownloader] Range not satisfiable, restarting from byte 0");
+            segment.restart();
+            return false;
+        }
+        if (res != CURLE_OK) {
+            Logger::logError("[GCodeDownloader] Download failed: " + std::string(curl_easy_strerror(res)) +
+                             (responseCode >= 400 ? " (HTTP " + std::to_string(responseCode) + ")" : ""));
+            return false;
+        }
+        return finishDownload();
+    }
+
+    bool GCodeDownloader::performParallelDownload(const std::string &url) {
+        CURLM *multi = curl_multi_init();
+        if (!multi) {
+            Logger::logError("[GCodeDownloader] Failed to initialize CURL multi handle");
+            return false;
+        }
+
+        std::vector<CURL *> added;
+        for (size_t i = 0; i < segments_.size(); ++i) {
+            auto &segment = *segments_[i];
+            if (segment.complete()) continue;
+            CURL *curl = handle(i);
+            if (!curl) continue; // L'intervallo resta incompleto: il tentativo fallisce
+            configureTransfer(curl, url, segment);
+            curl_multi_add_handle(multi, curl);
+            added.push_back(curl);
+        }
+        setStatus("Downloading (" + std::to_string(added.size()) + " connections)...");
+
+        int running = 0;
+        do {
+            if (curl_multi_perform(multi, &running) != CURLM_OK) break;
+            int queued = 0;
+            while (CURLMsg *msg = curl_multi_info_read(multi, &queued)) {
+                if (msg->msg == CURLMSG_DONE && msg->data.result != CURLE_OK && !cancelRequested_) {
+                    Logger::logError("[GCodeDownloader] Range download failed: " +
+                                     std::string(curl_easy_strerror(msg->data.result)));
                 }
-            } else {
-                error = "Downloaded file is empty or missing";
-                Logger::logError("[GCodeDownloader] " + error);
-                std::filesystem::remove(tempFilePath);
             }
+            if (running > 0) curl_multi_wait(multi, nullptr, 0, MULTI_WAIT_MS, nullptr);
+        } while (running > 0 && !cancelRequested_);
+
+        for (CURL *curl: added) {
+            curl_multi_remove_handle(multi, curl);
+        }
+        curl_multi_cleanup(multi);
+        for (auto &segment: segments_) {
+            segment->file.flush();
+        }
+
+        if (cancelRequested_) return false;
+
+        bool rangeIgnored = std::any_of(segments_.begin(), segments_.end(),
+                                        [](const auto &segment) { return segment->rangeIgnored; });
+        if (rangeIgnored) {
+            Logger::logWarning("[GCodeDownloader] Server ignored range requests, falling back to one connection");
+            prepareSegments(url, false);
+            return false;
         }
 
-        return success;
+        bool complete = std::all_of(segments_.begin(), segments_.end(),
+                                    [](const auto &segment) { return segment->complete(); });
+        return complete && finishDownload();
+    }
+
+    bool GCodeDownloader::finishDownload() {
+        std::error_code ec;
+        auto size = std::filesystem::file_size(tempFilePath_, ec);
+        if (ec || size == 0) {
+            Logger::logError("[GCodeDownloader] Downloaded file is empty or missing");
+            return false;
+        }
+
+        for (auto &segment: segments_) {
+            segment->file.close();
+        }
+        publishProgress(true);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - downloadStart_).count();
+        Logger::logInfo("[GCodeDownloader] Download completed successfully: " + tempFilePath_ + " (" +
+                        std::to_string(size) + " bytes, " +
+                        formatRate(seconds > 0 ? static_cast<double>(size) / seconds : 0.0) + ")");
+
+        std::optional<GCodeIndex> index;
+        Segment &sequential = *segments_.front();
+        if (sequential.indexer) {
+            // Ultima riga senza '\n', prima del callback di completamento
+            if (linesCallback_) {
+                sequential.deliverLines(nullptr, 0, true);
+            }
+            // Indice costruito durante il download: il job parte senza rileggere il file
+            index = sequential.indexer->finish();
+        } else {
+            // Intervalli arrivati fuori ordine: indice con una lettura del file
+            index = GCodeIndex::build(tempFilePath_);
+        }
+        if (index && index->save(GCodeIndex::pathFor(tempFilePath_))) {
+            Logger::logInfo("[GCodeDownloader] Indexed " + std::to_string(index->commandCount()) +
+                            " commands, " + std::to_string(index->layers.size()) + " layers");
+        }
+
+        if (completionCallback_) {
+            completionCallback_(true, tempFilePath_, "");
+        }
+        return true;
+    }
+
+    CURL *GCodeDownloader::handle(size_t index) {
+        while (handles_.size() <= index) {
+            CURL *curl = curl_easy_init();
+            if (!curl) return nullptr;
+            handles_.push_back(curl);
+        }
+        return handles_[index];
+    }
+
+    size_t GCodeDownloader::downloadedBytes() const {
+        size_t downloaded = 0;
+        for (const auto &segment: segments_) {
+            downloaded += segment->offset - segment->begin;
+        }
+        return downloaded;
+    }
+
+    void GCodeDownloader::setStatus(const std::string &status) {
+        std::lock_guard<std::mutex> lock(progressMutex_);
+        currentProgress_.status = status;
+    }
+
+    void GCodeDownloader::publishProgress(bool force) {
+        auto now = std::chrono::steady_clock::now();
+        size_t downloaded = downloadedBytes();
+        DownloadProgress progress;
+        {
+            std::lock_guard<std::mutex> lock(progressMutex_);
+            currentProgress_.totalBytes = totalBytes_;
+            currentProgress_.downloadedBytes = downloaded;
+            currentProgress_.percentage = totalBytes_ > 0 ? (double(downloaded) / totalBytes_) * 100.0 : 0.0;
+
+            auto elapsed = now - rateWindowStart_;
+            if (!force && elapsed < PROGRESS_INTERVAL) return;
+            double seconds = std::chrono::duration<double>(elapsed).count();
+            // Dopo un restart i byte ripartono da zero: la finestra ricomincia
+            if (seconds > 0 && downloaded >= rateWindowBytes_) {
+                currentProgress_.bytesPerSecond = double(downloaded - rateWindowBytes_) / seconds;
+            }
+            rateWindowStart_ = now;
+            rateWindowBytes_ = downloaded;
+            progress = currentProgress_;
+        }
+
+        if (progressCallback_) {
+            progressCallback_(progress);
+        }
     }
 
     size_t GCodeDownloader::writeCallback(void *contents, size_t size, size_t nmemb, void *userp) {
-        std::ofstream *file = static_cast<std::ofstream *>(userp);
+        auto *segment = static_cast<Segment *>(userp);
         size_t totalSize = size * nmemb;
-        file->write(static_cast<char *>(contents), totalSize);
+        if (!segment->responseChecked && !segment->checkResponse()) {
+            return 0; // Range ignorato: CURL interrompe il trasferimento
+        }
+
+        const char *data = static_cast<const char *>(contents);
+        segment->file.write(data, totalSize);
+        if (!segment->file) {
+            return 0; // Disco pieno o errore di scrittura: CURL interrompe il trasferimento
+        }
+        segment->offset += totalSize;
+        if (segment->indexer) {
+            segment->indexer->feed(data, totalSize);
+        }
+        if (segment->downloader->linesCallback_ && !segment->deliverLines(data, totalSize, false)) {
+            segment->rejected = true;
+            return 0; // CURL interrompe il trasferimento
+        }
         return totalSize;
     }
 
-    int GCodeDownloader::progressCallback(void *clientp, curl_off_t dltotal, curl_off_t dlnow,
-                                          curl_off_t ultotal, curl_off_t ulnow) {
+    int GCodeDownloader::progressCallback(void *clientp, std::int64_t dltotal, std::int64_t dlnow,
+                                          std::int64_t ultotal, std::int64_t ulnow) {
+        (void) dltotal;
+        (void) dlnow;
         (void) ultotal;
         (void) ulnow;
 
-        GCodeDownloader *downloader = static_cast<GCodeDownloader *>(clientp);
+        // I byte scritti dagli intervalli contano anche i tentativi precedenti, a differenza di dlnow
+        auto *segment = static_cast<Segment *>(clientp);
+        GCodeDownloader *downloader = segment->downloader;
 
         if (downloader->cancelRequested_) {
             return 1; // Abort download
         }
 
-        if (dltotal > 0) {
-            std::lock_guard<std::mutex> lock(downloader->progressMutex_);
-            downloader->currentProgress_.totalBytes = dltotal;
-            downloader->currentProgress_.downloadedBytes = dlnow;
-            downloader->currentProgress_.percentage = (double(dlnow) / dltotal) * 100.0;
-
-            if (downloader->progressCallback_) {
-                downloader->progressCallback_(downloader->currentProgress_);
-            }
-        }
-
+        downloader->publishProgress(false);
         return 0; // Continue download
     }
 
@@ -245,4 +637,4 @@ namespace core::print {
         std::lock_guard<std::mutex> lock(progressMutex_);
         return currentProgress_;
     }
-} // namespace core::print
\ No newline at end of file
+} // namespace core::print
@@ -0,0 +1,311 @@
+#include "core/printer/job/GCodeIndex.hpp"
+#include "logger/Logger.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <zlib.h>
+
+namespace core::print {
+    namespace {
+        constexpr char INDEX_MAGIC[6] = {'3', 'D', 'P', 'I', 'D', 'X'};
+        constexpr uint16_t INDEX_VERSION = 2;
+        constexpr double LAYER_THRESHOLD = 0.1;
+
+        template<typename T>
+        void writeValue(std::ofstream &out, const T &value) {
+            out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+        }
+
+        template<typename T>
+        bool readValue(std::ifstream &in, T &value) {
+            return static_cast<bool>(in.read(reinterpret_cast<char *>(&value), sizeof(T)));
+        }
+
+        void writeState(std::ofstream &out, const GCodeModalState &state) {
+            writeValue(out, state.x);
+            writeValue(out, state.y);
+            writeValue(out, state.z);
+            writeValue(out, state.e);
+            writeValue(out, state.feedRate);
+            writeValue(out, state.hotendTemp);
+            writeValue(out, state.bedTemp);
+            writeValue(out, static_cast<int32_t>(state.fanSpeed));
+            writeValue(out, static_cast<uint8_t>(state.absolutePositioning));
+            writeValue(out, static_cast<uint8_t>(state.absoluteExtrusion));
+        }
+
+        bool readState(std::ifstream &in, GCodeModalState &state) {
+            int32_t fanSpeed = 0;
+            uint8_t absolutePositioning = 1;
+            uint8_t absoluteExtrusion = 1;
+            if (!readValue(in, state.x) || !readValue(in, state.y) || !readValue(in, state.z) ||
+                !readValue(in, state.e) || !readValue(in, state.feedRate) || !readValue(in, state.hotendTemp) ||
+                !readValue(in, state.bedTemp) || !readValue(in, fanSpeed) || !readValue(in, absolutePositioning) ||
+                !readValue(in, absoluteExtrusion)) {
+                return false;
+            }
+            state.fanSpeed = fanSpeed;
+            state.absolutePositioning = absolutePositioning != 0;
+            state.absoluteExtrusion = absoluteExtrusion != 0;
+            return true;
+        }
+    } // namespace
+
+    GCodeModalState::LineInfo GCodeModalState::apply(const char *line) {
+        LineInfo info;
+        while (*line == ' ' || *line == '\t') line++;
+        char letter = static_cast<char>(std::toupper(static_cast<unsigned char>(*line)));
+        if (letter != 'G' && letter != 'M') return info;
+
+        char *end = nullptr;
+        long code = std::strtol(line + 1, &end, 10);
+        if (end == line + 1) return info;
+        info.letter = letter;
+        info.code = code;
+
+        // Parametri: una lettera seguita da un numero, fino al commento
+        std::optional<double> params[26];
+        for (const char *p = end; *p && *p != ';'; ++p) {
+            int key = std::toupper(static_cast<unsigned char>(*p)) - 'A';
+            if (key < 0 || key >= 26) continue;
+            char *valueEnd = nullptr;
+            double value = std::strtod(p + 1, &valueEnd);
+            if (valueEnd == p + 1) continue;
+            params[key] = value;
+            p = valueEnd - 1;
+        }
+        auto param = [&params](char key) -> const std::optional<double> & { return params[key - 'A']; };
+        info.hasZ = param('Z').has_value();
+        info.hasE = param('E').has_value();
+
+        if (letter == 'G') {
+            switch (code) {
+                case 0:
+                case 1:
+                case 2:
+                case 3: {
+                    double *axes[] = {&x, &y, &z};
+                    const char keys[] = {'X', 'Y', 'Z'};
+                    for (int i = 0; i < 3; ++i) {
+                        if (!param(keys[i])) continue;
+                        *axes[i] = absolutePositioning ? *param(keys[i]) : *axes[i] + *param(keys[i]);
+                    }
+                    if (param('E')) e = absoluteExtrusion ? *param('E') : e + *param('E');
+                    if (param('F')) feedRate = *param('F');
+                    break;
+                }
+                case 28: {
+                    bool all = !param('X') && !param('Y') && !param('Z');
+                    if (all || param('X')) x = 0.0;
+                    if (all || param('Y')) y = 0.0;
+                    if (all || param('Z')) z = 0.0;
+                    break;
+                }
+                case 90: absolutePositioning = absoluteExtrusion = true;
+                    break;
+                case 91: absolutePositioning = absoluteExtrusion = false;
+                    break;
+                case 92: {
+                    bool all = !param('X') && !param('Y') && !param('Z') && !param('E');
+                    x = param('X').value_or(all ? 0.0 : x);
+                    y = param('Y').value_or(all ? 0.0 : y);
+                    z = param('Z').value_or(all ? 0.0 : z);
+                    e = param('E').value_or(all ? 0.0 : e);
+                    break;
+                }
+                default: break;
+            }
+        } else {
+            switch (code) {
+                case 82: absoluteExtrusion = true;
+                    break;
+                case 83: absoluteExtrusion = false;
+                    break;
+                case 104:
+                case 109: if (param('S')) hotendTemp = *param('S');
+                    break;
+                case 140:
+                case 190: if (param('S')) bedTemp = *param('S');
+                    break;
+                case 106: fanSpeed = static_cast<int>(param('S').value_or(255.0));
+                    break;
+                case 107: fanSpeed = 0;
+                    break;
+                default: break;
+            }
+        }
+        return info;
+    }
+
+    bool GCodeIndex::save(const std::string &path) const {
+        std::string tempPath = path + ".tmp";
+        {
+            std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+            if (!out.is_open()) {
+                Logger::logError("[GCodeIndex] Cannot write " + tempPath);
+                return false;
+            }
+            out.write(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+            writeValue(out, INDEX_VERSION);
+            writeValue(out, fileSize);
+            writeValue(out, totalLines);
+            writeValue(out, crc32);
+            writeValue(out, moveCommands);
+            writeValue(out, extrusionMoves);
+            writeValue(out, commentLines);
+            writeValue(out, maxZ);
+            writeValue(out, static_cast<uint64_t>(commandOffsets.size()));
+            writeValue(out, static_cast<uint64_t>(layers.size()));
+            out.write(reinterpret_cast<const char *>(commandOffsets.data()),
+                      static_cast<std::streamsize>(commandOffsets.size() * sizeof(uint64_t)));
+            for (const auto &layer: layers) {
+                writeValue(out, layer.commandIndex);
+                writeValue(out, layer.offset);
+                writeValue(out, layer.z);
+                writeState(out, layer.state);
+            }
+            if (!out) {
+                Logger::logError("[GCodeIndex] Write failed: " + tempPath);
+                return false;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tempPath, path, ec);
+        if (ec) {
+            Logger::logError("[GCodeIndex] Cannot rename " + tempPath + ": " + ec.message());
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+        return true;
+    }
+
+    std::optional<GCodeIndex> GCodeIndex::load(const std::string &gcodePath) {
+        std::ifstream in(pathFor(gcodePath), std::ios::binary);
+        if (!in.is_open()) return std::nullopt;
+
+        char magic[sizeof(INDEX_MAGIC)];
+        uint16_t version = 0;
+        if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, INDEX_MAGIC, sizeof(magic)) != 0 ||
+            !readValue(in, version) || version != INDEX_VERSION) {
+            return std::nullopt;
+        }
+
+        GCodeIndex index;
+        uint64_t commandCount = 0;
+        uint64_t layerCount = 0;
+        if (!readValue(in, index.fileSize) || !readValue(in, index.totalLines) || !readValue(in, index.crc32) ||
+            !readValue(in, index.moveCommands) || !readValue(in, index.extrusionMoves) ||
+            !readValue(in, index.commentLines) || !readValue(in, index.maxZ) ||
+            !readValue(in, commandCount) || !readValue(in, layerCount)) {
+            return std::nullopt;
+        }
+
+        // Indice di un'altra versione del file (es. download sovrascritto)
+        std::error_code ec;
+        auto actualSize = std::filesystem::file_size(gcodePath, ec);
+        if (ec || actualSize != index.fileSize || commandCount > index.fileSize || layerCount > commandCount) {
+            return std::nullopt;
+        }
+
+        index.commandOffsets.resize(commandCount);
+        if (!in.read(reinterpret_cast<char *>(index.commandOffsets.data()),
+                     static_cast<std::streamsize>(commandCount * sizeof(uint64_t)))) {
+            return std::nullopt;
+        }
+        index.layers.resize(layerCount);
+        for (auto &layer: index.layers) {
+            if (!readValue(in, layer.commandIndex) || !readValue(in, layer.offset) || !readValue(in, layer.z) ||
+                !readState(in, layer.state)) {
+                return std::nullopt;
+            }
+        }
+        return index;
+    }
+
+    std::optional<GCodeIndex> GCodeIndex::build(const std::string &gcodePath) {
+        std::ifstream in(gcodePath, std::ios::binary);
+        if (!in.is_open()) return std::nullopt;
+
+        GCodeIndexer indexer;
+        std::vector<char> buffer(256 * 1024);
+        while (in) {
+            in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            if (in.gcount() > 0) indexer.feed(buffer.data(), static_cast<size_t>(in.gcount()));
+        }
+        if (in.bad()) return std::nullopt;
+        return indexer.finish();
+    }
+
+    void GCodeIndexer::feed(const char *data, size_t size) {
+        index_.crc32 = static_cast<uint32_t>(
+            ::crc32(index_.crc32, reinterpret_cast<const Bytef *>(data), static_cast<uInt>(size)));
+        index_.fileSize += size;
+
+        size_t position = 0;
+        while (position < size) {
+            const auto *newline = static_cast<const char *>(std::memchr(data + position, '\n', size - position));
+            size_t end = newline ? static_cast<size_t>(newline - data) : size;
+            appendToLine(data + position, end - position);
+            if (!newline) {
+                offset_ += end - position;
+                break;
+            }
+            offset_ += end - position + 1;
+            finishLine();
+            lineStart_ = offset_;
+            position = end + 1;
+        }
+    }
+
+    GCodeIndex GCodeIndexer::finish() {
+        if (offset_ > lineStart_) {
+            finishLine();
+            lineStart_ = offset_;
+        }
+        GCodeIndex index = std::move(index_);
+        index_ = GCodeIndex{};
+        return index;
+    }
+
+    void GCodeIndexer::appendToLine(const char *data, size_t size) {
+        if (line_.size() < MAX_PARSED_LINE) {
+            line_.append(data, std::min(size, MAX_PARSED_LINE - line_.size()));
+        }
+        for (size_t i = 0; i < size && !hasContent_; ++i) {
+            hasContent_ = data[i] != ' ' && data[i] != '\t' && data[i] != '\r';
+        }
+    }
+
+    void GCodeIndexer::finishLine() {
+        index_.totalLines++;
+        if (!line_.empty() && (line_[0] == ';' || line_[0] == '%')) {
+            index_.commentLines++;
+        } else if (hasContent_) {
+            index_.commandOffsets.push_back(lineStart_);
+            parseCommand();
+        }
+        line_.clear();
+        hasContent_ = false;
+    }
+
+    void GCodeIndexer::parseCommand() {
+        GCodeModalState before = modal_;
+        auto line = modal_.apply(line_.c_str());
+        if (line.letter != 'G' || line.code < 0 || line.code > 3) return;
+
+        index_.moveCommands++;
+        if (line.hasE) index_.extrusionMoves++;
+
+        if (line.hasZ && line.code <= 1) {
+            if (modal_.z > lastZ_ + LAYER_THRESHOLD) {
+                index_.layers.push_back({index_.commandOffsets.size() - 1, lineStart_, modal_.z, before});
+            }
+            lastZ_ = modal_.z;
+            index_.maxZ = std::max(index_.maxZ, modal_.z);
+        }
+    }
+} // namespace core::print
@@ -1,22 +1,60 @@
 #include "core/printer/job/PrintJobManager.hpp"
+#include "application/config/ConfigManager.hpp"
+#include "core/printer/job/GCodeIndex.hpp"
+#include "core/printer/job/tracking/JobCheckpoint.hpp"
 #include "core/printer/job/tracking/JobTracker.hpp"
+#include "core/printer/state/StateTracker.hpp"
+#include "core/utils/FloatFormatter.hpp"
 #include "logger/Logger.hpp"
+#include <algorithm>
 #include <cmath>
 #include <fstream>
 #include <filesystem>
+#include <iterator>
 
 namespace core::print {
+    namespace {
+        constexpr double RESUME_Z_LIFT = 2.0;            // mm sopra la quota di ripresa durante lo spostamento XY
+        constexpr double RESUME_Z_FEEDRATE = 600.0;      // mm/min
+        constexpr double RESUME_TRAVEL_FEEDRATE = 3000.0; // mm/min
+        constexpr int RESUME_PRECISION = 3;
+        constexpr size_t RESUME_BATCH_LINES = 1024;       // Righe lette e accodate per volta dal punto di ripresa
+
+        // Righe eseguibili fino a un blocco pieno o alla fine del file
+        bool readResumeBatch(std::ifstream &file, std::vector<std::string> &batch) {
+            std::string line;
+            while (batch.size() < RESUME_BATCH_LINES && std::getline(file, line)) {
+                if (!line.empty() && line.find_first_not_of(" \t\r\n") != std::string::npos &&
+                    line[0] != ';' && line[0] != '%') {
+                    batch.push_back(std::move(line));
+                }
+            }
+            return !batch.empty();
+        }
+    } // namespace
+
     PrintJobManager::PrintJobManager(std::shared_ptr<DriverInterface> driver,
-                                     std::shared_ptr<core::CommandExecutorQueue> commandQueue)
-            : driver_(driver), commandQueue_(commandQueue), currentState_(JobState::CREATED) {
+                                     std::shared_ptr<core::CommandExecutorQueue> commandQueue,
+                                     jobs::JobCheckpoint &checkpoint)
+            : driver_(driver), commandQueue_(commandQueue), checkpoint_(checkpoint), currentState_(JobState::CREATED) {
+        streamMargin_ = config::ConfigManager::getInstance().getQueueConfig().streamMarginLines;
+    }
+
+    PrintJobManager::~PrintJobManager() {
+        std::unique_lock<std::mutex> lock(stateMutex_);
+        stopResumeReader(lock);
     }
 
-    bool PrintJobManager::startPrintJob(const std::string &gcodePath, const std::string &jobId) {
+    bool PrintJobManager::startPrintJob(const std::string &gcodePath, const std::string &jobId,
+                                        const std::vector<std::string> &startCommands,
+                                        const std::vector<std::string> &endCommands) {
         std::lock_guard<std::mutex> lock(stateMutex_);
-        return startPrintJobInternal(gcodePath, jobId);
+        return startPrintJobInternal(gcodePath, jobId, startCommands, endCommands);
     }
 
-    bool PrintJobManager::startPrintJobInternal(const std::string &gcodePath, const std::string &jobId) {
+    bool PrintJobManager::startPrintJobInternal(const std::string &gcodePath, const std::string &jobId,
+                                                const std::vector<std::string> &startCommands,
+                                                const std::vector<std::string> &endCommands) {
         if (currentState_ == JobState::RUNNING) {
             Logger::logError("[PrintJobManager] Cannot start - job already active: " + currentJobId_);
             return false;
@@ -38,23 +76,19 @@ namespace core::print {
         // Load file
         updateState(JobState::LOADING);
 
-        // Count lines for progress tracking
-        std::ifstream file(gcodePath);
-        if (!file.is_open()) {
+        // Command count from the index built while downloading; local files are indexed here in one pass
+        auto index = loadIndex(gcodePath);
+        if (!index) {
             Logger::logError("[PrintJobManager] Cannot open G-code file: " + gcodePath);
             updateState(JobState::FAILED);
             driver_->setState(PrintState::Error);
             return false;
         }
 
-        std::string line;
-        size_t lineCount = 0;
-        while (std::getline(file, line)) {
-            if (!line.empty() && line[0] != ';' && line[0] != '%') {
-                lineCount++;
-            }
-        }
-        file.close();
+        size_t lineCount = index->commandCount();
+        Logger::logInfo("[PrintJobManager] G-code index: " + std::to_string(lineCount) + " commands, " +
+                        std::to_string(index->layers.size()) + " layers, " +
+                        std::to_string(index->moveCommands) + " moves, max Z " + std::to_string(index->maxZ));
 
         // Initialize job in tracker
         auto &jobTracker = jobs::JobTracker::getInstance();
@@ -73,9 +107,13 @@ namespace core::print {
             commandQueue_->start();
         }
 
-        // Queue the entire G-code file
+        // Queue the entire G-code file, between the job's start and end G-code (same priority, FIFO)
         Logger::logInfo("[PrintJobManager] Enqueuing G-code file with " + std::to_string(lineCount) + " commands");
+        if (!startCommands.empty()) commandQueue_->enqueueCommands(startCommands, 3);
         commandQueue_->enqueueFile(gcodePath, 3, jobId);
+        if (!endCommands.empty()) commandQueue_->enqueueCommands(endCommands, 3);
+        progress_ = jobTracker.acquireProgress(jobId);
+        checkpoint_.begin(jobId, gcodePath, lineCount);
 
         // Update states
         updateState(JobState::RUNNING);
@@ -84,7 +122,233 @@ namespace core::print {
         return true;
     }
 
-    bool PrintJobManager::startPrintJobFromUrl(const std::string &gcodeUrl, const std::string &jobId) {
+    std::optional<GCodeIndex> PrintJobManager::loadIndex(const std::string &gcodePath) {
+        auto index = GCodeIndex::load(gcodePath);
+        if (!index) {
+            index = GCodeIndex::build(gcodePath);
+            if (index) index->save(GCodeIndex::pathFor(gcodePath));
+        }
+        return index;
+    }
+
+    bool PrintJobManager::resumeFromLayer(const std::string &gcodePath, const std::string &jobId, size_t layer) {
+        std::unique_lock<std::mutex> lock(stateMutex_);
+        auto index = loadIndex(gcodePath);
+        if (!index) {
+            Logger::logError("[PrintJobManager] Cannot open G-code file: " + gcodePath);
+            return false;
+        }
+        if (layer == 0 || layer > index->layers.size()) {
+            Logger::logError("[PrintJobManager] Cannot resume - layer " + std::to_string(layer) + " out of range (1-" +
+                             std::to_string(index->layers.size()) + ")");
+            return false;
+        }
+
+        const auto &start = index->layers[layer - 1];
+        return resumeInternal(lock, gcodePath, jobId, *index, start.commandIndex, start.state);
+    }
+
+    bool PrintJobManager::resumeFromCommand(const std::string &gcodePath, const std::string &jobId,
+                                            size_t commandIndex) {
+        std::unique_lock<std::mutex> lock(stateMutex_);
+        auto index = loadIndex(gcodePath);
+        if (!index) {
+            Logger::logError("[PrintJobManager] Cannot open G-code file: " + gcodePath);
+            return false;
+        }
+        if (commandIndex >= index->commandCount()) {
+            Logger::logError("[PrintJobManager] Cannot resume - command " + std::to_string(commandIndex) +
+                             " out of range (" + std::to_string(index->commandCount()) + " commands)");
+            return false;
+        }
+
+        // Stato all'inizio del layer che contiene il comando, poi solo le righe del layer fino al comando
+        auto layer = std::upper_bound(index->layers.begin(), index->layers.end(), commandIndex,
+                                      [](size_t value, const GCodeLayer &l) { return value < l.commandIndex; });
+        GCodeModalState state;
+        uint64_t position = 0;
+        if (layer != index->layers.begin()) {
+            --layer;
+            state = layer->state;
+            position = layer->offset;
+        }
+
+        uint64_t target = index->commandOffsets[commandIndex];
+        if (position < target) {
+            std::ifstream file(gcodePath, std::ios::binary);
+            file.seekg(static_cast<std::streamoff>(position));
+            std::string line;
+            while (position < target && std::getline(file, line)) {
+                state.apply(line.c_str());
+                position += line.size() + 1;
+            }
+        }
+        return resumeInternal(lock, gcodePath, jobId, *index, commandIndex, state);
+    }
+
+    bool PrintJobManager::resumeFromCheckpoint(bool axesReferenced) {
+        auto record = checkpoint_.recovered();
+        if (!record) {
+            Logger::logWarning("[PrintJobManager] Cannot resume - no interrupted job in the checkpoint");
+            return false;
+        }
+        if (!axesReferenced) {
+            Logger::logError("[PrintJobManager] Cannot resume " + record->jobId + " - after a power loss home X/Y, "
+                             "set Z at the resume height and confirm with axesReferenced");
+            return false;
+        }
+
+        std::unique_lock<std::mutex> lock(stateMutex_);
+        auto index = loadIndex(record->gcodePath);
+        if (!index) {
+            Logger::logError("[PrintJobManager] Cannot open G-code file: " + record->gcodePath);
+            return false;
+        }
+        // Il file è cambiato dopo l'interruzione: l'indice del comando non corrisponde più
+        if (index->commandCount() != record->totalCommands || record->commandIndex >= index->commandCount()) {
+            Logger::logError("[PrintJobManager] Cannot resume " + record->jobId + " - " + record->gcodePath +
+                             " no longer matches the checkpoint");
+            return false;
+        }
+
+        Logger::logInfo("[PrintJobManager] Resuming interrupted job " + record->jobId + " from checkpoint");
+        if (!resumeInternal(lock, record->gcodePath, record->jobId, *index, record->commandIndex, record->state)) {
+            return false;
+        }
+        checkpoint_.discardRecovered();
+        return true;
+    }
+
+    bool PrintJobManager::resumeInternal(std::unique_lock<std::mutex> &lock, const std::string &gcodePath,
+                                         const std::string &jobId, const GCodeIndex &index, size_t commandIndex,
+                                         const GCodeModalState &state) {
+        // Lettore di una ripresa precedente (già terminato o in uscita)
+        stopResumeReader(lock);
+        if (currentState_ == JobState::RUNNING) {
+            Logger::logError("[PrintJobManager] Cannot resume - job already active: " + currentJobId_);
+            return false;
+        }
+
+        currentJobId_ = jobId;
+        updateState(JobState::PRECHECK);
+        if (!isReadyToPrint()) {
+            updateState(JobState::FAILED);
+            return false;
+        }
+
+        driver_->system()->startPrint();
+        driver_->setState(PrintState::Printing);
+        updateState(JobState::LOADING);
+
+        // Seek diretto all'offset indicizzato: nessuna riga prima del punto di ripresa viene letta
+        std::ifstream file(gcodePath, std::ios::binary);
+        if (!file.is_open() || !file.seekg(static_cast<std::streamoff>(index.commandOffsets[commandIndex]))) {
+            Logger::logError("[PrintJobManager] Cannot open G-code file: " + gcodePath);
+            updateState(JobState::FAILED);
+            driver_->setState(PrintState::Error);
+            return false;
+        }
+
+        // Layer già iniziati prima del comando di ripresa
+        auto layersBefore = static_cast<int>(std::lower_bound(
+            index.layers.begin(), index.layers.end(), commandIndex,
+            [](const GCodeLayer &l, size_t value) { return l.commandIndex < value; }) - index.layers.begin());
+
+        auto &jobTracker = jobs::JobTracker::getInstance();
+        jobTracker.startJob(jobId, index.commandCount(), commandIndex);
+        checkpoint_.begin(jobId, gcodePath, index.commandCount(), commandIndex, index.commandOffsets[commandIndex],
+                          state);
+
+        auto &stateTracker = driver_->stateTracker();
+        stateTracker.resetForNewJob();
+        stateTracker.modify([&](state::StateSnapshot &snapshot) {
+            snapshot.ePosition = state.e;
+            if (state.feedRate > 0) snapshot.feedRate = state.feedRate;
+            snapshot.currentLayer = layersBefore;
+            snapshot.fanSpeed = state.fanSpeed;
+            snapshot.hotendTargetTemp = state.hotendTemp;
+            snapshot.bedTargetTemp = state.bedTemp;
+        });
+
+        currentFilePath_ = gcodePath;
+        totalLines_ = index.commandCount();
+        executedLines_ = commandIndex;
+        startTime_ = std::chrono::steady_clock::now();
+
+        if (commandQueue_ && !commandQueue_->isRunning()) {
+            Logger::logInfo("[PrintJobManager] Starting command executor queue");
+            commandQueue_->start();
+        }
+
+        // Comandi di ripristino senza jobId (non contano nell'avanzamento), poi il file: stessa priorità, FIFO
+        commandQueue_->enqueueCommands(buildRestoreCommands(state), 3);
+        progress_ = jobTracker.acquireProgress(jobId);
+
+        // Il file si accoda a blocchi come nello streaming: il primo qui, così l'esecuzione parte subito, il resto
+        // dal thread di lettura senza tenere stateMutex_ (pausa e annullamento restano disponibili)
+        std::vector<std::string> batch;
+        batch.reserve(RESUME_BATCH_LINES);
+        readResumeBatch(file, batch);
+        commandQueue_->appendCommands(batch, 3, jobId);
+        if (file) {
+            resumeReader_ = std::thread(&PrintJobManager::feedResume, this, std::move(file), jobId);
+        }
+
+        updateState(JobState::RUNNING);
+
+        Logger::logInfo("[PrintJobManager] Print job resumed: " + jobId + " at command " +
+                        std::to_string(commandIndex) + "/" + std::to_string(index.commandCount()) + " (layer " +
+                        std::to_string(layersBefore) + ", Z " + utils::formatFloat(static_cast<float>(state.z),
+                                                                               RESUME_PRECISION) + ")");
+        return true;
+    }
+
+    void PrintJobManager::feedResume(std::ifstream file, std::string jobId) {
+        std::vector<std::string> batch;
+        batch.reserve(RESUME_BATCH_LINES);
+        while (readResumeBatch(file, batch)) {
+            std::lock_guard<std::mutex> lock(stateMutex_);
+            if (stopResumeReader_ || currentJobId_ != jobId ||
+                (currentState_ != JobState::RUNNING && currentState_ != JobState::PAUSED)) {
+                return;
+            }
+            commandQueue_->appendCommands(batch, 3, jobId);
+            batch.clear();
+        }
+        Logger::logInfo("[PrintJobManager] Resumed job fully queued: " + jobId);
+    }
+
+    void PrintJobManager::stopResumeReader(std::unique_lock<std::mutex> &lock) {
+        if (!resumeReader_.joinable()) return;
+        stopResumeReader_ = true;
+        lock.unlock();
+        resumeReader_.join();
+        lock.lock();
+        stopResumeReader_ = false;
+    }
+
+    std::vector<std::string> PrintJobManager::buildRestoreCommands(const GCodeModalState &state) {
+        auto format = [](double value) { return utils::formatFloat(static_cast<float>(value), RESUME_PRECISION); };
+
+        // Riscaldamento in parallelo, poi attesa di entrambe le temperature prima di muovere l'ugello
+        std::vector<std::string> commands;
+        if (state.bedTemp > 0) commands.push_back("M140 S" + format(state.bedTemp));
+        if (state.hotendTemp > 0) commands.push_back("M104 S" + format(state.hotendTemp));
+        if (state.bedTemp > 0) commands.push_back("M190 S" + format(state.bedTemp));
+        if (state.hotendTemp > 0) commands.push_back("M109 S" + format(state.hotendTemp));
+        commands.push_back(state.fanSpeed > 0 ? "M106 S" + std::to_string(state.fanSpeed) : "M107");
+
+        // Sopra il pezzo, spostamento XY, discesa alla quota di ripresa con il feedrate del file
+        double feedRate = state.feedRate > 0 ? state.feedRate : RESUME_Z_FEEDRATE;
+        commands.push_back("G1 Z" + format(state.z + RESUME_Z_LIFT) + " F" + format(RESUME_Z_FEEDRATE));
+        commands.push_back("G1 X" + format(state.x) + " Y" + format(state.y) + " F" + format(RESUME_TRAVEL_FEEDRATE));
+        commands.push_back("G1 Z" + format(state.z) + " F" + format(feedRate));
+        return commands;
+    }
+
+    bool PrintJobManager::startPrintJobFromUrl(const std::string &gcodeUrl, const std::string &jobId,
+                                               const std::vector<std::string> &startCommands,
+                                               const std::vector<std::string> &endCommands) {
         std::lock_guard<std::mutex> lock(stateMutex_);
         if (currentState_ == JobState::RUNNING) {
             Logger::logError("[PrintJobManager] Cannot start download - job already active: " + currentJobId_);
@@ -96,21 +360,32 @@ namespace core::print {
         }
 
         currentJobId_ = jobId;
+        pendingStartCommands_ = startCommands;
+        pendingEndCommands_ = endCommands;
+        streamBuffer_.clear();
+        streaming_ = false;
         updateState(JobState::LOADING);
 
+        GCodeDownloader::LinesCallback linesCb = nullptr;
+        if (streamMargin_ > 0) {
+            linesCb = [this](std::vector<std::string> &&lines) { return onDownloadLines(std::move(lines)); };
+        }
+
         downloader_->downloadAsync(
                 gcodeUrl, jobId,
                 [this](const DownloadProgress &progress) { onDownloadProgress(progress); },
                 [this](bool success, const std::string &filePath, const std::string &error) {
                     onDownloadCompleted(success, filePath, error);
-                }
+                },
+                linesCb
         );
 
-        Logger::logInfo("[PrintJobManager] Started G-code download for job: " + jobId);
+        Logger::logInfo("[PrintJobManager] Started G-code download for job: " + jobId +
+                        (streamMargin_ > 0 ? " (printing after " + std::to_string(streamMargin_) + " lines)" : ""));
         return true;
     }
 
-    bool PrintJobManager::pauseJob() {
+    bool PrintJobManager::pauseJob(std::chrono::steady_clock::time_point receivedAt) {
         std::lock_guard<std::mutex> lock(stateMutex_);
         if (currentState_ != JobState::RUNNING) {
             Logger::logWarning("[PrintJobManager] Cannot pause - not printing");
@@ -118,7 +393,7 @@ namespace core::print {
         }
 
         try {
-            driver_->system()->pause();
+            driver_->system()->pause(receivedAt);
             driver_->setState(PrintState::Paused);
             updateState(JobState::PAUSED);
 
@@ -159,7 +434,7 @@ namespace core::print {
     }
 
     bool PrintJobManager::cancelJob() {
-        std::lock_guard<std::mutex> lock(stateMutex_);
+        std::unique_lock<std::mutex> lock(stateMutex_);
 
         if (!(currentState_ == JobState::RUNNING || currentState_ == JobState::PAUSED ||
               currentState_ == JobState::LOADING || currentState_ == JobState::PRECHECK)) {
@@ -167,10 +442,17 @@ namespace core::print {
             return false;
         }
 
-        // Cancel download if in progress
+        // Cancel download if in progress. cancelDownload() joins the download thread, whose callbacks take
+        // stateMutex_: release it meanwhile and have them ignored
         if (downloader_ && downloader_->isDownloading()) {
+            cancelling_ = true;
+            lock.unlock();
             downloader_->cancelDownload();
+            lock.lock();
+            cancelling_ = false;
         }
+        // Il lettore della ripresa accoda sotto stateMutex_: fermato prima di svuotare la coda
+        stopResumeReader(lock);
 
         // Clear command queue
         if (commandQueue_) {
@@ -180,6 +462,7 @@ namespace core::print {
         // Update job tracker
         auto &jobTracker = jobs::JobTracker::getInstance();
         jobTracker.cancelJob(currentJobId_);
+        checkpoint_.finish(currentJobId_);
 
         // Emergency stop
         try {
@@ -203,6 +486,19 @@ namespace core::print {
         return currentState_;
     }
 
+    bool PrintJobManager::isIdle() {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        if (currentState_ == JobState::RUNNING && progress_ && !progress_->isStreaming() &&
+            progress_->acknowledgedCommands() >= progress_->totalCommands()) {
+            driver_->setState(PrintState::Idle);
+            updateState(JobState::COMPLETED);
+            Logger::logInfo("[PrintJobManager] Job completed: " + currentJobId_);
+            resetJob();
+        }
+        return !(currentState_ == JobState::RUNNING || currentState_ == JobState::PAUSED ||
+                 currentState_ == JobState::LOADING || currentState_ == JobState::PRECHECK);
+    }
+
     bool PrintJobManager::isReadyToPrint() const {
         // Basic safety check - removed strict requirements
         PrintState driverState = driver_->getState();
@@ -263,6 +559,7 @@ namespace core::print {
                 jobTracker.failJob(currentJobId_, "Job failed");
             } else if (newState == JobState::COMPLETED) {
                 jobTracker.completeJob(currentJobId_);
+                checkpoint_.finish(currentJobId_);
             }
         }
     }
@@ -289,11 +586,11 @@ namespace core::print {
                 return false;
             }
 
-            for (const auto &line: result.body) {
-                if (line.find("TRIGGERED") != std::string::npos) {
-                    Logger::logWarning("[PrintJobManager] Endstop triggered: " + line);
-                    return false;
-                }
+            const auto &endstops = result.decoded.endstops;
+            if (endstops && endstops->anyTriggered()) {
+                Logger::logWarning("[PrintJobManager] Endstop triggered: " +
+                                   (result.body.empty() ? std::string("ENDSTOP") : result.body.front()));
+                return false;
             }
             return true;
         } catch (const std::exception &e) {
@@ -313,6 +610,11 @@ namespace core::print {
         totalLines_ = 0;
         executedLines_ = 0;
         startTime_ = std::chrono::steady_clock::now();
+        progress_.reset();
+        streaming_ = false;
+        streamBuffer_.clear();
+        pendingStartCommands_.clear();
+        pendingEndCommands_.clear();
     }
 
     std::string PrintJobManager::stateToString(JobState state) const {
@@ -346,28 +648,120 @@ namespace core::print {
 
     void PrintJobManager::onDownloadProgress(const DownloadProgress &progress) {
         Logger::logInfo("[PrintJobManager] Download progress: " + std::to_string(int(progress.percentage)) + "% (" +
-                        std::to_string(progress.downloadedBytes / 1024) + " KB)");
+                        std::to_string(progress.downloadedBytes / 1024) + " KB, " +
+                        std::to_string(int(progress.bytesPerSecond / 1024)) + " KB/s)");
     }
 
     void PrintJobManager::onDownloadCompleted(bool success, const std::string &filePath, const std::string &error) {
         std::lock_guard<std::mutex> lock(stateMutex_);
+        if (cancelling_) return;
 
         if (!success) {
             Logger::logError("[PrintJobManager] Download failed: " + error);
+            if (streaming_) {
+                // Il file è incompleto: le righe già accodate non vanno eseguite
+                commandQueue_->clearQueue();
+            }
             updateState(JobState::FAILED);
             driver_->setState(PrintState::Error);
             resetJob();
             return;
         }
 
+        if (streaming_) {
+            finishStreaming(filePath);
+            return;
+        }
+
         Logger::logInfo("[PrintJobManager] Download completed, starting print job with: " + filePath);
 
-        if (startPrintJobInternal(filePath, currentJobId_)) {
+        if (startPrintJobInternal(filePath, currentJobId_, pendingStartCommands_, pendingEndCommands_)) {
             Logger::logInfo("[PrintJobManager] Print job started successfully from downloaded G-code");
         } else {
             Logger::logError("[PrintJobManager] Failed to start print job from downloaded G-code");
             std::filesystem::remove(filePath);
+            std::filesystem::remove(GCodeIndex::pathFor(filePath));
         }
     }
-} // namespace core::print
 
+    bool PrintJobManager::onDownloadLines(std::vector<std::string> &&lines) {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        if (cancelling_) return false;
+
+        if (streaming_) {
+            if (currentState_ != JobState::RUNNING && currentState_ != JobState::PAUSED) return false;
+            // Prima il totale, poi i comandi: il job non risulta mai completato con righe ancora da eseguire
+            progress_->addCommands(lines.size());
+            commandQueue_->appendCommands(lines, 3, currentJobId_);
+            return true;
+        }
+
+        if (currentState_ != JobState::LOADING) return false;
+        streamBuffer_.insert(streamBuffer_.end(), std::make_move_iterator(lines.begin()),
+                             std::make_move_iterator(lines.end()));
+        if (streamBuffer_.size() < streamMargin_) return true;
+        return beginStreaming();
+    }
+
+    bool PrintJobManager::beginStreaming() {
+        // Safety pre-checks
+        updateState(JobState::PRECHECK);
+        if (!isReadyToPrint()) {
+            updateState(JobState::FAILED);
+            resetJob();
+            return false;
+        }
+
+        driver_->system()->startPrint();
+        driver_->setState(PrintState::Printing);
+
+        // Totale ancora ignoto: cresce con le righe accodate fino alla fine del download
+        auto &jobTracker = jobs::JobTracker::getInstance();
+        jobTracker.startStreamingJob(currentJobId_);
+        progress_ = jobTracker.acquireProgress(currentJobId_);
+        driver_->stateTracker().resetForNewJob(); // Come enqueueFile per un job da file
+
+        currentFilePath_.clear();
+        totalLines_ = 0;
+        executedLines_ = 0;
+        startTime_ = std::chrono::steady_clock::now();
+
+        if (commandQueue_ && !commandQueue_->isRunning()) {
+            Logger::logInfo("[PrintJobManager] Starting command executor queue");
+            commandQueue_->start();
+        }
+
+        if (!pendingStartCommands_.empty()) commandQueue_->enqueueCommands(pendingStartCommands_, 3);
+        progress_->addCommands(streamBuffer_.size());
+        commandQueue_->appendCommands(streamBuffer_, 3, currentJobId_);
+
+        Logger::logInfo("[PrintJobManager] Print job started while downloading: " + currentJobId_ + " (" +
+                        std::to_string(streamBuffer_.size()) + " lines received)");
+        streamBuffer_.clear();
+        streamBuffer_.shrink_to_fit();
+        streaming_ = true;
+        updateState(JobState::RUNNING);
+        return true;
+    }
+
+    void PrintJobManager::finishStreaming(const std::string &filePath) {
+        // Tutte le righe del file sono già in coda: il G-code di fine le segue
+        if (!pendingEndCommands_.empty()) commandQueue_->enqueueCommands(pendingEndCommands_, 3);
+
+        size_t total = progress_->totalCommands();
+        auto index = GCodeIndex::load(filePath);
+        if (index && index->commandCount() != total) {
+            Logger::logWarning("[PrintJobManager] Streamed " + std::to_string(total) + " commands, index has " +
+                               std::to_string(index->commandCount()));
+        }
+
+        currentFilePath_ = filePath;
+        totalLines_ = total;
+        checkpoint_.begin(currentJobId_, filePath, total);
+        jobs::JobTracker::getInstance().finishStreaming(progress_);
+        streaming_ = false;
+
+        Logger::logInfo("[PrintJobManager] Download completed while printing: " + currentJobId_ + " (" +
+                        std::to_string(total) + " commands)");
+    }
+} // namespace core::print
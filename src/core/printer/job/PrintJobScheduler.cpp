@@ -0,0 +1,316 @@
+#include "core/printer/job/PrintJobScheduler.hpp"
+#include "core/printer/job/tracking/JobTracker.hpp"
+#include "logger/Logger.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <sstream>
+
+namespace core::print {
+    PrintJobScheduler::PrintJobScheduler(std::shared_ptr<PrintJobManager> jobManager)
+            : jobManager_(std::move(jobManager)), downloader_(std::make_unique<GCodeDownloader>()) {
+    }
+
+    PrintJobScheduler::~PrintJobScheduler() {
+        stop();
+    }
+
+    void PrintJobScheduler::start() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (running_) return;
+        running_ = true;
+        schedulerThread_ = std::thread(&PrintJobScheduler::schedulerLoop, this);
+        Logger::logInfo("[PrintJobScheduler] Started");
+    }
+
+    void PrintJobScheduler::stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!running_) return;
+            running_ = false;
+        }
+        wakeCv_.notify_all();
+        if (schedulerThread_.joinable()) schedulerThread_.join();
+        downloader_->cancelDownload();
+        Logger::logInfo("[PrintJobScheduler] Stopped");
+    }
+
+    bool PrintJobScheduler::submit(ScheduledJob job) {
+        if (job.jobId.empty() || (job.gcodeUrl.empty() && job.gcodePath.empty())) {
+            Logger::logError("[PrintJobScheduler] Rejected job without id or G-code source");
+            return false;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            bool duplicate = std::any_of(jobs_.begin(), jobs_.end(),
+                                         [&job](const ScheduledJob &queued) { return queued.jobId == job.jobId; });
+            if (duplicate) {
+                Logger::logWarning("[PrintJobScheduler] Job already queued: " + job.jobId);
+                return false;
+            }
+
+            job.sequence = nextSequence_++;
+            job.state = ScheduledJobState::QUEUED;
+            job.commandCount = 0;
+            if (held_) {
+                Logger::logInfo("[PrintJobScheduler] New job submitted - queue released");
+                held_ = false;
+            }
+            Logger::logInfo("[PrintJobScheduler] Queued job " + job.jobId + " (priority " +
+                            std::to_string(job.priority) + ", " + std::to_string(jobs_.size() + 1) + " pending)");
+            jobs_.push_back(std::move(job));
+            wake_ = true;
+        }
+        wakeCv_.notify_one();
+        return true;
+    }
+
+    bool PrintJobScheduler::remove(const std::string &jobId) {
+        bool cancelDownload = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = std::find_if(jobs_.begin(), jobs_.end(),
+                                   [&jobId](const ScheduledJob &job) { return job.jobId == jobId; });
+            if (it == jobs_.end()) return false;
+
+            cancelDownload = it->state == ScheduledJobState::PREFETCHING && !it->gcodeUrl.empty();
+            // File scaricato dal prefetch: non serve più
+            if (it->state == ScheduledJobState::READY && !it->gcodeUrl.empty()) {
+                std::error_code ec;
+                std::filesystem::remove(it->gcodePath, ec);
+                std::filesystem::remove(GCodeIndex::pathFor(it->gcodePath), ec);
+            }
+            jobs_.erase(it);
+        }
+        // Fuori dal lock: il callback di completamento del download lo riprende
+        if (cancelDownload) downloader_->cancelDownload();
+        Logger::logInfo("[PrintJobScheduler] Removed job " + jobId);
+        return true;
+    }
+
+    void PrintJobScheduler::release() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!held_) return;
+            held_ = false;
+            wake_ = true;
+        }
+        wakeCv_.notify_one();
+        Logger::logInfo("[PrintJobScheduler] Queue released");
+    }
+
+    void PrintJobScheduler::hold() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (held_) return;
+        held_ = true;
+        Logger::logInfo("[PrintJobScheduler] Queue held");
+    }
+
+    std::vector<ScheduledJob> PrintJobScheduler::pendingJobs() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto pending = jobs_;
+        std::sort(pending.begin(), pending.end(), [](const ScheduledJob &a, const ScheduledJob &b) {
+            return a.priority != b.priority ? a.priority < b.priority : a.sequence < b.sequence;
+        });
+        return pending;
+    }
+
+    std::vector<ScheduledJob>::iterator PrintJobScheduler::nextJob() {
+        return std::min_element(jobs_.begin(), jobs_.end(), [](const ScheduledJob &a, const ScheduledJob &b) {
+            return a.priority != b.priority ? a.priority < b.priority : a.sequence < b.sequence;
+        });
+    }
+
+    void PrintJobScheduler::schedulerLoop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (running_) {
+            wakeCv_.wait_for(lock, POLL_INTERVAL, [this] { return !running_ || wake_; });
+            if (!running_) break;
+            wake_ = false;
+
+            // Prossimo job da URL senza prefetch in corso: se la stampante è libera parte scaricandosi
+            auto next = nextJob();
+            bool streamNext = jobManager_->streamMargin() > 0 && !held_ && prefetchingJobId_.empty() &&
+                              next != jobs_.end() && next->state == ScheduledJobState::QUEUED &&
+                              !next->gcodeUrl.empty();
+            auto startable = [streamNext](const ScheduledJob &job) {
+                return job.state == ScheduledJobState::READY || (streamNext && job.state == ScheduledJobState::QUEUED);
+            };
+
+            if (!streamNext) startPrefetch(lock);
+
+            next = nextJob();
+            if (held_ || next == jobs_.end() || !startable(*next)) continue;
+
+            if (!printerIdle(lock)) {
+                // Stampante occupata: il job da URL si scarica in anticipo come gli altri
+                if (streamNext && running_) startPrefetch(lock);
+                continue;
+            }
+
+            // Il job può essere stato rimosso, o la coda fermata, mentre il lock era libero
+            next = nextJob();
+            if (held_ || next == jobs_.end() || !startable(*next)) continue;
+            ScheduledJob job = std::move(*next);
+            jobs_.erase(next);
+            lastStartedJobId_ = job.jobId;
+
+            lock.unlock();
+            bool started = startJob(job);
+            lock.lock();
+            if (!started) {
+                held_ = true;
+                lastStartedJobId_.clear();
+            }
+            wake_ = true; // Prefetch del job successivo
+        }
+    }
+
+    bool PrintJobScheduler::printerIdle(std::unique_lock<std::mutex> &lock) {
+        // Stampante libera? L'ultimo job avviato dalla coda deve essersi concluso come COMPLETED
+        std::string lastJobId = lastStartedJobId_;
+        lock.unlock();
+        bool idle = jobManager_->isIdle();
+        std::optional<JobState> lastState;
+        if (idle && !lastJobId.empty()) {
+            auto info = jobs::JobTracker::getInstance().getJobInfo(lastJobId);
+            if (info) lastState = info->state;
+        }
+        lock.lock();
+
+        if (!idle || !running_) return false;
+        // Nessuno stato: il job non è mai stato registrato (es. download da URL fallito prima del margine)
+        if (!lastJobId.empty() && (!lastState || *lastState != JobState::COMPLETED)) {
+            held_ = true;
+            lastStartedJobId_.clear();
+            Logger::logWarning("[PrintJobScheduler] Job " + lastJobId + " ended as " +
+                               (lastState ? jobStateToCode(*lastState) : std::string("unregistered")) +
+                               " - queue held until release or a new job");
+            return false;
+        }
+        return true;
+    }
+
+    void PrintJobScheduler::startPrefetch(std::unique_lock<std::mutex> &lock) {
+        if (!prefetchingJobId_.empty()) return;
+
+        // Primo job in ordine di avvio non ancora scaricato
+        auto candidate = jobs_.end();
+        for (auto it = jobs_.begin(); it != jobs_.end(); ++it) {
+            if (it->state != ScheduledJobState::QUEUED) continue;
+            if (candidate == jobs_.end() || it->priority < candidate->priority ||
+                (it->priority == candidate->priority && it->sequence < candidate->sequence)) {
+                candidate = it;
+            }
+        }
+        if (candidate == jobs_.end()) return;
+        // Il download precedente chiama il callback prima di liberare il downloader: si riprova al prossimo giro
+        if (!candidate->gcodeUrl.empty() && downloader_->isDownloading()) return;
+
+        candidate->state = ScheduledJobState::PREFETCHING;
+        prefetchingJobId_ = candidate->jobId;
+        std::string jobId = candidate->jobId;
+        std::string url = candidate->gcodeUrl;
+        std::string path = candidate->gcodePath;
+        Logger::logInfo("[PrintJobScheduler] Prefetching job " + jobId);
+
+        lock.unlock();
+        if (url.empty()) {
+            // File locale: solo indice e validazione
+            onPrefetchCompleted(jobId, false, true, path, "");
+        } else {
+            downloader_->downloadAsync(url, jobId, nullptr,
+                                       [this, jobId](bool success, const std::string &filePath,
+                                                     const std::string &error) {
+                                           onPrefetchCompleted(jobId, true, success, filePath, error);
+                                       });
+        }
+        lock.lock();
+    }
+
+    void PrintJobScheduler::onPrefetchCompleted(const std::string &jobId, bool downloaded, bool success,
+                                                const std::string &filePath, const std::string &error) {
+        std::string reason = error;
+        size_t commandCount = success ? validate(filePath, reason) : 0;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (prefetchingJobId_ == jobId) prefetchingJobId_.clear();
+            wake_ = true;
+
+            auto it = std::find_if(jobs_.begin(), jobs_.end(),
+                                   [&jobId](const ScheduledJob &job) { return job.jobId == jobId; });
+            if (it == jobs_.end()) {
+                // Rimosso durante il download
+                if (success && downloaded) {
+                    std::error_code ec;
+                    std::filesystem::remove(filePath, ec);
+                    std::filesystem::remove(GCodeIndex::pathFor(filePath), ec);
+                }
+            } else if (commandCount > 0) {
+                it->state = ScheduledJobState::READY;
+                it->gcodePath = filePath;
+                it->commandCount = commandCount;
+                Logger::logInfo("[PrintJobScheduler] Job " + jobId + " ready (" + std::to_string(commandCount) +
+                                " commands)");
+            } else {
+                jobs_.erase(it);
+                if (success && downloaded) {
+                    std::error_code ec;
+                    std::filesystem::remove(filePath, ec);
+                    std::filesystem::remove(GCodeIndex::pathFor(filePath), ec);
+                }
+                commandCount = 0;
+            }
+        }
+        wakeCv_.notify_one();
+
+        if (commandCount == 0) {
+            Logger::logError("[PrintJobScheduler] Prefetch failed for job " + jobId + ": " + reason);
+            jobs::JobTracker::getInstance().failJob(jobId, "PREFETCH_FAILED");
+        }
+    }
+
+    size_t PrintJobScheduler::validate(const std::string &gcodePath, std::string &error) {
+        auto index = PrintJobManager::loadIndex(gcodePath);
+        if (!index) {
+            error = "cannot read " + gcodePath;
+            return 0;
+        }
+        if (index->commandCount() == 0) {
+            error = gcodePath + " contains no commands";
+            return 0;
+        }
+        return index->commandCount();
+    }
+
+    bool PrintJobScheduler::startJob(const ScheduledJob &job) {
+        bool started;
+        if (job.state == ScheduledJobState::QUEUED) {
+            Logger::logInfo("[PrintJobScheduler] Starting job " + job.jobId + " while downloading");
+            started = jobManager_->startPrintJobFromUrl(job.gcodeUrl, job.jobId, splitGCode(job.startGCode),
+                                                        splitGCode(job.endGCode));
+        } else {
+            Logger::logInfo("[PrintJobScheduler] Starting job " + job.jobId + " (" +
+                            std::to_string(job.commandCount) + " commands)");
+            started = jobManager_->startPrintJob(job.gcodePath, job.jobId, splitGCode(job.startGCode),
+                                                 splitGCode(job.endGCode));
+        }
+        if (started) return true;
+        Logger::logError("[PrintJobScheduler] Job manager refused job " + job.jobId + " - queue held");
+        jobs::JobTracker::getInstance().failJob(job.jobId, "START_FAILED");
+        return false;
+    }
+
+    std::vector<std::string> PrintJobScheduler::splitGCode(const std::string &gcode) {
+        std::istringstream stream(gcode);
+        std::string line;
+        std::vector<std::string> commands;
+        while (std::getline(stream, line)) {
+            if (!line.empty() && line[0] != ';' && line.find_first_not_of(" \t\r\n") != std::string::npos) {
+                commands.push_back(line);
+            }
+        }
+        return commands;
+    }
+} // namespace core::print
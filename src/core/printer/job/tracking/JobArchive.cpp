@@ -0,0 +1,332 @@
+#include "core/printer/job/tracking/JobArchive.hpp"
+
+#include "logger/Logger.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace core::jobs {
+    namespace {
+        constexpr size_t FIELD_COUNT = 8;
+        constexpr size_t INDEX_CHUNK = 512;   // Voci lette per volta caricando l'indice
+        constexpr size_t MAX_MISSES = 4096;   // jobId sconosciuti ricordati prima di svuotare la cache
+
+        std::string escapeField(const std::string &value) {
+            std::string out;
+            out.reserve(value.size());
+            for (char c: value) {
+                switch (c) {
+                    case '\\': out += "\\\\";
+                        break;
+                    case '\t': out += "\\t";
+                        break;
+                    case '\n': out += "\\n";
+                        break;
+                    case '\r': out += "\\r";
+                        break;
+                    default: out += c;
+                }
+            }
+            return out;
+        }
+
+        std::string unescapeField(const std::string &value) {
+            std::string out;
+            out.reserve(value.size());
+            for (size_t i = 0; i < value.size(); ++i) {
+                if (value[i] != '\\' || i + 1 == value.size()) {
+                    out += value[i];
+                    continue;
+                }
+                switch (value[++i]) {
+                    case 't': out += '\t';
+                        break;
+                    case 'n': out += '\n';
+                        break;
+                    case 'r': out += '\r';
+                        break;
+                    default: out += value[i];
+                }
+            }
+            return out;
+        }
+
+        std::optional<core::print::JobState> stateFromCode(const std::string &code) {
+            for (int i = static_cast<int>(core::print::JobState::CREATED);
+                 i <= static_cast<int>(core::print::JobState::HEATING); ++i) {
+                auto state = static_cast<core::print::JobState>(i);
+                if (core::print::jobStateToCode(state) == code) return state;
+            }
+            return std::nullopt;
+        }
+    } // namespace
+
+    JobArchive::~JobArchive() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        archive_.close();
+        index_.close();
+        reader_.close();
+    }
+
+    bool JobArchive::open(const std::string &directory) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::error_code ec;
+        fs::create_directories(directory, ec);
+        if (ec) {
+            Logger::logError("[JobArchive] Cannot create " + directory + ": " + ec.message());
+            return false;
+        }
+
+        archivePath_ = (fs::path(directory) / "jobs.archive").string();
+        indexPath_ = (fs::path(directory) / "jobs.index").string();
+        if (!recover()) return false;
+
+        archive_.open(archivePath_, std::ios::binary | std::ios::app);
+        index_.open(indexPath_, std::ios::binary | std::ios::app);
+        reader_.open(archivePath_, std::ios::binary);
+        if (!archive_.is_open() || !index_.is_open() || !reader_.is_open()) {
+            Logger::logError("[JobArchive] Cannot open archive in " + directory);
+            archive_.close();
+            index_.close();
+            reader_.close();
+            return false;
+        }
+
+        Logger::logInfo("[JobArchive] Opened " + archivePath_ + " (" + std::to_string(entries_) + " jobs)");
+        return true;
+    }
+
+    bool JobArchive::isOpen() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return archive_.is_open();
+    }
+
+    bool JobArchive::append(const JobInfo &info) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!archive_.is_open()) return false;
+
+        std::string line = formatRecord(info);
+        IndexEntry entry{hashJobId(info.jobId), archiveSize_};
+
+        archive_.write(line.data(), static_cast<std::streamsize>(line.size()));
+        archive_.flush();
+        if (!archive_) {
+            Logger::logError("[JobArchive] Write failed for job " + info.jobId);
+            archive_.clear();
+            return false;
+        }
+        archiveSize_ += line.size();
+
+        // L'indice segue la riga: dopo un crash tra le due scritture recover() lo completa
+        index_.write(reinterpret_cast<const char *>(&entry), sizeof(entry));
+        index_.flush();
+        entries_++;
+        offsets_[entry.hash].push_back(entry.offset);
+        misses_.erase(info.jobId);
+        return true;
+    }
+
+    std::optional<JobInfo> JobArchive::find(const std::string &jobId) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!archive_.is_open() || misses_.count(jobId)) return std::nullopt;
+
+        // Dal più recente: con collisioni di hash si scartano le righe di altri jobId
+        auto it = offsets_.find(hashJobId(jobId));
+        if (it != offsets_.end()) {
+            for (auto offset = it->second.rbegin(); offset != it->second.rend(); ++offset) {
+                auto info = readRecord(*offset);
+                if (info && info->jobId == jobId) return info;
+            }
+        }
+
+        if (misses_.size() >= MAX_MISSES) misses_.clear();
+        misses_.insert(jobId);
+        return std::nullopt;
+    }
+
+    size_t JobArchive::size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_;
+    }
+
+    uint64_t JobArchive::hashJobId(const std::string &jobId) {
+        uint64_t hash = 14695981039346656037ULL;
+        for (unsigned char c: jobId) {
+            hash ^= c;
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    std::string JobArchive::formatRecord(const JobInfo &info) {
+        // I tempi del tracker sono monotoni: nell'archivio diventano ms epoch
+        auto steadyNow = std::chrono::steady_clock::now();
+        auto systemNow = std::chrono::system_clock::now();
+        auto toEpochMs = [&](std::chrono::steady_clock::time_point time) {
+            auto wall = systemNow - std::chrono::duration_cast<std::chrono::system_clock::duration>(steadyNow - time);
+            return std::chrono::duration_cast<std::chrono::milliseconds>(wall.time_since_epoch()).count();
+        };
+
+        std::string line;
+        line.reserve(128);
+        line += escapeField(info.jobId);
+        line += '\t';
+        line += core::print::jobStateToCode(info.state);
+        line += '\t';
+        line += std::to_string(toEpochMs(info.startTime));
+        line += '\t';
+        line += std::to_string(toEpochMs(info.lastUpdate));
+        line += '\t';
+        line += std::to_string(info.totalCommands);
+        line += '\t';
+        line += std::to_string(info.executedCommands);
+        line += '\t';
+        line += escapeField(info.currentCommand);
+        line += '\t';
+        line += escapeField(info.error);
+        line += '\n';
+        return line;
+    }
+
+    std::optional<JobInfo> JobArchive::parseRecord(const std::string &line) {
+        std::vector<std::string> fields;
+        size_t start = 0;
+        while (fields.size() < FIELD_COUNT) {
+            size_t tab = line.find('\t', start);
+            if (tab == std::string::npos) {
+                fields.push_back(line.substr(start));
+                break;
+            }
+            fields.push_back(line.substr(start, tab - start));
+            start = tab + 1;
+        }
+        if (fields.size() != FIELD_COUNT) return std::nullopt;
+
+        auto state = stateFromCode(fields[1]);
+        if (!state) return std::nullopt;
+
+        try {
+            auto steadyNow = std::chrono::steady_clock::now();
+            auto systemNow = std::chrono::system_clock::now();
+            auto fromEpochMs = [&](const std::string &value) {
+                std::chrono::system_clock::time_point wall{std::chrono::milliseconds(std::stoll(value))};
+                return steadyNow - std::chrono::duration_cast<std::chrono::steady_clock::duration>(systemNow - wall);
+            };
+
+            JobInfo info;
+            info.jobId = unescapeField(fields[0]);
+            info.state = *state;
+            info.startTime = fromEpochMs(fields[2]);
+            info.lastUpdate = fromEpochMs(fields[3]);
+            info.totalCommands = std::stoull(fields[4]);
+            info.executedCommands = std::stoull(fields[5]);
+            info.currentCommand = unescapeField(fields[6]);
+            info.error = unescapeField(fields[7]);
+            return info;
+        } catch (const std::exception &) {
+            return std::nullopt;
+        }
+    }
+
+    bool JobArchive::recover() {
+        std::error_code ec;
+        uint64_t archiveSize = fs::exists(archivePath_, ec) ? fs::file_size(archivePath_, ec) : 0;
+        uint64_t indexSize = fs::exists(indexPath_, ec) ? fs::file_size(indexPath_, ec) : 0;
+        if (ec) {
+            Logger::logError("[JobArchive] Cannot stat archive: " + ec.message());
+            return false;
+        }
+
+        // Voce d'indice scritta a metà
+        if (indexSize % sizeof(IndexEntry) != 0) {
+            indexSize -= indexSize % sizeof(IndexEntry);
+            fs::resize_file(indexPath_, indexSize, ec);
+        }
+        entries_ = indexSize / sizeof(IndexEntry);
+
+        // Fine dell'ultima riga indicizzata
+        std::ifstream archive(archivePath_, std::ios::binary);
+        uint64_t indexedEnd = 0;
+        if (entries_ > 0) {
+            std::ifstream index(indexPath_, std::ios::binary);
+            IndexEntry last{};
+            index.seekg(static_cast<std::streamoff>((entries_ - 1) * sizeof(IndexEntry)));
+            index.read(reinterpret_cast<char *>(&last), sizeof(last));
+
+            std::string line;
+            if (index && last.offset < archiveSize && archive.seekg(static_cast<std::streamoff>(last.offset)) &&
+                std::getline(archive, line) && !archive.eof()) {
+                indexedEnd = last.offset + line.size() + 1;
+            } else {
+                Logger::logWarning("[JobArchive] Index does not match archive, rebuilding");
+                entries_ = 0;
+                fs::resize_file(indexPath_, 0, ec);
+            }
+        }
+
+        // Righe successive all'indice (crash tra riga e voce d'indice) e riga finale incompleta
+        std::vector<IndexEntry> missing;
+        uint64_t position = indexedEnd;
+        if (archiveSize > indexedEnd) {
+            archive.clear();
+            archive.seekg(static_cast<std::streamoff>(indexedEnd));
+            std::string line;
+            while (std::getline(archive, line)) {
+                if (archive.eof()) break; // Nessun '\n': riga troncata
+                auto info = parseRecord(line);
+                if (info) missing.push_back({hashJobId(info->jobId), position});
+                position += line.size() + 1;
+            }
+        }
+        archive.close();
+
+        if (position < archiveSize) {
+            Logger::logWarning("[JobArchive] Discarding " + std::to_string(archiveSize - position) +
+                               " bytes of truncated record");
+            fs::resize_file(archivePath_, position, ec);
+        }
+        if (!missing.empty()) {
+            std::ofstream index(indexPath_, std::ios::binary | std::ios::app);
+            index.write(reinterpret_cast<const char *>(missing.data()),
+                        static_cast<std::streamsize>(missing.size() * sizeof(IndexEntry)));
+            entries_ += missing.size();
+            Logger::logInfo("[JobArchive] Indexed " + std::to_string(missing.size()) + " unindexed jobs");
+        }
+
+        archiveSize_ = position;
+        return loadIndex();
+    }
+
+    bool JobArchive::loadIndex() {
+        offsets_.clear();
+        misses_.clear();
+        if (entries_ == 0) return true;
+
+        std::ifstream index(indexPath_, std::ios::binary);
+        std::vector<IndexEntry> chunk(INDEX_CHUNK);
+        for (size_t begin = 0; begin < entries_; begin += INDEX_CHUNK) {
+            size_t count = std::min(INDEX_CHUNK, entries_ - begin);
+            index.read(reinterpret_cast<char *>(chunk.data()),
+                       static_cast<std::streamsize>(count * sizeof(IndexEntry)));
+            if (!index) {
+                Logger::logError("[JobArchive] Cannot read " + indexPath_);
+                offsets_.clear();
+                return false;
+            }
+            for (size_t i = 0; i < count; ++i) {
+                offsets_[chunk[i].hash].push_back(chunk[i].offset);
+            }
+        }
+        return true;
+    }
+
+    std::optional<JobInfo> JobArchive::readRecord(uint64_t offset) const {
+        reader_.clear();
+        if (!reader_.seekg(static_cast<std::streamoff>(offset))) return std::nullopt;
+        std::string line;
+        if (!std::getline(reader_, line)) return std::nullopt;
+        return parseRecord(line);
+    }
+} // namespace core::jobs
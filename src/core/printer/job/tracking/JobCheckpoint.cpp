@@ -0,0 +1,380 @@
+#include "core/printer/job/tracking/JobCheckpoint.hpp"
+
+#include "logger/Logger.hpp"
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <zlib.h>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace core::jobs {
+    namespace {
+        constexpr uint32_t CHECKPOINT_MAGIC = 0x4B434433; // "3DCK"
+        constexpr uint16_t CHECKPOINT_VERSION = 1;
+        constexpr size_t SLOT_SIZE = 512;
+        constexpr size_t MAX_JOB_ID = 64;
+        constexpr size_t MAX_GCODE_PATH = 256;
+        constexpr auto MIN_SYNC_INTERVAL = std::chrono::milliseconds(10);
+
+        void copyField(char *destination, size_t size, const std::string &value) {
+            size_t length = std::min(value.size(), size - 1);
+            std::memcpy(destination, value.data(), length);
+            std::memset(destination + length, 0, size - length);
+        }
+
+        std::string readField(const char *source, size_t size) {
+            return std::string(source, strnlen(source, size));
+        }
+
+        std::string lastSystemError() {
+#ifdef _WIN32
+            return "error " + std::to_string(GetLastError());
+#else
+            return std::strerror(errno);
+#endif
+        }
+    } // namespace
+
+    struct JobCheckpoint::Slot {
+        uint32_t magic;
+        uint16_t version;
+        uint8_t active;
+        uint8_t absolutePositioning;
+        uint64_t sequence;
+        uint64_t commandIndex;
+        uint64_t totalCommands;
+        int64_t updatedAtMs;
+        double x, y, z, e, feedRate, hotendTemp, bedTemp;
+        int32_t fanSpeed;
+        uint8_t absoluteExtrusion;
+        uint8_t reserved[3];
+        char jobId[MAX_JOB_ID];
+        char gcodePath[MAX_GCODE_PATH];
+        uint32_t crc; // Su tutti i campi precedenti
+    };
+
+    JobCheckpoint &JobCheckpoint::getInstance() {
+        static JobCheckpoint instance;
+        return instance;
+    }
+
+    JobCheckpoint::~JobCheckpoint() {
+        close();
+    }
+
+    bool JobCheckpoint::open(const std::string &path, std::chrono::milliseconds syncInterval) {
+        close();
+
+        std::error_code ec;
+        auto directory = std::filesystem::path(path).parent_path();
+        if (!directory.empty()) std::filesystem::create_directories(directory, ec);
+
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_ALWAYS,
+                                  FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            Logger::logError("[JobCheckpoint] Cannot open " + path + ": " + lastSystemError());
+            return false;
+        }
+        // Un mapping più grande del file lo estende (azzerato), come ftruncate
+        HANDLE fileMapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, 0, FILE_SIZE, nullptr);
+        if (!fileMapping) {
+            Logger::logError("[JobCheckpoint] Cannot size " + path + ": " + lastSystemError());
+            CloseHandle(file);
+            return false;
+        }
+        void *mapping = MapViewOfFile(fileMapping, FILE_MAP_ALL_ACCESS, 0, 0, FILE_SIZE);
+        if (!mapping) {
+            Logger::logError("[JobCheckpoint] Cannot map " + path + ": " + lastSystemError());
+            CloseHandle(fileMapping);
+            CloseHandle(file);
+            return false;
+        }
+#else
+        int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            Logger::logError("[JobCheckpoint] Cannot open " + path + ": " + lastSystemError());
+            return false;
+        }
+        if (::ftruncate(fd, FILE_SIZE) != 0) {
+            Logger::logError("[JobCheckpoint] Cannot size " + path + ": " + lastSystemError());
+            ::close(fd);
+            return false;
+        }
+        void *mapping = ::mmap(nullptr, FILE_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapping == MAP_FAILED) {
+            Logger::logError("[JobCheckpoint] Cannot map " + path + ": " + lastSystemError());
+            ::close(fd);
+            return false;
+        }
+#endif
+
+        std::lock_guard<std::mutex> lock(mutex_);
+#ifdef _WIN32
+        fileHandle_ = file;
+        mappingHandle_ = fileMapping;
+#else
+        fd_ = fd;
+#endif
+        mapping_ = static_cast<char *>(mapping);
+        syncInterval_ = std::max(syncInterval, MIN_SYNC_INTERVAL);
+        stopping_ = false;
+        syncNow_ = false;
+        active_ = false;
+        dirty_ = false;
+
+        bool active = false;
+        auto record = readSlots(active);
+        if (record && active) {
+            recovered_ = record;
+            Logger::logWarning("[JobCheckpoint] Interrupted job " + record->jobId + " at command " +
+                               std::to_string(record->commandIndex) + "/" + std::to_string(record->totalCommands) +
+                               " (" + record->gcodePath + ")");
+        } else {
+            recovered_.reset();
+        }
+
+        syncThread_ = std::thread(&JobCheckpoint::syncLoop, this);
+        Logger::logInfo("[JobCheckpoint] Checkpoint file " + path + " (sync every " +
+                        std::to_string(syncInterval_.count()) + " ms)");
+        return true;
+    }
+
+    void JobCheckpoint::close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!mapping_) return;
+            stopping_ = true;
+        }
+        syncCv_.notify_all();
+        if (syncThread_.joinable()) syncThread_.join();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        update();
+        syncMapping();
+#ifdef _WIN32
+        UnmapViewOfFile(mapping_);
+        CloseHandle(mappingHandle_);
+        CloseHandle(fileHandle_);
+        mappingHandle_ = nullptr;
+        fileHandle_ = nullptr;
+#else
+        ::munmap(mapping_, FILE_SIZE);
+        ::close(fd_);
+        fd_ = -1;
+#endif
+        mapping_ = nullptr;
+        active_ = false;
+        progress_.reset();
+        file_.close();
+    }
+
+    bool JobCheckpoint::isOpen() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return mapping_ != nullptr;
+    }
+
+    std::optional<CheckpointRecord> JobCheckpoint::recovered() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return recovered_;
+    }
+
+    void JobCheckpoint::discardRecovered() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        recovered_.reset();
+    }
+
+    void JobCheckpoint::begin(const std::string &jobId, const std::string &gcodePath, uint64_t totalCommands,
+                              uint64_t commandIndex, uint64_t fileOffset, const core::print::GCodeModalState &state) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!mapping_) return;
+            if (jobId.size() >= MAX_JOB_ID || gcodePath.size() >= MAX_GCODE_PATH) {
+                Logger::logWarning("[JobCheckpoint] Job id or path too long, no checkpoint for " + jobId);
+                return;
+            }
+            auto progress = JobTracker::getInstance().acquireProgress(jobId);
+            if (!progress) {
+                Logger::logWarning("[JobCheckpoint] Job " + jobId + " not tracked, no checkpoint");
+                return;
+            }
+
+            file_.close();
+            file_.clear();
+            file_.open(gcodePath, std::ios::binary);
+            if (!file_.is_open() || !file_.seekg(static_cast<std::streamoff>(fileOffset))) {
+                Logger::logWarning("[JobCheckpoint] Cannot read " + gcodePath + ", no checkpoint for " + jobId);
+                file_.close();
+                return;
+            }
+
+            current_.jobId = jobId;
+            current_.gcodePath = gcodePath;
+            current_.commandIndex = commandIndex;
+            current_.totalCommands = totalCommands;
+            current_.state = state;
+            progress_ = std::move(progress);
+            active_ = true;
+            dirty_ = true;
+            recovered_.reset();
+            syncNow_ = true;
+        }
+        syncCv_.notify_one();
+    }
+
+    void JobCheckpoint::finish(const std::string &jobId) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!mapping_ || !active_ || jobId != current_.jobId) return;
+            active_ = false;
+            dirty_ = true;
+            progress_.reset();
+            file_.close();
+            syncNow_ = true;
+        }
+        syncCv_.notify_one();
+    }
+
+    bool JobCheckpoint::update() {
+        if (active_ && progress_) {
+            uint64_t acknowledged = std::min<uint64_t>(progress_->acknowledgedCommands(), current_.totalCommands);
+            if (acknowledged > current_.commandIndex) {
+                advanceTo(acknowledged);
+                dirty_ = true;
+            }
+            if (current_.commandIndex >= current_.totalCommands) {
+                active_ = false;
+                progress_.reset();
+                file_.close();
+            }
+        }
+        if (!dirty_) return false;
+        writeSlot();
+        dirty_ = false;
+        return true;
+    }
+
+    void JobCheckpoint::advanceTo(uint64_t target) {
+        // Stessa regola della coda: righe non vuote che non iniziano con ';' o '%'
+        std::string line;
+        while (current_.commandIndex < target && std::getline(file_, line)) {
+            if (line.empty() || line[0] == ';' || line[0] == '%' ||
+                line.find_first_not_of(" \t\r\n") == std::string::npos) {
+                continue;
+            }
+            current_.state.apply(line.c_str());
+            current_.commandIndex++;
+        }
+        if (current_.commandIndex < target) {
+            Logger::logWarning("[JobCheckpoint] " + current_.gcodePath + " ended before command " +
+                               std::to_string(target) + ", checkpoint stopped");
+            active_ = false;
+            progress_.reset();
+            file_.close();
+        }
+    }
+
+    void JobCheckpoint::writeSlot() {
+        static_assert(sizeof(Slot) <= SLOT_SIZE && 2 * SLOT_SIZE <= FILE_SIZE, "checkpoint slots exceed the file");
+        uint64_t sequence = ++sequence_;
+
+        Slot slot{};
+        slot.magic = CHECKPOINT_MAGIC;
+        slot.version = CHECKPOINT_VERSION;
+        slot.active = active_ ? 1 : 0;
+        slot.sequence = sequence;
+        slot.commandIndex = current_.commandIndex;
+        slot.totalCommands = current_.totalCommands;
+        slot.updatedAtMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        const auto &state = current_.state;
+        slot.x = state.x;
+        slot.y = state.y;
+        slot.z = state.z;
+        slot.e = state.e;
+        slot.feedRate = state.feedRate;
+        slot.hotendTemp = state.hotendTemp;
+        slot.bedTemp = state.bedTemp;
+        slot.fanSpeed = state.fanSpeed;
+        slot.absolutePositioning = state.absolutePositioning ? 1 : 0;
+        slot.absoluteExtrusion = state.absoluteExtrusion ? 1 : 0;
+        copyField(slot.jobId, sizeof(slot.jobId), current_.jobId);
+        copyField(slot.gcodePath, sizeof(slot.gcodePath), current_.gcodePath);
+        slot.crc = static_cast<uint32_t>(::crc32(0, reinterpret_cast<const Bytef *>(&slot), offsetof(Slot, crc)));
+
+        // Slot alternati: quello della sequenza precedente resta intatto mentre si scrive questo
+        std::memcpy(mapping_ + (sequence % 2) * SLOT_SIZE, &slot, sizeof(slot));
+    }
+
+    std::optional<CheckpointRecord> JobCheckpoint::readSlots(bool &active) {
+        std::optional<CheckpointRecord> best;
+        uint64_t bestSequence = 0;
+        for (size_t i = 0; i < 2; ++i) {
+            Slot slot;
+            std::memcpy(&slot, mapping_ + i * SLOT_SIZE, sizeof(slot));
+            if (slot.magic != CHECKPOINT_MAGIC || slot.version != CHECKPOINT_VERSION ||
+                slot.crc != ::crc32(0, reinterpret_cast<const Bytef *>(&slot), offsetof(Slot, crc)) ||
+                (best && slot.sequence <= bestSequence)) {
+                continue;
+            }
+
+            CheckpointRecord record;
+            record.jobId = readField(slot.jobId, sizeof(slot.jobId));
+            record.gcodePath = readField(slot.gcodePath, sizeof(slot.gcodePath));
+            record.commandIndex = slot.commandIndex;
+            record.totalCommands = slot.totalCommands;
+            record.state.x = slot.x;
+            record.state.y = slot.y;
+            record.state.z = slot.z;
+            record.state.e = slot.e;
+            record.state.feedRate = slot.feedRate;
+            record.state.hotendTemp = slot.hotendTemp;
+            record.state.bedTemp = slot.bedTemp;
+            record.state.fanSpeed = slot.fanSpeed;
+            record.state.absolutePositioning = slot.absolutePositioning != 0;
+            record.state.absoluteExtrusion = slot.absoluteExtrusion != 0;
+            record.updatedAt = std::chrono::system_clock::time_point(std::chrono::milliseconds(slot.updatedAtMs));
+            best = std::move(record);
+            bestSequence = slot.sequence;
+            active = slot.active != 0;
+        }
+        sequence_ = bestSequence;
+        return best;
+    }
+
+    void JobCheckpoint::syncLoop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stopping_) {
+            syncCv_.wait_for(lock, syncInterval_, [this] { return stopping_ || syncNow_; });
+            if (stopping_) break; // L'ultimo aggiornamento lo scrive close()
+            syncNow_ = false;
+            if (!update()) continue;
+
+            // Solo questo thread scrive gli slot: sync senza lock, begin/finish non attendono il disco
+            lock.unlock();
+            if (!syncMapping()) {
+                Logger::logWarning("[JobCheckpoint] Checkpoint sync failed: " + lastSystemError());
+            }
+            lock.lock();
+        }
+    }
+
+    bool JobCheckpoint::syncMapping() {
+#ifdef _WIN32
+        // FlushViewOfFile avvia solo la scrittura delle pagine: FlushFileBuffers attende che arrivino su disco
+        return FlushViewOfFile(mapping_, FILE_SIZE) && FlushFileBuffers(fileHandle_);
+#else
+        return ::msync(mapping_, FILE_SIZE, MS_SYNC) == 0;
+#endif
+    }
+} // namespace core::jobs
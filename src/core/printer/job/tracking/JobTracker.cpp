@@ -3,17 +3,102 @@
 //
 
 #include "core/printer/job/tracking/JobTracker.hpp"
+#include "core/printer/job/tracking/JobArchive.hpp"
 
 #include "logger/Logger.hpp"
 #include <algorithm>
+#include <cstring>
+#include <thread>
 
 namespace core::jobs {
+    JobProgress::JobProgress(std::string jobId, size_t totalCommands, size_t executedCommands, bool streaming)
+        : jobId_(std::move(jobId)), totalCommands_(totalCommands), streaming_(streaming), executed_(executedCommands),
+          acknowledged_(executedCommands) {
+        lastUpdate_.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+    }
+
+    size_t JobProgress::recordCommand(std::string_view command) {
+        size_t length = std::min(command.size(), MAX_COMMAND_LENGTH);
+        size_t count = (length + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+        std::array<uint64_t, WORDS> words{};
+        std::memcpy(words.data(), command.data(), length);
+
+        uint32_t sequence = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        commandLength_.store(static_cast<uint32_t>(length), std::memory_order_relaxed);
+        for (size_t i = 0; i < count; ++i) {
+            command_[i].store(words[i], std::memory_order_relaxed);
+        }
+        sequence_.store(sequence + 2, std::memory_order_release);
+
+        lastUpdate_.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+        return executed_.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    std::chrono::steady_clock::time_point JobProgress::lastUpdate() const {
+        return std::chrono::steady_clock::time_point(
+            std::chrono::steady_clock::duration(lastUpdate_.load(std::memory_order_relaxed)));
+    }
+
+    std::string JobProgress::currentCommand() const {
+        std::array<uint64_t, WORDS> words{};
+        size_t length = 0;
+        while (true) {
+            uint32_t before = sequence_.load(std::memory_order_acquire);
+            if (before & 1) {
+                std::this_thread::yield();
+                continue;
+            }
+            length = std::min<size_t>(commandLength_.load(std::memory_order_relaxed), MAX_COMMAND_LENGTH);
+            size_t count = (length + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+            for (size_t i = 0; i < count; ++i) {
+                words[i] = command_[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence_.load(std::memory_order_relaxed) == before) break;
+        }
+        std::string command(length, '\0');
+        std::memcpy(command.data(), words.data(), length);
+        return command;
+    }
+
     JobTracker &JobTracker::getInstance() {
         static JobTracker instance;
         return instance;
     }
 
-    void JobTracker::startJob(const std::string &jobId, size_t totalCommands) {
+    JobTracker::JobTracker() = default;
+
+    JobTracker::~JobTracker() = default;
+
+    void JobTracker::configure(size_t maxFinishedJobs, const std::string &archiveDirectory) {
+        std::unique_ptr<JobArchive> archive;
+        if (!archiveDirectory.empty()) {
+            archive = std::make_unique<JobArchive>();
+            if (!archive->open(archiveDirectory)) {
+                Logger::logWarning("[JobTracker] Job archive unavailable, finished jobs beyond " +
+                                   std::to_string(maxFinishedJobs) + " will be dropped");
+                archive.reset();
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(jobsMutex_);
+        maxFinishedJobs_ = maxFinishedJobs;
+        archive_ = std::move(archive);
+        cleanupCompletedJobs();
+    }
+
+    void JobTracker::startJob(const std::string &jobId, size_t totalCommands, size_t executedCommands) {
+        registerJob(jobId, totalCommands, executedCommands, false);
+    }
+
+    void JobTracker::startStreamingJob(const std::string &jobId) {
+        registerJob(jobId, 0, 0, true);
+    }
+
+    void JobTracker::registerJob(const std::string &jobId, size_t totalCommands, size_t executedCommands,
+                                 bool streaming) {
         std::lock_guard<std::mutex> lock(jobsMutex_);
         JobInfo info;
         info.jobId = jobId;
@@ -21,36 +106,66 @@ namespace core::jobs {
         info.startTime = std::chrono::steady_clock::now();
         info.lastUpdate = info.startTime;
         info.totalCommands = totalCommands;
-        info.executedCommands = 0;
-        jobs_[jobId] = std::move(info);
+        info.executedCommands = executedCommands;
+        jobs_[jobId] = JobEntry{std::move(info),
+                                std::make_shared<JobProgress>(jobId, totalCommands, executedCommands, streaming)};
+        activeJobIds_.insert(jobId);
+        generation_.fetch_add(1, std::memory_order_release);
         currentJobId_ = jobId;
         stats_.totalJobs++;
-        Logger::logInfo("[JobTracker] Started job: " + jobId + " (" + std::to_string(totalCommands) + " commands)");
+        Logger::logInfo("[JobTracker] Started job: " + jobId + " (" +
+                        (streaming ? std::string("streaming") : std::to_string(totalCommands) + " commands") + ")");
     }
 
-    void JobTracker::updateJobProgress(const std::string &jobId, const std::string &currentCommand) {
+    void JobTracker::finishStreaming(const JobProgressHandle &progress) {
+        if (!progress || !progress->isStreaming()) return;
+
+        progress->streaming_.store(false);
+        // Stesso controllo di updateJobProgress: l'ultimo comando può essere già stato eseguito
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (progress->executedCommands() < std::max<size_t>(progress->totalCommands(), 1)) return;
+
+        std::lock_guard<std::mutex> lock(jobsMutex_);
+        auto it = jobs_.find(progress->jobId());
+        if (it != jobs_.end() && it->second.progress == progress &&
+            it->second.info.state == core::print::JobState::RUNNING) {
+            updateJobState(progress->jobId(), core::print::JobState::COMPLETED);
+            Logger::logInfo("[JobTracker] Job " + progress->jobId() + " completed automatically");
+        }
+    }
+
+    JobProgressHandle JobTracker::acquireProgress(const std::string &jobId) const {
         std::lock_guard<std::mutex> lock(jobsMutex_);
         auto it = jobs_.find(jobId);
-        if (it == jobs_.end()) return;
+        return (it != jobs_.end()) ? it->second.progress : nullptr;
+    }
+
+    void JobTracker::updateJobProgress(const JobProgressHandle &progress, std::string_view currentCommand) {
+        if (!progress) return;
 
-        it->second.executedCommands++;
-        it->second.currentCommand = currentCommand;
-        it->second.lastUpdate = std::chrono::steady_clock::now();
+        size_t executed = progress->recordCommand(currentCommand);
+        size_t total = progress->totalCommands();
 
         // FIX: Log progresso ogni 1000 comandi
-        if (it->second.executedCommands % 1000 == 0) {
-            float progress = it->second.getProgress();
-            Logger::logInfo("[JobTracker] Job " + jobId + " progress: " +
-                            std::to_string(int(progress)) + "% (" +
-                            std::to_string(it->second.executedCommands) + "/" +
-                            std::to_string(it->second.totalCommands) + ")");
+        if (executed % 1000 == 0) {
+            float percent = total > 0 ? (float(executed) / total) * 100.0f : 0.0f;
+            Logger::logInfo("[JobTracker] Job " + progress->jobId() + " progress: " +
+                            std::to_string(int(percent)) + "% (" +
+                            std::to_string(executed) + "/" +
+                            std::to_string(total) + ")");
         }
 
-        // Auto-complete check
-        if (it->second.executedCommands >= it->second.totalCommands &&
-            it->second.state == core::print::JobState::RUNNING) {
-            updateJobState(jobId, core::print::JobState::COMPLETED);
-            Logger::logInfo("[JobTracker] Job " + jobId + " completed automatically");
+        // Auto-complete check: unico punto in cui il thread esecutore prende il lock.
+        // Un job in streaming si completa solo a download concluso (finishStreaming)
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!progress->isStreaming() && executed == std::max<size_t>(progress->totalCommands(), 1)) {
+            std::lock_guard<std::mutex> lock(jobsMutex_);
+            auto it = jobs_.find(progress->jobId());
+            if (it != jobs_.end() && it->second.progress == progress &&
+                it->second.info.state == core::print::JobState::RUNNING) {
+                updateJobState(progress->jobId(), core::print::JobState::COMPLETED);
+                Logger::logInfo("[JobTracker] Job " + progress->jobId() + " completed automatically");
+            }
         }
     }
 
@@ -67,7 +182,7 @@ namespace core::jobs {
         std::lock_guard<std::mutex> lock(jobsMutex_);
         auto it = jobs_.find(jobId);
         if (it != jobs_.end()) {
-            it->second.error = error;
+            it->second.info.error = error;
             updateJobState(jobId, core::print::JobState::FAILED);
         }
         stats_.failedJobs++;
@@ -96,27 +211,30 @@ namespace core::jobs {
     }
 
     std::optional<JobInfo> JobTracker::getJobInfo(const std::string &jobId) const {
-        std::lock_guard<std::mutex> lock(jobsMutex_);
-        auto it = jobs_.find(jobId);
-        return (it != jobs_.end()) ? std::optional<JobInfo>(it->second) : std::nullopt;
+        JobArchive *archive;
+        {
+            std::lock_guard<std::mutex> lock(jobsMutex_);
+            auto it = jobs_.find(jobId);
+            if (it != jobs_.end()) return snapshot(it->second);
+            archive = archive_.get();
+        }
+        // Lettura da disco fuori da jobsMutex_ (l'archivio ha il suo lock)
+        return archive ? archive->find(jobId) : std::nullopt;
     }
 
     std::string JobTracker::getJobStateCode(const std::string &jobId) const {
-        std::lock_guard<std::mutex> lock(jobsMutex_);
-        auto it = jobs_.find(jobId);
-        if (it == jobs_.end()) return "UNK";
-        return core::print::jobStateToCode(it->second.state);
+        auto info = getJobInfo(jobId);
+        if (!info) return "UNK";
+        return core::print::jobStateToCode(info->state);
     }
 
     std::vector<JobInfo> JobTracker::getActiveJobs() const {
         std::lock_guard<std::mutex> lock(jobsMutex_);
         std::vector<JobInfo> active;
-        for (const auto &[id, info]: jobs_) {
-            if (info.state == core::print::JobState::RUNNING || info.state == core::print::JobState::PAUSED ||
-                info.state == core::print::JobState::LOADING ||
-                info.state == core::print::JobState::HEATING) {
-                active.push_back(info);
-            }
+        active.reserve(activeJobIds_.size());
+        for (const auto &id: activeJobIds_) {
+            auto it = jobs_.find(id);
+            if (it != jobs_.end()) active.push_back(snapshot(it->second));
         }
         return active;
     }
@@ -137,32 +255,62 @@ namespace core::jobs {
 
     void JobTracker::updateJobState(const std::string &jobId, core::print::JobState newState) {
         auto it = jobs_.find(jobId);
-        if (it != jobs_.end()) {
-            it->second.state = newState;
-            it->second.lastUpdate = std::chrono::steady_clock::now();
+        if (it == jobs_.end()) return;
+
+        auto &entry = it->second;
+        auto previous = entry.info.state;
+        entry.info.state = newState;
+        entry.info.lastUpdate = std::chrono::steady_clock::now();
+
+        if (isActiveState(newState)) {
+            activeJobIds_.insert(jobId);
+        } else {
+            activeJobIds_.erase(jobId);
+        }
+
+        if (!isFinalState(newState) || previous == newState) return;
+
+        // Compattazione: i contatori tornano in JobInfo e il blocco di avanzamento viene rilasciato
+        entry.info = snapshot(entry);
+        entry.progress.reset();
+
+        if (archive_) archive_->append(entry.info);
+        if (!isFinalState(previous)) {
+            finishedJobIds_.push_back(jobId);
+            cleanupCompletedJobs();
         }
     }
 
-    void JobTracker::cleanupCompletedJobs() {
-        // Keep only last 100 completed jobs to prevent memory leak
-        constexpr size_t MAX_COMPLETED_JOBS = 100;
-        std::vector<std::pair<std::string, std::chrono::steady_clock::time_point> > completed;
-        for (const auto &[id, info]: jobs_) {
-            if (info.state == core::print::JobState::COMPLETED ||
-                info.state == core::print::JobState::FAILED ||
-                info.state == core::print::JobState::CANCELLED) {
-                completed.emplace_back(id, info.lastUpdate);
-            }
+    JobInfo JobTracker::snapshot(const JobEntry &entry) {
+        JobInfo info = entry.info;
+        if (entry.progress) {
+            info.totalCommands = entry.progress->totalCommands();
+            info.executedCommands = entry.progress->executedCommands();
+            info.currentCommand = entry.progress->currentCommand();
+            info.lastUpdate = std::max(info.lastUpdate, entry.progress->lastUpdate());
         }
+        return info;
+    }
 
-        if (completed.size() > MAX_COMPLETED_JOBS) {
-            std::sort(completed.begin(), completed.end(),
-                      [](const auto &a, const auto &b) { return a.second < b.second; });
+    bool JobTracker::isActiveState(core::print::JobState state) {
+        return state == core::print::JobState::RUNNING || state == core::print::JobState::PAUSED ||
+               state == core::print::JobState::LOADING || state == core::print::JobState::HEATING;
+    }
 
-            size_t toRemove = completed.size() - MAX_COMPLETED_JOBS;
-            for (size_t i = 0; i < toRemove; ++i) {
-                jobs_.erase(completed[i].first);
+    bool JobTracker::isFinalState(core::print::JobState state) {
+        return state == core::print::JobState::COMPLETED || state == core::print::JobState::FAILED ||
+               state == core::print::JobState::CANCELLED;
+    }
+
+    void JobTracker::cleanupCompletedJobs() {
+        // Keep only the last maxFinishedJobs_ finished jobs in memory, older ones stay in the archive
+        while (finishedJobIds_.size() > maxFinishedJobs_) {
+            auto it = jobs_.find(finishedJobIds_.front());
+            // Lo stesso jobId potrebbe essere stato riavviato nel frattempo
+            if (it != jobs_.end() && isFinalState(it->second.info.state)) {
+                jobs_.erase(it);
             }
+            finishedJobIds_.pop_front();
         }
     }
 } // namespace core::jobs
@@ -0,0 +1,34 @@
+#include "core/printer/registry/PrinterRegistry.hpp"
+#include "logger/Logger.hpp"
+#include <stdexcept>
+
+namespace core {
+    std::shared_ptr<PrinterContext> PrinterRegistry::add(config::PrinterConfig config) {
+        if (config.driverId.empty()) {
+            throw std::invalid_argument("Printer driverId cannot be empty");
+        }
+        if (byDriverId_.count(config.driverId)) {
+            throw std::invalid_argument("Printer already registered: " + config.driverId);
+        }
+
+        auto printer = std::make_shared<PrinterContext>();
+        printer->config = std::move(config);
+        if (!printers_.empty()) {
+            printer->ownStateTracker = std::make_unique<state::StateTracker>();
+            printer->ownCheckpoint = std::make_unique<jobs::JobCheckpoint>();
+        }
+
+        byDriverId_.emplace(printer->driverId(), printer);
+        printers_.push_back(printer);
+        Logger::logInfo("[PrinterRegistry] Registered printer " + printer->driverId() + " on " +
+                        printer->config.serialPort + " @ " + std::to_string(printer->config.baudrate) + " baud" +
+                        (printer->config.cpuCore >= 0 ? " (core " + std::to_string(printer->config.cpuCore) + ")"
+                                                      : ""));
+        return printer;
+    }
+
+    std::shared_ptr<PrinterContext> PrinterRegistry::find(const std::string &driverId) const {
+        auto it = byDriverId_.find(driverId);
+        return it != byDriverId_.end() ? it->second : nullptr;
+    }
+} // namespace core
@@ -4,9 +4,81 @@
 
 #include "core/printer/state/StateTracker.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <type_traits>
+
 namespace core::state {
+    static_assert(std::is_trivially_copyable_v<StateSnapshot>, "StateSnapshot viene pubblicato byte per byte");
+
+    CommandRef CommandRef::of(std::string_view command) {
+        CommandRef ref;
+        size_t length = std::min(command.size(), MAX_NAME);
+        std::memcpy(ref.name.data(), command.data(), length);
+        return ref;
+    }
+
+    CommandRef &CommandRef::with(char key, double value) {
+        if (paramCount < MAX_PARAMS) {
+            keys[paramCount] = key;
+            values[paramCount] = value;
+            paramCount++;
+        }
+        return *this;
+    }
+
+    std::string CommandRef::toString() const {
+        if (empty()) return {};
+        std::ostringstream out;
+        out << name.data();
+        for (size_t i = 0; i < paramCount; ++i) {
+            out << " " << keys[i] << values[i];
+        }
+        return out.str();
+    }
+
     StateTracker &StateTracker::getInstance() {
         static StateTracker instance;
         return instance;
     }
+
+    StateTracker::StateTracker() {
+        publish();
+    }
+
+    void StateTracker::publish() {
+        uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+        state_.version = sequence / 2 + 1;
+
+        std::array<uint64_t, WORDS> words{};
+        std::memcpy(words.data(), &state_, sizeof(StateSnapshot));
+
+        sequence_.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < WORDS; ++i) {
+            published_[i].store(words[i], std::memory_order_relaxed);
+        }
+        sequence_.store(sequence + 2, std::memory_order_release);
+    }
+
+    StateSnapshot StateTracker::snapshot() const {
+        std::array<uint64_t, WORDS> words{};
+        while (true) {
+            uint64_t before = sequence_.load(std::memory_order_acquire);
+            if (before & 1) {
+                std::this_thread::yield();
+                continue;
+            }
+            for (size_t i = 0; i < WORDS; ++i) {
+                words[i] = published_[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence_.load(std::memory_order_relaxed) == before) break;
+        }
+
+        StateSnapshot result;
+        std::memcpy(static_cast<void *>(&result), words.data(), sizeof(StateSnapshot));
+        return result;
+    }
 } // namespace core::state
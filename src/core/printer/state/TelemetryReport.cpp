@@ -0,0 +1,94 @@
+#include "core/printer/state/TelemetryReport.hpp"
+#include "core/printer/state/StateTracker.hpp"
+#include <cstdlib>
+#include <sstream>
+
+namespace core::state {
+    namespace {
+        bool parseNumber(const std::string &text, double &value) {
+            if (text.empty()) return false;
+            char *end = nullptr;
+            value = std::strtod(text.c_str(), &end);
+            return end == text.c_str() + text.size();
+        }
+
+        // "205.1/210" -> attuale e target, "205.1" -> solo attuale
+        bool parseTemperature(const std::string &text, std::optional<double> &actual, std::optional<double> &target) {
+            double value;
+            auto slash = text.find('/');
+            if (!parseNumber(text.substr(0, slash), value)) return false;
+            actual = value;
+
+            if (slash != std::string::npos) {
+                if (!parseNumber(text.substr(slash + 1), value)) return false;
+                target = value;
+            }
+            return true;
+        }
+
+        // "010" -> X aperto, Y premuto, Z aperto
+        bool parseEndstops(const std::string &text, std::optional<types::EndstopStatus> &endstops) {
+            if (text.size() != 3 || text.find_first_not_of("01") != std::string::npos) return false;
+            types::EndstopStatus status;
+            status.x = text[0] == '1';
+            status.y = text[1] == '1';
+            status.z = text[2] == '1';
+            endstops = status;
+            return true;
+        }
+    }
+
+    bool TelemetryReport::matches(const std::string &payload) {
+        return payload.compare(0, 4, "STS ") == 0;
+    }
+
+    std::optional<TelemetryReport> TelemetryReport::parse(const std::string &payload) {
+        if (!matches(payload)) return std::nullopt;
+
+        TelemetryReport report;
+        std::istringstream iss(payload.substr(4));
+        std::string token;
+
+        while (iss >> token) {
+            auto eq = token.find('=');
+            if (eq == std::string::npos) return std::nullopt;
+
+            std::string key = token.substr(0, eq);
+            std::string value = token.substr(eq + 1);
+            double number;
+
+            if (key == "HE") {
+                if (!parseTemperature(value, report.hotendTemp, report.hotendTarget)) return std::nullopt;
+            } else if (key == "BED") {
+                if (!parseTemperature(value, report.bedTemp, report.bedTarget)) return std::nullopt;
+            } else if (key == "ES") {
+                if (!parseEndstops(value, report.endstops)) return std::nullopt;
+            } else if (!parseNumber(value, number)) {
+                return std::nullopt;
+            } else if (key == "X") {
+                report.x = number;
+            } else if (key == "Y") {
+                report.y = number;
+            } else if (key == "Z") {
+                report.z = number;
+            } else if (key == "FAN") {
+                report.fanSpeed = static_cast<int>(number);
+            }
+            // Chiavi sconosciute ignorate: firmware più recenti possono aggiungere campi
+        }
+
+        return report;
+    }
+
+    void TelemetryReport::applyTo(StateTracker &stateTracker) const {
+        if (hotendTemp) stateTracker.updateHotendActualTemp(*hotendTemp);
+        if (hotendTarget) stateTracker.setHotendTargetTemp(*hotendTarget);
+        if (bedTemp) stateTracker.updateBedActualTemp(*bedTemp);
+        if (bedTarget) stateTracker.setBedTargetTemp(*bedTarget);
+        if (fanSpeed) stateTracker.updateReportedFanSpeed(*fanSpeed);
+        if (endstops) stateTracker.updateEndstops(*endstops);
+
+        // La posizione è aggiornata solo se completa, per non mischiare assi di istanti diversi
+        if (x && y && z) stateTracker.updatePosition(*x, *y, *z);
+    }
+} // namespace core::state
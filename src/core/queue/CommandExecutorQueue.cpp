@@ -1,5 +1,6 @@
 #include "core/queue/CommandExecutorQueue.hpp"
 #include "logger/Logger.hpp"
+#include "logger/TraceLog.hpp"
 #include "translator/exceptions/GCodeTranslatorInvalidCommandException.hpp"
 #include "translator/exceptions/GCodeTranslatorUnknownCommandException.hpp"
 #include <fstream>
@@ -9,6 +10,7 @@
 
 #include "core/printer/job/tracking/JobTracker.hpp"
 #include "core/printer/state/StateTracker.hpp"
+#include "core/utils/ThreadAffinity.hpp"
 
 namespace core {
     static constexpr size_t MAX_COMMANDS_IN_RAM = 10000;
@@ -16,14 +18,15 @@ namespace core {
     static constexpr size_t RELOAD_THRESHOLD = 100;
     static constexpr size_t RELOAD_BATCH_SIZE = 1000;
 
-    CommandExecutorQueue::CommandExecutorQueue(std::shared_ptr<translator::gcode::GCodeTranslator> translator)
-            : translator_(std::move(translator)), running_(false), stopping_(false),
+    CommandExecutorQueue::CommandExecutorQueue(std::shared_ptr<translator::gcode::GCodeTranslator> translator,
+                                               std::string diskPath)
+            : translator_(std::move(translator)), diskPath_(std::move(diskPath)), running_(false), stopping_(false),
               lastExecutionTime_(std::chrono::steady_clock::now()) {
         if (!translator_) {
             throw std::invalid_argument("GCodeTranslator cannot be null");
         }
         initDiskFile();
-        Logger::logInfo("[CommandExecutorQueue] Created with advanced paging system");
+        DRIVER_LOG_INFO(LogModule::Queue, "[CommandExecutorQueue] Created with advanced paging system");
     }
 
     CommandExecutorQueue::~CommandExecutorQueue() {
@@ -33,11 +36,11 @@ namespace core {
 
     void CommandExecutorQueue::start() {
         if (running_) {
-            Logger::logWarning("[CommandExecutorQueue] Already running");
+            DRIVER_LOG_WARNING(LogModule::Queue, "[CommandExecutorQueue] Already running");
             return;
         }
 
-        Logger::logInfo("[CommandExecutorQueue] Starting executor");
+        DRIVER_LOG_INFO(LogModule::Queue, "[CommandExecutorQueue] Starting executor");
         running_ = true;
         stopping_ = false;
         lastExecutionTime_ = std::chrono::steady_clock::now();
@@ -48,7 +51,8 @@ namespace core {
             try {
                 processingLoop();
             } catch (const std::exception &e) {
-                Logger::logError("[CommandExecutorQueue] Processing thread crashed: " + std::string(e.what()));
+                DRIVER_LOG_ERROR(LogModule::Queue,
+                                 "[CommandExecutorQueue] Processing thread crashed: " + std::string(e.what()));
                 running_ = false;
             }
         });
@@ -58,17 +62,18 @@ namespace core {
             try {
                 healthMonitorLoop();
             } catch (const std::exception &e) {
-                Logger::logError("[CommandExecutorQueue] Health thread crashed: " + std::string(e.what()));
+                DRIVER_LOG_ERROR(LogModule::Queue,
+                                 "[CommandExecutorQueue] Health thread crashed: " + std::string(e.what()));
             }
         });
 
-        Logger::logInfo("[CommandExecutorQueue] Started successfully");
+        DRIVER_LOG_INFO(LogModule::Queue, "[CommandExecutorQueue] Started successfully");
     }
 
     void CommandExecutorQueue::stop() {
         if (!running_) return;
 
-        Logger::logInfo("[CommandExecutorQueue] Stopping...");
+        DRIVER_LOG_INFO(LogModule::Queue, "[CommandExecutorQueue] Stopping...");
 
         // CRITICAL: Set stopping flag first to prevent new commands
         {
@@ -89,11 +94,16 @@ namespace core {
         }
 
         clearQueue();
-        Logger::logInfo("[CommandExecutorQueue] Stopped");
+        DRIVER_LOG_INFO(LogModule::Queue, "[CommandExecutorQueue] Stopped");
     }
 
     void CommandExecutorQueue::processingLoop() {
-        Logger::logInfo("[CommandExecutorQueue] Processing loop started");
+        DRIVER_LOG_INFO(LogModule::Queue, "[CommandExecutorQueue] Processing loop started");
+        int cpu = cpuAffinity_;
+        if (cpu >= 0 && !utils::pinCurrentThread(cpu)) {
+            DRIVER_LOG_WARNING(LogModule::Queue,
+                               "[CommandExecutorQueue] Cannot pin processing thread to core " + std::to_string(cpu));
+        }
         processingThreadAlive_ = true;
         processingThreadId_ = std::this_thread::get_id();
 
@@ -118,7 +128,8 @@ namespace core {
                     // Progressive reload logic with timeout
                     if (executedSinceReload >= RELOAD_THRESHOLD) {
                         if (!loadFromAllSourcesSafe()) {
-                            Logger::logWarning("[CommandExecutorQueue] Load from sources failed - continuing");
+                            DRIVER_LOG_WARNING(LogModule::Queue,
+                                               "[CommandExecutorQueue] Load from sources failed - continuing");
                         }
                         executedSinceReload = 0;
                     }
@@ -159,13 +170,15 @@ namespace core {
                         if (executedCount % 100 == 0) {
                             auto now = std::chrono::steady_clock::now();
                             auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - lastLogTime).count();
-                            Logger::logInfo("[CommandExecutorQueue] Executed: " + std::to_string(executedCount) +
+                            DRIVER_LOG_INFO(LogModule::Queue,
+                                            "[CommandExecutorQueue] Executed: " + std::to_string(executedCount) +
                                             ", Rate: " + std::to_string(elapsed > 0 ? 100 / elapsed : 0) + " cmd/s");
                             lastLogTime = now;
                         }
 
                     } catch (const std::exception &e) {
-                        Logger::logError("[CommandExecutorQueue] Command execution failed: " + std::string(e.what()));
+                        DRIVER_LOG_ERROR(LogModule::Queue,
+                                         "[CommandExecutorQueue] Command execution failed: " + std::string(e.what()));
                         // Continue processing other commands
                     }
                 }
@@ -174,19 +187,20 @@ namespace core {
                 std::this_thread::sleep_for(std::chrono::milliseconds(10));
             }
         } catch (const std::exception &e) {
-            Logger::logError("[CommandExecutorQueue] Processing loop crashed: " + std::string(e.what()));
+            DRIVER_LOG_ERROR(LogModule::Queue,
+                             "[CommandExecutorQueue] Processing loop crashed: " + std::string(e.what()));
             processingThreadAlive_ = false;
             running_ = false;
             throw; // Re-throw to be caught by health monitor
         }
 
         processingThreadAlive_ = false;
-        Logger::logInfo(
+        DRIVER_LOG_INFO(LogModule::Queue,
                 "[CommandExecutorQueue] Processing loop finished. Total executed: " + std::to_string(executedCount));
     }
 
     void CommandExecutorQueue::healthMonitorLoop() {
-        Logger::logInfo("[CommandExecutorQueue] Health monitor started");
+        DRIVER_LOG_INFO(LogModule::Queue, "[CommandExecutorQueue] Health monitor started");
 
         while (running_) {
             std::this_thread::sleep_for(std::chrono::seconds(5));
@@ -211,13 +225,14 @@ namespace core {
 
             if (isStalled && !executionStalled_) {
                 executionStalled_ = true;
-                Logger::logError("[CommandExecutorQueue] STALL DETECTED! " +
-                                 std::to_string(timeSinceLastExecution) + "s since last execution, " +
-                                 "thread alive: " + (threadAlive ? "true" : "false"));
+                DRIVER_LOG_ERROR(LogModule::Queue, "[CommandExecutorQueue] STALL DETECTED! " +
+                                                   std::to_string(timeSinceLastExecution) + "s since last execution, " +
+                                                   "thread alive: " + (threadAlive ? "true" : "false"));
 
                 // AGGRESSIVE RECOVERY STRATEGY
                 if (!threadAlive || timeSinceLastExecution > 60) {
-                    Logger::logError("[CommandExecutorQueue] CRITICAL: Processing thread dead or hung - RESTARTING");
+                    DRIVER_LOG_ERROR(LogModule::Queue,
+                                     "[CommandExecutorQueue] CRITICAL: Processing thread dead or hung - RESTARTING");
 
                     // Force restart processing thread
                     restartProcessingThread();
@@ -232,35 +247,48 @@ namespace core {
             // Periodic status log
             static int statusCounter = 0;
             if (++statusCounter % 12 == 0 && totalCommands > 0) {
-                Logger::logInfo("[CommandExecutorQueue] Health: " + std::to_string(totalCommands) +
+                DRIVER_LOG_INFO(LogModule::Queue,
+                                "[CommandExecutorQueue] Health: " + std::to_string(totalCommands) +
                                 " commands pending, last exec " + std::to_string(timeSinceLastExecution) +
                                 "s ago, thread alive: " + (threadAlive ? "true" : "false"));
             }
         }
 
-        Logger::logInfo("[CommandExecutorQueue] Health monitor stopped");
+        DRIVER_LOG_INFO(LogModule::Queue, "[CommandExecutorQueue] Health monitor stopped");
     }
 
     void CommandExecutorQueue::executeCommand(const PriorityCommand &cmd) {
-        auto &tracker = jobs::JobTracker::getInstance();
-        tracker.updateJobProgress(cmd.jobId, cmd.command);
-
-        // Skip comments and empty lines
+        // Skip comments and empty lines (not counted in the job total either)
         if (cmd.command.empty() || cmd.command[0] == ';' || cmd.command[0] == '%') {
             updateStats(true, false);
             return;
         }
 
-        // Log critical commands
-        bool shouldLog = (cmd.priority <= 2) ||
+        // Job progress handle resolved once per job, then updated without locks
+        if (!cmd.jobId.empty()) {
+            auto &tracker = jobs::JobTracker::getInstance();
+            uint64_t generation = tracker.generation();
+            if (cmd.jobId != progressJobId_ || generation != progressGeneration_) {
+                progressJobId_ = cmd.jobId;
+                progressGeneration_ = generation;
+                progress_ = tracker.acquireProgress(cmd.jobId);
+            }
+            tracker.updateJobProgress(progress_, cmd.command);
+        }
+
+        DRIVER_TRACE(TraceEvent::QueueExecute, cmd.command, cmd.priority, TraceInterned{cmd.jobId});
+
+        // Log critical commands (no text search when queue INFO logging is off)
+        bool shouldLog = Logger::isEnabled(LogModule::Queue, LogLevel::Info) &&
+                        ((cmd.priority <= 2) ||
                          (cmd.command.find("M24") != std::string::npos) ||  // Start print
                          (cmd.command.find("M25") != std::string::npos) ||  // Pause
                          (cmd.command.find("M112") != std::string::npos) || // Emergency stop
-                         (cmd.command.find("G28") != std::string::npos);    // Homing
+                         (cmd.command.find("G28") != std::string::npos));   // Homing
 
         if (shouldLog) {
-            Logger::logInfo("[CommandExecutorQueue] EXECUTING: " + cmd.command +
-                            " (priority=" + std::to_string(cmd.priority) + ", jobId=" + cmd.jobId + ")");
+            DRIVER_LOG_INFO(LogModule::Queue, "[CommandExecutorQueue] EXECUTING: ", cmd.command,
+                            " (priority=", cmd.priority, ", jobId=", cmd.jobId, ")");
         }
 
         try {
@@ -268,22 +296,29 @@ namespace core {
             updateStats(true, false);
 
             if (shouldLog) {
-                Logger::logInfo("[CommandExecutorQueue] Command executed successfully");
+                DRIVER_LOG_INFO(LogModule::Queue, "[CommandExecutorQueue] Command executed successfully");
             }
 
         } catch (const GCodeTranslatorInvalidCommandException &e) {
             updateStats(false, true);
-            Logger::logWarning("[CommandExecutorQueue] Invalid G-code: " + cmd.command + " - " + std::string(e.what()));
+            DRIVER_LOG_WARNING(LogModule::Queue,
+                               "[CommandExecutorQueue] Invalid G-code: " + cmd.command + " - " + std::string(e.what()));
         } catch (const GCodeTranslatorUnknownCommandException &e) {
             updateStats(false, true);
-            Logger::logWarning("[CommandExecutorQueue] Unknown G-code: " + cmd.command + " - " + std::string(e.what()));
+            DRIVER_LOG_WARNING(LogModule::Queue,
+                               "[CommandExecutorQueue] Unknown G-code: " + cmd.command + " - " + std::string(e.what()));
         }
 
         catch (const std::exception &e) {
             updateStats(false, true);
-            Logger::logError(
+            DRIVER_LOG_ERROR(LogModule::Queue,
                     "[CommandExecutorQueue] Execution error for '" + cmd.command + "': " + std::string(e.what()));
         }
+
+        // Read by the job checkpoint; rejected lines count too, the queue moves past them anyway
+        if (!cmd.jobId.empty() && progress_) {
+            progress_->recordAcknowledged();
+        }
     }
 
     // Rest of the methods remain the same but with FIXED locking order
@@ -329,8 +364,8 @@ namespace core {
             }
 
             if (loadedFromBuffer > 0 || loadedFromDisk > 0) {
-                Logger::logInfo("[CommandExecutorQueue] Loaded " + std::to_string(loadedFromBuffer) +
-                                " from buffer, " + std::to_string(loadedFromDisk) + " from disk");
+                DRIVER_LOG_INFO(LogModule::Queue, "[CommandExecutorQueue] Loaded " + std::to_string(loadedFromBuffer) +
+                                                  " from buffer, " + std::to_string(loadedFromDisk) + " from disk");
             }
         }
     }
@@ -351,7 +386,7 @@ namespace core {
                 loaded++;
             }
             if (loaded > 0) {
-                Logger::logInfo(
+                DRIVER_LOG_INFO(LogModule::Queue,
                         "[CommandExecutorQueue] Force loaded " + std::to_string(loaded) + " commands from disk");
             }
         }
@@ -363,7 +398,7 @@ namespace core {
         }
 
         if (!running_) {
-            Logger::logInfo("[CommandExecutorQueue] Auto-starting queue for incoming command");
+            DRIVER_LOG_INFO(LogModule::Queue, "[CommandExecutorQueue] Auto-starting queue for incoming command");
             start();
         }
 
@@ -376,14 +411,14 @@ namespace core {
         {
             std::lock_guard<std::mutex> lock(queueMutex_);
             if (stopping_) {
-                Logger::logWarning("[CommandExecutorQueue] Rejecting command - queue is stopping");
+                DRIVER_LOG_WARNING(LogModule::Queue, "[CommandExecutorQueue] Rejecting command - queue is stopping");
                 return;
             }
 
             // High priority goes directly to RAM
             if (priority < 3) {
                 commandQueue_.push(cmd);
-                Logger::logInfo("[CommandExecutorQueue] High priority command enqueued");
+                DRIVER_LOG_INFO(LogModule::Queue, "[CommandExecutorQueue] High priority command enqueued");
             } else {
                 // Normal priority follows standard flow
                 if (commandQueue_.size() < MAX_COMMANDS_IN_RAM) {
@@ -405,8 +440,8 @@ namespace core {
                                                const std::string &jobId) {
         if (commands.empty()) return;
 
-        Logger::logInfo("[CommandExecutorQueue] Enqueuing " + std::to_string(commands.size()) +
-                        " commands with priority " + std::to_string(priority));
+        DRIVER_LOG_INFO(LogModule::Queue, "[CommandExecutorQueue] Enqueuing " + std::to_string(commands.size()) +
+                                          " commands with priority " + std::to_string(priority));
 
         if (!running_) {
             start();
@@ -415,29 +450,11 @@ namespace core {
         size_t enqueuedCount = 0;
         {
             std::lock_guard<std::mutex> lock(queueMutex_);
-            for (const auto &command: commands) {
-                if (!command.empty() && command.find_first_not_of(" \t\r\n") != std::string::npos) {
-                    PriorityCommand cmd;
-                    cmd.command = command;
-                    cmd.priority = priority;
-                    cmd.jobId = jobId;
-                    cmd.sequenceId = nextSequenceId_.fetch_add(1);
-
-                    if (commandQueue_.size() < MAX_COMMANDS_IN_RAM) {
-                        commandQueue_.push(cmd);
-                    } else if (pagingBuffer_.size() < PAGING_BUFFER_SIZE) {
-                        pagingBuffer_.push(cmd);
-                    } else {
-                        flushPagingBufferToDisk();
-                        pagingBuffer_.push(cmd);
-                    }
-                    enqueuedCount++;
-                }
-            }
-            stats_.totalEnqueued += enqueuedCount;
+            enqueuedCount = pushCommands(commands, priority, jobId);
         }
 
-        Logger::logInfo("[CommandExecutorQueue] Successfully enqueued " + std::to_string(enqueuedCount) + " commands");
+        DRIVER_LOG_INFO(LogModule::Queue,
+                        "[CommandExecutorQueue] Successfully enqueued " + std::to_string(enqueuedCount) + " commands");
 
         // Wake up processing thread
         for (int i = 0; i < 5; ++i) {
@@ -446,10 +463,61 @@ namespace core {
         }
     }
 
+    void CommandExecutorQueue::appendCommands(const std::vector<std::string> &commands, int priority,
+                                              const std::string &jobId) {
+        if (commands.empty()) return;
+
+        if (!running_) {
+            start();
+        }
+
+        size_t enqueuedCount = 0;
+        {
+            std::lock_guard<std::mutex> lock(queueMutex_);
+            if (stopping_) {
+                DRIVER_LOG_WARNING(LogModule::Queue, "[CommandExecutorQueue] Rejecting commands - queue is stopping");
+                return;
+            }
+            enqueuedCount = pushCommands(commands, priority, jobId);
+        }
+        queueCondition_.notify_all();
+
+        DRIVER_LOG_DEBUG(LogModule::Queue,
+                         "[CommandExecutorQueue] Appended " + std::to_string(enqueuedCount) + " commands");
+    }
+
+    size_t CommandExecutorQueue::pushCommands(const std::vector<std::string> &commands, int priority,
+                                              const std::string &jobId) {
+        size_t enqueuedCount = 0;
+        for (const auto &command: commands) {
+            if (!command.empty() && command.find_first_not_of(" \t\r\n") != std::string::npos) {
+                PriorityCommand cmd;
+                cmd.command = command;
+                cmd.priority = priority;
+                cmd.jobId = jobId;
+                cmd.sequenceId = nextSequenceId_.fetch_add(1);
+
+                if (commandQueue_.size() < MAX_COMMANDS_IN_RAM) {
+                    commandQueue_.push(cmd);
+                } else if (pagingBuffer_.size() < PAGING_BUFFER_SIZE) {
+                    pagingBuffer_.push(cmd);
+                } else {
+                    flushPagingBufferToDisk();
+                    pagingBuffer_.push(cmd);
+                }
+                enqueuedCount++;
+            }
+        }
+
+        std::lock_guard<std::mutex> statsLock(statsMutex_);
+        stats_.totalEnqueued += enqueuedCount;
+        return enqueuedCount;
+    }
+
     void CommandExecutorQueue::enqueueFile(const std::string &filePath, int priority, const std::string &jobId) {
         std::ifstream file(filePath);
         if (!file.is_open()) {
-            Logger::logError("[CommandExecutorQueue] Cannot open file: " + filePath);
+            DRIVER_LOG_ERROR(LogModule::Queue, "[CommandExecutorQueue] Cannot open file: " + filePath);
             return;
         }
 
@@ -466,10 +534,11 @@ namespace core {
         }
         file.close();
 
-        Logger::logInfo("[CommandExecutorQueue] File loaded: " + std::to_string(validCommands) + " commands");
+        DRIVER_LOG_INFO(LogModule::Queue,
+                        "[CommandExecutorQueue] File loaded: " + std::to_string(validCommands) + " commands");
 
         if (commands.empty()) {
-            Logger::logWarning("[CommandExecutorQueue] No valid commands in file");
+            DRIVER_LOG_WARNING(LogModule::Queue, "[CommandExecutorQueue] No valid commands in file");
             return;
         }
 
@@ -477,8 +546,7 @@ namespace core {
         auto &jobTracker = core::jobs::JobTracker::getInstance();
         jobTracker.startJob(jobId, commands.size());
 
-        auto &stateTracker = core::state::StateTracker::getInstance();
-        stateTracker.resetForNewJob();
+        translator_->getDriver()->stateTracker().resetForNewJob();
 
         enqueueCommands(commands, priority, jobId);
     }
@@ -500,14 +568,17 @@ namespace core {
         diskQueue_.clear();
 
         if (clearedCount > 0) {
-            Logger::logInfo("[CommandExecutorQueue] Cleared " + std::to_string(clearedCount) + " commands");
+            DRIVER_LOG_INFO(LogModule::Queue,
+                            "[CommandExecutorQueue] Cleared " + std::to_string(clearedCount) + " commands");
         }
     }
 
     CommandExecutorQueue::Statistics CommandExecutorQueue::getStatistics() const {
+        // Prima delle code: chi accoda prende queueMutex_ e poi statsMutex_
+        size_t queueSize = getTotalCommandsAvailable();
         std::lock_guard<std::mutex> lock(statsMutex_);
         Statistics result = stats_;
-        result.currentQueueSize = getTotalCommandsAvailable();
+        result.currentQueueSize = queueSize;
         return result;
     }
 
@@ -578,30 +649,31 @@ namespace core {
     }
 
     void CommandExecutorQueue::initDiskFile() {
-        std::filesystem::create_directories("temp");
-        std::string diskPath = "temp/command_queue.dat";
+        std::error_code ec;
+        auto directory = std::filesystem::path(diskPath_).parent_path();
+        if (!directory.empty()) std::filesystem::create_directories(directory, ec);
 
-        if (std::filesystem::exists(diskPath)) {
-            std::filesystem::remove(diskPath);
+        if (std::filesystem::exists(diskPath_)) {
+            std::filesystem::remove(diskPath_);
         }
 
-        diskFile_.open(diskPath, std::ios::binary | std::ios::in | std::ios::out | std::ios::app);
+        diskFile_.open(diskPath_, std::ios::binary | std::ios::in | std::ios::out | std::ios::app);
         if (!diskFile_.is_open()) {
-            Logger::logWarning("[CommandExecutorQueue] Could not open disk file");
+            DRIVER_LOG_WARNING(LogModule::Queue, "[CommandExecutorQueue] Could not open disk file");
         } else {
-            Logger::logInfo("[CommandExecutorQueue] Disk file initialized: " + diskPath);
+            DRIVER_LOG_INFO(LogModule::Queue, "[CommandExecutorQueue] Disk file initialized: " + diskPath_);
         }
     }
 
     void CommandExecutorQueue::closeDiskFile() {
         if (diskFile_.is_open()) {
             diskFile_.close();
-            std::filesystem::remove("temp/command_queue.dat");
+            std::filesystem::remove(diskPath_);
         }
     }
 
     void CommandExecutorQueue::restartProcessingThread() {
-        Logger::logError("[CommandExecutorQueue] Forcing processing thread restart");
+        DRIVER_LOG_ERROR(LogModule::Queue, "[CommandExecutorQueue] Forcing processing thread restart");
 
         // Stop current thread if still joinable
         running_ = false;
@@ -610,9 +682,10 @@ namespace core {
         if (processingThread_.joinable()) {
             try {
                 processingThread_.join();
-                Logger::logInfo("[CommandExecutorQueue] Old processing thread joined");
+                DRIVER_LOG_INFO(LogModule::Queue, "[CommandExecutorQueue] Old processing thread joined");
             } catch (const std::exception &e) {
-                Logger::logError("[CommandExecutorQueue] Error joining old thread: " + std::string(e.what()));
+                DRIVER_LOG_ERROR(LogModule::Queue,
+                                 "[CommandExecutorQueue] Error joining old thread: " + std::string(e.what()));
             }
         }
 
@@ -628,18 +701,18 @@ namespace core {
             try {
                 processingLoop();
             } catch (const std::exception &e) {
-                Logger::logError(
+                DRIVER_LOG_ERROR(LogModule::Queue,
                         "[CommandExecutorQueue] Restarted processing thread crashed: " + std::string(e.what()));
                 processingThreadAlive_ = false;
                 running_ = false;
             }
         });
 
-        Logger::logInfo("[CommandExecutorQueue] Processing thread restarted successfully");
+        DRIVER_LOG_INFO(LogModule::Queue, "[CommandExecutorQueue] Processing thread restarted successfully");
     }
 
     void CommandExecutorQueue::recoverFromStall() {
-        Logger::logInfo("[CommandExecutorQueue] Attempting standard stall recovery");
+        DRIVER_LOG_INFO(LogModule::Queue, "[CommandExecutorQueue] Attempting standard stall recovery");
 
         // Clear any potential deadlock by aggressive loading
         {
@@ -692,7 +765,8 @@ namespace core {
                         }
 
                         if (loadedFromBuffer > 0 || loadedFromDisk > 0) {
-                            Logger::logInfo("[CommandExecutorQueue] Loaded " + std::to_string(loadedFromBuffer) +
+                            DRIVER_LOG_INFO(LogModule::Queue,
+                                            "[CommandExecutorQueue] Loaded " + std::to_string(loadedFromBuffer) +
                                             " from buffer, " + std::to_string(loadedFromDisk) + " from disk");
                         }
                         break;
@@ -701,14 +775,16 @@ namespace core {
                 }
 
                 if (!diskLockAcquired) {
-                    Logger::logWarning("[CommandExecutorQueue] Disk lock timeout - skipping disk load");
+                    DRIVER_LOG_WARNING(LogModule::Queue,
+                                       "[CommandExecutorQueue] Disk lock timeout - skipping disk load");
                     return false;
                 }
             }
 
             return true;
         } catch (const std::exception &e) {
-            Logger::logError("[CommandExecutorQueue] loadFromAllSourcesSafe failed: " + std::string(e.what()));
+            DRIVER_LOG_ERROR(LogModule::Queue,
+                             "[CommandExecutorQueue] loadFromAllSourcesSafe failed: " + std::string(e.what()));
             return false;
         }
     }
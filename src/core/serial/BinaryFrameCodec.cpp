@@ -0,0 +1,204 @@
+#include "core/serial/BinaryFrameCodec.hpp"
+#include <array>
+#include <cctype>
+#include <cstdlib>
+
+namespace core {
+
+    namespace {
+
+        constexpr std::array<uint16_t, 256> makeCrcTable() {
+            std::array<uint16_t, 256> table{};
+            for (uint16_t i = 0; i < 256; ++i) {
+                uint16_t crc = static_cast<uint16_t>(i << 8);
+                for (int bit = 0; bit < 8; ++bit) {
+                    crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x1021) : static_cast<uint16_t>(crc << 1);
+                }
+                table[i] = crc;
+            }
+            return table;
+        }
+
+        constexpr auto CRC_TABLE = makeCrcTable();
+
+        constexpr int MAX_MANTISSA_DIGITS = 15;
+
+        void appendVarint(std::string &out, uint64_t value) {
+            while (value >= 0x80) {
+                out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<char>(value));
+        }
+
+        bool readVarint(const std::string &data, size_t &pos, size_t end, uint64_t &value) {
+            value = 0;
+            for (int shift = 0; shift < 64 && pos < end; shift += 7) {
+                auto byte = static_cast<uint8_t>(data[pos++]);
+                value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0) return true;
+            }
+            return false;
+        }
+
+        uint64_t zigzag(int64_t value) {
+            return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+        }
+
+        int64_t unzigzag(uint64_t value) {
+            return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+        }
+
+        bool parseUnsigned(const std::string &token, uint64_t &value) {
+            if (token.empty() || token.size() > MAX_MANTISSA_DIGITS) return false;
+            value = 0;
+            for (char c: token) {
+                if (!std::isdigit(static_cast<unsigned char>(c))) return false;
+                value = value * 10 + static_cast<uint64_t>(c - '0');
+            }
+            return true;
+        }
+
+        /**
+         * @brief Codifica "X10.5" / "F1500" / "X" nel formato parametro binario
+         */
+        bool encodeParam(std::string &out, const std::string &token) {
+            auto letter = static_cast<unsigned char>(token[0]);
+            if (!std::isupper(letter)) return false;
+
+            if (token.size() == 1) {
+                out.push_back(static_cast<char>(letter | BinaryFrameCodec::FLAG_PARAM));
+                return true;
+            }
+
+            size_t pos = 1;
+            bool negative = token[pos] == '-';
+            if (negative) pos++;
+
+            std::string digits;
+            int decimals = 0;
+            size_t dot = token.find('.', pos);
+            if (dot == std::string::npos) {
+                digits = token.substr(pos);
+            } else {
+                decimals = static_cast<int>(token.size() - dot - 1);
+                if (decimals == 0 || decimals > BinaryFrameCodec::MAX_DECIMALS) return false;
+                digits = token.substr(pos, dot - pos) + token.substr(dot + 1);
+            }
+
+            uint64_t magnitude;
+            if (!parseUnsigned(digits, magnitude)) return false;
+
+            // "-0" perderebbe il segno: lo lascia all'ASCII
+            if (negative && magnitude == 0) return false;
+
+            int64_t mantissa = negative ? -static_cast<int64_t>(magnitude) : static_cast<int64_t>(magnitude);
+            out.push_back(static_cast<char>(letter));
+            appendVarint(out, (zigzag(mantissa) << 2) | static_cast<uint64_t>(decimals));
+            return true;
+        }
+
+        std::string formatFixed(int64_t mantissa, int decimals) {
+            std::string digits = std::to_string(mantissa < 0 ? -mantissa : mantissa);
+            if (decimals > 0) {
+                if (digits.size() <= static_cast<size_t>(decimals)) {
+                    digits.insert(0, static_cast<size_t>(decimals) + 1 - digits.size(), '0');
+                }
+                digits.insert(digits.size() - static_cast<size_t>(decimals), ".");
+            }
+            return mantissa < 0 ? "-" + digits : digits;
+        }
+
+    } // namespace
+
+    uint16_t BinaryFrameCodec::crc16(const uint8_t *data, size_t size) {
+        uint16_t crc = 0xFFFF;
+        for (size_t i = 0; i < size; ++i) {
+            crc = static_cast<uint16_t>((crc << 8) ^ CRC_TABLE[((crc >> 8) ^ data[i]) & 0xFF]);
+        }
+        return crc;
+    }
+
+    std::optional<std::string> BinaryFrameCodec::encode(const std::string &command) {
+        // Formato atteso: N<numero> <categoria><codice> [parametri] [*checksum]
+        size_t pos = 0;
+        auto nextToken = [&command, &pos]() -> std::string {
+            while (pos < command.size() && command[pos] == ' ') pos++;
+            size_t start = pos;
+            while (pos < command.size() && command[pos] != ' ') pos++;
+            return command.substr(start, pos - start);
+        };
+
+        std::string numberToken = nextToken();
+        std::string commandToken = nextToken();
+        uint64_t number;
+        uint64_t code;
+        if (numberToken.size() < 2 || numberToken[0] != 'N' || !parseUnsigned(numberToken.substr(1), number) ||
+            commandToken.size() < 2 || !std::isupper(static_cast<unsigned char>(commandToken[0])) ||
+            !parseUnsigned(commandToken.substr(1), code)) {
+            return std::nullopt;
+        }
+
+        std::string frame;
+        frame.reserve(HEADER_SIZE + 32 + CRC_SIZE);
+        frame.push_back(static_cast<char>(SYNC_BYTE));
+        frame.push_back('\0'); // LEN, scritto a fine corpo
+
+        appendVarint(frame, number);
+        frame.push_back(commandToken[0]);
+        appendVarint(frame, code);
+
+        for (std::string token = nextToken(); !token.empty() && token[0] != '*'; token = nextToken()) {
+            if (!encodeParam(frame, token)) return std::nullopt;
+        }
+
+        size_t bodySize = frame.size() - HEADER_SIZE;
+        if (bodySize > MAX_BODY_SIZE) return std::nullopt;
+        frame[1] = static_cast<char>(bodySize);
+
+        uint16_t crc = crc16(reinterpret_cast<const uint8_t *>(frame.data()) + 1, bodySize + 1);
+        frame.push_back(static_cast<char>(crc >> 8));
+        frame.push_back(static_cast<char>(crc & 0xFF));
+        return frame;
+    }
+
+    std::optional<size_t> BinaryFrameCodec::frameSize(const std::string &data) {
+        if (data.size() < HEADER_SIZE || static_cast<uint8_t>(data[0]) != SYNC_BYTE) {
+            return std::nullopt;
+        }
+        return HEADER_SIZE + static_cast<uint8_t>(data[1]) + CRC_SIZE;
+    }
+
+    std::optional<std::string> BinaryFrameCodec::decode(const std::string &frame) {
+        auto size = frameSize(frame);
+        if (!size || frame.size() < *size) return std::nullopt;
+
+        size_t end = *size - CRC_SIZE;
+        uint16_t expected = static_cast<uint16_t>((static_cast<uint8_t>(frame[end]) << 8) |
+                                                  static_cast<uint8_t>(frame[end + 1]));
+        if (crc16(reinterpret_cast<const uint8_t *>(frame.data()) + 1, end - 1) != expected) {
+            return std::nullopt;
+        }
+
+        size_t pos = HEADER_SIZE;
+        uint64_t number;
+        uint64_t code;
+        if (!readVarint(frame, pos, end, number) || pos >= end) return std::nullopt;
+        char category = frame[pos++];
+        if (!readVarint(frame, pos, end, code)) return std::nullopt;
+
+        std::string command = "N" + std::to_string(number) + " " + category + std::to_string(code);
+        while (pos < end) {
+            auto tag = static_cast<uint8_t>(frame[pos++]);
+            command += ' ';
+            command += static_cast<char>(tag & ~FLAG_PARAM);
+            if (tag & FLAG_PARAM) continue;
+
+            uint64_t value;
+            if (!readVarint(frame, pos, end, value)) return std::nullopt;
+            command += formatFixed(unzigzag(value >> 2), static_cast<int>(value & 0x3));
+        }
+        return command;
+    }
+
+} // namespace core
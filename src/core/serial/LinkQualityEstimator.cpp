@@ -0,0 +1,133 @@
+#include "core/serial/LinkQualityEstimator.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+
+namespace core {
+
+    // Costanti RFC 6298
+    static constexpr double RTT_ALPHA = 1.0 / 8.0;
+    static constexpr double RTT_BETA = 1.0 / 4.0;
+    static constexpr double RTO_K = 4.0;
+    static constexpr double CLOCK_GRANULARITY_US = 1000.0;
+    static constexpr uint32_t MAX_OVERFLOW_SHIFT = 10;
+
+    LinkQualityEstimator::LinkQualityEstimator() : LinkQualityEstimator(Config{}) {}
+
+    LinkQualityEstimator::LinkQualityEstimator(Config config) : config_(config) {}
+
+    void LinkQualityEstimator::addSample(const std::string &key, std::chrono::microseconds rtt) {
+        double rttUs = static_cast<double>(std::max<int64_t>(rtt.count(), 0));
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        update(estimates_[key], rttUs);
+        update(link_, rttUs);
+    }
+
+    void LinkQualityEstimator::update(Estimate &estimate, double rttUs) {
+        if (estimate.samples == 0) {
+            estimate.srttUs = rttUs;
+            estimate.rttvarUs = rttUs / 2.0;
+        } else {
+            estimate.rttvarUs = (1.0 - RTT_BETA) * estimate.rttvarUs + RTT_BETA * std::abs(estimate.srttUs - rttUs);
+            estimate.srttUs = (1.0 - RTT_ALPHA) * estimate.srttUs + RTT_ALPHA * rttUs;
+        }
+        estimate.samples++;
+    }
+
+    std::chrono::milliseconds LinkQualityEstimator::computeRto(const Estimate &estimate) const {
+        if (estimate.samples == 0) {
+            return config_.initialRto;
+        }
+
+        double rtoUs = estimate.srttUs + std::max(CLOCK_GRANULARITY_US, RTO_K * estimate.rttvarUs);
+        auto rto = std::chrono::milliseconds(static_cast<int64_t>(rtoUs / 1000.0) + 1);
+        return std::clamp(rto, config_.minRto, config_.maxRto);
+    }
+
+    std::chrono::milliseconds LinkQualityEstimator::retransmissionTimeout(const std::string &key) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = estimates_.find(key);
+        if (it != estimates_.end() && it->second.samples > 0) {
+            return computeRto(it->second);
+        }
+        // Comando mai visto: la stima del link è un limite inferiore troppo ottimistico,
+        // quindi si usa l'RTO iniziale conservativo
+        return config_.initialRto;
+    }
+
+    std::chrono::milliseconds LinkQualityEstimator::retransmissionTimeout() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return computeRto(link_);
+    }
+
+    std::chrono::milliseconds LinkQualityEstimator::backoff(std::chrono::milliseconds rto) const {
+        return std::min(rto * 2, config_.maxRto);
+    }
+
+    std::chrono::milliseconds LinkQualityEstimator::retryDelay() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (link_.samples == 0) {
+            return config_.maxRetryDelay;
+        }
+        auto srtt = std::chrono::milliseconds(static_cast<int64_t>(link_.srttUs / 1000.0) + 1);
+        return std::min(srtt, config_.maxRetryDelay);
+    }
+
+    std::chrono::milliseconds LinkQualityEstimator::onBufferOverflow() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        uint32_t shift = std::min(consecutiveOverflows_, MAX_OVERFLOW_SHIFT);
+        consecutiveOverflows_++;
+
+        // Il buffer del firmware si svuota alla velocità con cui esegue i comandi: la base è un RTT di link
+        int64_t baseMs = link_.samples > 0 ? static_cast<int64_t>(link_.srttUs / 1000.0) + 1 : 10;
+        auto backoff = std::chrono::milliseconds(std::max<int64_t>(baseMs, 5) << shift);
+        return std::min(backoff, config_.maxOverflowBackoff);
+    }
+
+    void LinkQualityEstimator::onAcknowledged() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        consecutiveOverflows_ = 0;
+    }
+
+    uint32_t LinkQualityEstimator::consecutiveOverflows() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return consecutiveOverflows_;
+    }
+
+    LinkQualityEstimator::Snapshot LinkQualityEstimator::toSnapshot(const Estimate &estimate) const {
+        Snapshot snapshot;
+        snapshot.srtt = std::chrono::microseconds(static_cast<int64_t>(estimate.srttUs));
+        snapshot.rttvar = std::chrono::microseconds(static_cast<int64_t>(estimate.rttvarUs));
+        snapshot.rto = computeRto(estimate);
+        snapshot.samples = estimate.samples;
+        return snapshot;
+    }
+
+    LinkQualityEstimator::Snapshot LinkQualityEstimator::snapshot(const std::string &key) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = estimates_.find(key);
+        return it != estimates_.end() ? toSnapshot(it->second) : toSnapshot(Estimate{});
+    }
+
+    LinkQualityEstimator::Snapshot LinkQualityEstimator::linkSnapshot() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return toSnapshot(link_);
+    }
+
+    std::string LinkQualityEstimator::commandKey(const std::string &command) {
+        // Formato: N<numero> <categoria><codice> [parametri] *<checksum>
+        size_t start = command.find(' ');
+        if (start == std::string::npos || start + 1 >= command.size()) {
+            return "";
+        }
+        start++;
+
+        size_t end = start + 1;
+        while (end < command.size() && std::isdigit(static_cast<unsigned char>(command[end]))) {
+            end++;
+        }
+        return command.substr(start, end - start);
+    }
+
+} // namespace core
@@ -0,0 +1,146 @@
+#include "core/serial/SerialCapture.hpp"
+#include "logger/Logger.hpp"
+
+namespace core {
+
+    namespace {
+        constexpr char CAPTURE_MAGIC[] = {'3', 'D', 'P', 'C', 'A', 'P'};
+        constexpr uint8_t CAPTURE_VERSION = 1;
+        constexpr uint64_t MAX_RECORD_SIZE = 1 << 20;
+
+        void writeVarint(std::ofstream &out, uint64_t value) {
+            char buffer[10];
+            size_t size = 0;
+            while (value >= 0x80) {
+                buffer[size++] = static_cast<char>((value & 0x7F) | 0x80);
+                value >>= 7;
+            }
+            buffer[size++] = static_cast<char>(value);
+            out.write(buffer, static_cast<std::streamsize>(size));
+        }
+
+        bool readVarint(std::ifstream &in, uint64_t &value) {
+            value = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                int byte = in.get();
+                if (byte == std::char_traits<char>::eof()) return false;
+                value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0) return true;
+            }
+            return false;
+        }
+    }
+
+    SerialCaptureWriter::SerialCaptureWriter(const std::string &path)
+            : buffer_(FLUSH_BYTES), start_(std::chrono::steady_clock::now()), lastFlush_(start_) {
+        // Il buffer va impostato prima dell'apertura: le write arrivano al kernel solo quando è pieno
+        file_.rdbuf()->pubsetbuf(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+        file_.open(path, std::ios::binary | std::ios::trunc);
+        if (!file_.is_open()) {
+            DRIVER_LOG_ERROR(LogModule::Serial, "[SerialCapture] Cannot open capture file: " + path);
+            return;
+        }
+
+        file_.write(CAPTURE_MAGIC, sizeof(CAPTURE_MAGIC));
+        file_.put(static_cast<char>(CAPTURE_VERSION));
+        file_.flush();
+        DRIVER_LOG_INFO(LogModule::Serial, "[SerialCapture] Capturing serial traffic to " + path);
+    }
+
+    SerialCaptureWriter::~SerialCaptureWriter() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (file_.is_open()) {
+            file_.close();
+        }
+    }
+
+    bool SerialCaptureWriter::isOpen() const {
+        return file_.is_open();
+    }
+
+    void SerialCaptureWriter::record(CaptureDirection direction, const std::string &data) {
+        auto now = std::chrono::steady_clock::now();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!file_.is_open()) return;
+
+        auto timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(now - start_);
+        auto delta = timestamp > lastTimestamp_ ? timestamp - lastTimestamp_ : std::chrono::nanoseconds(0);
+        lastTimestamp_ += delta;
+
+        file_.put(static_cast<char>(direction));
+        writeVarint(file_, static_cast<uint64_t>(delta.count()));
+        writeVarint(file_, data.size());
+        file_.write(data.data(), static_cast<std::streamsize>(data.size()));
+        records_++;
+
+        // Nessuna write per record sul percorso TX/RX: su disco al più FLUSH_INTERVAL dopo
+        if (now - lastFlush_ >= FLUSH_INTERVAL) {
+            file_.flush();
+            lastFlush_ = now;
+        }
+    }
+
+    void SerialCaptureWriter::flush() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (file_.is_open()) {
+            file_.flush();
+        }
+    }
+
+    uint64_t SerialCaptureWriter::recordCount() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return records_;
+    }
+
+    SerialCaptureReader::SerialCaptureReader(const std::string &path)
+            : file_(path, std::ios::binary) {
+        char magic[sizeof(CAPTURE_MAGIC)];
+        if (!file_.read(magic, sizeof(magic)) ||
+            !std::equal(magic, magic + sizeof(magic), CAPTURE_MAGIC)) {
+            DRIVER_LOG_ERROR(LogModule::Serial, "[SerialCapture] Not a capture file: " + path);
+            return;
+        }
+
+        int version = file_.get();
+        if (version != CAPTURE_VERSION) {
+            DRIVER_LOG_ERROR(LogModule::Serial,
+                             "[SerialCapture] Unsupported capture version " + std::to_string(version));
+            return;
+        }
+        valid_ = true;
+    }
+
+    bool SerialCaptureReader::isOpen() const {
+        return valid_;
+    }
+
+    std::optional<CaptureRecord> SerialCaptureReader::next() {
+        if (!valid_) return std::nullopt;
+
+        int direction = file_.get();
+        if (direction == std::char_traits<char>::eof()) return std::nullopt;
+
+        uint64_t delta;
+        uint64_t size;
+        if (direction > static_cast<int>(CaptureDirection::TX_FRAME) ||
+            !readVarint(file_, delta) || !readVarint(file_, size) || size > MAX_RECORD_SIZE) {
+            DRIVER_LOG_WARNING(LogModule::Serial, "[SerialCapture] Corrupted capture record - stopping");
+            valid_ = false;
+            return std::nullopt;
+        }
+
+        CaptureRecord record;
+        record.direction = static_cast<CaptureDirection>(direction);
+        timestamp_ += std::chrono::nanoseconds(static_cast<int64_t>(delta));
+        record.timestamp = timestamp_;
+        record.data.resize(size);
+        if (!file_.read(record.data.data(), static_cast<std::streamsize>(size))) {
+            DRIVER_LOG_WARNING(LogModule::Serial, "[SerialCapture] Truncated capture record - stopping");
+            valid_ = false;
+            return std::nullopt;
+        }
+        return record;
+    }
+
+} // namespace core
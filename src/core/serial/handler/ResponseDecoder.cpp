@@ -0,0 +1,154 @@
+#include "core/serial/handler/ResponseDecoder.hpp"
+#include <cstdlib>
+#include <cstring>
+
+namespace core {
+
+    namespace {
+        bool startsWith(const char *cursor, const char *end, const char *prefix) {
+            size_t length = std::strlen(prefix);
+            return static_cast<size_t>(end - cursor) >= length && std::memcmp(cursor, prefix, length) == 0;
+        }
+
+        const char *skipSpaces(const char *cursor, const char *end) {
+            while (cursor < end && *cursor == ' ') ++cursor;
+            return cursor;
+        }
+
+        const char *tokenEnd(const char *cursor, const char *end) {
+            while (cursor < end && *cursor != ' ') ++cursor;
+            return cursor;
+        }
+
+        // Numero in [cursor, end): strtod si ferma al primo carattere non numerico, che deve essere la fine
+        bool parseNumber(const char *cursor, const char *end, double &value) {
+            if (cursor >= end) return false;
+            char buffer[32];
+            size_t length = static_cast<size_t>(end - cursor);
+            if (length >= sizeof(buffer)) return false;
+            std::memcpy(buffer, cursor, length);
+            buffer[length] = '\0';
+
+            char *parsed = nullptr;
+            value = std::strtod(buffer, &parsed);
+            return parsed == buffer + length;
+        }
+
+        /**
+         * @brief Itera i token "CHIAVE=valore" separati da spazi, chiamando visit(chiave, inizio, fine valore).
+         * @return false se un token non ha '=' o visit rifiuta il valore
+         */
+        template<typename Visitor>
+        bool forEachField(const char *cursor, const char *end, Visitor visit) {
+            while ((cursor = skipSpaces(cursor, end)) < end) {
+                const char *stop = tokenEnd(cursor, end);
+                const char *eq = static_cast<const char *>(std::memchr(cursor, '=', stop - cursor));
+                if (!eq) return false;
+                if (!visit(cursor, eq, eq + 1, stop)) return false;
+                cursor = stop;
+            }
+            return true;
+        }
+
+        bool keyIs(const char *key, const char *keyEnd, char name) {
+            return keyEnd - key == 1 && *key == name;
+        }
+    }
+
+    bool ResponseDecoder::decode(const std::string &payload, types::DecodedResponse &decoded) {
+        const char *cursor = payload.data();
+        const char *end = cursor + payload.size();
+
+        if (startsWith(cursor, end, "POS ")) return decodePosition(cursor + 4, end, decoded);
+        if (startsWith(cursor, end, "TEMP=")) return decodeTemperature(cursor + 5, end, decoded);
+        if (startsWith(cursor, end, "ENDSTOP ")) return decodeEndstops(cursor + 8, end, decoded);
+        if (startsWith(cursor, end, "FAN")) return decodeFan(cursor + 3, end, decoded);
+        return false;
+    }
+
+    bool ResponseDecoder::decodePosition(const char *cursor, const char *end, types::DecodedResponse &decoded) {
+        bool hasX = false, hasY = false, hasZ = false;
+        ::position::Position position{0.0, 0.0, 0.0};
+
+        bool valid = forEachField(cursor, end, [&](const char *key, const char *keyEnd,
+                                                  const char *value, const char *valueEnd) {
+            double number;
+            if (!parseNumber(value, valueEnd, number)) return false;
+            if (keyIs(key, keyEnd, 'X')) {
+                position.x = number;
+                hasX = true;
+            } else if (keyIs(key, keyEnd, 'Y')) {
+                position.y = number;
+                hasY = true;
+            } else if (keyIs(key, keyEnd, 'Z')) {
+                position.z = number;
+                hasZ = true;
+            }
+            // Altri assi (E...) ignorati
+            return true;
+        });
+
+        // Solo posizioni complete: un asse mancante lascerebbe un valore inventato
+        if (!valid || !hasX || !hasY || !hasZ) return false;
+        decoded.position = position;
+        return true;
+    }
+
+    bool ResponseDecoder::decodeTemperature(const char *cursor, const char *end, types::DecodedResponse &decoded) {
+        const char *stop = tokenEnd(cursor, end);
+        const char *slash = static_cast<const char *>(std::memchr(cursor, '/', stop - cursor));
+
+        types::TemperatureReading reading;
+        if (!parseNumber(cursor, slash ? slash : stop, reading.actual)) return false;
+        if (slash) {
+            double target;
+            if (!parseNumber(slash + 1, stop, target)) return false;
+            reading.target = target;
+        }
+
+        decoded.temperature = reading;
+        return true;
+    }
+
+    bool ResponseDecoder::decodeEndstops(const char *cursor, const char *end, types::DecodedResponse &decoded) {
+        types::EndstopStatus status;
+
+        bool valid = forEachField(cursor, end, [&](const char *key, const char *keyEnd,
+                                                  const char *value, const char *valueEnd) {
+            bool triggered;
+            if (startsWith(value, valueEnd, "TRIGGERED") || (valueEnd - value == 1 && *value == '1')) {
+                triggered = true;
+            } else if (startsWith(value, valueEnd, "OPEN") || (valueEnd - value == 1 && *value == '0')) {
+                triggered = false;
+            } else {
+                return false;
+            }
+
+            if (keyIs(key, keyEnd, 'X')) status.x = triggered;
+            else if (keyIs(key, keyEnd, 'Y')) status.y = triggered;
+            else if (keyIs(key, keyEnd, 'Z')) status.z = triggered;
+            return true;
+        });
+
+        if (!valid) return false;
+        decoded.endstops = status;
+        return true;
+    }
+
+    bool ResponseDecoder::decodeFan(const char *cursor, const char *end, types::DecodedResponse &decoded) {
+        // "FAN=255" oppure "FAN S=255"
+        if (cursor < end && *cursor == '=') {
+            cursor += 1;
+        } else if (startsWith(cursor, end, " S=")) {
+            cursor += 3;
+        } else {
+            return false;
+        }
+
+        double speed;
+        if (!parseNumber(cursor, tokenEnd(cursor, end), speed) || speed < 0) return false;
+        decoded.fanSpeed = speed > 255 ? 255 : static_cast<int>(speed);
+        return true;
+    }
+
+} // namespace core
@@ -3,36 +3,63 @@
 //
 
 #include "core/serial/handler/SerialProtocolHandler.hpp"
+#include "core/printer/state/StateTracker.hpp"
+#include "core/printer/state/TelemetryReport.hpp"
 #include "logger/Logger.hpp"
+#include "logger/TraceLog.hpp"
 #include <sstream>
 #include <algorithm>
-#include <regex>
 #include <iomanip>
 
+namespace {
+    bool isDigit(char c) {
+        return c >= '0' && c <= '9';
+    }
+
+    /**
+     * @brief "OKn", "Enn", "EMn", "ETn" o "ESn" seguito da " N<numero>", senza regex né allocazioni
+     */
+    bool isStandardResponse(const std::string &message) {
+        if (message.size() < 6 || !isDigit(message[2])) return false;
+        bool code = (message[0] == 'O' && message[1] == 'K') ||
+                    (message[0] == 'E' && (isDigit(message[1]) || message[1] == 'M' || message[1] == 'T' ||
+                                           message[1] == 'S'));
+        return code && message[3] == ' ' && message[4] == 'N' && isDigit(message[5]);
+    }
+} // namespace
+
 namespace core {
 
-    SerialProtocolHandler::SerialProtocolHandler(std::shared_ptr<SerialPort> serialPort)
-            : serialPort_(std::move(serialPort)), waitingForCriticalMessage_(false) {
+    SerialProtocolHandler::SerialProtocolHandler(std::shared_ptr<SerialPort> serialPort,
+                                                 std::shared_ptr<LinkQualityEstimator> linkQuality,
+                                                 state::StateTracker &stateTracker)
+            : serialPort_(std::move(serialPort)), linkQuality_(std::move(linkQuality)), stateTracker_(stateTracker),
+              waitingForCriticalMessage_(false) {
         if (!serialPort_) {
             throw std::invalid_argument("SerialPort cannot be null");
         }
-        Logger::logInfo("[SerialProtocolHandler] Initialized with checksum validation and ACK protocol");
+        DRIVER_LOG_INFO(LogModule::Serial,
+                        "[SerialProtocolHandler] Initialized with checksum validation and ACK protocol");
     }
 
-    SerialMessage SerialProtocolHandler::receiveMessage() {
+    SerialMessage SerialProtocolHandler::receiveMessage(std::chrono::milliseconds timeout) {
         std::lock_guard<std::mutex> lock(protocolMutex_);
 
         if (!serialPort_ || !serialPort_->isOpen()) {
-            Logger::logError("[SerialProtocolHandler] Serial port not available");
+            DRIVER_LOG_ERROR(LogModule::Serial, "[SerialProtocolHandler] Serial port not available");
             return {MessageType::STANDARD, MessageCodeType::UNAVAIABLE_SERIAL_PORT, "", 0, 0, ""};
         }
 
-        std::string rawMessage = serialPort_->receiveLine();
+        std::string rawMessage = serialPort_->receiveLine(timeout);
         if (rawMessage.empty()) {
             return {MessageType::STANDARD, MessageCodeType::EMPTY_MESSAGE, "", 0, 0, ""};
         }
 
-        Logger::logInfo("[SerialProtocolHandler] Raw message received: " + rawMessage);
+        if (rawMessage == "CONN_LOST" || rawMessage == "SERIAL_ERROR") {
+            return {MessageType::STANDARD, MessageCodeType::CONNECTION_LOST, "", 0, 0, rawMessage};
+        }
+
+        DRIVER_LOG_DEBUG(LogModule::Serial, "[SerialProtocolHandler] Raw message received: ", rawMessage);
 
         SerialMessage message = parseMessage(rawMessage);
 
@@ -48,21 +75,90 @@ namespace core {
         if (!isValidMessage(message)) {
             // Skip BUSY
             if (message.rawMessage.find("BUSY") != 0) {
-                Logger::logWarning("[SerialProtocolHandler] Checksum mismatch - discarding message: " + rawMessage);
+                DRIVER_LOG_WARNING(LogModule::Serial,
+                                   "[SerialProtocolHandler] Checksum mismatch - discarding message: " + rawMessage);
             }
             return {MessageType::STANDARD, MessageCodeType::CHECKSUM_ERROR_SKIP, "", 0, 0, rawMessage};
         }
 
-        Logger::logInfo("[SerialProtocolHandler] Message validated successfully");
+        if (message.type == MessageType::URGENT) {
+            {
+                std::lock_guard<std::mutex> urgentLock(urgentMutex_);
+                urgentAcks_++;
+            }
+            urgentCondition_.notify_all();
+            DRIVER_LOG_INFO(LogModule::Serial,
+                            "[SerialProtocolHandler] Urgent command acknowledged: " + message.payload);
+            return message;
+        }
+
+        if (message.type == MessageType::TELEMETRY) {
+            if (auto report = state::TelemetryReport::parse(message.payload)) {
+                report->applyTo(stateTracker_);
+            } else {
+                DRIVER_LOG_WARNING(LogModule::Serial,
+                                   "[SerialProtocolHandler] Malformed telemetry report: " + message.payload);
+            }
+            return message;
+        }
+
+        DRIVER_LOG_DEBUG(LogModule::Serial, "[SerialProtocolHandler] Message validated successfully");
         return message;
     }
 
     void SerialProtocolHandler::sendCommand(const std::string &command) {
-        if (isOpen()) {
-            serialPort_->send(command);
-        } else {
-            Logger::logError("[SerialProtocolHandler] Cannot send - serial port not available");
+        if (!isOpen()) {
+            DRIVER_LOG_ERROR(LogModule::Serial, "[SerialProtocolHandler] Cannot send - serial port not available");
+            return;
         }
+
+        std::lock_guard<std::mutex> writeLock(writeMutex_);
+        if (framingMode_.load() == FramingMode::BINARY) {
+            // Comandi non rappresentabili (es. più di 3 decimali) restano in ASCII: il firmware accetta entrambi
+            if (auto frame = BinaryFrameCodec::encode(command)) {
+                serialPort_->sendBytes(*frame);
+                return;
+            }
+        }
+
+        serialPort_->send(command);
+    }
+
+    void SerialProtocolHandler::sendUrgent(const std::string &line) {
+        if (!isOpen()) {
+            DRIVER_LOG_ERROR(LogModule::Serial,
+                             "[SerialProtocolHandler] Cannot send urgent command - serial port not available");
+            return;
+        }
+
+        // Sempre ASCII: il firmware riconosce '!' a inizio linea in entrambi i framing
+        std::lock_guard<std::mutex> writeLock(writeMutex_);
+        serialPort_->send(line);
+    }
+
+    uint64_t SerialProtocolHandler::urgentAckCount() const {
+        std::lock_guard<std::mutex> lock(urgentMutex_);
+        return urgentAcks_;
+    }
+
+    bool SerialProtocolHandler::waitForUrgentAck(uint64_t seen, std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lock(urgentMutex_);
+        return urgentCondition_.wait_for(lock, timeout, [this, seen] { return urgentAcks_ > seen; });
+    }
+
+    void SerialProtocolHandler::setFramingMode(FramingMode mode) {
+        framingMode_.store(mode);
+        DRIVER_LOG_INFO(LogModule::Serial, std::string("[SerialProtocolHandler] Framing mode: ") +
+                                           (mode == FramingMode::BINARY ? "BINARY (CRC16)" : "ASCII"));
+    }
+
+    FramingMode SerialProtocolHandler::getFramingMode() const {
+        return framingMode_.load();
+    }
+
+    bool SerialProtocolHandler::reconnect(std::chrono::milliseconds timeout) {
+        std::lock_guard<std::mutex> writeLock(writeMutex_);
+        return serialPort_->reconnect(timeout);
     }
 
     bool SerialProtocolHandler::isOpen() const {
@@ -81,7 +177,8 @@ namespace core {
         size_t pos = message.find(" *");
         if (pos == std::string::npos) {
             if (message.find("BUSY") != 0) { // Skip BUSY
-                Logger::logWarning("[SerialProtocolHandler] No checksum found in message: " + message);
+                DRIVER_LOG_WARNING(LogModule::Serial,
+                                   "[SerialProtocolHandler] No checksum found in message: " + message);
             }
             return -1; // Return 0 if no checksum found
         }
@@ -90,7 +187,7 @@ namespace core {
         try {
             return static_cast<uint8_t>(std::stoi(checksumStr));
         } catch (const std::exception &e) {
-            Logger::logError("[SerialProtocolHandler] Invalid checksum format: " + checksumStr);
+            DRIVER_LOG_ERROR(LogModule::Serial, "[SerialProtocolHandler] Invalid checksum format: " + checksumStr);
             return -1;
         }
     }
@@ -114,9 +211,16 @@ namespace core {
             return MessageType::CRITICAL;
         }
 
+        if (state::TelemetryReport::matches(message)) {
+            return MessageType::TELEMETRY;
+        }
+
+        if (message.find("URG ") == 0) {
+            return MessageType::URGENT;
+        }
+
         // Check for standard response codes (OK, E01-E05, EM0, ET0, ES0, ES1)
-        std::regex standardPattern("^(OK[0-9]|E[0-9]{2}|E[MT][0-9]|ES[0-9]) N[0-9]+");
-        if (std::regex_search(message, standardPattern)) {
+        if (isStandardResponse(message)) {
             return MessageType::STANDARD;
         }
 
@@ -139,13 +243,13 @@ namespace core {
         message.code = decodeMessageCodeFromString(token);
 
         if (token.find("BUSY") != 0) { // Skip BUSY log
-            Logger::logInfo(std::string("[SerialProtocolHandler] Parsed - Type: ") +
-                            (message.type == MessageType::CRITICAL ? "CRT" :
-                             message.type == MessageType::STANDARD ? "STD" : "INF") +
-                            ", Code: " + token +
-                            ", Valid: " + (isValidMessage(message) ? "true" : "false") +
-                            ", Checksum: " + std::to_string(message.receivedChecksum) + "/" +
-                            std::to_string(message.calculatedChecksum));
+            DRIVER_LOG_DEBUG(LogModule::Serial, "[SerialProtocolHandler] Parsed - Type: ",
+                             message.type == MessageType::CRITICAL ? "CRT" :
+                             message.type == MessageType::STANDARD ? "STD" :
+                             message.type == MessageType::TELEMETRY ? "STS" :
+                             message.type == MessageType::URGENT ? "URG" : "INF",
+                             ", Code: ", token, ", Valid: ", isValidMessage(message),
+                             ", Checksum: ", message.receivedChecksum, "/", message.calculatedChecksum);
         }
 
         return message;
@@ -153,7 +257,7 @@ namespace core {
 
     void SerialProtocolHandler::sendAck(uint8_t checksum) {
         if (!isOpen()) {
-            Logger::logError("[SerialProtocolHandler] Cannot send ACK - serial port not available");
+            DRIVER_LOG_ERROR(LogModule::Serial, "[SerialProtocolHandler] Cannot send ACK - serial port not available");
             return;
         }
 
@@ -162,44 +266,56 @@ namespace core {
         ack << "A" << std::setfill('0') << std::setw(3) << static_cast<int>(checksum);
 
         std::string ackMessage = ack.str();
-        serialPort_->send(ackMessage);
+        {
+            std::lock_guard<std::mutex> writeLock(writeMutex_);
+            serialPort_->send(ackMessage);
+        }
 
-        Logger::logInfo("[SerialProtocolHandler] Sent ACK: " + ackMessage);
+        DRIVER_TRACE(TraceEvent::AckSent, ackMessage);
+        DRIVER_LOG_DEBUG(LogModule::Serial, "[SerialProtocolHandler] Sent ACK: ", ackMessage);
     }
 
     SerialMessage SerialProtocolHandler::handleCriticalMessage(SerialMessage &message) {
-        Logger::logInfo("[SerialProtocolHandler] Handling critical message: " + message.rawMessage);
+        DRIVER_LOG_INFO(LogModule::Serial, "[SerialProtocolHandler] Handling critical message: " + message.rawMessage);
 
         if (isValidMessage(message)) {
-            Logger::logInfo("[SerialProtocolHandler] Critical message valid - processing");
+            DRIVER_LOG_INFO(LogModule::Serial, "[SerialProtocolHandler] Critical message valid - processing");
             return message;
         }
 
         // Checksum errato per messaggio CRT - blocco e attendo nuovo messaggio
-        Logger::logWarning("[SerialProtocolHandler] Critical message checksum invalid - waiting for retry");
+        DRIVER_LOG_WARNING(LogModule::Serial,
+                           "[SerialProtocolHandler] Critical message checksum invalid - waiting for retry");
         waitingForCriticalMessage_ = true;
 
-        SerialMessage retryMessage = waitForRetryMessage();
+        // Il firmware ritrasmette il CRT dopo il NACK: si attende qualche RTT di link, non minuti
+        auto timeout = linkQuality_ ? linkQuality_->backoff(linkQuality_->backoff(linkQuality_->retransmissionTimeout()))
+                                    : std::chrono::milliseconds(3000);
+        SerialMessage retryMessage = waitForRetryMessage(timeout);
         waitingForCriticalMessage_ = false;
 
         return retryMessage;
     }
 
-    SerialMessage SerialProtocolHandler::waitForRetryMessage(long timeoutMs) {
-        Logger::logInfo("[SerialProtocolHandler] Waiting for firmware retry...");
+    SerialMessage SerialProtocolHandler::waitForRetryMessage(std::chrono::milliseconds timeout) {
+        DRIVER_LOG_INFO(LogModule::Serial,
+                        "[SerialProtocolHandler] Waiting for firmware retry (" + std::to_string(timeout.count()) +
+                        "ms)...");
 
-        auto startTime = std::chrono::steady_clock::now();
-        auto timeout = std::chrono::milliseconds(timeoutMs);
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+
+        while (true) {
+            auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+            if (remaining.count() <= 0) break;
 
-        while (std::chrono::steady_clock::now() - startTime < timeout) {
             if (!isOpen()) {
-                Logger::logError("[SerialProtocolHandler] Serial port lost during retry wait");
+                DRIVER_LOG_ERROR(LogModule::Serial, "[SerialProtocolHandler] Serial port lost during retry wait");
                 return {MessageType::CRITICAL, MessageCodeType::UNAVAIABLE_SERIAL_PORT, "", 0, 0, ""};
             }
 
-            std::string rawMessage = serialPort_->receiveLine();
+            std::string rawMessage = serialPort_->receiveLine(remaining);
             if (!rawMessage.empty()) {
-                Logger::logInfo("[SerialProtocolHandler] Retry message received: " + rawMessage);
+                DRIVER_LOG_INFO(LogModule::Serial, "[SerialProtocolHandler] Retry message received: " + rawMessage);
 
                 SerialMessage retryMessage = parseMessage(rawMessage);
 
@@ -207,17 +323,16 @@ namespace core {
                 sendAck(retryMessage.calculatedChecksum > 0 ? retryMessage.calculatedChecksum : 0);
 
                 if (isValidMessage(retryMessage)) {
-                    Logger::logInfo("[SerialProtocolHandler] Retry message valid - unblocking");
+                    DRIVER_LOG_INFO(LogModule::Serial, "[SerialProtocolHandler] Retry message valid - unblocking");
                     return retryMessage;
                 } else {
-                    Logger::logWarning("[SerialProtocolHandler] Retry message still invalid - continuing wait");
+                    DRIVER_LOG_WARNING(LogModule::Serial,
+                                       "[SerialProtocolHandler] Retry message still invalid - continuing wait");
                 }
             }
-
-            std::this_thread::sleep_for(std::chrono::milliseconds(50));
         }
 
-        Logger::logError("[SerialProtocolHandler] Timeout waiting for valid retry message");
+        DRIVER_LOG_ERROR(LogModule::Serial, "[SerialProtocolHandler] Timeout waiting for valid retry message");
         return {MessageType::CRITICAL, MessageCodeType::CRITICAL_MESSAGE_PROCESSING_ERROR, "", 0, 0,
                 "UNAVAIABLE_SERIAL_PORT"};
     }
@@ -1,5 +1,6 @@
 #include "core/serial/impl/RealSerialPort.hpp"
 #include "logger/Logger.hpp"
+#include "logger/TraceLog.hpp"
 #include <boost/system/error_code.hpp>
 #include <iostream>
 #include <thread>
@@ -7,12 +8,12 @@
 
 namespace core {
     RealSerialPort::RealSerialPort(const std::string &portName, uint32_t baudrate)
-            : io_context_(), serial_port_(nullptr) {
+            : portName_(portName), baudrate_(baudrate), io_context_(), serial_port_(nullptr) {
         try {
             serial_port_ = std::make_unique<boost::asio::serial_port>(io_context_, portName);
 
             if (!serial_port_->is_open()) {
-                Logger::logError("[SerialPort] Failed to open " + portName);
+                DRIVER_LOG_ERROR(LogModule::Serial, "[SerialPort] Failed to open " + portName);
                 serial_port_.reset();
                 return;
             }
@@ -22,11 +23,12 @@ namespace core {
 
             // Force device reset via DTR (generic serial device)
             triggerDeviceReset();
+            keepDtrOnClose();
 
-            Logger::logInfo("[SerialPort] Opened successfully on " + portName);
+            DRIVER_LOG_INFO(LogModule::Serial, "[SerialPort] Opened successfully on " + portName);
 
         } catch (const boost::system::system_error &e) {
-            Logger::logError("[SerialPort] Failed to open " + portName + ": " + e.what());
+            DRIVER_LOG_ERROR(LogModule::Serial, "[SerialPort] Failed to open " + portName + ": " + e.what());
             serial_port_.reset();
         }
     }
@@ -36,7 +38,7 @@ namespace core {
             boost::system::error_code ec;
             serial_port_->close(ec);
             if (ec) {
-                Logger::logError("[SerialPort] Error closing port: " + ec.message());
+                DRIVER_LOG_ERROR(LogModule::Serial, "[SerialPort] Error closing port: " + ec.message());
             }
         }
     }
@@ -49,28 +51,29 @@ namespace core {
         // Set baud rate
         serial_port_->set_option(boost::asio::serial_port_base::baud_rate(baudrate), ec);
         if (ec) {
-            Logger::logWarning("[SerialPort] Failed to set baud rate: " + ec.message());
+            DRIVER_LOG_WARNING(LogModule::Serial, "[SerialPort] Failed to set baud rate: " + ec.message());
         }
 
         // Set character size (8 bits) - with better error handling
         try {
             serial_port_->set_option(boost::asio::serial_port_base::character_size(8));
         } catch (const boost::system::system_error &e) {
-            Logger::logWarning("[SerialPort] Character size setting failed (non-critical): " + std::string(e.what()));
+            DRIVER_LOG_WARNING(LogModule::Serial,
+                               "[SerialPort] Character size setting failed (non-critical): " + std::string(e.what()));
         }
 
         // Set parity (none)
         serial_port_->set_option(boost::asio::serial_port_base::parity(
                 boost::asio::serial_port_base::parity::none), ec);
         if (ec) {
-            Logger::logWarning("[SerialPort] Failed to set parity: " + ec.message());
+            DRIVER_LOG_WARNING(LogModule::Serial, "[SerialPort] Failed to set parity: " + ec.message());
         }
 
         // Set stop bits (1)
         serial_port_->set_option(boost::asio::serial_port_base::stop_bits(
                 boost::asio::serial_port_base::stop_bits::one), ec);
         if (ec) {
-            Logger::logWarning("[SerialPort] Failed to set stop bits: " + ec.message());
+            DRIVER_LOG_WARNING(LogModule::Serial, "[SerialPort] Failed to set stop bits: " + ec.message());
         }
 
         // Set flow control (hardware - important for DTR)
@@ -81,15 +84,69 @@ namespace core {
             serial_port_->set_option(boost::asio::serial_port_base::flow_control(
                     boost::asio::serial_port_base::flow_control::none), ec);
             if (ec) {
-                Logger::logWarning("[SerialPort] Failed to set flow control: " + ec.message());
+                DRIVER_LOG_WARNING(LogModule::Serial, "[SerialPort] Failed to set flow control: " + ec.message());
             }
         }
     }
 
+    void RealSerialPort::keepDtrOnClose() {
+#ifndef _WIN32
+        if (!serial_port_ || !serial_port_->is_open()) return;
+
+        termios tio{};
+        int fd = serial_port_->native_handle();
+        if (tcgetattr(fd, &tio) == 0) {
+            tio.c_cflag &= ~HUPCL;
+            if (tcsetattr(fd, TCSANOW, &tio) != 0) {
+                DRIVER_LOG_WARNING(LogModule::Serial,
+                                   "[SerialPort] Failed to clear HUPCL - a reconnect may reset the device");
+            }
+        }
+#endif
+    }
+
+    bool RealSerialPort::reconnect(std::chrono::milliseconds timeout) {
+        auto start = std::chrono::steady_clock::now();
+        auto deadline = start + timeout;
+
+        if (serial_port_) {
+            boost::system::error_code ec;
+            serial_port_->close(ec);
+            serial_port_.reset();
+        }
+        buffer_.clear(); // Una linea parziale precedente alla perdita non è recuperabile
+
+        // Dopo una ri-enumerazione USB il device node può ricomparire con qualche ms di ritardo
+        while (std::chrono::steady_clock::now() < deadline) {
+            try {
+                auto port = std::make_unique<boost::asio::serial_port>(io_context_, portName_);
+                if (port->is_open()) {
+                    serial_port_ = std::move(port);
+                    keepDtrOnClose();
+                    configurePort(baudrate_);
+
+                    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                            std::chrono::steady_clock::now() - start);
+                    DRIVER_LOG_INFO(LogModule::Serial,
+                                    "[SerialPort] Reconnected to " + portName_ + " without reset in " +
+                                    std::to_string(elapsed.count()) + "ms");
+                    return true;
+                }
+            } catch (const boost::system::system_error &) {
+                // Device non ancora disponibile
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+
+        DRIVER_LOG_ERROR(LogModule::Serial, "[SerialPort] Reconnect to " + portName_ + " failed after " +
+                                            std::to_string(timeout.count()) + "ms");
+        return false;
+    }
+
     void RealSerialPort::triggerDeviceReset() {
         if (!serial_port_ || !serial_port_->is_open()) return;
 
-        Logger::logInfo("[SerialPort] Triggering device reset via DTR...");
+        DRIVER_LOG_INFO(LogModule::Serial, "[SerialPort] Triggering device reset via DTR...");
 
 #ifdef _WIN32
         // Windows-specific DTR control
@@ -134,12 +191,8 @@ namespace core {
         tcflush(fd, TCIOFLUSH);
 #endif
 
-        // Wait for device to boot (typically 2 seconds for bootloader)
-        Logger::logInfo("[SerialPort] Waiting for device bootloader...");
-        std::this_thread::sleep_for(std::chrono::milliseconds(2000));
-
-        // Clear any bootloader messages
-        clearBuffer();
+        // Nessuna attesa fissa del bootloader: RealPrinter::initialize attende il banner "Sistema pronto."
+        buffer_.clear();
     }
 
     uint32_t RealSerialPort::getAvailableBytes() {
@@ -180,7 +233,7 @@ namespace core {
 
     void RealSerialPort::send(const std::string &data) {
         if (!serial_port_ || !serial_port_->is_open()) {
-            Logger::logError("[SerialPort] ERROR: Serial port not open when trying to send!");
+            DRIVER_LOG_ERROR(LogModule::Serial, "[SerialPort] ERROR: Serial port not open when trying to send!");
             return;
         }
 
@@ -191,19 +244,46 @@ namespace core {
                                                   boost::asio::buffer(message), ec);
 
         if (ec) {
-            Logger::logError("[SerialPort] Write error: " + ec.message());
+            DRIVER_LOG_ERROR(LogModule::Serial, "[SerialPort] Write error: " + ec.message());
             return;
         }
 
         if (bytes_written != message.length()) {
-            Logger::logWarning("[SerialPort] Not all bytes written: " +
+            DRIVER_LOG_WARNING(LogModule::Serial,
+                               "[SerialPort] Not all bytes written: " +
                                std::to_string(bytes_written) + "/" + std::to_string(message.length()));
         }
 
-        Logger::logInfo("[TX] " + data);
+        if (capture_) capture_->record(CaptureDirection::TX, data);
+        DRIVER_TRACE(TraceEvent::SerialTx, data);
+        DRIVER_LOG_DEBUG(LogModule::Serial, "[TX] ", data);
     }
 
-    std::string RealSerialPort::receiveLine() {
+    void RealSerialPort::sendBytes(const std::string &bytes) {
+        if (!serial_port_ || !serial_port_->is_open()) {
+            DRIVER_LOG_ERROR(LogModule::Serial, "[SerialPort] ERROR: Serial port not open when trying to send!");
+            return;
+        }
+
+        boost::system::error_code ec;
+        size_t bytes_written = boost::asio::write(*serial_port_, boost::asio::buffer(bytes), ec);
+
+        if (ec) {
+            DRIVER_LOG_ERROR(LogModule::Serial, "[SerialPort] Write error: " + ec.message());
+            return;
+        }
+
+        if (bytes_written != bytes.length()) {
+            DRIVER_LOG_WARNING(LogModule::Serial, "[SerialPort] Not all bytes written: " +
+                                                  std::to_string(bytes_written) + "/" + std::to_string(bytes.length()));
+        }
+
+        if (capture_) capture_->record(CaptureDirection::TX_FRAME, bytes);
+        DRIVER_TRACE(TraceEvent::SerialTxFrame, bytes.length());
+        DRIVER_LOG_DEBUG(LogModule::Serial, "[TX] <binary frame ", bytes.length(), " bytes>");
+    }
+
+    std::string RealSerialPort::receiveLine(std::chrono::milliseconds timeout) {
         if (!serial_port_ || !serial_port_->is_open()) {
             return "";
         }
@@ -212,36 +292,41 @@ namespace core {
         std::string line;
 
         try {
-            static int timeoutCount = 0;
-            boost::asio::steady_timer timer(io_context_);
-            timer.expires_after(std::chrono::milliseconds(500));
-
-            bool timeout = false;
-            timer.async_wait([&](const boost::system::error_code &) {
-                timeout = true;
-                timeoutCount++;
-                serial_port_->cancel();
-            });
-
-            boost::asio::read_until(*serial_port_, boost::asio::dynamic_buffer(buffer_), '\n', ec);
-            timer.cancel();
-
-            if (timeout) {
-                if (timeoutCount % 100 == 0) {
-                    Logger::logWarning("[SerialPort] " + std::to_string(timeoutCount) + " timeouts occurred");
+            // Lettura asincrona limitata da run_for: una read_until sincrona non è interrompibile dal timer
+            bool completed = false;
+            boost::asio::async_read_until(*serial_port_, boost::asio::dynamic_buffer(buffer_), '\n',
+                                          [&](const boost::system::error_code &error, std::size_t) {
+                                              ec = error;
+                                              completed = true;
+                                          });
+
+            io_context_.restart();
+            io_context_.run_for(timeout);
+
+            if (!completed) {
+                // Timeout: si annulla la lettura e si attende il suo handler (operation_aborted).
+                // I byte di una linea parziale restano in buffer_ per la chiamata successiva.
+                boost::system::error_code cancelError;
+                serial_port_->cancel(cancelError);
+                io_context_.restart();
+                io_context_.run();
+                if (ec == boost::asio::error::operation_aborted) {
+                    return "";
                 }
-                return "";
             }
 
-            timeoutCount = 0;
-
             if (ec) {
                 if (ec != boost::asio::error::operation_aborted) {
-                    Logger::logError("[SerialPort] Read error: " + ec.message());
+                    DRIVER_LOG_ERROR(LogModule::Serial, "[SerialPort] Read error: " + ec.message());
 
+                    // Cavo scollegato / ri-enumerazione USB: EOF o EIO sul tty
                     if (ec == boost::asio::error::broken_pipe ||
-                        ec == boost::asio::error::connection_reset) {
-                        Logger::logError("[SerialPort] Connection lost - attempting recovery");
+                        ec == boost::asio::error::connection_reset ||
+                        ec == boost::asio::error::eof ||
+                        ec == boost::asio::error::bad_descriptor ||
+                        ec == boost::system::errc::io_error ||
+                        ec == boost::system::errc::no_such_device) {
+                        DRIVER_LOG_ERROR(LogModule::Serial, "[SerialPort] Connection lost - attempting recovery");
                         return "CONN_LOST";
                     }
                 }
@@ -259,18 +344,33 @@ namespace core {
                 }
 
                 if (!line.empty()) {
-                    Logger::logInfo("[RX] Received: " + line);
+                    if (capture_) capture_->record(CaptureDirection::RX, line);
+                    DRIVER_TRACE(TraceEvent::SerialRx, line);
+                    DRIVER_LOG_DEBUG(LogModule::Serial, "[RX] Received: ", line);
                 }
             }
 
         } catch (const std::exception &e) {
-            Logger::logError("[SerialPort] Exception: " + std::string(e.what()));
+            DRIVER_LOG_ERROR(LogModule::Serial, "[SerialPort] Exception: " + std::string(e.what()));
             return "SERIAL_ERROR";
         }
 
         return line;
     }
 
+    bool RealSerialPort::hasPendingInput() {
+        return buffer_.find('\n') != std::string::npos || getAvailableBytes() > 0;
+    }
+
+    bool RealSerialPort::startCapture(const std::string &path) {
+        auto capture = std::make_unique<SerialCaptureWriter>(path);
+        if (!capture->isOpen()) {
+            return false;
+        }
+        capture_ = std::move(capture);
+        return true;
+    }
+
     bool RealSerialPort::isOpen() const {
         return serial_port_ && serial_port_->is_open();
     }
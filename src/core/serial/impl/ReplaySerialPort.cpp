@@ -0,0 +1,167 @@
+#include "core/serial/impl/ReplaySerialPort.hpp"
+#include "logger/Logger.hpp"
+#include "logger/TraceLog.hpp"
+
+namespace core {
+
+    namespace {
+        bool isTransmit(CaptureDirection direction) {
+            return direction == CaptureDirection::TX || direction == CaptureDirection::TX_FRAME;
+        }
+    }
+
+    ReplaySerialPort::ReplaySerialPort(const std::string &capturePath, double speed)
+            : speed_(speed > 0.0 ? speed : 0.0),
+              anchorWall_(std::chrono::steady_clock::now()) {
+        SerialCaptureReader reader(capturePath);
+        if (!reader.isOpen()) {
+            DRIVER_LOG_ERROR(LogModule::Serial, "[ReplaySerialPort] Cannot load capture " + capturePath);
+            return;
+        }
+
+        while (auto record = reader.next()) {
+            records_.push_back(std::move(*record));
+        }
+        loaded_ = true;
+
+        DRIVER_LOG_INFO(LogModule::Serial, "[ReplaySerialPort] Loaded " + std::to_string(records_.size()) +
+                                           " records from " + capturePath + " (speed " +
+                                           (speed_ > 0.0 ? std::to_string(speed_) + "x" : std::string("max")) + ")");
+    }
+
+    ReplaySerialPort::~ReplaySerialPort() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!loaded_) return;
+
+        DRIVER_LOG_INFO(LogModule::Serial,
+                        "[ReplaySerialPort] Replay ended at record " + std::to_string(cursor_) + "/" +
+                        std::to_string(records_.size()) + ", " + std::to_string(mismatches_) +
+                        " TX mismatches, " + std::to_string(unexpectedSends_) + " unexpected sends");
+    }
+
+    std::chrono::steady_clock::time_point ReplaySerialPort::dueTime(const CaptureRecord &record) const {
+        if (speed_ == 0.0) {
+            return anchorWall_;
+        }
+
+        auto offset = record.timestamp - anchorRecorded_;
+        if (offset.count() <= 0) {
+            return anchorWall_;
+        }
+        auto scaled = std::chrono::nanoseconds(static_cast<int64_t>(static_cast<double>(offset.count()) / speed_));
+        return anchorWall_ + std::chrono::duration_cast<std::chrono::steady_clock::duration>(scaled);
+    }
+
+    void ReplaySerialPort::handleSend(CaptureDirection direction, const std::string &data) {
+        auto now = std::chrono::steady_clock::now();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            // Le RX registrate prima di questo TX non ancora lette vengono consegnate subito
+            size_t next = cursor_;
+            while (next < records_.size() && !isTransmit(records_[next].direction)) {
+                next++;
+            }
+
+            if (next >= records_.size()) {
+                unexpectedSends_++;
+                DRIVER_LOG_WARNING(LogModule::Serial, "[ReplaySerialPort] Send beyond end of capture ignored");
+                return;
+            }
+
+            for (size_t i = cursor_; i < next; ++i) {
+                ready_.push_back(records_[i].data);
+            }
+
+            const auto &expected = records_[next];
+            if (expected.direction != direction || expected.data != data) {
+                mismatches_++;
+                DRIVER_LOG_WARNING(LogModule::Serial,
+                                   "[ReplaySerialPort] TX mismatch at record " + std::to_string(next) +
+                                   (direction == CaptureDirection::TX ? ": sent '" + data + "'" : ": binary frame") +
+                                   (expected.direction == CaptureDirection::TX ? ", expected '" + expected.data + "'"
+                                                                              : ", expected binary frame"));
+            }
+
+            cursor_ = next + 1;
+            anchorWall_ = now;
+            anchorRecorded_ = expected.timestamp;
+        }
+        cv_.notify_all();
+    }
+
+    void ReplaySerialPort::send(const std::string &data) {
+        handleSend(CaptureDirection::TX, data);
+        DRIVER_TRACE(TraceEvent::SerialTx, data);
+        DRIVER_LOG_DEBUG(LogModule::Serial, "[TX] ", data);
+    }
+
+    void ReplaySerialPort::sendBytes(const std::string &bytes) {
+        handleSend(CaptureDirection::TX_FRAME, bytes);
+        DRIVER_TRACE(TraceEvent::SerialTxFrame, bytes.length());
+        DRIVER_LOG_DEBUG(LogModule::Serial, "[TX] <binary frame ", bytes.length(), " bytes>");
+    }
+
+    std::string ReplaySerialPort::receiveLine(std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+
+        while (true) {
+            if (!ready_.empty()) {
+                std::string line = std::move(ready_.front());
+                ready_.pop_front();
+                DRIVER_TRACE(TraceEvent::SerialRx, line);
+                DRIVER_LOG_DEBUG(LogModule::Serial, "[RX] Received: ", line);
+                return line;
+            }
+
+            auto now = std::chrono::steady_clock::now();
+            if (now >= deadline) {
+                return "";
+            }
+
+            // In attesa di un TX dell'host (o cattura terminata): solo send() può sbloccare
+            if (cursor_ >= records_.size() || isTransmit(records_[cursor_].direction)) {
+                cv_.wait_until(lock, deadline);
+                continue;
+            }
+
+            auto due = dueTime(records_[cursor_]);
+            if (due <= now) {
+                ready_.push_back(records_[cursor_].data);
+                cursor_++;
+                continue;
+            }
+
+            cv_.wait_until(lock, std::min(due, deadline));
+        }
+    }
+
+    bool ReplaySerialPort::hasPendingInput() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!ready_.empty()) return true;
+        return cursor_ < records_.size() && !isTransmit(records_[cursor_].direction) &&
+               dueTime(records_[cursor_]) <= std::chrono::steady_clock::now();
+    }
+
+    bool ReplaySerialPort::isOpen() const {
+        return loaded_;
+    }
+
+    bool ReplaySerialPort::reconnect(std::chrono::milliseconds) {
+        // La cattura non perde mai il collegamento: le eventuali CONN_LOST registrate sono semplici linee RX
+        return loaded_;
+    }
+
+    bool ReplaySerialPort::finished() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return cursor_ >= records_.size() && ready_.empty();
+    }
+
+    uint64_t ReplaySerialPort::mismatchCount() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return mismatches_;
+    }
+
+} // namespace core
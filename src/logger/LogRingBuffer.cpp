@@ -0,0 +1,60 @@
+#include "logger/LogRingBuffer.hpp"
+
+namespace {
+    size_t roundUpToPowerOfTwo(size_t value) {
+        size_t result = 2;
+        while (result < value) result <<= 1;
+        return result;
+    }
+}
+
+LogRingBuffer::LogRingBuffer(size_t capacity)
+        : slots_(new Slot[roundUpToPowerOfTwo(capacity)]),
+          mask_(roundUpToPowerOfTwo(capacity) - 1) {
+    for (size_t i = 0; i <= mask_; ++i) {
+        slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool LogRingBuffer::tryPush(LogRecord &&record) {
+    size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+    Slot *slot;
+
+    for (;;) {
+        slot = &slots_[pos & mask_];
+        size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+
+        if (diff == 0) {
+            // Slot libero per questa posizione: lo si prenota avanzando l'indice
+            if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            return false; // Piena: il consumatore non ha ancora liberato lo slot
+        } else {
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->record = std::move(record);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool LogRingBuffer::tryPop(LogRecord &record) {
+    Slot &slot = slots_[dequeuePos_ & mask_];
+    size_t sequence = slot.sequence.load(std::memory_order_acquire);
+    if (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(dequeuePos_ + 1) < 0) {
+        return false; // Vuota o produttore non ancora completato
+    }
+
+    record = std::move(slot.record);
+    slot.sequence.store(dequeuePos_ + mask_ + 1, std::memory_order_release);
+    ++dequeuePos_;
+    return true;
+}
+
+bool LogRingBuffer::empty() const {
+    const Slot &slot = slots_[dequeuePos_ & mask_];
+    return static_cast<intptr_t>(slot.sequence.load(std::memory_order_acquire)) -
+           static_cast<intptr_t>(dequeuePos_ + 1) < 0;
+}
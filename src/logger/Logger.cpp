@@ -12,7 +12,10 @@
 #include <filesystem>
 #include <thread>
 #include <atomic>
+#include <cctype>
+#include <ctime>
 #include <vector>
+#include <zlib.h>
 
 namespace fs = std::filesystem;
 
@@ -23,68 +26,301 @@ std::atomic<size_t> Logger::currentLogSize_{0};
 std::atomic<bool> Logger::rotationEnabled_{true};
 std::thread Logger::cleanupThread_;
 std::atomic<bool> Logger::shutdownRequested_{false};
+std::mutex Logger::cleanupMutex_;
+std::condition_variable Logger::cleanupCv_;
+std::vector<std::string> Logger::pendingCompression_;
+std::thread Logger::writerThread_;
+std::atomic<bool> Logger::writerRunning_{false};
+std::atomic<bool> Logger::writerIdle_{false};
+std::mutex Logger::writerMutex_;
+std::condition_variable Logger::writerCv_;
+std::atomic<bool> Logger::consoleEnabled_{true};
+std::atomic<uint64_t> Logger::enqueued_{0};
+std::atomic<uint64_t> Logger::dropped_{0};
+std::atomic<uint64_t> Logger::written_{0};
+std::atomic<uint64_t> Logger::batches_{0};
+std::atomic<LogLevel> Logger::moduleLevels_[static_cast<size_t>(LogModule::Count)] = {
+    static_cast<LogLevel>(DRIVER_LOG_MIN_LEVEL), static_cast<LogLevel>(DRIVER_LOG_MIN_LEVEL),
+    static_cast<LogLevel>(DRIVER_LOG_MIN_LEVEL), static_cast<LogLevel>(DRIVER_LOG_MIN_LEVEL),
+    static_cast<LogLevel>(DRIVER_LOG_MIN_LEVEL)
+};
 
 constexpr size_t MAX_LOG_SIZE = 50 * 1024 * 1024; // 50MB
-constexpr size_t MAX_LOG_FILES = 10;
+constexpr uintmax_t MAX_ARCHIVE_SIZE = 512ull * 1024 * 1024; // Log ruotati .log.gz
+constexpr size_t MAX_LOG_FILES = 10; // .log non compressi (crash, altri processi, rotazioni in sospeso)
+constexpr size_t COMPRESSION_CHUNK = 256 * 1024;
 constexpr std::chrono::hours LOG_RETENTION{24 * 7}; // 7 days
+constexpr const char *LOG_FILE_PREFIX = "3dp_driver_";
+constexpr size_t RING_CAPACITY = 1 << 16;           // Record in coda (memoria limitata)
+constexpr size_t WRITE_BATCH = 1024;                // Record per write
+constexpr std::chrono::milliseconds WRITER_IDLE_WAIT{20};
+
+namespace {
+    const char *levelName(LogLevel level) {
+        switch (level) {
+            case LogLevel::Debug:
+                return "DEBUG";
+            case LogLevel::Warning:
+                return "WARNING";
+            case LogLevel::Error:
+                return "ERROR";
+            default:
+                return "INFO";
+        }
+    }
+
+    bool localTime(std::time_t time, std::tm &out) {
+#ifdef _WIN32
+        return localtime_s(&out, &time) == 0;
+#else
+        return localtime_r(&time, &out) != nullptr;
+#endif
+    }
+}
+
+LogRingBuffer &Logger::ring() {
+    static LogRingBuffer instance(RING_CAPACITY);
+    return instance;
+}
 
 void Logger::init() {
-    rotateLogFile();
+    {
+        std::lock_guard<std::mutex> lock(logMutex_);
+        rotateLogFile();
+    }
     startCleanupThread();
+
+    if (!writerRunning_.exchange(true)) {
+        writerThread_ = std::thread(&Logger::writerLoop);
+    }
     std::cout << "[Logger] Initialized with auto-rotation (max " << MAX_LOG_SIZE / 1024 / 1024 << "MB)" << std::endl;
 }
 
 void Logger::shutdown() {
-    shutdownRequested_ = true;
+    // Il writer svuota la coda prima di uscire
+    if (writerRunning_.exchange(false)) {
+        writerCv_.notify_all();
+        if (writerThread_.joinable()) {
+            writerThread_.join();
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(cleanupMutex_);
+        shutdownRequested_ = true;
+    }
+    cleanupCv_.notify_all();
     if (cleanupThread_.joinable()) {
         cleanupThread_.join();
     }
+
     std::lock_guard<std::mutex> lock(logMutex_);
     if (logFile_.is_open()) {
         logFile_.close();
     }
 }
 
-void Logger::logInfo(const std::string &message) {
-    log("INFO", message);
+void Logger::logInfo(std::string message) {
+    if (isEnabled(LogModule::General, LogLevel::Info)) log(LogLevel::Info, std::move(message));
+}
+
+void Logger::logWarning(std::string message) {
+    if (isEnabled(LogModule::General, LogLevel::Warning)) log(LogLevel::Warning, std::move(message));
 }
 
-void Logger::logWarning(const std::string &message) {
-    log("WARNING", message);
+void Logger::logError(std::string message) {
+    log(LogLevel::Error, std::move(message));
 }
 
-void Logger::logError(const std::string &message) {
-    log("ERROR", message);
+void Logger::setLevel(LogModule module, LogLevel level) {
+    moduleLevels_[static_cast<size_t>(module)].store(level, std::memory_order_relaxed);
 }
 
-void Logger::log(const std::string &level, const std::string &message) {
+void Logger::setLevel(LogLevel level) {
+    for (auto &moduleLevel: moduleLevels_) {
+        moduleLevel.store(level, std::memory_order_relaxed);
+    }
+}
+
+LogLevel Logger::level(LogModule module) {
+    return moduleLevels_[static_cast<size_t>(module)].load(std::memory_order_relaxed);
+}
+
+bool Logger::parseLevel(const std::string &name, LogLevel &level) {
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return std::tolower(c); });
+
+    if (lower == "debug") level = LogLevel::Debug;
+    else if (lower == "info") level = LogLevel::Info;
+    else if (lower == "warning" || lower == "warn") level = LogLevel::Warning;
+    else if (lower == "error") level = LogLevel::Error;
+    else return false;
+    return true;
+}
+
+void Logger::flush() {
+    uint64_t target = enqueued_.load();
+    while (writerRunning_ && written_.load() < target) {
+        writerCv_.notify_one();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+Logger::Stats Logger::stats() {
+    Stats stats;
+    stats.enqueued = enqueued_.load();
+    stats.dropped = dropped_.load();
+    stats.written = written_.load();
+    stats.batches = batches_.load();
+    return stats;
+}
+
+void Logger::setConsoleEnabled(bool enabled) {
+    consoleEnabled_ = enabled;
+}
+
+void Logger::log(LogLevel level, std::string &&message) {
     if (message.empty() || message.find_first_not_of(" \t\r\n") == std::string::npos) {
         return;
     }
 
-    std::string timestamp = currentTimestamp();
-    std::string formatted = "[" + level + "] [" + timestamp + "] " + message;
+    LogRecord record{level, std::chrono::system_clock::now(), std::move(message)};
+
+    if (!writerRunning_.load(std::memory_order_relaxed)) {
+        writeSynchronously(record);
+        return;
+    }
+
+    if (!ring().tryPush(std::move(record))) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    enqueued_.fetch_add(1, std::memory_order_relaxed);
 
-    if (level == "ERROR") {
-        std::cerr << formatted << std::endl;
-    } else {
-        std::cout << formatted << std::endl;
+    // Notifica solo se il writer dorme: nel caso comune nessuna syscall sul percorso del chiamante
+    if (writerIdle_.load(std::memory_order_relaxed)) {
+        writerCv_.notify_one();
+    }
+}
+
+void Logger::writerLoop() {
+    std::string out;
+    std::string err;
+    std::string file;
+    out.reserve(64 * 1024);
+    file.reserve(64 * 1024);
+    uint64_t reportedDrops = 0;
+    LogRecord record;
+
+    for (;;) {
+        size_t count = 0;
+        while (count < WRITE_BATCH && ring().tryPop(record)) {
+            size_t start = file.size();
+            appendFormatted(record, file);
+            if (consoleEnabled_.load(std::memory_order_relaxed)) {
+                (record.level == LogLevel::Error ? err : out).append(file, start, std::string::npos);
+            }
+            ++count;
+        }
+
+        uint64_t drops = dropped_.load(std::memory_order_relaxed);
+        if (drops != reportedDrops) {
+            LogRecord notice{LogLevel::Warning, std::chrono::system_clock::now(),
+                             "[Logger] " + std::to_string(drops - reportedDrops) + " log records dropped (queue full)"};
+            size_t start = file.size();
+            appendFormatted(notice, file);
+            if (consoleEnabled_.load(std::memory_order_relaxed)) out.append(file, start, std::string::npos);
+            reportedDrops = drops;
+        }
+
+        if (!file.empty()) {
+            if (!out.empty()) {
+                std::cout.write(out.data(), static_cast<std::streamsize>(out.size()));
+                std::cout.flush();
+                out.clear();
+            }
+            if (!err.empty()) {
+                std::cerr.write(err.data(), static_cast<std::streamsize>(err.size()));
+                err.clear();
+            }
+            {
+                std::lock_guard<std::mutex> lock(logMutex_);
+                writeToFile(file);
+            }
+            file.clear();
+            written_.fetch_add(count, std::memory_order_relaxed);
+            batches_.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        if (!writerRunning_) break; // Coda svuotata dopo shutdown()
+
+        std::unique_lock<std::mutex> lock(writerMutex_);
+        writerIdle_ = true;
+        writerCv_.wait_for(lock, WRITER_IDLE_WAIT, [] { return !ring().empty() || !writerRunning_; });
+        writerIdle_ = false;
+    }
+}
+
+void Logger::writeSynchronously(const LogRecord &record) {
+    std::string formatted;
+    appendFormatted(record, formatted);
+
+    if (consoleEnabled_) {
+        auto &stream = record.level == LogLevel::Error ? std::cerr : std::cout;
+        stream.write(formatted.data(), static_cast<std::streamsize>(formatted.size()));
+        stream.flush();
     }
 
     std::lock_guard<std::mutex> lock(logMutex_);
+    writeToFile(formatted);
+}
+
+void Logger::appendFormatted(const LogRecord &record, std::string &out) {
+    // Timestamp riformattato solo al cambio di secondo
+    thread_local std::time_t cachedSecond = -1;
+    thread_local char cachedStamp[32] = {0};
+
+    std::time_t second = std::chrono::system_clock::to_time_t(record.time);
+    if (second != cachedSecond) {
+        std::tm tm{};
+        if (localTime(second, tm)) {
+            std::strftime(cachedStamp, sizeof(cachedStamp), "%Y-%m-%d %H:%M:%S", &tm);
+        }
+        cachedSecond = second;
+    }
+
+    out += '[';
+    out += levelName(record.level);
+    out += "] [";
+    out += cachedStamp;
+    out += "] ";
+    out += record.message;
+    out += '\n';
+}
+
+void Logger::writeToFile(const std::string &data) {
     if (rotationEnabled_ && currentLogSize_ > MAX_LOG_SIZE) {
         rotateLogFile();
     }
 
     if (logFile_.is_open()) {
-        logFile_ << formatted << std::endl;
-        currentLogSize_ += formatted.length() + 1;
+        logFile_.write(data.data(), static_cast<std::streamsize>(data.size()));
+        logFile_.flush();
+        currentLogSize_ += data.size();
     }
 }
 
 void Logger::rotateLogFile() {
     if (logFile_.is_open()) {
         logFile_.close();
+
+        // La compressione avviene sul thread di pulizia, mai sul percorso di scrittura
+        {
+            std::lock_guard<std::mutex> lock(cleanupMutex_);
+            pendingCompression_.push_back(currentLogPath_);
+        }
+        cleanupCv_.notify_one();
     }
 
     currentLogPath_ = generateLogFilename();
@@ -98,42 +334,119 @@ void Logger::rotateLogFile() {
 
 void Logger::startCleanupThread() {
     cleanupThread_ = std::thread([]() {
-        while (!shutdownRequested_) {
+        std::unique_lock<std::mutex> lock(cleanupMutex_);
+        while (true) {
+            std::vector<std::string> pending;
+            pending.swap(pendingCompression_);
+            lock.unlock();
+
+            for (const auto &path: pending) {
+                compressLogFile(path);
+            }
             cleanupOldLogs();
-            std::this_thread::sleep_for(std::chrono::hours(1));
+
+            lock.lock();
+            // Allo shutdown si esce solo con la coda vuota: nessun file ruotato resta non compresso
+            if (shutdownRequested_ && pendingCompression_.empty()) break;
+            // Attesa interrompibile: shutdown() non deve aspettare fino a un'ora
+            cleanupCv_.wait_for(lock, std::chrono::hours(1), [] {
+                return shutdownRequested_.load() || !pendingCompression_.empty();
+            });
         }
     });
 }
 
+bool Logger::compressLogFile(const std::string &path) {
+    std::string target = path + ".gz";
+    std::string temporary = target + ".tmp";
+
+    std::ifstream input(path, std::ios::binary);
+    if (!input.is_open()) return false;
+
+    gzFile output = gzopen(temporary.c_str(), "wb6");
+    if (!output) {
+        std::cerr << "[Logger] Cannot create " << temporary << std::endl;
+        return false;
+    }
+    gzbuffer(output, COMPRESSION_CHUNK);
+
+    std::vector<char> buffer(COMPRESSION_CHUNK);
+    bool ok = true;
+    while (ok && input) {
+        input.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        auto count = static_cast<unsigned>(input.gcount());
+        if (count > 0 && gzwrite(output, buffer.data(), count) != static_cast<int>(count)) {
+            ok = false;
+        }
+    }
+    ok = ok && !input.bad();
+    ok = (gzclose(output) == Z_OK) && ok;
+    input.close();
+
+    std::error_code ec;
+    if (!ok) {
+        std::cerr << "[Logger] Compression failed for " << path << std::endl;
+        fs::remove(temporary, ec);
+        return false;
+    }
+
+    // Rename atomico: un .gz esistente è sempre completo
+    fs::rename(temporary, target, ec);
+    if (ec) {
+        fs::remove(temporary, ec);
+        return false;
+    }
+    fs::remove(path, ec);
+    return true;
+}
+
 void Logger::cleanupOldLogs() {
     try {
         std::string logsFolder = "logs";
         if (!fs::exists(logsFolder)) return;
 
+        // Si comprimono solo i file ruotati da questo processo (pendingCompression_): un altro driver può
+        // scrivere nella stessa cartella e i suoi .log attivi non vanno toccati. La retention invece vale
+        // per tutti i .log e .gz del driver, così anche i log lasciati da un crash non crescono senza limite.
+        std::string currentLog;
+        {
+            std::lock_guard<std::mutex> lock(logMutex_);
+            currentLog = currentLogPath_;
+        }
         auto cutoffTime = std::chrono::system_clock::now() - LOG_RETENTION;
-        std::vector<fs::path> logFiles;
+        std::vector<std::pair<fs::file_time_type, fs::path>> logs;
+        std::vector<std::pair<fs::file_time_type, fs::path>> archives;
 
         for (const auto &entry: fs::directory_iterator(logsFolder)) {
-            if (entry.path().extension() == ".log") {
-                auto writeTime = fs::last_write_time(entry);
-                auto sctp = std::chrono::time_point_cast<std::chrono::system_clock::duration>(
-                    writeTime - fs::file_time_type::clock::now() + std::chrono::system_clock::now());
-
-                if (sctp < cutoffTime) {
-                    fs::remove(entry);
-                } else {
-                    logFiles.push_back(entry.path());
-                }
+            std::string name = entry.path().filename().string();
+            auto extension = entry.path().extension();
+            if (name.rfind(LOG_FILE_PREFIX, 0) != 0 || (extension != ".gz" && extension != ".log")) continue;
+            if (entry.path() == fs::path(currentLog)) continue;
+
+            auto writeTime = fs::last_write_time(entry);
+            auto sctp = std::chrono::time_point_cast<std::chrono::system_clock::duration>(
+                writeTime - fs::file_time_type::clock::now() + std::chrono::system_clock::now());
+
+            if (sctp < cutoffTime) {
+                fs::remove(entry);
+            } else {
+                (extension == ".gz" ? archives : logs).emplace_back(writeTime, entry.path());
             }
         }
 
-        if (logFiles.size() > MAX_LOG_FILES) {
-            std::sort(logFiles.begin(), logFiles.end(), [](const fs::path &a, const fs::path &b) {
-                return fs::last_write_time(a) < fs::last_write_time(b);
-            });
+        // .log per numero, .gz per dimensione compressa: si eliminano i più vecchi oltre il limite
+        auto newestFirst = [](const auto &a, const auto &b) { return a.first > b.first; };
+        std::sort(logs.begin(), logs.end(), newestFirst);
+        for (size_t i = MAX_LOG_FILES; i < logs.size(); ++i) {
+            fs::remove(logs[i].second);
+        }
 
-            for (size_t i = 0; i < logFiles.size() - MAX_LOG_FILES; ++i) {
-                fs::remove(logFiles[i]);
+        std::sort(archives.begin(), archives.end(), newestFirst);
+        uintmax_t totalSize = 0;
+        for (const auto &[writeTime, path]: archives) {
+            totalSize += fs::file_size(path);
+            if (totalSize > MAX_ARCHIVE_SIZE) {
+                fs::remove(path);
             }
         }
     } catch (const std::exception &e) {
@@ -141,15 +454,6 @@ void Logger::cleanupOldLogs() {
     }
 }
 
-std::string Logger::currentTimestamp() {
-    auto now = std::chrono::system_clock::now();
-    auto in_time_t = std::chrono::system_clock::to_time_t(now);
-
-    std::stringstream ss;
-    ss << std::put_time(std::localtime(&in_time_t), "%Y-%m-%d %H:%M:%S");
-    return ss.str();
-}
-
 std::string Logger::generateLogFilename() {
     auto now = std::chrono::system_clock::now();
     auto in_time_t = std::chrono::system_clock::to_time_t(now);
@@ -162,5 +466,11 @@ std::string Logger::generateLogFilename() {
         fs::create_directory(logsFolder);
     }
 
-    return logsFolder + "/3dp_driver_" + ss.str() + ".log";
+    // Più rotazioni nello stesso secondo: il file precedente potrebbe essere ancora in compressione
+    std::string base = logsFolder + "/" + LOG_FILE_PREFIX + ss.str();
+    std::string path = base + ".log";
+    for (int suffix = 1; fs::exists(path) || fs::exists(path + ".gz"); ++suffix) {
+        path = base + "_" + std::to_string(suffix) + ".log";
+    }
+    return path;
 }
@@ -0,0 +1,300 @@
+#include "logger/TraceLog.hpp"
+#include "logger/Logger.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+namespace {
+    constexpr char TRACE_MAGIC[] = {'3', 'D', 'P', 'T', 'R', 'C'};
+    constexpr uint8_t TRACE_VERSION = 1;
+    constexpr uint8_t STRING_DEFINITION = 0xFF;
+    constexpr uint64_t MAX_FIELD_SIZE = 1 << 20;
+    constexpr std::chrono::milliseconds FLUSH_INTERVAL{500};
+
+    void writeVarint(std::string &out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<char>(value));
+    }
+
+    void writeField(std::string &out, std::string_view value) {
+        writeVarint(out, value.size());
+        out.append(value.data(), value.size());
+    }
+
+    bool readVarint(std::ifstream &in, uint64_t &value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            int byte = in.get();
+            if (byte == std::char_traits<char>::eof()) return false;
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) return true;
+        }
+        return false;
+    }
+
+    bool readField(std::ifstream &in, std::string &value) {
+        uint64_t size;
+        if (!readVarint(in, size) || size > MAX_FIELD_SIZE) return false;
+        value.resize(size);
+        return static_cast<bool>(in.read(value.data(), static_cast<std::streamsize>(size)));
+    }
+}
+
+std::atomic<bool> TraceLog::enabled_{false};
+
+TraceLog &TraceLog::getInstance() {
+    static TraceLog instance;
+    return instance;
+}
+
+const std::vector<TraceEventInfo> &TraceLog::schema() {
+    static const std::vector<TraceEventInfo> events = {
+            {TraceEvent::SerialTx, "serial.tx", "line:b"},
+            {TraceEvent::SerialTxFrame, "serial.tx_frame", "bytes:u"},
+            {TraceEvent::SerialRx, "serial.rx", "line:b"},
+            {TraceEvent::AckSent, "serial.ack", "line:b"},
+            {TraceEvent::CommandSent, "command.sent", "number:u line:b"},
+            {TraceEvent::CommandCompleted, "command.completed", "number:u"},
+            {TraceEvent::CommandStored, "command.stored", "number:u history:u"},
+            {TraceEvent::CommandRemoved, "command.removed", "number:u history:u"},
+            {TraceEvent::CommandRetrieved, "command.retrieved", "number:u"},
+            {TraceEvent::QueueExecute, "queue.execute", "command:b priority:s job:i"},
+            {TraceEvent::TranslatorDispatch, "translator.dispatch", "command:i"},
+            {TraceEvent::KafkaReceived, "kafka.received", "receiver:i key:b size:u"},
+            {TraceEvent::KafkaSent, "kafka.sent", "sender:i topic:i key:b"}
+    };
+    return events;
+}
+
+bool TraceLog::open(const std::string &path) {
+    close();
+
+    std::lock_guard<std::mutex> fileLock(fileMutex_);
+    file_.open(path, std::ios::binary | std::ios::trunc);
+    if (!file_.is_open()) {
+        Logger::logError("[TraceLog] Cannot open trace file: " + path);
+        return false;
+    }
+
+    std::string header(TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    header.push_back(static_cast<char>(TRACE_VERSION));
+    writeVarint(header, schema().size());
+    for (const auto &info: schema()) {
+        header.push_back(static_cast<char>(info.event));
+        writeField(header, info.name);
+        writeField(header, info.args);
+    }
+    file_.write(header.data(), static_cast<std::streamsize>(header.size()));
+    file_.flush();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        active_.clear();
+        active_.reserve(FLUSH_THRESHOLD * 2);
+        interned_.clear();
+        start_ = std::chrono::steady_clock::now();
+        lastTimestamp_ = std::chrono::nanoseconds(0);
+        events_ = 0;
+        dropped_ = 0;
+        stopping_ = false;
+        enabled_ = true;
+    }
+    flushThread_ = std::thread(&TraceLog::flushLoop, this);
+
+    Logger::logInfo("[TraceLog] Tracing high-frequency events to " + path);
+    return true;
+}
+
+void TraceLog::close() {
+    bool wasOpen = stop();
+    if (wasOpen) {
+        Logger::logInfo("[TraceLog] Closed (" + std::to_string(eventCount()) + " events, " +
+                        std::to_string(droppedCount()) + " dropped)");
+    }
+}
+
+TraceLog::~TraceLog() {
+    // Nessun log qui: il Logger potrebbe essere già distrutto
+    stop();
+}
+
+bool TraceLog::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        enabled_ = false;
+        stopping_ = true;
+    }
+    flushCv_.notify_all();
+    if (flushThread_.joinable()) {
+        flushThread_.join();
+    }
+
+    std::lock_guard<std::mutex> fileLock(fileMutex_);
+    if (!file_.is_open()) return false;
+    file_.close();
+    return true;
+}
+
+uint64_t TraceLog::eventCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return events_;
+}
+
+uint64_t TraceLog::droppedCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return dropped_;
+}
+
+void TraceLog::flushLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_) {
+        flushCv_.wait_for(lock, FLUSH_INTERVAL, [this] { return stopping_ || active_.size() >= FLUSH_THRESHOLD; });
+        lock.unlock();
+        writePending();
+        lock.lock();
+    }
+    lock.unlock();
+    writePending();
+}
+
+void TraceLog::writePending() {
+    std::lock_guard<std::mutex> fileLock(fileMutex_);
+    {
+        // Scambio dei buffer: la write su disco avviene fuori dal lock dei produttori
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (active_.empty()) return;
+        spare_.clear();
+        active_.swap(spare_);
+    }
+    if (file_.is_open()) {
+        file_.write(spare_.data(), static_cast<std::streamsize>(spare_.size()));
+        file_.flush();
+    }
+}
+
+void TraceLog::appendVarint(uint64_t value) {
+    writeVarint(active_, value);
+}
+
+void TraceLog::appendTimestamp(std::chrono::steady_clock::time_point now) {
+    auto timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(now - start_);
+    auto delta = timestamp > lastTimestamp_ ? timestamp - lastTimestamp_ : std::chrono::nanoseconds(0);
+    lastTimestamp_ += delta;
+    appendVarint(static_cast<uint64_t>(delta.count()));
+}
+
+void TraceLog::appendBytes(std::string_view value) {
+    writeField(active_, value);
+}
+
+void TraceLog::appendArg(const TraceInterned &value) {
+    auto it = interned_.find(std::string(value.value));
+    if (it == interned_.end()) {
+        uint32_t id = static_cast<uint32_t>(interned_.size());
+        it = interned_.emplace(std::string(value.value), id).first;
+
+        std::string definition(1, static_cast<char>(STRING_DEFINITION));
+        writeVarint(definition, id);
+        writeField(definition, value.value);
+        active_.insert(recordStart_, definition);
+        recordStart_ += definition.size();
+    }
+    appendVarint(it->second);
+}
+
+TraceReader::TraceReader(const std::string &path)
+        : file_(path, std::ios::binary) {
+    char magic[sizeof(TRACE_MAGIC)];
+    if (!file_.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), TRACE_MAGIC)) {
+        Logger::logError("[TraceReader] Not a trace file: " + path);
+        return;
+    }
+
+    int version = file_.get();
+    if (version != TRACE_VERSION) {
+        Logger::logError("[TraceReader] Unsupported trace version " + std::to_string(version));
+        return;
+    }
+
+    uint64_t count;
+    if (!readVarint(file_, count)) return;
+    for (uint64_t i = 0; i < count; ++i) {
+        int event = file_.get();
+        EventSchema schema;
+        std::string args;
+        if (event == std::char_traits<char>::eof() || !readField(file_, schema.name) || !readField(file_, args)) {
+            Logger::logError("[TraceReader] Truncated schema in " + path);
+            return;
+        }
+
+        std::istringstream fields(args);
+        std::string field;
+        while (fields >> field) {
+            size_t colon = field.find(':');
+            if (colon == std::string::npos || colon + 1 >= field.size()) continue;
+            schema.args.emplace_back(field.substr(0, colon), field[colon + 1]);
+        }
+        schema_[static_cast<uint8_t>(event)] = std::move(schema);
+    }
+    valid_ = true;
+}
+
+bool TraceReader::isOpen() const {
+    return valid_;
+}
+
+std::optional<TraceRecord> TraceReader::next() {
+    while (valid_) {
+        int event = file_.get();
+        if (event == std::char_traits<char>::eof()) return std::nullopt;
+
+        if (event == STRING_DEFINITION) {
+            uint64_t id;
+            std::string value;
+            if (!readVarint(file_, id) || !readField(file_, value)) break;
+            strings_[id] = std::move(value);
+            continue;
+        }
+
+        auto schema = schema_.find(static_cast<uint8_t>(event));
+        uint64_t delta;
+        if (schema == schema_.end() || !readVarint(file_, delta)) break;
+
+        TraceRecord record;
+        record.event = static_cast<uint8_t>(event);
+        record.name = schema->second.name;
+        timestamp_ += std::chrono::nanoseconds(static_cast<int64_t>(delta));
+        record.timestamp = timestamp_;
+
+        bool complete = true;
+        for (const auto &[name, type]: schema->second.args) {
+            TraceArgument arg;
+            arg.name = name;
+            arg.type = type;
+            if (type == 'b') {
+                complete = readField(file_, arg.text);
+            } else {
+                complete = readVarint(file_, arg.number);
+                if (type == 's') {
+                    arg.signedNumber = static_cast<int64_t>(arg.number >> 1) ^ -static_cast<int64_t>(arg.number & 1);
+                } else if (type == 'i') {
+                    auto it = strings_.find(arg.number);
+                    arg.text = it != strings_.end() ? it->second : "#" + std::to_string(arg.number);
+                }
+            }
+            if (!complete) break;
+            record.args.push_back(std::move(arg));
+        }
+        if (!complete) break;
+        return record;
+    }
+
+    if (valid_) {
+        Logger::logWarning("[TraceReader] Corrupted or truncated trace record - stopping");
+        valid_ = false;
+    }
+    return std::nullopt;
+}
@@ -6,6 +6,7 @@
 #include "translator/exceptions/GCodeTranslatorInvalidCommandException.hpp"
 #include "translator/exceptions/GCodeTranslatorUnknownCommandException.hpp"
 #include "logger/Logger.hpp"
+#include "logger/TraceLog.hpp"
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -15,7 +16,8 @@ namespace translator::gcode {
 
     GCodeTranslator::GCodeTranslator(std::shared_ptr<core::DriverInterface> driver)
             : driver_(std::move(driver)) {
-        Logger::logInfo("[GCodeTranslator] Created with " + std::to_string(dispatchers_.size()) + " dispatchers");
+        DRIVER_LOG_INFO(LogModule::Translator,
+                        "[GCodeTranslator] Created with " + std::to_string(dispatchers_.size()) + " dispatchers");
     }
 
     void GCodeTranslator::parseFile(const std::string &filePath) {
@@ -23,7 +25,7 @@ namespace translator::gcode {
         if (!file.is_open()) {
             std::stringstream ss;
             ss << "[GCodeTranslator] Error opening file: " << filePath;
-            Logger::logError(ss.str());
+            DRIVER_LOG_ERROR(LogModule::Translator, ss.str());
             return;
         }
 
@@ -40,17 +42,17 @@ namespace translator::gcode {
     }
 
     void GCodeTranslator::parseLine(const std::string &line) {
-        Logger::logInfo("[GCodeTranslator] Parsing line: " + line);
+        DRIVER_LOG_DEBUG(LogModule::Translator, "[GCodeTranslator] Parsing line: ", line);
 
         auto [command, params] = parseGCodeLine(line);
 
-        Logger::logInfo("[GCodeTranslator] Extracted command: " + command);
-        if (!params.empty()) {
+        DRIVER_LOG_DEBUG(LogModule::Translator, "[GCodeTranslator] Extracted command: ", command);
+        if (!params.empty() && Logger::isEnabled(LogModule::Translator, LogLevel::Debug)) {
             std::stringstream paramStr;
             for (const auto &[key, value]: params) {
                 paramStr << " " << key << "=" << value;
             }
-            Logger::logInfo("[GCodeTranslator] Parameters:" + paramStr.str());
+            DRIVER_LOG_DEBUG(LogModule::Translator, "[GCodeTranslator] Parameters:", paramStr.str());
         }
 
         dispatchCommand(command, params);
@@ -77,7 +79,7 @@ namespace translator::gcode {
                 double value = std::stod(token.substr(1));
                 params[std::string(1, key)] = value;
             } catch (const std::exception &e) {
-                Logger::logWarning("[GCodeTranslator] Failed to parse parameter: " + token);
+                DRIVER_LOG_WARNING(LogModule::Translator, "[GCodeTranslator] Failed to parse parameter: " + token);
             }
         }
 
@@ -85,23 +87,24 @@ namespace translator::gcode {
     }
 
     void GCodeTranslator::dispatchCommand(const std::string &command, const std::map<std::string, double> &params) {
-        Logger::logInfo("[GCodeTranslator] Dispatching command: " + command +
-                        " to " + std::to_string(dispatchers_.size()) + " dispatchers");
+        DRIVER_TRACE(TraceEvent::TranslatorDispatch, TraceInterned{command});
+        DRIVER_LOG_DEBUG(LogModule::Translator, "[GCodeTranslator] Dispatching command: ", command,
+                         " to ", dispatchers_.size(), " dispatchers");
 
         bool handled = false;
         for (auto &dispatcher: dispatchers_) {
             if (dispatcher->canHandle(command)) {
-                Logger::logInfo("[GCodeTranslator] Dispatcher found for command: " + command);
+                DRIVER_LOG_DEBUG(LogModule::Translator, "[GCodeTranslator] Dispatcher found for command: ", command);
 
                 if (dispatcher->validate(command, params)) {
-                    Logger::logInfo("[GCodeTranslator] Command validated, handling: " + command);
+                    DRIVER_LOG_DEBUG(LogModule::Translator, "[GCodeTranslator] Command validated, handling: ", command);
                     dispatcher->handle(command, params);
                     handled = true;
-                    Logger::logInfo("[GCodeTranslator] Command handled successfully: " + command);
+                    DRIVER_LOG_DEBUG(LogModule::Translator, "[GCodeTranslator] Command handled successfully: ", command);
                 } else {
                     std::stringstream ss;
                     ss << "[GCodeTranslator] Command validation failed: " << command;
-                    Logger::logWarning(ss.str());
+                    DRIVER_LOG_WARNING(LogModule::Translator, ss.str());
                     throw GCodeTranslatorInvalidCommandException(command);
                 }
                 return;
@@ -111,14 +114,15 @@ namespace translator::gcode {
         if (!handled) {
             std::stringstream ss;
             ss << "[GCodeTranslator] No dispatcher found for command: " << command;
-            Logger::logWarning(ss.str());
+            DRIVER_LOG_WARNING(LogModule::Translator, ss.str());
             throw GCodeTranslatorUnknownCommandException(command);
         }
     }
 
     void GCodeTranslator::registerDispatcher(std::unique_ptr<ICommandDispatcher> dispatcher) {
         dispatchers_.push_back(std::move(dispatcher));
-        Logger::logInfo("[GCodeTranslator] Registered dispatcher, total: " + std::to_string(dispatchers_.size()));
+        DRIVER_LOG_INFO(LogModule::Translator,
+                        "[GCodeTranslator] Registered dispatcher, total: " + std::to_string(dispatchers_.size()));
     }
 
     std::shared_ptr<core::DriverInterface> GCodeTranslator::getDriver() const {
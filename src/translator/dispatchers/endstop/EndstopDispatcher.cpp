@@ -14,11 +14,11 @@ namespace translator::gcode {
         return command == "M119";
     }
 
-    bool EndstopDispatcher::validate(const std::string &command, const std::map<std::string, double> &) const {
+    bool EndstopDispatcher::validate(const std::string &, const std::map<std::string, double> &) const {
         return true;
     }
 
-    void EndstopDispatcher::handle(const std::string &command, const std::map<std::string, double> &) {
+    void EndstopDispatcher::handle(const std::string &, const std::map<std::string, double> &) {
         driver_->endstop()->readEndstopStatus();
     }
 
@@ -16,12 +16,12 @@ namespace translator::gcode {
         return command == "G10" || command == "G11";
     }
 
-    bool ExtruderDispatcher::validate(const std::string &command, const std::map<std::string, double> &) const {
+    bool ExtruderDispatcher::validate(const std::string &, const std::map<std::string, double> &) const {
         return true;
     }
 
     void ExtruderDispatcher::handle(const std::string &command, const std::map<std::string, double> &params) {
-        auto &stateTracker = core::state::StateTracker::getInstance();
+        auto &stateTracker = driver_->stateTracker();
         float length = params.count("L") ? params.at("L") : 5.0f;
         float feedrate = params.count("F") ? params.at("F") : 300.0f;
         if (command == "G10") {
@@ -40,7 +40,7 @@ namespace translator::gcode {
             }
         }
 
-        stateTracker.updateLastCommand(command + " L" + std::to_string(length));
+        stateTracker.updateLastCommand(core::state::CommandRef::of(command).with('L', length));
         stateTracker.updateFeedRate(feedrate);
     }
 } // namespace translator::gcode
@@ -24,7 +24,7 @@ namespace translator::gcode {
     }
 
     void FanDispatcher::handle(const std::string &command, const std::map<std::string, double> &params) {
-        auto &stateTracker = core::state::StateTracker::getInstance();
+        auto &stateTracker = driver_->stateTracker();
 
         if (command == "M106") {
             int speed = static_cast<int>(params.at("S"));
@@ -32,13 +32,13 @@ namespace translator::gcode {
             if (result.isSuccess()) {
                 stateTracker.updateFanSpeed(speed);
             }
-            stateTracker.updateLastCommand("M106 S" + std::to_string(speed));
+            stateTracker.updateLastCommand(core::state::CommandRef::of(command).with('S', speed));
         } else if (command == "M107") {
             auto result = driver_->fan()->setFanSpeed(0);
             if (result.isSuccess()) {
                 stateTracker.updateFanSpeed(0);
             }
-            stateTracker.updateLastCommand("M107");
+            stateTracker.updateLastCommand(core::state::CommandRef::of(command));
         }
     }
 } // namespace translator::gcode
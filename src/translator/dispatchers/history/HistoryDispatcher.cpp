@@ -14,7 +14,7 @@ namespace translator::gcode {
         return command == "M702";
     }
 
-    bool HistoryDispatcher::validate(const std::string &command, const std::map<std::string, double> &) const {
+    bool HistoryDispatcher::validate(const std::string &, const std::map<std::string, double> &) const {
         return true;
     }
 
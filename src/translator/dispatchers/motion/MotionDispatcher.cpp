@@ -3,7 +3,6 @@
 #include <iostream>
 #include <cmath>
 
-#include "core/printer/job/tracking/JobTracker.hpp"
 #include "core/printer/state/StateTracker.hpp"
 
 namespace translator::gcode {
@@ -41,42 +40,33 @@ namespace translator::gcode {
     }
 
     void MotionDispatcher::handle(const std::string &command, const std::map<std::string, double> &params) {
-        auto &stateTracker = core::state::StateTracker::getInstance();
-        auto &jobTracker = core::jobs::JobTracker::getInstance();
-        // Track feedrate changes
-        if (params.count("F")) {
-            stateTracker.updateFeedRate(params.at("F"));
-        }
-        // Track E position changes
-        if (params.count("E")) {
-            double eValue = params.at("E");
-            stateTracker.updateEPosition(eValue);
-        }
-        // Build command string for tracking
-        std::ostringstream cmdStr;
-        cmdStr << command;
-        for (const auto &[key, value]: params) {
-            cmdStr << " " << key << value;
-        }
-        stateTracker.updateLastCommand(cmdStr.str());
-        stateTracker.incrementCommandCount();
+        auto &stateTracker = driver_->stateTracker();
         // Layer detection from Z moves
+        bool newLayer = false;
+        double layerHeight = 0.0;
         if (params.count("Z")) {
-            static double lastZ = 0.0;
             double currentZ = params.at("Z");
-            if (currentZ > lastZ + 0.1) {
+            if (currentZ > lastZ_ + 0.1) {
                 // Layer change threshold
-                stateTracker.incrementLayer();
-                stateTracker.setLayerHeight(currentZ - lastZ);
+                newLayer = true;
+                layerHeight = currentZ - lastZ_;
             }
-            lastZ = currentZ;
-        }
-
-        // Update job progress if we have an active job
-        std::string currentJobId = jobTracker.getCurrentJobId();
-        if (!currentJobId.empty()) {
-            jobTracker.updateJobProgress(currentJobId, cmdStr.str());
+            lastZ_ = currentZ;
         }
+        // Feedrate, E position, last command and layer published as one state version
+        stateTracker.modify([&](core::state::StateSnapshot &state) {
+            if (params.count("F")) state.feedRate = params.at("F");
+            if (params.count("E")) state.ePosition = params.at("E");
+            state.lastCommand = core::state::CommandRef::of(command);
+            for (const auto &[key, value]: params) {
+                state.lastCommand.with(key.empty() ? '?' : key[0], value);
+            }
+            state.commandCount++;
+            if (newLayer) {
+                state.currentLayer++;
+                state.layerHeight = layerHeight;
+            }
+        });
 
         // Execute actual motion command
         if (command == "G0" || command == "G1") {
@@ -17,44 +17,44 @@ namespace translator::gcode {
                          command == "M999";
 
         if (canHandle) {
-            Logger::logInfo("[SystemDispatcher] Can handle command: " + command);
+            DRIVER_LOG_DEBUG(LogModule::Translator, "[SystemDispatcher] Can handle command: ", command);
         }
 
         return canHandle;
     }
 
     bool SystemDispatcher::validate(const std::string &command, const std::map<std::string, double> &) const {
-        Logger::logInfo("[SystemDispatcher] Validating command: " + command);
+        DRIVER_LOG_DEBUG(LogModule::Translator, "[SystemDispatcher] Validating command: ", command);
         return true;
     }
 
     void SystemDispatcher::handle(const std::string &command, const std::map<std::string, double> &) {
-        Logger::logInfo("[SystemDispatcher] Handling command: " + command);
+        DRIVER_LOG_DEBUG(LogModule::Translator, "[SystemDispatcher] Handling command: ", command);
 
         if (command == "G28") {
-            Logger::logInfo("[SystemDispatcher] Executing homing");
+            DRIVER_LOG_INFO(LogModule::Translator, "[SystemDispatcher] Executing homing");
             driver_->system()->homing();
         } else if (command == "M24") {
-            Logger::logInfo("[SystemDispatcher] Executing start print");
+            DRIVER_LOG_INFO(LogModule::Translator, "[SystemDispatcher] Executing start print");
             driver_->system()->startPrint();
         } else if (command == "M25") {
-            Logger::logInfo("[SystemDispatcher] Executing pause");
+            DRIVER_LOG_INFO(LogModule::Translator, "[SystemDispatcher] Executing pause");
             driver_->system()->pause();
         } else if (command == "M26") {
-            Logger::logInfo("[SystemDispatcher] Executing resume");
+            DRIVER_LOG_INFO(LogModule::Translator, "[SystemDispatcher] Executing resume");
             driver_->system()->resume();
         } else if (command == "M105") {
-            Logger::logInfo("[SystemDispatcher] Executing print status");
+            DRIVER_LOG_INFO(LogModule::Translator, "[SystemDispatcher] Executing print status");
             driver_->system()->printStatus();
         } else if (command == "M112") {
-            Logger::logInfo("[SystemDispatcher] Executing brutal reset");
+            DRIVER_LOG_INFO(LogModule::Translator, "[SystemDispatcher] Executing brutal reset");
             driver_->system()->brutalReset();
         } else if (command == "M999") {
-            Logger::logInfo("[SystemDispatcher] Executing emergency reset");
+            DRIVER_LOG_INFO(LogModule::Translator, "[SystemDispatcher] Executing emergency reset");
             driver_->system()->emergencyReset();
         }
 
-        Logger::logInfo("[SystemDispatcher] Command handled successfully: " + command);
+        DRIVER_LOG_DEBUG(LogModule::Translator, "[SystemDispatcher] Command handled successfully: ", command);
     }
 
 } // namespace translator::gcode
\ No newline at end of file
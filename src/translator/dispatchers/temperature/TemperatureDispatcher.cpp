@@ -4,33 +4,71 @@
 
 #include "translator/dispatchers/temperature/TemperatureDispatcher.hpp"
 #include <iostream>
+#include <chrono>
+#include <thread>
 
 #include "core/printer/state/StateTracker.hpp"
+#include "logger/Logger.hpp"
 
 namespace translator::gcode {
+    namespace {
+        constexpr double TEMPERATURE_TOLERANCE = 2.0; // °C sotto il target considerati raggiunti
+        constexpr auto TEMPERATURE_POLL_INTERVAL = std::chrono::seconds(1);
+    }
+
     TemperatureDispatcher::TemperatureDispatcher(std::shared_ptr<core::DriverInterface> driver)
         : driver_(std::move(driver)) {
     }
 
     bool TemperatureDispatcher::canHandle(const std::string &command) const {
-        return command == "M104" || command == "M140";
+        return command == "M104" || command == "M140" || command == "M109" || command == "M190";
     }
 
     bool
-    TemperatureDispatcher::validate(const std::string &command, const std::map<std::string, double> &params) const {
+    TemperatureDispatcher::validate(const std::string &, const std::map<std::string, double> &params) const {
         return params.count("S");
     }
 
     void TemperatureDispatcher::handle(const std::string &command, const std::map<std::string, double> &params) {
-        auto &stateTracker = core::state::StateTracker::getInstance();
+        auto &stateTracker = driver_->stateTracker();
         double temp = params.at("S");
 
-        if (command == "M104") {
+        if (command == "M104" || command == "M109") {
             driver_->temperature()->setHotendTemperature(temp);
             stateTracker.setHotendTargetTemp(temp); // Target, not actual
-        } else if (command == "M140") {
+        } else if (command == "M140" || command == "M190") {
             driver_->temperature()->setBedTemperature(temp);
             stateTracker.setBedTargetTemp(temp); // Target, not actual
         }
+
+        if (command == "M109" || command == "M190") {
+            waitForTemperature(command == "M109", temp);
+        }
+    }
+
+    void TemperatureDispatcher::waitForTemperature(bool hotend, double target) {
+        const std::string name = hotend ? "hotend" : "bed";
+        DRIVER_LOG_INFO(LogModule::Translator, "[TemperatureDispatcher] Waiting for ", name, " to reach ", target);
+        const core::PrintState startState = driver_->getState();
+
+        while (true) {
+            auto result = hotend ? driver_->temperature()->getHotendTemperature()
+                                 : driver_->temperature()->getBedTemperature();
+            if (result.isSuccess() && result.decoded.temperature &&
+                result.decoded.temperature->actual >= target - TEMPERATURE_TOLERANCE) {
+                DRIVER_LOG_INFO(LogModule::Translator, "[TemperatureDispatcher] ", name, " at ",
+                                result.decoded.temperature->actual);
+                return;
+            }
+
+            auto state = driver_->getState();
+            if (state != startState && (state == core::PrintState::Idle || state == core::PrintState::Error)) {
+                DRIVER_LOG_WARNING(LogModule::Translator, "[TemperatureDispatcher] Wait for ", name,
+                                   " temperature interrupted");
+                return;
+            }
+
+            std::this_thread::sleep_for(TEMPERATURE_POLL_INTERVAL);
+        }
     }
 } // namespace translator::gcode
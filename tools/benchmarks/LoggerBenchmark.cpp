@@ -0,0 +1,85 @@
+// Benchmark del logger asincrono: N thread producono M messaggi ciascuno, come il percorso di stampa.
+// Misura la latenza lato chiamante (p50/p99/max), il throughput, i record scartati e il tempo di svuotamento,
+// poi il costo di una chiamata DRIVER_LOG_* con il livello del modulo disattivato.
+
+#include "logger/Logger.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    double percentile(std::vector<int64_t> &samples, double p) {
+        if (samples.empty()) return 0.0;
+        size_t index = std::min(samples.size() - 1, static_cast<size_t>(p * static_cast<double>(samples.size())));
+        std::nth_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(index), samples.end());
+        return static_cast<double>(samples[index]);
+    }
+
+} // namespace
+
+int main(int argc, char **argv) {
+    size_t threads = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4;
+    size_t calls = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 200000;
+
+    Logger::setConsoleEnabled(false);
+    Logger::init();
+
+    std::cout << "Logging " << threads << " x " << calls << " messages" << std::endl;
+
+    std::vector<std::vector<int64_t>> latencies(threads);
+    std::vector<std::thread> workers;
+    auto start = Clock::now();
+
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([t, calls, &latencies]() {
+            auto &samples = latencies[t];
+            samples.reserve(calls);
+            for (size_t i = 0; i < calls; ++i) {
+                auto before = Clock::now();
+                Logger::logInfo("[Benchmark] thread " + std::to_string(t) + " line " + std::to_string(i) +
+                                " X=" + std::to_string(i % 200) + ".25 Y=" + std::to_string(i % 180) + ".50");
+                samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - before).count());
+            }
+        });
+    }
+    for (auto &worker: workers) worker.join();
+
+    double produceSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+    Logger::flush();
+    double drainSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::vector<int64_t> all;
+    for (auto &samples: latencies) all.insert(all.end(), samples.begin(), samples.end());
+    double total = static_cast<double>(all.size());
+
+    auto stats = Logger::stats();
+    std::cout << std::fixed << std::setprecision(0)
+              << "caller      " << std::setw(12) << total / produceSeconds << " calls/s" << std::endl
+              << "written     " << std::setw(12) << static_cast<double>(stats.written) / drainSeconds << " lines/s ("
+              << stats.batches << " batches)" << std::endl
+              << "latency ns  p50=" << percentile(all, 0.50) << " p99=" << percentile(all, 0.99)
+              << " max=" << percentile(all, 1.0) << std::endl
+              << "dropped     " << stats.dropped << " of " << all.size() << std::endl;
+
+    // Livello disattivato a runtime: gli argomenti non vengono valutati
+    Logger::setLevel(LogModule::Serial, LogLevel::Warning);
+    size_t disabledCalls = threads * calls;
+    auto disabledStart = Clock::now();
+    for (size_t i = 0; i < disabledCalls; ++i) {
+        DRIVER_LOG_INFO(LogModule::Serial, "[Benchmark] line " + std::to_string(i) + " X=" + std::to_string(i % 200));
+    }
+    double disabledSeconds = std::chrono::duration<double>(Clock::now() - disabledStart).count();
+    std::cout << std::setprecision(2) << "disabled    " << disabledSeconds * 1e9 / static_cast<double>(disabledCalls)
+              << " ns/call" << std::endl;
+
+    Logger::shutdown();
+    return 0;
+}
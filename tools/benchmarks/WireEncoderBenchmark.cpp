@@ -0,0 +1,142 @@
+// Benchmark della codifica dei comandi motion: percorso a stringhe (formatFloat + vector + ostringstream)
+// contro WireEncoder su buffer fisso. Stampa frame/s e verifica che l'output sia identico byte per byte.
+
+#include "core/CommandBuilder.hpp"
+#include "core/utils/WireEncoder.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+    // Implementazione precedente, mantenuta come riferimento
+    std::string legacyFormatFloat(float value, int precision = 2) {
+        float factor = std::pow(10.0f, precision);
+        float rounded = std::round(value * factor) / factor;
+        if (rounded == std::floor(rounded)) {
+            return std::to_string(static_cast<int>(rounded));
+        }
+
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(precision) << rounded;
+        std::string result = oss.str();
+
+        size_t end = result.find_last_not_of('0');
+        if (end != std::string::npos && result[end] == '.') end--;
+        return result.substr(0, end + 1);
+    }
+
+    std::string legacyBuildCommand(uint32_t number, char category, int code, const std::vector<std::string> &params) {
+        std::ostringstream oss;
+
+        oss << "N" << number << " " << category << code;
+        for (const auto &param: params) {
+            oss << " " << param;
+        }
+
+        std::string rawCommand = oss.str();
+        uint8_t checksum = 0;
+        for (char c: rawCommand) {
+            checksum ^= static_cast<uint8_t>(c);
+        }
+
+        oss << " *" << static_cast<int>(checksum);
+        return oss.str();
+    }
+
+    struct Move {
+        float x, y, z, f;
+    };
+
+    std::vector<Move> makeMoves(size_t count) {
+        std::vector<Move> moves;
+        moves.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            float t = static_cast<float>(i) * 0.137f;
+            moves.push_back({100.0f + 80.0f * std::sin(t), 100.0f + 80.0f * std::cos(t),
+                             0.2f + static_cast<float>(i / 500) * 0.2f, i % 7 == 0 ? 9000.0f : 1500.0f});
+        }
+        return moves;
+    }
+
+    template<typename Fn>
+    double measure(const char *name, size_t frames, Fn &&fn) {
+        auto start = std::chrono::steady_clock::now();
+        size_t bytes = fn();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        double rate = static_cast<double>(frames) / seconds;
+
+        std::cout << std::left << std::setw(12) << name
+                  << std::right << std::setw(14) << std::fixed << std::setprecision(0) << rate << " frames/s  "
+                  << std::setw(8) << std::setprecision(1) << seconds * 1e9 / static_cast<double>(frames) << " ns/frame  "
+                  << bytes << " bytes" << std::endl;
+        return rate;
+    }
+
+} // namespace
+
+int main(int argc, char **argv) {
+    size_t frames = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2000000;
+    auto moves = makeMoves(4096);
+
+    // Verifica di equivalenza prima della misura
+    for (size_t i = 0; i < moves.size(); ++i) {
+        const Move &m = moves[i];
+        std::string legacy = legacyBuildCommand(static_cast<uint32_t>(i), 'M', 10, {
+                "X" + legacyFormatFloat(m.x), "Y" + legacyFormatFloat(m.y),
+                "Z" + legacyFormatFloat(m.z), "F" + legacyFormatFloat(m.f)});
+
+        char buffer[core::utils::MAX_WIRE_COMMAND_SIZE];
+        size_t size = core::CommandBuilder::buildCommand(buffer, sizeof(buffer), static_cast<uint32_t>(i), 'M', 10,
+                                                         {{'X', m.x}, {'Y', m.y}, {'Z', m.z}, {'F', m.f}});
+        if (legacy != std::string(buffer, size)) {
+            std::cerr << "Mismatch: " << legacy << " != " << std::string(buffer, size) << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << "Encoding " << frames << " M10 frames" << std::endl;
+
+    double legacyRate = measure("legacy", frames, [&]() {
+        size_t bytes = 0;
+        for (size_t i = 0; i < frames; ++i) {
+            const Move &m = moves[i % moves.size()];
+            std::vector<std::string> params = {
+                    "X" + legacyFormatFloat(m.x), "Y" + legacyFormatFloat(m.y),
+                    "Z" + legacyFormatFloat(m.z), "F" + legacyFormatFloat(m.f)};
+            bytes += legacyBuildCommand(static_cast<uint32_t>(i), 'M', 10, params).size();
+        }
+        return bytes;
+    });
+
+    measure("strings", frames, [&]() {
+        size_t bytes = 0;
+        for (size_t i = 0; i < frames; ++i) {
+            const Move &m = moves[i % moves.size()];
+            std::vector<std::string> params = {
+                    "X" + core::utils::formatFloat(m.x), "Y" + core::utils::formatFloat(m.y),
+                    "Z" + core::utils::formatFloat(m.z), "F" + core::utils::formatFloat(m.f)};
+            bytes += core::CommandBuilder::buildCommand(static_cast<uint32_t>(i), 'M', 10, params).size();
+        }
+        return bytes;
+    });
+
+    double encoderRate = measure("encoder", frames, [&]() {
+        size_t bytes = 0;
+        char buffer[core::utils::MAX_WIRE_COMMAND_SIZE];
+        for (size_t i = 0; i < frames; ++i) {
+            const Move &m = moves[i % moves.size()];
+            bytes += core::CommandBuilder::buildCommand(buffer, sizeof(buffer), static_cast<uint32_t>(i), 'M', 10,
+                                                        {{'X', m.x}, {'Y', m.y}, {'Z', m.z}, {'F', m.f}});
+        }
+        return bytes;
+    });
+
+    std::cout << "Speedup: " << std::setprecision(1) << encoderRate / legacyRate << "x" << std::endl;
+    return 0;
+}
@@ -0,0 +1,123 @@
+// Emulatore del firmware 3DP su pseudo-terminale.
+//
+// Uso: firmware_emulator [opzioni]
+// Il percorso dello slave pty va passato al driver come SERIAL_PORT.
+
+#include "FirmwareEmulator.hpp"
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace {
+
+    tools::emulator::FirmwareEmulator *g_emulator = nullptr;
+
+    void onSignal(int) {
+        if (g_emulator) g_emulator->stop();
+    }
+
+    void printUsage(const char *program) {
+        std::cout << "Usage: " << program << " [options]\n"
+                  << "  --link PATH              Create a symlink to the pty slave (e.g. /tmp/ttyV0)\n"
+                  << "  --boot-delay-ms N        Delay between port open and boot banner (default 2500)\n"
+                  << "  --latency-ms N           Default command execution time (default 2)\n"
+                  << "  --latency KEY=MS         Per-command latency, KEY is a command (M10) or category (M)\n"
+                  << "  --planner-depth N        Queued motion commands before E02 (default 16)\n"
+                  << "  --busy-interval-ms N     BUSY keepalive period, 0 disables (default 1000)\n"
+                  << "  --crt-interval-ms N      Period of CRT messages, 0 disables (default 0)\n"
+                  << "  --rx-error-rate P        Probability of replying E01 to a valid command\n"
+                  << "  --tx-corrupt-rate P      Probability of corrupting a reply payload\n"
+                  << "  --drop-rate P            Probability of dropping a reply\n"
+                  << "  --no-binary              Do not advertise binary framing (CAP BIN1)\n"
+                  << "  --no-urgent              Ignore urgent \"!\" commands and do not advertise URG1\n"
+                  << "  --no-reset-on-open       Reopening the port does not reboot the firmware (HUPCL off)\n"
+                  << "  --hiccup-interval-ms N   Periodically drop the link and re-create the pty (USB re-enumeration)\n"
+                  << "  --seed N                 Random seed for error injection\n"
+                  << "  --verbose                Print every line sent and received\n";
+    }
+
+} // namespace
+
+int main(int argc, char **argv) {
+    tools::emulator::EmulatorConfig config;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << arg << std::endl;
+                std::exit(2);
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--link") {
+            config.linkPath = value();
+        } else if (arg == "--boot-delay-ms") {
+            config.bootDelay = std::chrono::milliseconds(std::stol(value()));
+        } else if (arg == "--latency-ms") {
+            config.defaultLatency = std::chrono::milliseconds(std::stol(value()));
+        } else if (arg == "--latency") {
+            std::string spec = value();
+            size_t eq = spec.find('=');
+            if (eq == std::string::npos) {
+                std::cerr << "Invalid latency spec: " << spec << std::endl;
+                return 2;
+            }
+            config.latencies[spec.substr(0, eq)] = std::chrono::milliseconds(std::stol(spec.substr(eq + 1)));
+        } else if (arg == "--planner-depth") {
+            config.plannerDepth = std::stoul(value());
+        } else if (arg == "--busy-interval-ms") {
+            config.busyInterval = std::chrono::milliseconds(std::stol(value()));
+        } else if (arg == "--crt-interval-ms") {
+            config.criticalInterval = std::chrono::milliseconds(std::stol(value()));
+        } else if (arg == "--rx-error-rate") {
+            config.rxChecksumErrorRate = std::stod(value());
+        } else if (arg == "--tx-corrupt-rate") {
+            config.txCorruptRate = std::stod(value());
+        } else if (arg == "--drop-rate") {
+            config.dropRate = std::stod(value());
+        } else if (arg == "--no-binary") {
+            config.binaryFraming = false;
+        } else if (arg == "--no-urgent") {
+            config.urgentLane = false;
+        } else if (arg == "--no-reset-on-open") {
+            config.resetOnOpen = false;
+        } else if (arg == "--hiccup-interval-ms") {
+            config.hiccupInterval = std::chrono::milliseconds(std::stol(value()));
+        } else if (arg == "--seed") {
+            config.seed = static_cast<uint32_t>(std::stoul(value()));
+        } else if (arg == "--verbose") {
+            config.verbose = true;
+        } else if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    try {
+        tools::emulator::FirmwareEmulator emulator(config);
+        g_emulator = &emulator;
+        std::signal(SIGINT, onSignal);
+        std::signal(SIGTERM, onSignal);
+
+        std::string slave = emulator.open();
+        std::cout << "[Emulator] Listening on " << slave;
+        if (!config.linkPath.empty()) std::cout << " (" << config.linkPath << ")";
+        std::cout << std::endl;
+
+        emulator.run();
+
+        std::cout << "[Emulator] " << emulator.formatStats() << std::endl;
+        g_emulator = nullptr;
+    } catch (const std::exception &e) {
+        std::cerr << "[Emulator] " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
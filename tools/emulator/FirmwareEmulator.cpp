@@ -0,0 +1,642 @@
+#include "FirmwareEmulator.hpp"
+#include "core/serial/BinaryFrameCodec.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <iomanip>
+#include <iostream>
+#include <poll.h>
+#include <sstream>
+#include <stdexcept>
+#include <termios.h>
+#include <thread>
+#include <unistd.h>
+
+namespace tools::emulator {
+
+    namespace {
+        constexpr const char *BOOT_BANNER = "Avvio firmware 3DP...";
+        constexpr const char *READY_BANNER = "Sistema pronto.";
+        constexpr const char *CATEGORIES = "MAEFHST";
+        constexpr double AMBIENT_TEMP = 22.0;
+        constexpr double HEATING_RATE = 2.0; // °C/s
+        constexpr double MAX_TEMPERATURE = 300.0;
+    }
+
+    FirmwareEmulator::FirmwareEmulator(EmulatorConfig config)
+            : config_(std::move(config)), rng_(config_.seed) {}
+
+    FirmwareEmulator::~FirmwareEmulator() {
+        if (!config_.linkPath.empty()) {
+            ::unlink(config_.linkPath.c_str());
+        }
+        if (masterFd_ >= 0) {
+            ::close(masterFd_);
+        }
+    }
+
+    std::string FirmwareEmulator::open() {
+        masterFd_ = ::posix_openpt(O_RDWR | O_NOCTTY);
+        if (masterFd_ < 0 || ::grantpt(masterFd_) != 0 || ::unlockpt(masterFd_) != 0) {
+            throw std::runtime_error(std::string("Failed to create pty: ") + std::strerror(errno));
+        }
+
+        const char *name = ::ptsname(masterFd_);
+        if (!name) {
+            throw std::runtime_error("ptsname failed");
+        }
+        slavePath_ = name;
+
+        // Modalità raw sullo slave; chiudendolo il master segnala POLLHUP finché il driver non lo apre
+        int slaveFd = ::open(slavePath_.c_str(), O_RDWR | O_NOCTTY);
+        if (slaveFd >= 0) {
+            termios tio{};
+            if (::tcgetattr(slaveFd, &tio) == 0) {
+                ::cfmakeraw(&tio);
+                ::tcsetattr(slaveFd, TCSANOW, &tio);
+            }
+            ::close(slaveFd);
+        }
+
+        ::fcntl(masterFd_, F_SETFL, ::fcntl(masterFd_, F_GETFL) | O_NONBLOCK);
+
+        if (!config_.linkPath.empty()) {
+            ::unlink(config_.linkPath.c_str());
+            if (::symlink(slavePath_.c_str(), config_.linkPath.c_str()) != 0) {
+                throw std::runtime_error("Failed to create symlink " + config_.linkPath + ": " + std::strerror(errno));
+            }
+        }
+
+        return slavePath_;
+    }
+
+    void FirmwareEmulator::run() {
+        running_ = true;
+        lastTick_ = Clock::now();
+
+        while (running_) {
+            pollConnection();
+
+            if (connected_ && !booted_ && Clock::now() >= bootAt_) {
+                boot();
+            }
+
+            if (booted_ && connected_) {
+                readInput();
+                extractMessages();
+            }
+            // Senza reset il firmware continua a lavorare anche con il link scollegato
+            if (booted_) {
+                tick();
+            }
+
+            if (connected_ && booted_ && config_.hiccupInterval.count() > 0 && Clock::now() >= nextHiccup_) {
+                hiccup();
+            }
+        }
+    }
+
+    void FirmwareEmulator::hiccup() {
+        std::cout << "[Emulator] Simulated link loss: re-creating pty" << std::endl;
+        stats_.hiccups++;
+
+        ::close(masterFd_);
+        masterFd_ = -1;
+        open();
+
+        connected_ = false;
+        if (config_.resetOnOpen) {
+            booted_ = false;
+        }
+        rxBuffer_.clear();
+    }
+
+    void FirmwareEmulator::stop() {
+        running_ = false;
+    }
+
+    void FirmwareEmulator::pollConnection() {
+        pollfd pfd{masterFd_, POLLIN, 0};
+        ::poll(&pfd, 1, 1);
+
+        bool hangup = (pfd.revents & POLLHUP) != 0;
+        if (hangup && connected_) {
+            std::cout << "[Emulator] Host disconnected" << std::endl;
+            connected_ = false;
+            if (config_.resetOnOpen) {
+                booted_ = false;
+            }
+        } else if (hangup) {
+            // Nessuno ha lo slave aperto: evita busy loop
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        } else if (!connected_ && booted_) {
+            // HUPCL disattivato: nessun reset, la sessione riprende con lo stato corrente
+            std::cout << "[Emulator] Host reconnected without reset" << std::endl;
+            connected_ = true;
+            nextHiccup_ = Clock::now() + config_.hiccupInterval;
+        } else if (!connected_) {
+            // Apertura della porta = reset DTR della scheda: il firmware riparte dopo il bootloader
+            std::cout << "[Emulator] Host connected, booting in " << config_.bootDelay.count() << "ms" << std::endl;
+            connected_ = true;
+            booted_ = false;
+            bootAt_ = Clock::now() + config_.bootDelay;
+        }
+    }
+
+    void FirmwareEmulator::resetState() {
+        synced_ = false;
+        lastNumber_ = 0;
+        activeCommand_.reset();
+        planner_.clear();
+        plannerTail_ = Clock::now();
+        pendingCritical_.reset();
+        position_ = Axes{};
+        hotendTarget_ = 0.0;
+        bedTarget_ = 0.0;
+        fanSpeed_ = 0;
+        paused_ = false;
+        autoReportInterval_ = std::chrono::milliseconds(0);
+        rxBuffer_.clear();
+        pendingLines_.clear();
+    }
+
+    void FirmwareEmulator::boot() {
+        resetState();
+
+        // Scarta quanto arrivato durante il "bootloader"
+        char discard[512];
+        while (::read(masterFd_, discard, sizeof(discard)) > 0) {}
+
+        writeLine(BOOT_BANNER);
+        writeLine(READY_BANNER);
+
+        booted_ = true;
+        stats_.boots++;
+        nextCritical_ = Clock::now() + config_.criticalInterval;
+        nextHiccup_ = Clock::now() + config_.hiccupInterval;
+        std::cout << "[Emulator] Firmware ready" << std::endl;
+    }
+
+    void FirmwareEmulator::readInput() {
+        char buffer[4096];
+        while (true) {
+            ssize_t n = ::read(masterFd_, buffer, sizeof(buffer));
+            if (n <= 0) break;
+            rxBuffer_.append(buffer, static_cast<size_t>(n));
+            stats_.bytesIn += static_cast<uint64_t>(n);
+        }
+    }
+
+    void FirmwareEmulator::extractMessages() {
+        while (!rxBuffer_.empty()) {
+            if (static_cast<uint8_t>(rxBuffer_[0]) == core::BinaryFrameCodec::SYNC_BYTE) {
+                auto size = core::BinaryFrameCodec::frameSize(rxBuffer_);
+                if (!size || rxBuffer_.size() < *size) break;
+
+                std::string frame = rxBuffer_.substr(0, *size);
+                rxBuffer_.erase(0, *size);
+                stats_.binaryFrames++;
+
+                auto decoded = core::BinaryFrameCodec::decode(frame);
+                if (!decoded) {
+                    stats_.checksumErrors++;
+                    reply("E01", lastNumber_ + 1);
+                    continue;
+                }
+                pendingLines_.push_back({*decoded, true});
+                continue;
+            }
+
+            size_t pos = rxBuffer_.find('\n');
+            if (pos == std::string::npos) break;
+
+            std::string line = rxBuffer_.substr(0, pos);
+            rxBuffer_.erase(0, pos + 1);
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (line.empty()) continue;
+
+            if (config_.verbose) std::cout << "[RX] " << line << std::endl;
+
+            // Gli ACK e i comandi urgenti non attendono la fine del comando in esecuzione
+            if (line[0] == 'A' && line.size() == 4) {
+                handleAck(line);
+            } else if (line[0] == '!') {
+                handleUrgent(line);
+            } else {
+                pendingLines_.push_back({line, false});
+            }
+        }
+    }
+
+    void FirmwareEmulator::tick() {
+        auto now = Clock::now();
+        updateTemperatures(std::chrono::duration<double>(now - lastTick_).count());
+        lastTick_ = now;
+
+        while (!planner_.empty() && planner_.front() <= now) {
+            planner_.pop_front();
+        }
+
+        if (activeCommand_) {
+            if (now >= activeUntil_) {
+                Command command = *activeCommand_;
+                activeCommand_.reset();
+                complete(command);
+            } else if (config_.busyInterval.count() > 0 && now >= nextBusy_) {
+                writeLine("BUSY");
+                nextBusy_ = now + config_.busyInterval;
+            }
+        }
+
+        if (pendingCritical_ && now >= criticalDeadline_) {
+            stats_.criticalRetransmits++;
+            sendCritical(*pendingCritical_);
+        } else if (!pendingCritical_ && config_.criticalInterval.count() > 0 && now >= nextCritical_) {
+            std::ostringstream payload;
+            payload << "CRT TMP " << formatValue(hotendTemp_) << " " << formatValue(hotendTarget_);
+            sendCritical(payload.str());
+            nextCritical_ = now + config_.criticalInterval;
+        }
+
+        if (booted_ && autoReportInterval_.count() > 0 && now >= nextReport_) {
+            std::ostringstream payload;
+            payload << "STS HE=" << formatValue(hotendTemp_) << "/" << formatValue(hotendTarget_)
+                    << " BED=" << formatValue(bedTemp_) << "/" << formatValue(bedTarget_)
+                    << " X=" << formatValue(position_.x) << " Y=" << formatValue(position_.y)
+                    << " Z=" << formatValue(position_.z) << " FAN=" << fanSpeed_ << " ES=000";
+            info(payload.str());
+            stats_.telemetryReports++;
+            nextReport_ = now + autoReportInterval_;
+        }
+
+        while (!activeCommand_ && !pendingLines_.empty()) {
+            PendingLine line = pendingLines_.front();
+            pendingLines_.pop_front();
+            handleLine(line);
+        }
+    }
+
+    void FirmwareEmulator::handleAck(const std::string &line) {
+        if (!pendingCritical_) return;
+
+        int value = std::atoi(line.c_str() + 1);
+        if (value == pendingCriticalChecksum_) {
+            pendingCritical_.reset();
+        }
+    }
+
+    void FirmwareEmulator::handleUrgent(const std::string &line) {
+        // "!M0 *cs": non numerato, eseguito subito anche con un comando in corso
+        if (!config_.urgentLane) return; // Firmware legacy: linea ignorata, nessuna conferma
+
+        auto star = line.find(" *");
+        if (star == std::string::npos) return;
+
+        std::string payload = line.substr(0, star);
+        if (std::atoi(line.c_str() + star + 2) != checksum(payload)) {
+            stats_.checksumErrors++;
+            return; // Nessuna risposta: l'host ritrasmette allo scadere dell'RTO
+        }
+
+        std::string key = payload.substr(1);
+        if (key == "M0") {
+            planner_.clear();
+            plannerTail_ = Clock::now();
+            if (activeCommand_) {
+                reply("ES0", activeCommand_->number);
+                activeCommand_.reset();
+            }
+        } else if (key == "S2") {
+            paused_ = true;
+        } else {
+            return;
+        }
+
+        stats_.urgent++;
+        info("URG " + key);
+    }
+
+    void FirmwareEmulator::handleLine(const PendingLine &line) {
+        bool checksumValid = false;
+        auto command = parseCommand(line.text, line.binary, checksumValid);
+        if (!command) {
+            stats_.checksumErrors++;
+            reply("E01", lastNumber_ + 1);
+            return;
+        }
+        handleCommand(*command, checksumValid);
+    }
+
+    void FirmwareEmulator::handleCommand(const Command &command, bool checksumValid) {
+        stats_.commands++;
+
+        if (checksumValid && chance(config_.rxChecksumErrorRate)) {
+            stats_.injectedChecksumErrors++;
+            checksumValid = false;
+        }
+
+        if (!checksumValid) {
+            stats_.checksumErrors++;
+            reply("E01", command.number);
+            return;
+        }
+
+        // Il primo comando dopo il boot fissa la numerazione
+        if (!synced_) {
+            lastNumber_ = command.number - 1;
+            synced_ = true;
+        }
+
+        if (command.number <= lastNumber_) {
+            stats_.duplicates++;
+            reply("E03", command.number);
+            return;
+        }
+
+        if (command.number > lastNumber_ + 1) {
+            stats_.resends++;
+            reply("E04", lastNumber_ + 1);
+            return;
+        }
+
+        if (std::strchr(CATEGORIES, command.category) == nullptr || !numericParams(command)) {
+            lastNumber_ = command.number;
+            reply("E05", command.number);
+            return;
+        }
+
+        auto now = Clock::now();
+
+        if (isQueued(command)) {
+            if (paused_) {
+                lastNumber_ = command.number;
+                reply("EM0", command.number);
+                return;
+            }
+
+            if (planner_.size() >= config_.plannerDepth) {
+                stats_.overflows++;
+                reply("E02", command.number);
+                return;
+            }
+
+            lastNumber_ = command.number;
+            plannerTail_ = std::max(now, plannerTail_) + latencyFor(command);
+            planner_.push_back(plannerTail_);
+
+            if (command.category == 'M') {
+                position_.x = param(command, 'X', position_.x);
+                position_.y = param(command, 'Y', position_.y);
+                position_.z = param(command, 'Z', position_.z);
+            }
+
+            reply("OK0", command.number);
+            return;
+        }
+
+        if (command.key == "T10" || command.key == "T20") {
+            if (param(command, 'S', 0.0) > MAX_TEMPERATURE) {
+                lastNumber_ = command.number;
+                reply("ET0", command.number);
+                return;
+            }
+        }
+
+        lastNumber_ = command.number;
+        activeCommand_ = command;
+
+        // Homing e lettura posizione attendono lo svuotamento del planner
+        bool waitPlanner = command.key == "S0" || command.key == "M114";
+        activeUntil_ = (waitPlanner ? std::max(now, plannerTail_) : now) + latencyFor(command);
+        nextBusy_ = now + config_.busyInterval;
+    }
+
+    void FirmwareEmulator::complete(const Command &command) {
+        const std::string &key = command.key;
+        if (key == "M0" || key == "A0" || key == "S4" || key == "S5") {
+            planner_.clear();
+            plannerTail_ = Clock::now();
+            paused_ = false;
+        } else if (key == "M114") {
+            info("POS X=" + formatValue(position_.x) + " Y=" + formatValue(position_.y) +
+                 " Z=" + formatValue(position_.z));
+        } else if (key == "E10") {
+            info("ENDSTOP X=0 Y=0 Z=0");
+        } else if (key == "F10") {
+            fanSpeed_ = static_cast<int>(param(command, 'S', fanSpeed_));
+        } else if (key == "F0") {
+            fanSpeed_ = 0;
+        } else if (key == "H10") {
+            info("HISTORY LAST N=" + std::to_string(lastNumber_));
+        } else if (key == "H40") {
+            info("LAST N=" + std::to_string(lastNumber_));
+        } else if (key == "S0") {
+            position_ = Axes{};
+        } else if (key == "S1" || key == "S3") {
+            paused_ = false;
+        } else if (key == "S2") {
+            paused_ = true;
+        } else if (key == "S10") {
+            info(std::string("STATUS ") + (paused_ ? "PAUSED" : "RUNNING") + " PLANNER=" +
+                 std::to_string(planner_.size()) + " FAN=" + std::to_string(fanSpeed_));
+        } else if (key == "S90") {
+            std::string capabilities = "CAP";
+            if (config_.binaryFraming) capabilities += " BIN1";
+            if (config_.urgentLane) capabilities += " URG1";
+            info(capabilities);
+        } else if (key == "S91") {
+            autoReportInterval_ = std::chrono::milliseconds(static_cast<int>(param(command, 'I', 0)));
+            nextReport_ = Clock::now() + autoReportInterval_;
+        } else if (key == "T10") {
+            hotendTarget_ = param(command, 'S', hotendTarget_);
+        } else if (key == "T20") {
+            bedTarget_ = param(command, 'S', bedTarget_);
+        } else if (key == "T11") {
+            info("TEMP=" + formatValue(hotendTemp_));
+        } else if (key == "T21") {
+            info("TEMP=" + formatValue(bedTemp_));
+        }
+
+        reply("OK0", command.number);
+    }
+
+    bool FirmwareEmulator::isQueued(const Command &command) const {
+        return command.key == "M10" || command.key == "M11" ||
+               (command.category == 'A' && command.code >= 10 && command.code <= 13);
+    }
+
+    std::chrono::milliseconds FirmwareEmulator::latencyFor(const Command &command) const {
+        auto it = config_.latencies.find(command.key);
+        if (it != config_.latencies.end()) return it->second;
+
+        // Chiave di sola categoria, es. "M"
+        it = config_.latencies.find(std::string(1, command.category));
+        return it != config_.latencies.end() ? it->second : config_.defaultLatency;
+    }
+
+    void FirmwareEmulator::updateTemperatures(double seconds) {
+        auto approach = [seconds](double current, double target) {
+            double goal = target > 0.0 ? target : AMBIENT_TEMP;
+            double step = HEATING_RATE * seconds;
+            return std::abs(goal - current) <= step ? goal : current + (goal > current ? step : -step);
+        };
+        hotendTemp_ = approach(hotendTemp_, hotendTarget_);
+        bedTemp_ = approach(bedTemp_, bedTarget_);
+    }
+
+    void FirmwareEmulator::reply(const std::string &code, uint32_t number) {
+        if (chance(config_.dropRate)) {
+            stats_.droppedReplies++;
+            return;
+        }
+        if (code == "OK0") stats_.ok++;
+        writeLine(frame(code + " N" + std::to_string(number)));
+    }
+
+    void FirmwareEmulator::info(const std::string &payload) {
+        writeLine(frame(payload));
+    }
+
+    void FirmwareEmulator::sendCritical(const std::string &payload) {
+        pendingCritical_ = payload;
+        pendingCriticalChecksum_ = checksum(payload);
+        criticalDeadline_ = Clock::now() + config_.criticalAckTimeout;
+        stats_.criticalSent++;
+        writeLine(frame(payload));
+    }
+
+    std::string FirmwareEmulator::frame(const std::string &payload) {
+        std::string line = withChecksum(payload);
+        if (chance(config_.txCorruptRate)) {
+            // Rumore sulla linea: un bit del payload, il checksum resta quello originale
+            stats_.corruptedReplies++;
+            size_t pos = payload.size() - 1;
+            line[pos] = static_cast<char>(line[pos] ^ 0x01);
+        }
+        return line;
+    }
+
+    void FirmwareEmulator::writeLine(const std::string &line) {
+        // Link scollegato: i byte inviati dal firmware vanno persi
+        if (!connected_) return;
+        if (config_.verbose) std::cout << "[TX] " << line << std::endl;
+
+        std::string data = line + "\n";
+        size_t written = 0;
+        while (written < data.size()) {
+            ssize_t n = ::write(masterFd_, data.data() + written, data.size() - written);
+            if (n > 0) {
+                written += static_cast<size_t>(n);
+            } else if (n < 0 && errno == EAGAIN) {
+                // Il driver non sta leggendo: il buffer del pty è pieno
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            } else {
+                return;
+            }
+        }
+        stats_.bytesOut += data.size();
+    }
+
+    bool FirmwareEmulator::chance(double probability) {
+        if (probability <= 0.0) return false;
+        return std::uniform_real_distribution<double>(0.0, 1.0)(rng_) < probability;
+    }
+
+    std::optional<FirmwareEmulator::Command>
+    FirmwareEmulator::parseCommand(const std::string &text, bool binary, bool &checksumValid) {
+        std::string body = text;
+        checksumValid = binary;
+
+        size_t star = text.find(" *");
+        if (star != std::string::npos) {
+            body = text.substr(0, star);
+            try {
+                checksumValid = std::stoi(text.substr(star + 2)) == checksum(body);
+            } catch (const std::exception &) {
+                checksumValid = false;
+            }
+        }
+
+        std::istringstream iss(body);
+        std::string token;
+        Command command;
+
+        if (!(iss >> token) || token.size() < 2 || token[0] != 'N') return std::nullopt;
+        try {
+            command.number = static_cast<uint32_t>(std::stoul(token.substr(1)));
+        } catch (const std::exception &) {
+            return std::nullopt;
+        }
+
+        if (!(iss >> token) || token.size() < 2) return std::nullopt;
+        command.category = token[0];
+        try {
+            command.code = std::stoi(token.substr(1));
+        } catch (const std::exception &) {
+            return std::nullopt;
+        }
+        command.key = std::string(1, command.category) + std::to_string(command.code);
+
+        while (iss >> token) {
+            command.params[token[0]] = token.substr(1);
+        }
+        return command;
+    }
+
+    bool FirmwareEmulator::numericParams(const Command &command) {
+        for (const auto &[letter, value]: command.params) {
+            if (value.empty()) continue;
+            char *end = nullptr;
+            double number = std::strtod(value.c_str(), &end);
+            if (*end != '\0' || !std::isfinite(number)) return false;
+        }
+        return true;
+    }
+
+    double FirmwareEmulator::param(const Command &command, char letter, double fallback) {
+        auto it = command.params.find(letter);
+        if (it == command.params.end() || it->second.empty()) return fallback;
+        // Validato da numericParams prima dell'esecuzione: strtod non lancia eccezioni
+        return std::strtod(it->second.c_str(), nullptr);
+    }
+
+    uint8_t FirmwareEmulator::checksum(const std::string &data) {
+        uint8_t cs = 0;
+        for (char c: data) cs ^= static_cast<uint8_t>(c);
+        return cs;
+    }
+
+    std::string FirmwareEmulator::withChecksum(const std::string &payload) {
+        return payload + " *" + std::to_string(checksum(payload));
+    }
+
+    std::string FirmwareEmulator::formatValue(double value) {
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(2) << value;
+        return oss.str();
+    }
+
+    std::string FirmwareEmulator::formatStats() const {
+        std::ostringstream oss;
+        oss << "boots=" << stats_.boots
+            << " commands=" << stats_.commands
+            << " binary=" << stats_.binaryFrames
+            << " ok=" << stats_.ok
+            << " E01=" << stats_.checksumErrors << " (injected " << stats_.injectedChecksumErrors << ")"
+            << " E02=" << stats_.overflows
+            << " E03=" << stats_.duplicates
+            << " E04=" << stats_.resends
+            << " corrupted=" << stats_.corruptedReplies
+            << " dropped=" << stats_.droppedReplies
+            << " crt=" << stats_.criticalSent << " (retx " << stats_.criticalRetransmits << ")"
+            << " sts=" << stats_.telemetryReports
+            << " urgent=" << stats_.urgent
+            << " hiccups=" << stats_.hiccups
+            << " rx=" << stats_.bytesIn << "B tx=" << stats_.bytesOut << "B";
+        return oss.str();
+    }
+
+} // namespace tools::emulator
@@ -0,0 +1,227 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <optional>
+#include <random>
+#include <string>
+
+namespace tools::emulator {
+
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Parametri dell'emulatore (latenze, profondità del planner, iniezione errori)
+     */
+    struct EmulatorConfig {
+        std::string linkPath;                              // Symlink opzionale verso lo slave pty
+        std::chrono::milliseconds bootDelay{2500};         // Dopo l'apertura della porta (reset DTR simulato)
+        std::chrono::milliseconds defaultLatency{2};       // Tempo di esecuzione di un comando
+        std::map<std::string, std::chrono::milliseconds> latencies; // Per comando, es. "M10" -> 15ms, "S0" -> 3s
+        size_t plannerDepth = 16;                          // Comandi di movimento accodabili prima di E02
+        std::chrono::milliseconds busyInterval{1000};      // Keepalive BUSY durante comandi lunghi
+        std::chrono::milliseconds criticalInterval{0};     // Periodo dei messaggi CRT (0 = disabilitati)
+        std::chrono::milliseconds criticalAckTimeout{500}; // Ritrasmissione CRT senza ACK corretto
+        double rxChecksumErrorRate = 0.0;                  // Comando ricevuto "corrotto" -> E01
+        double txCorruptRate = 0.0;                        // Bit errato nel payload della risposta
+        double dropRate = 0.0;                             // Risposta persa
+        bool binaryFraming = true;                         // Annuncia BIN1 in risposta a S90
+        bool urgentLane = true;                            // Accetta i comandi "!" e annuncia URG1 in risposta a S90
+        bool resetOnOpen = true;                           // L'apertura della porta riavvia il firmware (DTR)
+        std::chrono::milliseconds hiccupInterval{0};       // Perdita periodica del link con nuovo pty (0 = mai)
+        uint32_t seed = 0;
+        bool verbose = false;
+    };
+
+    struct EmulatorStats {
+        uint64_t bytesIn = 0;
+        uint64_t bytesOut = 0;
+        uint64_t commands = 0;
+        uint64_t binaryFrames = 0;
+        uint64_t ok = 0;
+        uint64_t checksumErrors = 0;
+        uint64_t injectedChecksumErrors = 0;
+        uint64_t duplicates = 0;
+        uint64_t resends = 0;
+        uint64_t overflows = 0;
+        uint64_t corruptedReplies = 0;
+        uint64_t droppedReplies = 0;
+        uint64_t criticalSent = 0;
+        uint64_t criticalRetransmits = 0;
+        uint64_t telemetryReports = 0;
+        uint64_t urgent = 0;
+        uint64_t boots = 0;
+        uint64_t hiccups = 0;
+    };
+
+    /**
+     * @brief Emula il firmware 3DP su uno pseudo-terminale Linux.
+     *
+     * Il driver si collega allo slave pty (stampato all'avvio o raggiungibile via symlink) come
+     * a una scheda reale: banner di boot, comandi numerati con checksum XOR o frame binari CRC16,
+     * risposte OK0/E01-E05/EM0/ET0/ES0/ES1, BUSY, linee informative e CRT con ACK.
+     */
+    class FirmwareEmulator {
+    public:
+        explicit FirmwareEmulator(EmulatorConfig config);
+
+        ~FirmwareEmulator();
+
+        /**
+         * @brief Crea il pty e restituisce il percorso dello slave
+         */
+        std::string open();
+
+        /**
+         * @brief Loop principale, ritorna quando stop() viene chiamato
+         */
+        void run();
+
+        void stop();
+
+        const EmulatorStats &stats() const { return stats_; }
+
+        std::string formatStats() const;
+
+    private:
+        struct Command {
+            uint32_t number = 0;
+            char category = 0;
+            int code = 0;
+            std::map<char, std::string> params;
+            std::string key;
+        };
+
+        struct Axes {
+            double x = 0.0;
+            double y = 0.0;
+            double z = 0.0;
+        };
+
+        EmulatorConfig config_;
+        EmulatorStats stats_;
+        std::mt19937 rng_;
+
+        int masterFd_ = -1;
+        std::string slavePath_;
+        std::atomic<bool> running_{false};
+
+        // Connessione e boot
+        bool connected_ = false;
+        bool booted_ = false;
+        Clock::time_point bootAt_;
+        Clock::time_point nextHiccup_;
+
+        // Numerazione
+        bool synced_ = false;
+        uint32_t lastNumber_ = 0;
+
+        // Comando sincrono in esecuzione (non accodabile)
+        std::optional<Command> activeCommand_;
+        Clock::time_point activeUntil_;
+        Clock::time_point nextBusy_;
+
+        // Planner: istanti di completamento dei movimenti accodati
+        std::deque<Clock::time_point> planner_;
+        Clock::time_point plannerTail_;
+
+        // CRT in attesa di ACK
+        std::optional<std::string> pendingCritical_;
+        uint8_t pendingCriticalChecksum_ = 0;
+        Clock::time_point criticalDeadline_;
+        Clock::time_point nextCritical_;
+
+        // Auto-report (S91 I<ms>)
+        std::chrono::milliseconds autoReportInterval_{0};
+        Clock::time_point nextReport_;
+
+        // Stato simulato
+        Axes position_;
+        double hotendTemp_ = 22.0;
+        double hotendTarget_ = 0.0;
+        double bedTemp_ = 22.0;
+        double bedTarget_ = 0.0;
+        int fanSpeed_ = 0;
+        bool paused_ = false;
+
+        Clock::time_point lastTick_;
+
+        struct PendingLine {
+            std::string text;
+            bool binary;
+        };
+
+        std::string rxBuffer_;
+        std::deque<PendingLine> pendingLines_;
+
+        void pollConnection();
+
+        /**
+         * @brief Chiude il pty e ne crea uno nuovo (stesso symlink), come una ri-enumerazione USB
+         */
+        void hiccup();
+
+        void boot();
+
+        void readInput();
+
+        void extractMessages();
+
+        void tick();
+
+        void handleAck(const std::string &line);
+
+        void handleLine(const PendingLine &line);
+
+        void handleUrgent(const std::string &line);
+
+        void handleCommand(const Command &command, bool checksumValid);
+
+        void complete(const Command &command);
+
+        void updateTemperatures(double seconds);
+
+        void resetState();
+
+        bool isQueued(const Command &command) const;
+
+        std::chrono::milliseconds latencyFor(const Command &command) const;
+
+        void reply(const std::string &code, uint32_t number);
+
+        void info(const std::string &payload);
+
+        void sendCritical(const std::string &payload);
+
+        /**
+         * @brief Aggiunge il checksum, applicando l'eventuale corruzione iniettata
+         */
+        std::string frame(const std::string &payload);
+
+        void writeLine(const std::string &line);
+
+        bool chance(double probability);
+
+        static std::optional<Command> parseCommand(const std::string &text, bool binary, bool &checksumValid);
+
+        /**
+         * @brief Parametri vuoti (assenti) o numerici; altrimenti il comando riceve E05
+         */
+        static bool numericParams(const Command &command);
+
+        /**
+         * @return Valore del parametro, fallback se assente o vuoto
+         */
+        static double param(const Command &command, char letter, double fallback);
+
+        static uint8_t checksum(const std::string &data);
+
+        static std::string withChecksum(const std::string &payload);
+
+        static std::string formatValue(double value);
+    };
+
+} // namespace tools::emulator
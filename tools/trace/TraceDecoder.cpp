@@ -0,0 +1,109 @@
+// Decodifica un trace binario prodotto da TraceLog (LOG_TRACE_PATH) in testo o CSV.
+//
+// Uso: trace_decoder [--csv] [--event NOME] FILE
+
+#include "logger/TraceLog.hpp"
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+
+namespace {
+
+    void printUsage(const char *program) {
+        std::cout << "Usage: " << program << " [options] FILE\n"
+                  << "  --csv          One CSV row per event: time_ns,event,args\n"
+                  << "  --event NAME   Only print events with this name (e.g. serial.tx)\n"
+                  << "  --summary      Print event counts instead of events\n";
+    }
+
+    std::string csvQuote(const std::string &value) {
+        if (value.find_first_of(",\"\n") == std::string::npos) return value;
+        std::string quoted = "\"";
+        for (char c: value) {
+            if (c == '"') quoted += '"';
+            quoted += c;
+        }
+        return quoted + "\"";
+    }
+
+    std::string formatValue(const TraceArgument &arg) {
+        switch (arg.type) {
+            case 's':
+                return std::to_string(arg.signedNumber);
+            case 'b':
+            case 'i':
+                return arg.text;
+            default:
+                return std::to_string(arg.number);
+        }
+    }
+
+} // namespace
+
+int main(int argc, char **argv) {
+    bool csv = false;
+    bool summary = false;
+    std::string filter;
+    std::string path;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--csv") {
+            csv = true;
+        } else if (arg == "--summary") {
+            summary = true;
+        } else if (arg == "--event" && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (!arg.empty() && arg[0] != '-') {
+            path = arg;
+        } else {
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+    if (path.empty()) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    TraceReader reader(path);
+    if (!reader.isOpen()) return 1;
+
+    std::map<std::string, uint64_t> counts;
+    if (csv && !summary) std::cout << "time_ns,event,args" << std::endl;
+
+    while (auto record = reader.next()) {
+        if (!filter.empty() && record->name != filter) continue;
+        if (summary) {
+            counts[record->name]++;
+            continue;
+        }
+
+        if (csv) {
+            std::string args;
+            for (const auto &arg: record->args) {
+                if (!args.empty()) args += ' ';
+                args += arg.name + "=" + formatValue(arg);
+            }
+            std::cout << record->timestamp.count() << ',' << record->name << ',' << csvQuote(args) << '\n';
+        } else {
+            std::cout << std::fixed << std::setprecision(6) << std::setw(14)
+                      << static_cast<double>(record->timestamp.count()) / 1e9 << "  "
+                      << std::left << std::setw(20) << record->name << std::right;
+            for (const auto &arg: record->args) {
+                std::cout << ' ' << arg.name << '=' << formatValue(arg);
+            }
+            std::cout << '\n';
+        }
+    }
+
+    for (const auto &[name, count]: counts) {
+        std::cout << std::left << std::setw(20) << name << std::right << ' ' << count << '\n';
+    }
+    return 0;
+}